@@ -0,0 +1,138 @@
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+#include "BenchUtil.h"
+
+using namespace ggk::bench;
+
+namespace {
+
+bool parseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&](size_t& target) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+            target = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+            return target > 0;
+        };
+
+        bool ok = false;
+        if (strcmp(argv[i], "--suite") == 0 && i + 1 < argc) {
+            options.suite = argv[++i];
+            ok = options.suite == "all" || options.suite == "hci" || options.suite == "logger" ||
+                 options.suite == "gvariant" || options.suite == "gatt" || options.suite == "startup";
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+            ok = true;
+        } else if (strcmp(argv[i], "--iterations") == 0) {
+            ok = value(options.iterations);
+        } else if (strcmp(argv[i], "--commands") == 0) {
+            ok = value(options.commands);
+        } else if (strcmp(argv[i], "--batch") == 0) {
+            ok = value(options.batchSize);
+        } else if (strcmp(argv[i], "--reports") == 0) {
+            ok = value(options.reports);
+        } else if (strcmp(argv[i], "--completions") == 0) {
+            ok = value(options.completions);
+        } else if (strcmp(argv[i], "--window") == 0) {
+            ok = value(options.window);
+        }
+
+        if (!ok) {
+            fprintf(stderr,
+                    "usage: %s [--suite all|hci|logger|gvariant|gatt|startup] [--iterations N] [--json FILE]\n"
+                    "          [--commands N] [--batch N] [--reports N] [--completions N] [--window N]\n",
+                    argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeJsonString(FILE* pFile, const std::string& text) {
+    fputc('"', pFile);
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', pFile);
+        }
+        fputc(c, pFile);
+    }
+    fputc('"', pFile);
+}
+
+// 실행 정보와 결과 배열: {"context": {...}, "benchmarks": [{"name": ..., "<metric>": value, ...}, ...]}
+bool writeJson(const BenchOptions& options) {
+    FILE* pFile = fopen(options.jsonPath.c_str(), "w");
+    if (pFile == nullptr) {
+        perror(options.jsonPath.c_str());
+        return false;
+    }
+
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+    char date[32] = "";
+    time_t now = time(nullptr);
+    struct tm utc;
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime_r(&now, &utc));
+
+    fprintf(pFile, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"host_name\": ", date);
+    writeJsonString(pFile, host);
+    fprintf(pFile, ",\n    \"suite\": ");
+    writeJsonString(pFile, options.suite);
+    fprintf(pFile, ",\n    \"iterations\": %zu,\n    \"num_cpus\": %ld\n  },\n  \"benchmarks\": [", options.iterations,
+            sysconf(_SC_NPROCESSORS_ONLN));
+
+    const auto& results = benchResults();
+    for (size_t i = 0; i < results.size(); ++i) {
+        fprintf(pFile, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+        writeJsonString(pFile, results[i].name);
+        for (const auto& metric : results[i].metrics) {
+            fprintf(pFile, ", ");
+            writeJsonString(pFile, metric.first);
+            fprintf(pFile, ": %.3f", metric.second);
+        }
+        fprintf(pFile, "}");
+    }
+    fprintf(pFile, "\n  ]\n}\n");
+
+    bool ok = ferror(pFile) == 0;
+    return fclose(pFile) == 0 && ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    bool all = options.suite == "all";
+    bool ok = true;
+
+    if (all || options.suite == "logger") {
+        ok = runLoggerBenchmarks(options) && ok;
+    }
+    if (all || options.suite == "gvariant") {
+        ok = runGVariantBenchmarks(options) && ok;
+    }
+    if (all || options.suite == "gatt") {
+        ok = runGattBenchmarks(options) && ok;
+    }
+    if (all || options.suite == "startup") {
+        ok = runStartupBenchmarks(options) && ok;
+    }
+    // 가상 컨트롤러가 없으면 전체 실행에서는 건너뜀
+    if (all || options.suite == "hci") {
+        bool ran = runHciBenchmarks(options);
+        ok = (ran || all) && ok;
+    }
+
+    if (!options.jsonPath.empty() && !writeJson(options)) {
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
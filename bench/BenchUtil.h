@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ggk {
+namespace bench {
+
+// Command line options shared by every suite
+struct BenchOptions {
+    std::string suite = "all";          // all, hci, logger, gvariant, gatt, startup
+    size_t iterations = 1000000;        // 마이크로벤치마크 반복 횟수
+    std::string jsonPath;               // 비어 있지 않으면 모든 결과를 JSON으로 저장
+
+    // HCI (virtual controller)
+    size_t commands = 2000;
+    size_t batchSize = 32;
+    size_t reports = 100000;
+    size_t completions = 50000;
+    size_t window = 128;                // 처리되지 않은 주입 이벤트 최대 개수
+};
+
+// Suites; each returns false if it could not run
+bool runHciBenchmarks(const BenchOptions& options);
+bool runLoggerBenchmarks(const BenchOptions& options);
+bool runGVariantBenchmarks(const BenchOptions& options);
+bool runGattBenchmarks(const BenchOptions& options);
+bool runStartupBenchmarks(const BenchOptions& options);
+
+// Prevents the compiler from optimizing away a benchmarked value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Collects per-operation latencies and reports percentiles
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t expected = 0) { samples.reserve(expected); }
+
+    void add(uint64_t ns) { samples.push_back(ns); sorted = false; }
+    size_t count() const { return samples.size(); }
+
+    // `fraction` in [0, 1] (0.5 = 중앙값)
+    uint64_t percentile(double fraction) {
+        if (samples.empty()) {
+            return 0;
+        }
+        sort();
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(index, samples.size() - 1)];
+    }
+
+    uint64_t max() {
+        sort();
+        return samples.empty() ? 0 : samples.back();
+    }
+
+    double mean() const {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        double total = 0.0;
+        for (uint64_t sample : samples) {
+            total += static_cast<double>(sample);
+        }
+        return total / static_cast<double>(samples.size());
+    }
+
+private:
+    void sort() {
+        if (!sorted) {
+            std::sort(samples.begin(), samples.end());
+            sorted = true;
+        }
+    }
+
+    std::vector<uint64_t> samples;
+    bool sorted = false;
+};
+
+struct BenchResult;
+
+// Every printed result, in order, for the --json report
+inline std::vector<BenchResult>& benchResults() {
+    static std::vector<BenchResult> results;
+    return results;
+}
+
+// One benchmark result: a name plus named metrics, printed as one line
+struct BenchResult {
+    std::string name;
+    std::vector<std::pair<std::string, double>> metrics;
+
+    BenchResult& add(const std::string& metric, double value) {
+        metrics.emplace_back(metric, value);
+        return *this;
+    }
+
+    void print() const {
+        printf("%-36s", name.c_str());
+        for (const auto& metric : metrics) {
+            printf("  %s=%.1f", metric.first.c_str(), metric.second);
+        }
+        printf("\n");
+        fflush(stdout);
+        benchResults().push_back(*this);
+    }
+};
+
+// Runs `operation` `iterations` times after a 10% warm-up and prints ns_per_op and ops_per_s
+template <typename Operation>
+void benchLoop(const std::string& name, size_t iterations, Operation operation) {
+    // 워밍업
+    for (size_t i = 0; i < iterations / 10; ++i) {
+        operation();
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < iterations; ++i) {
+        operation();
+    }
+    double ns = static_cast<double>(nowNs() - start);
+
+    BenchResult{name, {}}
+        .add("ns_per_op", ns / static_cast<double>(iterations))
+        .add("ops_per_s", static_cast<double>(iterations) * 1e9 / ns)
+        .print();
+}
+
+// 지연 시간 기록을 결과에 추가 (마이크로초 단위)
+inline BenchResult& addLatency(BenchResult& result, LatencyRecorder& latency) {
+    return result.add("p50_us", static_cast<double>(latency.percentile(0.50)) / 1000.0)
+                 .add("p99_us", static_cast<double>(latency.percentile(0.99)) / 1000.0)
+                 .add("max_us", static_cast<double>(latency.max()) / 1000.0)
+                 .add("mean_us", latency.mean() / 1000.0);
+}
+
+} // namespace bench
+} // namespace ggk
@@ -0,0 +1,175 @@
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "GattWriteRequest.h"
+#include "GVariantCodec.h"
+#include "Utils.h"
+
+using namespace ggk;
+using namespace ggk::bench;
+
+// GVariant marshalling: Utils::gvariantFrom* helpers against the GVariantCodec templates
+//
+// Byte arrays are measured at a battery level (1 byte), an ATT payload at the default MTU (20), at a 247 byte MTU (244) and at
+// the largest attribute value (512). The decode cases compare the old handleWriteValue path (stringFromGVariantByteArray, then a
+// vector built from the string) with a vector decoded in one block and with a GVariantBytes view that copies nothing. The
+// write_ingest cases parse whole WriteValue parameters ("(aya{sv})" with device, type and mtu options); the _options variant also
+// unpacks the dictionary, which only happens when a callback asks for the metadata.
+
+namespace {
+
+// 부동 참조를 받아 해제 (BlueZ에 응답을 넘긴 뒤와 같은 상태)
+void consume(GVariant* pVariant) {
+    g_variant_unref(g_variant_ref_sink(pVariant));
+}
+
+void benchByteArrays(size_t iterations) {
+    for (size_t size : {size_t(1), size_t(20), size_t(244), size_t(512)}) {
+        std::vector<uint8_t> bytes(size);
+        for (size_t i = 0; i < size; ++i) {
+            bytes[i] = static_cast<uint8_t>('A' + i % 26);     // NUL이 없어야 문자열 경로도 같은 길이를 읽음
+        }
+        std::string suffix = "_" + std::to_string(size);
+
+        benchLoop("bytes_to_variant_utils" + suffix, iterations, [&]() { consume(Utils::gvariantFromByteArray(bytes)); });
+        benchLoop("bytes_to_variant_codec" + suffix, iterations, [&]() { consume(toGVariant(bytes)); });
+
+        GVariant* pVariant = g_variant_ref_sink(toGVariant(bytes));
+        benchLoop("bytes_from_variant_utils" + suffix, iterations, [&]() {
+            std::string text = Utils::stringFromGVariantByteArray(pVariant);
+            std::vector<uint8_t> value(text.begin(), text.end());
+            doNotOptimize(value.data());
+        });
+        benchLoop("bytes_from_variant_codec" + suffix, iterations, [&]() {
+            std::vector<uint8_t> value;
+            fromGVariant(pVariant, value);
+            doNotOptimize(value.data());
+        });
+        benchLoop("bytes_from_variant_view" + suffix, iterations, [&]() {
+            GVariantBytes view;
+            fromGVariant(pVariant, view);
+            doNotOptimize(view.data);
+        });
+        g_variant_unref(pVariant);
+    }
+}
+
+void benchWriteIngest(size_t iterations) {
+    for (size_t size : {size_t(20), size_t(244), size_t(512)}) {
+        std::vector<uint8_t> bytes(size, 0x5A);
+        GVariantBuilder builder;
+        g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+        g_variant_builder_add(&builder, "{sv}", "device", g_variant_new_object_path("/org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF"));
+        g_variant_builder_add(&builder, "{sv}", "type", g_variant_new_string("command"));
+        g_variant_builder_add(&builder, "{sv}", "mtu", g_variant_new_uint16(247));
+        GVariant* pParameters = g_variant_ref_sink(g_variant_new("(@ay@a{sv})", toGVariant(bytes), g_variant_builder_end(&builder)));
+        std::string suffix = "_" + std::to_string(size);
+
+        // 이전 handleWriteValue: 문자열, 콜백용 벡터, 저장된 값으로 복사
+        std::vector<uint8_t> stored;
+        benchLoop("write_ingest_vector" + suffix, iterations, [&]() {
+            GVariantPtr value = makeGVariantPtr(g_variant_get_child_value(pParameters, 0));
+            std::string text = Utils::stringFromGVariantByteArray(value.get());
+            std::vector<uint8_t> newValue(text.begin(), text.end());
+            stored = newValue;
+            doNotOptimize(stored.data());
+        });
+        benchLoop("write_ingest_request" + suffix, iterations, [&]() {
+            GattWriteRequest request;
+            GattWriteRequest::parse(pParameters, request);
+            doNotOptimize(request.pData);
+        });
+        benchLoop("write_ingest_request_options" + suffix, iterations, [&]() {
+            GattWriteRequest request;
+            GattWriteRequest::parse(pParameters, request);
+            doNotOptimize(request.device());
+        });
+        g_variant_unref(pParameters);
+    }
+}
+
+// 속성 값으로 쓰이는 스칼라 (UUID 문자열, 서비스 경로, Primary/Notifying, 정수)
+void benchScalars(size_t iterations) {
+    const std::string uuid = "00002a19-0000-1000-8000-00805f9b34fb";
+    const DBusObjectPath service("/com/example/bleserver/service0");
+
+    benchLoop("string_to_variant_utils", iterations, [&]() { consume(Utils::gvariantFromString(uuid)); });
+    benchLoop("string_to_variant_codec", iterations, [&]() { consume(toGVariant(uuid)); });
+    benchLoop("object_to_variant_utils", iterations, [&]() { consume(Utils::gvariantFromObject(service)); });
+    benchLoop("object_to_variant_codec", iterations, [&]() { consume(toGVariant(service)); });
+    benchLoop("boolean_to_variant_utils", iterations, [&]() { consume(Utils::gvariantFromBoolean(true)); });
+    benchLoop("boolean_to_variant_codec", iterations, [&]() { consume(toGVariant(true)); });
+    benchLoop("int32_to_variant_utils", iterations, [&]() { consume(Utils::gvariantFromInt(gint32(-42))); });
+    benchLoop("int32_to_variant_codec", iterations, [&]() { consume(toGVariant(int32_t(-42))); });
+}
+
+void benchStringArrays(size_t iterations) {
+    std::vector<std::string> flags = {"read", "write", "write-without-response", "notify", "indicate"};
+
+    benchLoop("string_array_to_variant_utils", iterations, [&]() { consume(Utils::gvariantFromStringArray(flags)); });
+    benchLoop("string_array_to_variant_codec", iterations, [&]() { consume(toGVariant(flags)); });
+
+    GVariant* pVariant = g_variant_ref_sink(toGVariant(flags));
+    benchLoop("string_array_from_variant_iter", iterations, [&]() {
+        std::vector<std::string> values;
+        GVariantIter iter;
+        const gchar* pFlag = nullptr;
+        g_variant_iter_init(&iter, pVariant);
+        while (g_variant_iter_next(&iter, "&s", &pFlag)) {
+            values.emplace_back(pFlag);
+        }
+        doNotOptimize(values.data());
+    });
+    benchLoop("string_array_from_variant_codec", iterations, [&]() {
+        std::vector<std::string> values;
+        fromGVariant(pVariant, values);
+        doNotOptimize(values.data());
+    });
+    g_variant_unref(pVariant);
+}
+
+// GattCharacteristic 속성 딕셔너리 (a{sv}): 포맷 문자열 빌더 대 템플릿
+void benchProperties(size_t iterations) {
+    const std::string uuid = "00002a19-0000-1000-8000-00805f9b34fb";
+    const DBusObjectPath service("/com/example/bleserver/service0");
+    const std::vector<std::string> flags = {"read", "notify"};
+    const std::vector<uint8_t> value = {0x64};
+
+    benchLoop("properties_to_variant_builder", iterations, [&]() {
+        GVariantBuilder builder;
+        g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+        g_variant_builder_add(&builder, "{sv}", "UUID", Utils::gvariantFromString(uuid));
+        g_variant_builder_add(&builder, "{sv}", "Service", Utils::gvariantFromObject(service));
+        g_variant_builder_add(&builder, "{sv}", "Flags", Utils::gvariantFromStringArray(flags));
+        g_variant_builder_add(&builder, "{sv}", "Value", Utils::gvariantFromByteArray(value));
+        g_variant_builder_add(&builder, "{sv}", "Notifying", Utils::gvariantFromBoolean(false));
+        consume(g_variant_builder_end(&builder));
+    });
+
+    benchLoop("properties_to_variant_codec", iterations, [&]() {
+        std::map<std::string, GVariantPtr> properties;
+        properties.emplace("UUID", makeGVariantPtr(g_variant_ref_sink(toGVariant(uuid))));
+        properties.emplace("Service", makeGVariantPtr(g_variant_ref_sink(toGVariant(service))));
+        properties.emplace("Flags", makeGVariantPtr(g_variant_ref_sink(toGVariant(flags))));
+        properties.emplace("Value", makeGVariantPtr(g_variant_ref_sink(toGVariant(value))));
+        properties.emplace("Notifying", makeGVariantPtr(g_variant_ref_sink(toGVariant(false))));
+        consume(toGVariant(properties));
+    });
+}
+
+} // namespace
+
+bool ggk::bench::runGVariantBenchmarks(const BenchOptions& options) {
+    // GVariant 생성은 할당을 포함하므로 반복 횟수를 줄임
+    size_t iterations = std::max<size_t>(options.iterations / 10, 1);
+
+    benchByteArrays(iterations);
+    benchWriteIngest(iterations);
+    benchScalars(iterations);
+    benchStringArrays(iterations);
+    benchProperties(iterations);
+    return true;
+}
@@ -0,0 +1,185 @@
+#include <gio/gio.h>
+
+#include "BenchUtil.h"
+#include "BlueZConstants.h"
+#include "GattApplication.h"
+#include "GattTypes.h"
+#include "Logger.h"
+
+using namespace ggk;
+using namespace ggk::bench;
+
+// GATT and D-Bus hot paths
+//
+// GattUuid parsing and formatting, the introspection XML of a characteristic, the GetManagedObjects reply for trees of 10, 100
+// and 1000 characteristics (10 per service), and ReadValue/WriteValue dispatch.
+//
+// Dispatch runs the real handlers: the objects are registered on one end of an in-process peer-to-peer D-Bus connection (a
+// socketpair, no bus daemon) and the benchmark calls them from the other end, so the numbers include GDBus marshalling and its
+// worker thread hops but not dbus-daemon routing. BlueZ adds one more hop through the daemon on a real system.
+
+namespace {
+
+constexpr size_t kCharacteristicsPerService = 10;
+constexpr size_t kDispatchValueSize = 20;               // 기본 MTU의 ATT 페이로드
+
+// generateIntrospectionXml은 protected: 파생 클래스를 통해 멤버 포인터를 얻음
+struct IntrospectionAccess : DBusObject {
+    using DBusObject::generateIntrospectionXml;
+};
+
+// 서비스당 특성 10개인 트리 생성 (특성은 생성 시 연결에 등록됨)
+GattApplication& buildTree(GattApplication& application, size_t characteristics) {
+    size_t serviceCount = (characteristics + kCharacteristicsPerService - 1) / kCharacteristicsPerService;
+    for (size_t s = 0; s < serviceCount; ++s) {
+        auto service = std::make_shared<GattService>(
+            application.getConnection(),
+            application.getPath() + ("service" + std::to_string(s)),
+            GattUuid::fromShortUuid(static_cast<uint16_t>(0xA000 + s)),
+            true);
+
+        size_t count = std::min(kCharacteristicsPerService, characteristics - s * kCharacteristicsPerService);
+        for (size_t c = 0; c < count; ++c) {
+            service->createCharacteristic(GattUuid::fromShortUuid(static_cast<uint16_t>(0x2A00 + c)),
+                                          GattProperty::PROP_READ | GattProperty::PROP_WRITE | GattProperty::PROP_NOTIFY,
+                                          GattPermission::PERM_READ | GattPermission::PERM_WRITE);
+        }
+        application.addService(service);
+    }
+    return application;
+}
+
+void benchUuid(size_t iterations) {
+    const std::string text = "12345678-1234-5678-1234-56789abcdef0";
+    const GattUuid uuid(text);
+
+    benchLoop("uuid_parse_128", iterations, [&]() { doNotOptimize(GattUuid(text).toString().size()); });
+    benchLoop("uuid_from_short", iterations, [&]() { doNotOptimize(GattUuid::fromShortUuid(0x2A19).toString().size()); });
+    benchLoop("uuid_to_string", iterations, [&]() { doNotOptimize(uuid.toString().size()); });
+    benchLoop("uuid_to_bluez_format", iterations, [&]() { doNotOptimize(uuid.toBlueZFormat().size()); });
+    benchLoop("uuid_to_bluez_short_format", iterations, [&]() {
+        doNotOptimize(GattUuid::fromShortUuid(0x2A19).toBlueZShortFormat().size());
+    });
+}
+
+void benchIntrospection(const GattCharacteristic& characteristic, size_t iterations) {
+    auto generate = &IntrospectionAccess::generateIntrospectionXml;
+    const DBusObject& object = characteristic;
+
+    benchLoop("introspection_xml_characteristic", iterations, [&]() { doNotOptimize((object.*generate)().size()); });
+}
+
+void benchManagedObjects(DBusConnection& connection, size_t iterations) {
+    for (size_t characteristics : {size_t(10), size_t(100), size_t(1000)}) {
+        GattApplication application(connection, DBusObjectPath("/com/example/tree" + std::to_string(characteristics)));
+        buildTree(application, characteristics);
+
+        // 트리 크기에 비례해 반복 횟수를 줄임
+        size_t scaled = std::max<size_t>(iterations * 10 / characteristics, 10);
+        benchLoop("managed_objects_" + std::to_string(characteristics), scaled, [&]() {
+            doNotOptimize(application.createManagedObjectsDict().get());
+        });
+    }
+}
+
+// 비동기 호출 후 응답이 올 때까지 기본 메인 컨텍스트를 돌림 (핸들러도 이 컨텍스트에서 실행됨)
+bool callAndWait(GDBusConnection* pClient, const char* pPath, const char* pMethod, GVariant* pParameters) {
+    struct Reply {
+        bool done = false;
+        bool ok = false;
+    } reply;
+
+    g_dbus_connection_call(
+        pClient, nullptr, pPath, BlueZConstants::GATT_CHARACTERISTIC_INTERFACE.c_str(), pMethod, pParameters, nullptr,
+        G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+        [](GObject* pSource, GAsyncResult* pResult, gpointer pUserData) {
+            Reply* pReply = static_cast<Reply*>(pUserData);
+            GVariant* pResultValue = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, nullptr);
+            pReply->ok = pResultValue != nullptr;
+            if (pResultValue != nullptr) {
+                g_variant_unref(pResultValue);
+            }
+            pReply->done = true;
+        },
+        &reply);
+
+    while (!reply.done) {
+        g_main_context_iteration(nullptr, TRUE);
+    }
+    return reply.ok;
+}
+
+template <typename MakeParameters>
+void benchDispatch(const std::string& name, GDBusConnection* pClient, const std::string& path, const char* pMethod,
+                   size_t iterations, MakeParameters makeParameters) {
+    for (size_t i = 0; i < iterations / 10; ++i) {
+        callAndWait(pClient, path.c_str(), pMethod, makeParameters());
+    }
+
+    LatencyRecorder latency(iterations);
+    size_t failed = 0;
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < iterations; ++i) {
+        uint64_t callStart = nowNs();
+        failed += callAndWait(pClient, path.c_str(), pMethod, makeParameters()) ? 0 : 1;
+        latency.add(nowNs() - callStart);
+    }
+    double ns = static_cast<double>(nowNs() - start);
+
+    BenchResult result{name, {}};
+    result.add("ns_per_op", ns / static_cast<double>(iterations))
+          .add("ops_per_s", static_cast<double>(iterations) * 1e9 / ns);
+    addLatency(result, latency).add("failed", static_cast<double>(failed)).print();
+}
+
+void benchReadWriteDispatch(GDBusConnection* pClient, GattCharacteristic& characteristic, size_t iterations) {
+    const std::string path = characteristic.getPath().toString();
+    std::vector<uint8_t> value(kDispatchValueSize, 0x5A);
+    characteristic.setValue(value);
+
+    benchDispatch("read_value_dispatch", pClient, path, "ReadValue", iterations, []() {
+        return g_variant_new("(@a{sv})", g_variant_new_array(G_VARIANT_TYPE("{sv}"), nullptr, 0));
+    });
+
+    auto makeWrite = [&value]() {
+        GVariant* pBytes = g_variant_new_fixed_array(G_VARIANT_TYPE("y"), value.data(), value.size(), sizeof(uint8_t));
+        return g_variant_new("(@ay@a{sv})", pBytes, g_variant_new_array(G_VARIANT_TYPE("{sv}"), nullptr, 0));
+    };
+
+    benchDispatch("write_value_dispatch", pClient, path, "WriteValue", iterations, makeWrite);
+
+    characteristic.setWriteRequestCallback([](GattWriteRequest& request) {
+        doNotOptimize(request.pData);
+        return true;
+    });
+    benchDispatch("write_value_dispatch_request", pClient, path, "WriteValue", iterations, makeWrite);
+    characteristic.setWriteRequestCallback(nullptr);
+}
+
+} // namespace
+
+bool ggk::bench::runGattBenchmarks(const BenchOptions& options) {
+    benchUuid(options.iterations);
+
+    GDBusConnectionPtr server = makeGDBusConnectionPtr(nullptr);
+    GDBusConnectionPtr client = makeGDBusConnectionPtr(nullptr);
+    if (!DBusConnection::openPeerPair(server, client)) {
+        return false;
+    }
+
+    {
+        DBusConnection connection(std::move(server));
+        GattApplication application(connection, DBusObjectPath("/com/example/dispatch"));
+        buildTree(application, 1);
+        GattCharacteristicPtr characteristic = application.getServices().front()->getCharacteristics().begin()->second;
+
+        benchIntrospection(*characteristic, std::max<size_t>(options.iterations / 10, 1));
+        benchManagedObjects(connection, std::max<size_t>(options.iterations / 100, 1));
+
+        // 왕복 한 번이 수십 마이크로초
+        benchReadWriteDispatch(client.get(), *characteristic, std::max<size_t>(options.iterations / 100, 1));
+    }
+
+    g_dbus_connection_close_sync(client.get(), nullptr, nullptr);
+    return true;
+}
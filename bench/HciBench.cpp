@@ -0,0 +1,221 @@
+#include <atomic>
+#include <thread>
+
+#include "BenchUtil.h"
+#include "HciAdapter.h"
+#include "VirtualController.h"
+
+using namespace ggk;
+using namespace ggk::bench;
+
+// End-to-end HCI benchmarks against a /dev/vhci virtual controller
+//
+// Everything between the kernel and the application is real (raw HCI socket, command queue, event thread, decoder, connection
+// tracker, ACL credits); only the radio is replaced by VirtualController. Injected events are paced with a fixed window of
+// in-flight events so the socket receive buffer never overflows and every run processes the same number of events.
+//
+// The hci_decode cases need no device: they feed prebuilt event parameters to HciEventDecoder::decode, the parsing step the
+// event thread runs for every packet read from the socket.
+
+namespace {
+
+const uint16_t kReadLocalVersion = 0x1001;
+const uint16_t kVendorNop = 0xFC01;
+const uint16_t kBenchHandle = 0x0040;
+const std::chrono::seconds kDrainTimeout(10);
+
+template <typename Counter>
+bool waitForCount(Counter counter, uint64_t expected) {
+    auto deadline = std::chrono::steady_clock::now() + kDrainTimeout;
+    while (counter() < expected) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// 소켓 없이 디코더만: 광고 보고서(31바이트 데이터), 완료 패킷 수, 연결 해제
+void benchEventDecode(const BenchOptions& options) {
+    HciEventDecoder decoder;
+    int64_t sink = 0;
+    decoder.onLeAdvertisingReport([&sink](const HciLeAdvertisingReportView& report) {
+        sink += report.rssi() + static_cast<int64_t>(report.data().size);
+    });
+    decoder.onNumberOfCompletedPackets([&sink](const HciNumberOfCompletedPacketsView& view) {
+        for (size_t i = 0; i < view.count(); ++i) {
+            sink += view.completedPackets(i);
+        }
+    });
+    decoder.onDisconnectionComplete([&sink](const HciDisconnectionCompleteView& view) { sink += view.reason(); });
+
+    // [subevent][num reports][event type][address type][address(6)][data length][data(31)][rssi]
+    std::vector<uint8_t> advertisingReport = {HciEventDecoder::LE_ADVERTISING_REPORT, 0x01, 0x00, 0x00,
+                                              0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 31};
+    advertisingReport.insert(advertisingReport.end(), 31, 0xAB);
+    advertisingReport.push_back(static_cast<uint8_t>(-60));
+
+    const uint8_t completedPackets[] = {0x01, kBenchHandle & 0xFF, kBenchHandle >> 8, 0x01, 0x00};
+    const uint8_t disconnection[] = {0x00, kBenchHandle & 0xFF, kBenchHandle >> 8, 0x13};
+
+    benchLoop("hci_decode_adv_report", options.iterations, [&]() {
+        decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(advertisingReport.data(), advertisingReport.size()));
+    });
+    benchLoop("hci_decode_completed_packets", options.iterations, [&]() {
+        decoder.decode(HciEventDecoder::EVT_NUMBER_OF_COMPLETED_PACKETS, HciByteView(completedPackets, sizeof(completedPackets)));
+    });
+    benchLoop("hci_decode_disconnection", options.iterations, [&]() {
+        decoder.decode(HciEventDecoder::EVT_DISCONNECTION_COMPLETE, HciByteView(disconnection, sizeof(disconnection)));
+    });
+    benchLoop("hci_decode_unhandled", options.iterations, [&]() {
+        decoder.decode(HciEventDecoder::EVT_COMMAND_STATUS, HciByteView(disconnection, sizeof(disconnection)));
+    });
+    doNotOptimize(sink);
+}
+
+// 명령 하나씩 전송 후 Command Complete까지 왕복 시간
+void benchCommandLatency(HciAdapter& adapter, const BenchOptions& options) {
+    LatencyRecorder latency(options.commands);
+    size_t failures = 0;
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < options.commands; ++i) {
+        uint64_t sent = nowNs();
+        if (!adapter.sendCommandSync(kReadLocalVersion, {}).succeeded()) {
+            ++failures;
+        }
+        latency.add(nowNs() - sent);
+    }
+    double seconds = static_cast<double>(nowNs() - start) / 1e9;
+
+    BenchResult result{"hci_command_latency", {}};
+    addLatency(result, latency)
+        .add("commands_per_s", static_cast<double>(options.commands) / seconds)
+        .add("failures", static_cast<double>(failures))
+        .print();
+}
+
+// 명령 큐 파이프라인 (컨트롤러 크레딧이 허용하는 만큼 연속 전송)
+void benchCommandBatch(HciAdapter& adapter, const BenchOptions& options) {
+    std::vector<HciCommand> batch(options.batchSize);
+    for (HciCommand& command : batch) {
+        command.opcode = kVendorNop;
+    }
+
+    size_t batches = std::max<size_t>(options.commands / options.batchSize, 1);
+    LatencyRecorder latency(batches);
+    size_t failures = 0;
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < batches; ++i) {
+        uint64_t sent = nowNs();
+        if (!adapter.sendCommandBatch(batch)) {
+            ++failures;
+        }
+        latency.add(nowNs() - sent);
+    }
+    double seconds = static_cast<double>(nowNs() - start) / 1e9;
+
+    BenchResult result{"hci_command_batch_" + std::to_string(options.batchSize), {}};
+    addLatency(result, latency)
+        .add("commands_per_s", static_cast<double>(batches * options.batchSize) / seconds)
+        .add("failures", static_cast<double>(failures))
+        .print();
+}
+
+// 광고 보고서 주입 -> 이벤트 스레드 -> 디코더 핸들러
+void benchAdvertisingReports(VirtualController& controller, const std::atomic<uint64_t>& decoded, const BenchOptions& options) {
+    const uint8_t address[6] = {0x01, 0x02, 0x03, 0x04, 0x05, 0xC6};
+    const uint8_t data[] = {0x02, 0x01, 0x06, 0x09, 0x09, 'b', 'l', 'e', '-', 'b', 'e', 'n', 'c', 'h'};
+
+    uint64_t base = decoded.load();
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < options.reports; ++i) {
+        while (i - (decoded.load() - base) >= options.window) {
+            std::this_thread::yield();
+        }
+        controller.injectAdvertisingReport(0x01, address, data, sizeof(data));
+    }
+    bool complete = waitForCount([&] { return decoded.load() - base; }, options.reports);
+    double seconds = static_cast<double>(nowNs() - start) / 1e9;
+
+    BenchResult{"hci_adv_report_decode", {}}
+        .add("events_per_s", static_cast<double>(decoded.load() - base) / seconds)
+        .add("ns_per_event", seconds * 1e9 / static_cast<double>(options.reports))
+        .add("lost", complete ? 0.0 : static_cast<double>(options.reports - (decoded.load() - base)))
+        .print();
+}
+
+// Number of Completed Packets -> AclFlowControl 크레딧 반환
+void benchCompletedPackets(HciAdapter& adapter, VirtualController& controller, const BenchOptions& options) {
+    const uint8_t peer[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+    AclFlowControl& flowControl = adapter.getAclFlowControl();
+
+    controller.injectLeConnectionComplete(kBenchHandle, peer);
+    if (!waitForCount([&] { return adapter.getConnectionTracker().connectionCount(); }, 1)) {
+        Logger::error("Virtual connection was not reported");
+        return;
+    }
+
+    auto completed = [&] {
+        AclFlowControl::ConnectionCredits credits;
+        return flowControl.getCredits(kBenchHandle, credits) ? credits.completed : 0;
+    };
+
+    flowControl.packetsQueued(kBenchHandle, options.completions);
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < options.completions; ++i) {
+        while (i - completed() >= options.window) {
+            std::this_thread::yield();
+        }
+        controller.injectNumberOfCompletedPackets(kBenchHandle, 1);
+    }
+    bool complete = waitForCount(completed, options.completions);
+    double seconds = static_cast<double>(nowNs() - start) / 1e9;
+
+    BenchResult{"hci_completed_packets", {}}
+        .add("events_per_s", static_cast<double>(completed()) / seconds)
+        .add("ns_per_event", seconds * 1e9 / static_cast<double>(options.completions))
+        .add("lost", complete ? 0.0 : static_cast<double>(options.completions - completed()))
+        .print();
+
+    controller.injectDisconnectionComplete(kBenchHandle);
+}
+
+} // namespace
+
+bool ggk::bench::runHciBenchmarks(const BenchOptions& options) {
+    benchEventDecode(options);
+
+    if (!VirtualController::isAvailable()) {
+        fprintf(stderr, "hci: skipped, %s is not available (load hci_vhci and run as root)\n", VirtualController::kDevicePath);
+        return false;
+    }
+
+    VirtualController controller;
+    controller.setResponse(kVendorNop, 0x00);
+    if (!controller.open()) {
+        return false;
+    }
+
+    HciAdapter adapter(controller.getDeviceIndex());
+    std::atomic<uint64_t> decoded(0);
+    adapter.getEventDecoder().onLeAdvertisingReport([&decoded](const HciLeAdvertisingReportView&) {
+        decoded.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    if (!adapter.initialize()) {
+        return false;
+    }
+
+    benchCommandLatency(adapter, options);
+    benchCommandBatch(adapter, options);
+    benchAdvertisingReports(controller, decoded, options);
+    benchCompletedPackets(adapter, controller, options);
+
+    adapter.stop();
+    controller.close();
+    return true;
+}
@@ -0,0 +1,171 @@
+#include <fcntl.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+#include "AsyncLogSink.h"
+#include "BenchUtil.h"
+#include "BinaryLog.h"
+#include "GattTypes.h"
+#include "Logger.h"
+
+using namespace ggk;
+using namespace ggk::bench;
+
+// Cost of the logging done by GattCharacteristic::handleReadValue
+//
+// Runs the part of ReadValue that does not touch D-Bus (debug log line, read callback under its lock, copy of the value) with the
+// eager `Logger::debug("..." + uuid.toString())` call it used to make and with the level-gated GGK_LOG_DEBUG macro, for debug
+// logging off (no receiver / receiver registered but the Gatt module above debug) and on, and with GGK_BLOG_DEBUG recording to
+// a BinaryLog file in /tmp (debug tracing left on in production).
+//
+// The output benchmarks compare a receiver that writes each line synchronously (as main.cpp's console receiver did) with
+// AsyncLogSink, measuring the latency seen by the logging thread; both write to /dev/null so the device does not dominate.
+
+namespace {
+
+size_t g_sinkBytes = 0;
+
+void nullSink(const char* pText) {
+    g_sinkBytes += pText[0] != '\0' ? 1 : 0;
+}
+
+struct ReadValueFixture {
+    GattUuid uuid = GattUuid::fromShortUuid(0x2A19);
+    std::mutex callbackMutex;
+    std::vector<uint8_t> value = {0x64};
+
+    std::vector<uint8_t> readCallback() { return value; }
+};
+
+enum class LogStyle {
+    Eager,      // Logger::debug(문자열 연결)
+    Macro,      // GGK_LOG_DEBUG
+    Binary      // GGK_BLOG_DEBUG
+};
+
+template <LogStyle Style>
+std::vector<uint8_t> readValue(ReadValueFixture& fixture) {
+    if (Style == LogStyle::Eager) {
+        Logger::debug("ReadValue called for characteristic: " + fixture.uuid.toString());
+    } else if (Style == LogStyle::Macro) {
+        GGK_LOG_DEBUG(Gatt, "ReadValue called for characteristic: " << fixture.uuid.toString());
+    } else {
+        GGK_BLOG_DEBUG(Gatt, "ReadValue called for characteristic: {}", fixture.uuid.toString());
+    }
+
+    std::lock_guard<std::mutex> lock(fixture.callbackMutex);
+    return fixture.readCallback();
+}
+
+template <LogStyle Style>
+void benchReadValue(const std::string& name, ReadValueFixture& fixture, size_t iterations) {
+    // 워밍업
+    for (size_t i = 0; i < iterations / 10; ++i) {
+        doNotOptimize(readValue<Style>(fixture).size());
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < iterations; ++i) {
+        doNotOptimize(readValue<Style>(fixture).size());
+    }
+    double ns = static_cast<double>(nowNs() - start);
+
+    BenchResult{name, {}}
+        .add("ns_per_op", ns / static_cast<double>(iterations))
+        .add("ops_per_s", static_cast<double>(iterations) * 1e9 / ns)
+        .print();
+}
+
+int g_syncFd = -1;
+
+void syncFileSink(const char* pText) {
+    std::string line = std::string(pText) + "\n";
+    ssize_t result = write(g_syncFd, line.data(), line.size());
+    doNotOptimize(result);
+}
+
+// 로그 한 줄당 호출 스레드 지연 시간
+void benchLogOutput(const std::string& name, size_t iterations) {
+    LatencyRecorder latency(iterations);
+    for (size_t i = 0; i < iterations; ++i) {
+        uint64_t start = nowNs();
+        Logger::info("Notification sent for characteristic: 00002a19-0000-1000-8000-00805f9b34fb");
+        latency.add(nowNs() - start);
+    }
+
+    BenchResult result{name, {}};
+    addLatency(result, latency).print();
+}
+
+void benchOutputs(size_t iterations) {
+    // 동기 write() 수신자
+    g_syncFd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (g_syncFd < 0) {
+        return;
+    }
+    Logger::registerInfoReceiver(&syncFileSink);
+    benchLogOutput("log_output_sync_write", iterations);
+    close(g_syncFd);
+    g_syncFd = -1;
+
+    // 비동기 싱크 (링이 넘치면 버림 / 기다림)
+    for (AsyncLogSink::OverflowPolicy policy : {AsyncLogSink::OverflowPolicy::Drop, AsyncLogSink::OverflowPolicy::Block}) {
+        bool drop = policy == AsyncLogSink::OverflowPolicy::Drop;
+        AsyncLogSink sink;
+        if (!sink.openFile("/dev/null") || !sink.start()) {
+            return;
+        }
+        sink.setOverflowPolicy(policy);
+        sink.install();
+
+        benchLogOutput(drop ? "log_output_async_drop" : "log_output_async_block", iterations);
+        sink.flush(std::chrono::seconds(10));
+
+        AsyncLogSink::Statistics statistics = sink.getStatistics();
+        BenchResult{drop ? "log_output_async_drop_stats" : "log_output_async_block_stats", {}}
+            .add("written", static_cast<double>(statistics.written))
+            .add("dropped", static_cast<double>(statistics.dropped))
+            .print();
+    }
+    Logger::registerInfoReceiver(nullptr);
+}
+
+} // namespace
+
+bool ggk::bench::runLoggerBenchmarks(const BenchOptions& options) {
+    ReadValueFixture fixture;
+    size_t iterations = options.iterations;
+
+    // 디버그 수신자 없음 (배포 기본값)
+    Logger::registerDebugReceiver(nullptr);
+    Logger::setLevel(LogLevel::Trace);
+    benchReadValue<LogStyle::Eager>("read_value_debug_off_eager", fixture, iterations);
+    benchReadValue<LogStyle::Macro>("read_value_debug_off_macro", fixture, iterations);
+
+    // 수신자는 등록되어 있지만 Gatt 모듈은 info 이상만 기록
+    Logger::registerDebugReceiver(&nullSink);
+    Logger::setLevel(LogModule::Gatt, LogLevel::Info);
+    benchReadValue<LogStyle::Eager>("read_value_gatt_info_eager", fixture, iterations);
+    benchReadValue<LogStyle::Macro>("read_value_gatt_info_macro", fixture, iterations);
+
+    // 디버그 로그 기록
+    Logger::setLevel(LogModule::Gatt, LogLevel::Trace);
+    benchReadValue<LogStyle::Eager>("read_value_debug_on_eager", fixture, iterations);
+    benchReadValue<LogStyle::Macro>("read_value_debug_on_macro", fixture, iterations);
+
+    // 디버그 로그를 바이너리 파일에 기록
+    const std::string binaryLogPath = "/tmp/ble_bench.blog";
+    if (BinaryLog::open(binaryLogPath, 4 * 1024 * 1024)) {
+        benchReadValue<LogStyle::Binary>("read_value_debug_on_binary", fixture, iterations);
+        BinaryLog::close();
+        unlink(binaryLogPath.c_str());
+    }
+
+    Logger::registerDebugReceiver(nullptr);
+    doNotOptimize(g_sinkBytes);
+
+    // 출력 경로: 호출 스레드가 부담하는 비용
+    benchOutputs(std::max<size_t>(iterations / 10, 1));
+    return true;
+}
@@ -0,0 +1,145 @@
+#include <gio/gio.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "BenchUtil.h"
+#include "GattApplication.h"
+#include "GattTypes.h"
+#include "Logger.h"
+#include "MockBluez.h"
+#include "StartupProfiler.h"
+
+using namespace ggk;
+using namespace ggk::bench;
+
+// Time to a registered GATT application
+//
+// For trees of 10, 100, 1000 and 10000 characteristics (10 per service): building the tree (each object generates its
+// introspection XML and is registered on the connection as it is created) and RegisterApplication up to its successful reply.
+// BlueZ is played by MockBluez on the other end of an in-process peer-to-peer connection and, like bluetoothd, replies only after
+// it has walked GetManagedObjects, so register_ms grows with the tree. The StartupProfiler phases split both numbers up.
+
+namespace {
+
+constexpr size_t kCharacteristicsPerService = 10;
+
+void buildTree(GattApplication& application, size_t characteristics) {
+    size_t serviceCount = (characteristics + kCharacteristicsPerService - 1) / kCharacteristicsPerService;
+    for (size_t s = 0; s < serviceCount; ++s) {
+        auto service = std::make_shared<GattService>(
+            application.getConnection(),
+            application.getPath() + ("service" + std::to_string(s)),
+            GattUuid::fromShortUuid(static_cast<uint16_t>(0xA000 + s)),
+            true);
+
+        size_t count = std::min(kCharacteristicsPerService, characteristics - s * kCharacteristicsPerService);
+        for (size_t c = 0; c < count; ++c) {
+            service->createCharacteristic(GattUuid::fromShortUuid(static_cast<uint16_t>(0x2A00 + c)),
+                                          GattProperty::PROP_READ | GattProperty::PROP_WRITE | GattProperty::PROP_NOTIFY,
+                                          GattPermission::PERM_READ | GattPermission::PERM_WRITE);
+        }
+        application.addService(service);
+    }
+}
+
+// 기록된 단계의 시간 (ms); 없으면 0
+double phaseMs(const std::vector<StartupProfiler::Phase>& phases, const char* pComponent, const char* pName) {
+    for (const StartupProfiler::Phase& phase : phases) {
+        if (phase.component == pComponent && phase.name == pName) {
+            return static_cast<double>(phase.durationNs) / 1e6;
+        }
+    }
+    return 0.0;
+}
+
+bool benchRegistration(size_t characteristics) {
+    GDBusConnectionPtr serverRaw = makeGDBusConnectionPtr(nullptr);
+    GDBusConnectionPtr bluezRaw = makeGDBusConnectionPtr(nullptr);
+    if (!DBusConnection::openPeerPair(serverRaw, bluezRaw)) {
+        return false;
+    }
+
+    MockBluez::Config config;
+    config.subscribe = false;
+
+    // 모의 BlueZ는 자체 컨텍스트의 스레드에서 (애플리케이션은 서버 스레드의 기본 컨텍스트)
+    std::atomic<bool> mockReady{false};
+    std::atomic<bool> mockFailed{false};
+    std::atomic<bool> quitMock{false};
+    GMainContext* pMockContext = g_main_context_new();
+    std::thread mockThread([&]() {
+        g_main_context_push_thread_default(pMockContext);
+        {
+            DBusConnection connection(std::move(bluezRaw));
+            MockBluez mock(connection, config);
+            mockFailed = !mock.start();
+            mockReady = true;
+            while (!mockFailed && !quitMock) {
+                g_main_context_iteration(pMockContext, TRUE);
+            }
+            mock.stop();
+        }
+        g_main_context_pop_thread_default(pMockContext);
+    });
+    while (!mockReady) {
+        std::this_thread::yield();
+    }
+
+    bool ok = !mockFailed;
+    if (ok) {
+        DBusConnection connection(std::move(serverRaw));
+
+        StartupProfiler::begin();
+        uint64_t start = nowNs();
+        GattApplication application(connection, DBusObjectPath("/com/example/startup"));
+        buildTree(application, characteristics);
+        uint64_t built = nowNs();
+
+        // 애플리케이션 객체는 기본 컨텍스트에 등록됨: 서버 스레드가 그 루프를 돌림
+        GMainLoop* pServerLoop = g_main_loop_new(nullptr, FALSE);
+        std::thread serverThread([pServerLoop]() { g_main_loop_run(pServerLoop); });
+
+        ok = application.registerWithBlueZ();
+        uint64_t registered = nowNs();
+        StartupProfiler::finish();
+
+        if (ok) {
+            std::vector<StartupProfiler::Phase> phases = StartupProfiler::getPhases();
+            double settleMs = phaseMs(phases, "gatt", "settle_delay");
+            BenchResult{"startup_register_" + std::to_string(characteristics) + "_chars", {}}
+                .add("build_ms", static_cast<double>(built - start) / 1e6)
+                .add("register_ms", static_cast<double>(registered - built) / 1e6)
+                .add("total_ms", static_cast<double>(registered - start) / 1e6)
+                .add("without_settle_ms", static_cast<double>(registered - start) / 1e6 - settleMs)
+                .add("xml_ms", phaseMs(phases, "dbus", "introspection_xml"))
+                .add("register_object_ms", phaseMs(phases, "dbus", "register_object"))
+                .add("settle_ms", settleMs)
+                .add("register_call_ms", phaseMs(phases, "gatt", "register_call"))
+                .print();
+        }
+
+        g_main_loop_quit(pServerLoop);
+        serverThread.join();
+        g_main_loop_unref(pServerLoop);
+    }
+
+    quitMock = true;
+    g_main_context_wakeup(pMockContext);
+    mockThread.join();
+    g_main_context_unref(pMockContext);
+    return ok;
+}
+
+} // namespace
+
+bool ggk::bench::runStartupBenchmarks(const BenchOptions& options) {
+    (void)options;
+
+    bool ok = true;
+    for (size_t characteristics : {10, 100, 1000, 10000}) {
+        ok = benchRegistration(characteristics) && ok;
+    }
+    return ok;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "ConnectionTracker.h"
+#include "GattCallbacks.h"
+#include "HciEventDecoder.h"
+
+namespace ggk {
+
+// Tracks the controller's LE ACL buffers and turns them into per-connection credits for notification producers
+//
+// The controller has a fixed number of ACL data packet buffers (LE Read Buffer Size) shared by all connections. Packets queued
+// by the application are charged to their connection and released again by Number of Completed Packets events. A connection has
+// credit while its outstanding packets are below its share of the buffers (an equal split unless a budget is set), so a bulk
+// stream on one link cannot fill every buffer and add latency to notifications on the others.
+//
+// Only packets reported through `packetsQueued()` / the credit callback are charged. Completions for traffic the application did
+// not report (e.g. ATT responses sent by bluetoothd) are counted separately and never push a connection below zero.
+//
+// A notification is charged to every connection because BlueZ does not tell the application which centrals subscribed. Charges
+// that a connection does not complete within the charge expiry (default 1 s) are dropped and the connection stops holding back
+// notifications until the controller reports completed packets for it again.
+class AclFlowControl {
+public:
+    static constexpr uint16_t CMD_READ_BUFFER_SIZE = 0x1005;
+    static constexpr uint16_t CMD_LE_READ_BUFFER_SIZE = 0x2002;
+
+    // Core spec 최소값 (LE 전용 버퍼를 읽지 못한 경우 사용)
+    static constexpr uint16_t kDefaultPacketLength = 27;
+    static constexpr uint16_t kDefaultTotalPackets = 4;
+
+    // L2CAP 기본 헤더(4) + ATT Handle Value Notification 헤더(3)
+    static constexpr size_t kNotificationOverhead = 7;
+
+    // 연결 간격(최대 4 s)보다 짧지만 일반적인 간격(7.5~50 ms)보다 충분히 긴 값
+    static constexpr std::chrono::milliseconds kDefaultChargeExpiry{1000};
+
+    struct ConnectionCredits {
+        size_t outstanding = 0;         // 전송 후 완료되지 않은 패킷
+        size_t budget = 0;              // 이 연결에 허용된 최대 미완료 패킷
+        uint64_t queued = 0;
+        uint64_t completed = 0;
+        uint64_t expired = 0;           // 완료되지 않고 만료된 패킷
+        bool receiving = true;          // false: 알림을 받지 않는 연결로 보고 알림 대기/예약에서 제외
+
+        bool hasCredit() const { return outstanding < budget; }
+    };
+
+    AclFlowControl();
+
+    AclFlowControl(const AclFlowControl&) = delete;
+    AclFlowControl& operator=(const AclFlowControl&) = delete;
+
+    // Registers for Number of Completed Packets and connection events
+    void attach(HciEventDecoder& decoder, ConnectionTracker& tracker);
+
+    // Controller buffer size (LE Read Buffer Size, or the shared BR/EDR buffers when the controller reports 0 LE buffers)
+    void setBufferSize(uint16_t packetLength, uint16_t totalPackets);
+    uint16_t getPacketLength() const;
+    uint16_t getTotalPackets() const;
+
+    // Caps every connection at `packets` outstanding packets (0 = equal share of the controller buffers)
+    void setConnectionBudget(size_t packets);
+
+    // Drops charges that have not completed after `expiry`
+    void setChargeExpiry(std::chrono::milliseconds expiry);
+
+    // Number of ACL packets a notification with a `bytes` payload occupies
+    size_t packetsForNotification(size_t bytes) const;
+
+    // Charges `count` packets to a connection
+    void packetsQueued(uint16_t handle, size_t count);
+
+    // Releases packets (Number of Completed Packets); public for tests
+    void packetsCompleted(uint16_t handle, size_t count);
+
+    // Poll / wait for credit on one connection or on all of them; unknown handles have no credit
+    bool hasCredit(uint16_t handle) const;
+    bool waitForCredit(uint16_t handle, std::chrono::milliseconds timeout);
+    bool waitForAllCredit(std::chrono::milliseconds timeout);
+
+    // Returns false for unknown connections
+    bool getCredits(uint16_t handle, ConnectionCredits& credits) const;
+
+    // Completions that did not match any packet charged by the application
+    uint64_t getUntrackedCompletions() const;
+
+    // Callback for GattCharacteristic::setCreditCallback(): waits until every receiving connection has credit and charges the
+    // notification to all of them (a notification goes to each subscribed central)
+    GattCreditCallback creditCallback();
+
+    void addConnection(uint16_t handle);
+    void removeConnection(uint16_t handle);
+    void clear();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // 완료 이벤트는 전송 순서대로 오므로 예약도 순서대로 해제
+    struct Charge {
+        Clock::time_point time;
+        size_t packets;
+    };
+
+    struct Connection {
+        ConnectionCredits credits;
+        std::deque<Charge> charges;
+    };
+
+    size_t budgetLocked() const;
+    void rebalanceLocked();
+    void chargeLocked(Connection& connection, size_t count, Clock::time_point now);
+    Clock::time_point expireChargesLocked(Clock::time_point now);
+    bool allHaveCreditLocked() const;
+    bool waitForAllCreditLocked(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout);
+
+    std::map<uint16_t, Connection> connections;
+    uint16_t packetLength;
+    uint16_t totalPackets;
+    size_t fixedBudget;
+    std::chrono::milliseconds chargeExpiry;
+    uint64_t untrackedCompletions;
+
+    mutable std::mutex mutex;
+    std::condition_variable creditCondition;
+};
+
+} // namespace ggk
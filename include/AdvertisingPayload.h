@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GattTypes.h"
+
+namespace ggk {
+
+// An encoded advertising payload (sequence of AD structures) in a fixed buffer
+//
+// Payloads are built once and copied around by value, so rotating between them never allocates. The capacity covers one
+// extended advertising data fragment; legacy advertising uses at most the first 31 bytes.
+struct AdvertisingPayload {
+    static constexpr size_t kCapacity = 251;
+
+    std::array<uint8_t, kCapacity> data = {};
+    uint8_t size = 0;
+
+    const uint8_t* bytes() const { return data.data(); }
+    bool empty() const { return size == 0; }
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(data.begin(), data.begin() + size); }
+};
+
+// Packs advertising fields into AD structures within a size limit
+//
+// Flags, TX power, service data and manufacturer data are required and make `build()` fail if they do not fit. Service UUIDs are
+// collapsed to their 16/32-bit forms when they are derived from the Bluetooth Base UUID and grouped into one list per width; lists
+// that do not fit completely are emitted as "incomplete" lists. The local name goes last and is shortened to the remaining space.
+class AdvertisingPayloadBuilder {
+public:
+    // AD types (Assigned Numbers, Common Data Types)
+    static constexpr uint8_t AD_FLAGS = 0x01;
+    static constexpr uint8_t AD_INCOMPLETE_UUID16 = 0x02;
+    static constexpr uint8_t AD_COMPLETE_UUID16 = 0x03;
+    static constexpr uint8_t AD_INCOMPLETE_UUID32 = 0x04;
+    static constexpr uint8_t AD_COMPLETE_UUID32 = 0x05;
+    static constexpr uint8_t AD_INCOMPLETE_UUID128 = 0x06;
+    static constexpr uint8_t AD_COMPLETE_UUID128 = 0x07;
+    static constexpr uint8_t AD_SHORTENED_NAME = 0x08;
+    static constexpr uint8_t AD_COMPLETE_NAME = 0x09;
+    static constexpr uint8_t AD_TX_POWER = 0x0A;
+    static constexpr uint8_t AD_SERVICE_DATA_UUID16 = 0x16;
+    static constexpr uint8_t AD_MANUFACTURER_DATA = 0xFF;
+
+    // LE General Discoverable, BR/EDR not supported
+    static constexpr uint8_t kDefaultFlags = 0x06;
+
+    static constexpr size_t kLegacyLimit = 31;
+
+    AdvertisingPayloadBuilder();
+
+    // Flags of 0 omit the Flags structure (e.g. non-connectable extended advertising)
+    AdvertisingPayloadBuilder& setFlags(uint8_t flags);
+    AdvertisingPayloadBuilder& setLocalName(const std::string& name);
+    AdvertisingPayloadBuilder& setTxPower(int8_t txPower);
+    AdvertisingPayloadBuilder& addServiceUuid(const GattUuid& uuid);
+    AdvertisingPayloadBuilder& addServiceData(uint16_t uuid, const std::vector<uint8_t>& data);
+    AdvertisingPayloadBuilder& addManufacturerData(uint16_t companyId, const std::vector<uint8_t>& data);
+
+    // Removes service data and manufacturer data (keeps name, flags and UUIDs) for rebuilding with new readings
+    AdvertisingPayloadBuilder& clearData();
+
+    // Encodes all fields into `payload`
+    // Returns false if the required fields do not fit in `limit` bytes
+    bool build(AdvertisingPayload& payload, size_t limit = kLegacyLimit) const;
+
+    // Returns the shortest encoding width of `uuid` (2, 4 or 16 bytes) and writes its little-endian bytes to `pOut`
+    static size_t encodeUuid(const GattUuid& uuid, uint8_t* pOut);
+
+private:
+    struct DataField {
+        uint8_t type;
+        uint16_t id;
+        std::vector<uint8_t> data;
+    };
+
+    uint8_t flags;
+    bool hasTxPower;
+    int8_t txPower;
+    std::string localName;
+    std::vector<GattUuid> serviceUuids;
+    std::vector<DataField> dataFields;
+};
+
+} // namespace ggk
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AdvertisingPayload.h"
+#include "ExtendedAdvertiser.h"
+#include "HciAdapter.h"
+
+namespace ggk {
+
+// Rotates the advertising data between precomputed payloads on a fixed period
+//
+// Each rotation sends exactly one Set Advertising Data command: LE Set Advertising Data (0x2008) for legacy advertising, or a
+// single complete LE Set Extended Advertising Data (0x2037) fragment when an extended advertising set is selected with
+// `useExtendedSet()`. Advertising parameters and enable state are left untouched. Payload slots may be replaced at any time
+// (e.g. with new sensor readings); the new payload goes out at the slot's next turn.
+//
+// A rotation is skipped while the previous command is still unanswered, so a slow controller never builds up a backlog. The rotator
+// may be destroyed with a command in flight: its completion only touches state shared with the callback.
+class AdvertisingRotator {
+public:
+    static constexpr std::chrono::milliseconds kDefaultPeriod{250};
+    static constexpr std::chrono::milliseconds kMinimumPeriod{20};
+
+    explicit AdvertisingRotator(HciAdapter& adapter);
+    ~AdvertisingRotator();
+
+    AdvertisingRotator(const AdvertisingRotator&) = delete;
+    AdvertisingRotator& operator=(const AdvertisingRotator&) = delete;
+
+    // Sends the payloads to an extended advertising set instead of legacy advertising
+    void useExtendedSet(uint8_t handle);
+    void useLegacy();
+
+    // Adds a payload slot and returns its index, or -1 if the payload is too large for the selected advertising type
+    int addPayload(const AdvertisingPayload& payload);
+
+    // Replaces the payload of a slot
+    bool updatePayload(size_t index, const AdvertisingPayload& payload);
+
+    void clearPayloads();
+    size_t getPayloadCount() const;
+
+    // Starts / stops the rotation timer
+    bool start(std::chrono::milliseconds period = kDefaultPeriod);
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+    // Sends the next payload (called by the timer thread; public for tests)
+    // Returns false if nothing was sent
+    bool rotate();
+
+    // Index of the slot sent last (-1 before the first rotation)
+    int getCurrentIndex() const { return currentIndex.load(); }
+
+    uint64_t getRotationCount() const { return rotationCount.load(); }
+    uint64_t getSkippedCount() const { return skippedCount.load(); }
+    uint64_t getFailureCount() const { return commandState->failures.load(); }
+
+    // Encodes the Set Advertising Data command parameters for `payload`
+    // Legacy commands are always 32 bytes (length + zero-padded 31-byte data); extended ones are the single fragment built by
+    // ExtendedAdvertiser::fragmentData().
+    static std::vector<uint8_t> encodeCommand(const AdvertisingPayload& payload, bool extended, uint8_t handle);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // 명령 완료 콜백이 갱신하는 상태 (콜백은 회전기보다 오래 살 수 있음)
+    struct CommandState {
+        std::atomic<bool> pending{false};
+        std::atomic<uint64_t> failures{0};
+    };
+
+    size_t maxPayloadSize() const;
+    void run(std::chrono::milliseconds period);
+
+    HciAdapter& adapter;
+
+    std::vector<AdvertisingPayload> payloads;
+    bool extended;
+    uint8_t setHandle;
+    mutable std::mutex payloadsMutex;
+
+    std::atomic<int> currentIndex;
+    std::shared_ptr<CommandState> commandState;
+    std::atomic<uint64_t> rotationCount;
+    std::atomic<uint64_t> skippedCount;
+
+    std::atomic<bool> running;
+    std::thread rotationThread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+};
+
+} // namespace ggk
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger.h"
+#include "SpscRing.h"
+
+namespace ggk {
+
+// Asynchronous Logger backend
+//
+// `install()` registers Logger receivers that copy each message, with its level, a timestamp and the thread id, into a fixed-size
+// record in a lock-free ring owned by the calling thread; nothing is formatted or written on that thread and, except for one
+// wake-up when the ring reaches half capacity, no system call is made (the clock is read through the vDSO, the thread id is
+// cached). A background thread collects the records from every ring,
+// orders them by timestamp, formats them and writes them to stdout, a file or the systemd journal in batches.
+//
+// When a thread's ring is full the overflow policy decides: `Drop` (default) discards the new message and counts it, and the
+// writer reports the count in the output; `Block` waits for room, for tools that must not lose messages. Messages longer than
+// kMaxMessageLength are truncated and counted.
+class AsyncLogSink {
+public:
+    enum class Target {
+        Stdout,
+        File,
+        Journal         // systemd-journald native protocol (/run/systemd/journal/socket)
+    };
+
+    enum class OverflowPolicy {
+        Drop,
+        Block
+    };
+
+    static constexpr size_t kRingCapacity = 512;           // 스레드당 레코드 수
+    static constexpr size_t kMaxMessageLength = 232;       // 레코드 크기를 256바이트로 유지
+    static constexpr std::chrono::milliseconds kPollInterval{5};
+    static constexpr const char* kJournalSocketPath = "/run/systemd/journal/socket";
+
+    struct Statistics {
+        uint64_t written = 0;
+        uint64_t dropped = 0;
+        uint64_t truncated = 0;
+        size_t producers = 0;           // 레코드를 남긴 스레드 (종료 후 비워진 링 제외)
+    };
+
+    AsyncLogSink();
+    ~AsyncLogSink();
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    // Output selection; call before start()
+    bool openStdout();
+    bool openFile(const std::string& path);
+    bool openJournal(const std::string& identifier);
+
+    void setOverflowPolicy(OverflowPolicy policy) { overflowPolicy.store(policy); }
+
+    // Starts the writer thread
+    bool start();
+
+    // Writes everything still queued and stops the writer thread (receivers installed by install() stay registered but drop)
+    void stop();
+
+    bool isRunning() const { return running.load(); }
+
+    // Registers this sink as the Logger receiver for every level; the sink must outlive any logging
+    void install();
+
+    // Producer side: queues one message (called by the installed receivers)
+    void submit(LogLevel level, const char* pText);
+
+    // Waits until every message queued before the call has been written
+    bool flush(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+    Statistics getStatistics() const;
+
+    // Formats one output line ("YYYY-MM-DD HH:MM:SS.uuuuuu LEVEL [tid] message\n"); public for tests
+    static std::string formatLine(uint64_t timestampUs, LogLevel level, uint32_t threadId, const char* pText, size_t length);
+
+private:
+    struct Record {
+        uint64_t timestampUs;           // Unix epoch
+        uint32_t threadId;
+        LogLevel level;
+        bool notice;                    // 기록 스레드가 만든 알림 (드롭 보고)
+        uint16_t length;
+        char text[kMaxMessageLength];
+    };
+
+    // One ring per producer thread
+    struct Producer {
+        SpscRing<Record, kRingCapacity> ring;
+        uint32_t threadId = 0;
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> retired{false};   // 스레드 종료됨 - 비워지면 제거
+        uint64_t reportedDrops = 0;         // 기록 스레드 전용
+    };
+
+    Producer* producerForThisThread();
+    size_t collect(std::vector<Record>& batch);
+    void writeBatch(const std::vector<Record>& batch);
+    void writeText(const std::string& text);
+    void writeJournal(const Record& record);
+    void closeOutput();
+    uint64_t submittedCount() const;
+    void requestWake();
+    void run();
+
+    const uint64_t sinkId;
+
+    std::vector<std::shared_ptr<Producer>> producers;
+    mutable std::mutex producersMutex;
+
+    Target target;
+    int fd;
+    std::string journalIdentifier;
+
+    std::atomic<OverflowPolicy> overflowPolicy;
+    bool installed;
+    std::atomic<uint64_t> written;
+    std::atomic<uint64_t> truncated;
+    std::atomic<uint64_t> retiredSubmitted;   // 제거된 생산자의 누적 값
+    std::atomic<uint64_t> retiredDropped;
+
+    std::atomic<bool> running;
+    std::thread writerThread;
+    std::atomic<bool> wakeRequested;    // 이미 요청된 깨우기는 다시 알리지 않음
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable flushCondition;
+};
+
+} // namespace ggk
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Logger.h"
+
+namespace ggk {
+
+// Binary logging for high-volume tracing
+//
+// A GGK_BLOG_* call site describes its message with a format string using `{}` placeholders (`{x}` for hex, `{{` / `}}` for
+// braces) and passes the values as arguments. The format string, argument types, file and line are a constexpr descriptor placed
+// by the linker in the `ggk_blog_formats` section, so they are known before main() and never copied at runtime: a record only
+// carries the descriptor index, a timestamp, the thread id and the raw argument bytes. Nothing is formatted on the logging thread.
+//
+// Records go to a memory-mapped file of fixed size (BinaryLog::open). The file holds the format table followed by fixed-size
+// blocks used as a ring: when the last block is full the oldest block is reused, so the file keeps the most recent records and
+// never grows. `ble-logdecode` renders it as text or JSON.
+//
+// When no binary log is open, the same call sites format their message and pass it to the Logger receivers, so converting a
+// GGK_LOG_* call site to GGK_BLOG_* does not change text output.
+class BinaryLog {
+public:
+    // Call-site descriptor (one per GGK_BLOG_* call site, in the `ggk_blog_formats` section)
+    struct Format {
+        const char* pFormat;
+        const char* pTypes;             // 인자 타입 코드 (BinaryLogArg::tag)
+        const char* pFile;
+        uint32_t line;
+        LogLevel level;
+        LogModule module;
+    };
+
+    // One decoded argument
+    struct Argument {
+        char type = '\0';
+        int64_t integer = 0;            // 부호 있는 정수, bool, char
+        uint64_t unsignedInteger = 0;
+        double real = 0.0;
+        const uint8_t* pData = nullptr; // 문자열 ('s'), 바이트 배열 ('x')
+        size_t length = 0;
+    };
+
+    // File layout (host byte order): FileHeader, format table, then blockCount blocks of blockSize bytes
+    static constexpr char kMagic[8] = {'G', 'G', 'K', 'B', 'L', 'O', 'G', '\0'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kBlockSize = 4096;
+    static constexpr size_t kMinBlocks = 2;
+    static constexpr size_t kDefaultSize = 16 * 1024 * 1024;
+    static constexpr size_t kMaxBytesLength = 512;      // 문자열, 바이트 배열 인자 최대 길이 (초과분은 잘림)
+    static constexpr size_t kRecordAlignment = 8;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t blockSize;
+        uint32_t blockCount;
+        uint32_t dataOffset;            // 첫 블록 위치
+        uint32_t formatCount;
+        uint32_t formatTableOffset;
+        uint64_t createdUs;             // Unix epoch
+        uint32_t pid;
+        uint32_t reserved;
+    };
+
+    // Followed by the format, types and file strings (not NUL-terminated); format ids start at 1
+    struct FormatEntry {
+        uint32_t line;
+        uint8_t level;
+        uint8_t module;
+        uint16_t formatLength;
+        uint16_t typesLength;
+        uint16_t fileLength;
+    };
+
+    // Block: header, then records (each starting on a kRecordAlignment boundary) until a zero format id or the end of the block
+    struct BlockHeader {
+        uint64_t sequence;              // 1부터 증가 (0 = 사용 안 됨)
+    };
+
+    struct RecordHeader {
+        uint16_t formatId;              // 마지막에 기록 (0이면 미완성 레코드)
+        uint16_t payloadLength;
+        uint32_t threadId;
+        uint64_t timestampUs;           // Unix epoch
+    };
+
+    static constexpr size_t kMaxPayloadLength = kBlockSize - sizeof(BlockHeader) - sizeof(RecordHeader);
+
+    struct Statistics {
+        uint64_t records = 0;
+        uint64_t dropped = 0;           // 인자가 한 블록보다 큰 레코드
+        uint64_t blocks = 0;            // 사용한 블록 수 (재사용 포함)
+    };
+
+    // Creates (or truncates) `path` with a total size of about `sizeBytes` and starts logging to it
+    static bool open(const std::string& path, size_t sizeBytes = kDefaultSize);
+
+    // Stops logging and unmaps the file (its content stays valid for the decoder)
+    static void close();
+
+    static bool isOpen() { return active.load(std::memory_order_relaxed); }
+
+    // True if a GGK_BLOG_* message at `level` would be recorded: to the binary log if one is open, otherwise to a Logger receiver
+    static bool isEnabled(LogLevel level, LogModule module) {
+        return isOpen() ? Logger::isLevelEnabled(level, module) : Logger::isEnabled(level, module);
+    }
+
+    static Statistics getStatistics();
+
+    // Descriptors of every GGK_BLOG_* call site linked into the program
+    static const Format* getFormats();
+    static size_t getFormatCount();
+
+    // Records one message (called by the GGK_BLOG macros; the second argument is the format literal, already in `format`)
+    template <typename... Args>
+    static void write(const Format& format, const char*, const Args&... args);
+
+    // Renders a message from its format, argument types and encoded arguments
+    static std::string formatMessage(const char* pFormat, const char* pTypes, const uint8_t* pPayload, size_t length);
+
+    // Decodes the arguments of a record; returns false if the payload does not match the types
+    static bool decodeArguments(const char* pTypes, const uint8_t* pPayload, size_t length, std::vector<Argument>& arguments);
+
+    // Renders one argument (`hex`: integers as 0x..., as the `{x}` placeholder)
+    static std::string formatArgument(const Argument& argument, bool hex = false);
+
+    // Number of `{...}` placeholders in a format string (checked against the argument count at compile time)
+    static constexpr size_t countPlaceholders(const char* pFormat) {
+        size_t count = 0;
+        for (; *pFormat != '\0'; ++pFormat) {
+            if (pFormat[0] == '{' && pFormat[1] == '{') {
+                ++pFormat;
+            } else if (pFormat[0] == '{') {
+                ++count;
+                while (pFormat[1] != '\0' && pFormat[0] != '}') {
+                    ++pFormat;
+                }
+            }
+        }
+        return count;
+    }
+
+private:
+    // Locks the writer and returns where the payload goes, or nullptr (lock released) if nothing can be recorded
+    static uint8_t* beginRecord(std::unique_lock<std::mutex>& lock, size_t payloadLength);
+
+    // Writes the record header and releases the writer
+    static void endRecord(std::unique_lock<std::mutex>& lock, const Format& format, size_t payloadLength);
+
+    static void writeText(const Format& format, const uint8_t* pPayload, size_t length);
+
+    static std::atomic<bool> active;
+    static std::mutex writeMutex;
+};
+
+// Argument encoding, selected by the decayed argument type; specialize to log other types
+template <typename T, typename Enable = void>
+struct BinaryLogArg;
+
+// Integers, bool, char and enums: raw value at its own width
+template <typename T>
+struct BinaryLogArg<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+    template <typename U, bool IsEnum = std::is_enum<U>::value>
+    struct RawType { using type = U; };
+    template <typename U>
+    struct RawType<U, true> { using type = typename std::underlying_type<U>::type; };
+    using Raw = typename RawType<T>::type;
+
+    static constexpr char tag = std::is_same<Raw, bool>::value ? '?'
+                              : std::is_same<Raw, char>::value ? 'c'
+                              : sizeof(Raw) == 1 ? (std::is_signed<Raw>::value ? 'b' : 'B')
+                              : sizeof(Raw) == 2 ? (std::is_signed<Raw>::value ? 'h' : 'H')
+                              : sizeof(Raw) == 4 ? (std::is_signed<Raw>::value ? 'i' : 'I')
+                              : (std::is_signed<Raw>::value ? 'q' : 'Q');
+
+    static constexpr size_t size(const T&) { return sizeof(Raw); }
+
+    static uint8_t* encode(uint8_t* pOut, const T& value) {
+        Raw raw = static_cast<Raw>(value);
+        memcpy(pOut, &raw, sizeof(raw));
+        return pOut + sizeof(raw);
+    }
+};
+
+template <typename T>
+struct BinaryLogArg<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static constexpr char tag = 'd';
+
+    static constexpr size_t size(const T&) { return sizeof(double); }
+
+    static uint8_t* encode(uint8_t* pOut, const T& value) {
+        double raw = static_cast<double>(value);
+        memcpy(pOut, &raw, sizeof(raw));
+        return pOut + sizeof(raw);
+    }
+};
+
+// Strings and byte arrays: 16-bit length followed by at most kMaxBytesLength bytes
+struct BinaryLogBytes {
+    static size_t size(size_t length) { return sizeof(uint16_t) + clamp(length); }
+
+    static uint8_t* encode(uint8_t* pOut, const void* pData, size_t length) {
+        uint16_t stored = static_cast<uint16_t>(clamp(length));
+        memcpy(pOut, &stored, sizeof(stored));
+        copy(pOut + sizeof(stored), pData, stored);
+        return pOut + sizeof(stored) + stored;
+    }
+
+    static size_t clamp(size_t length) { return length < BinaryLog::kMaxBytesLength ? length : BinaryLog::kMaxBytesLength; }
+
+    // Out of line on purpose: with the length bounded by clamp() GCC expands an inline memcpy into `rep movsq`, whose startup
+    // cost is larger than the rest of the record for short strings
+    static void copy(uint8_t* pOut, const void* pData, size_t length);
+};
+
+template <>
+struct BinaryLogArg<const char*> {
+    static constexpr char tag = 's';
+    static size_t size(const char* pText) { return BinaryLogBytes::size(pText != nullptr ? strlen(pText) : 0); }
+    static uint8_t* encode(uint8_t* pOut, const char* pText) {
+        return BinaryLogBytes::encode(pOut, pText, pText != nullptr ? strlen(pText) : 0);
+    }
+};
+
+template <>
+struct BinaryLogArg<char*> : BinaryLogArg<const char*> {};
+
+template <>
+struct BinaryLogArg<std::string> {
+    static constexpr char tag = 's';
+    static size_t size(const std::string& text) { return BinaryLogBytes::size(text.size()); }
+    static uint8_t* encode(uint8_t* pOut, const std::string& text) { return BinaryLogBytes::encode(pOut, text.data(), text.size()); }
+};
+
+template <>
+struct BinaryLogArg<std::vector<uint8_t>> {
+    static constexpr char tag = 'x';
+    static size_t size(const std::vector<uint8_t>& bytes) { return BinaryLogBytes::size(bytes.size()); }
+    static uint8_t* encode(uint8_t* pOut, const std::vector<uint8_t>& bytes) {
+        return BinaryLogBytes::encode(pOut, bytes.data(), bytes.size());
+    }
+};
+
+// GVariantBytes (GVariantCodec.h), e.g. the value view of a WriteValue call; declared here so every file logs it the same way
+template <typename T>
+struct GVariantSpan;
+
+template <typename T>
+struct BinaryLogArg<GVariantSpan<T>, typename std::enable_if<std::is_same<T, uint8_t>::value>::type> {
+    static constexpr char tag = 'x';
+    static size_t size(const GVariantSpan<T>& bytes) { return BinaryLogBytes::size(bytes.size); }
+    static uint8_t* encode(uint8_t* pOut, const GVariantSpan<T>& bytes) { return BinaryLogBytes::encode(pOut, bytes.data, bytes.size); }
+};
+
+// Compile-time argument type string of a call site
+template <typename... Args>
+struct BinaryLogSignature {
+    static constexpr char value[] = {BinaryLogArg<Args>::tag..., '\0'};
+    static constexpr size_t count = sizeof...(Args);
+};
+
+// Only used in decltype: the signature of a GGK_BLOG argument list (format first)
+template <typename Format, typename... Args>
+BinaryLogSignature<typename std::decay<Args>::type...> binaryLogSignatureOf(const Format&, const Args&...);
+
+template <typename... Args>
+void BinaryLog::write(const Format& format, const char*, const Args&... args) {
+    size_t length = (size_t(0) + ... + BinaryLogArg<typename std::decay<Args>::type>::size(args));
+
+    if (!isOpen()) {
+        std::vector<uint8_t> payload(length);
+        uint8_t* pOut = payload.data();
+        ((pOut = BinaryLogArg<typename std::decay<Args>::type>::encode(pOut, args)), ...);
+        (void)pOut;
+        writeText(format, payload.data(), payload.size());
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writeMutex, std::defer_lock);
+    uint8_t* pOut = beginRecord(lock, length);
+    if (pOut == nullptr) {
+        return;
+    }
+    ((pOut = BinaryLogArg<typename std::decay<Args>::type>::encode(pOut, args)), ...);
+    (void)pOut;
+    endRecord(lock, format, length);
+}
+
+} // namespace ggk
+
+// First macro argument (the format literal); the caller appends a dummy argument so `...` is never empty
+#define GGK_BLOG_FORMAT_(format, ...) format
+
+// Binary logging: GGK_BLOG(level, module, "format {}", args...); `level` and `module` must be constants
+#define GGK_BLOG(level, module, ...)                                                                                     \
+    do {                                                                                                                 \
+        if (::ggk::isLogLevelCompiled(static_cast<int>(level)) && ::ggk::BinaryLog::isEnabled(level, module)) {         \
+            using BlogSignature_ = decltype(::ggk::binaryLogSignatureOf(__VA_ARGS__));                                   \
+            static_assert(::ggk::BinaryLog::countPlaceholders(GGK_BLOG_FORMAT_(__VA_ARGS__, 0)) == BlogSignature_::count, \
+                          "GGK_BLOG: the number of {} placeholders does not match the number of arguments");             \
+            static constexpr ::ggk::BinaryLog::Format blogFormat_ __attribute__((used, section("ggk_blog_formats"))) = { \
+                GGK_BLOG_FORMAT_(__VA_ARGS__, 0), BlogSignature_::value, __FILE__, __LINE__, level, module};             \
+            ::ggk::BinaryLog::write(blogFormat_, __VA_ARGS__);                                                           \
+        }                                                                                                                \
+    } while (0)
+
+#define GGK_BLOG_TRACE(module, ...) GGK_BLOG(::ggk::LogLevel::Trace, ::ggk::LogModule::module, __VA_ARGS__)
+#define GGK_BLOG_DEBUG(module, ...) GGK_BLOG(::ggk::LogLevel::Debug, ::ggk::LogModule::module, __VA_ARGS__)
+#define GGK_BLOG_INFO(module, ...) GGK_BLOG(::ggk::LogLevel::Info, ::ggk::LogModule::module, __VA_ARGS__)
+#define GGK_BLOG_WARN(module, ...) GGK_BLOG(::ggk::LogLevel::Warn, ::ggk::LogModule::module, __VA_ARGS__)
+#define GGK_BLOG_ERROR(module, ...) GGK_BLOG(::ggk::LogLevel::Error, ::ggk::LogModule::module, __VA_ARGS__)
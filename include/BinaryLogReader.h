@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BinaryLog.h"
+
+namespace ggk {
+
+// Reads a file written by BinaryLog (used by the ble-logdecode tool)
+//
+// The format table comes from the file itself, so a log can be decoded without the binary that wrote it. Blocks are visited
+// oldest first; a block that was being written when the process stopped ends at its last complete record.
+class BinaryLogReader {
+public:
+    struct FormatInfo {
+        std::string format;
+        std::string types;
+        std::string file;
+        uint32_t line = 0;
+        LogLevel level = LogLevel::Info;
+        LogModule module = LogModule::General;
+    };
+
+    struct Entry {
+        uint64_t timestampUs = 0;
+        uint32_t threadId = 0;
+        const FormatInfo* pFormat = nullptr;
+        const uint8_t* pPayload = nullptr;
+        size_t payloadLength = 0;
+    };
+
+    // Loads and validates a log file
+    bool open(const std::string& path);
+
+    // Same as open() for a log already in memory
+    bool load(std::vector<uint8_t> data);
+
+    const std::vector<FormatInfo>& getFormats() const { return formats; }
+    uint32_t getPid() const { return pid; }
+    uint64_t getCreatedUs() const { return createdUs; }
+
+    // Calls `callback` for every record, oldest first; returns the number of records
+    size_t forEach(const std::function<void(const Entry&)>& callback) const;
+
+    // Renders one record as a log line (same layout as AsyncLogSink output, without the trailing newline)
+    static std::string toText(const Entry& entry);
+
+    // Renders one record as a single-line JSON object
+    static std::string toJson(const Entry& entry);
+
+private:
+    std::vector<uint8_t> data;
+    std::vector<FormatInfo> formats;
+    size_t dataOffset = 0;
+    size_t blockSize = 0;
+    size_t blockCount = 0;
+    uint32_t pid = 0;
+    uint64_t createdUs = 0;
+};
+
+} // namespace ggk
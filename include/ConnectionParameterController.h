@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "GattCallbacks.h"
+#include "HciAdapter.h"
+
+namespace ggk {
+
+// Chooses LE connection parameters for every connection from a small set of named profiles
+//
+// Profiles are requested with LE Connection Update (0x2013). In automatic mode the controller watches notification traffic
+// (through the GattTrafficCallback installed on GattCharacteristics, or depths reported with `reportQueueDepth()`) and moves all
+// connections to the high-throughput profile when the notification backlog builds up, and back to low-power after the link has
+// been idle for a while. Requested and measured parameters are kept per connection (see `getOutcome()`).
+class ConnectionParameterController {
+public:
+    enum class Profile : uint8_t {
+        LowLatency,
+        HighThroughput,
+        LowPower
+    };
+
+    // Connection parameters in HCI units (interval: 1.25 ms, supervision timeout: 10 ms)
+    struct ProfileParameters {
+        uint16_t minInterval;
+        uint16_t maxInterval;
+        uint16_t latency;
+        uint16_t supervisionTimeout;
+
+        static ProfileParameters forProfile(Profile profile);
+    };
+
+    // Requested vs. achieved parameters of one connection
+    struct Outcome {
+        Profile profile = Profile::LowPower;
+        ProfileParameters requested = {};
+        LinkRequestOutcome outcome = LinkRequestOutcome::NotRequested;
+        uint8_t status = 0;                         // HCI status of the request / update
+
+        // LE Connection Update Complete 결과
+        uint16_t interval = 0;
+        uint16_t latency = 0;
+        uint16_t supervisionTimeout = 0;
+        std::chrono::milliseconds settleTime{0};    // 요청부터 Connection Update Complete까지
+        uint32_t updateCount = 0;
+
+        bool withinRequest() const {
+            return interval >= requested.minInterval && interval <= requested.maxInterval && latency <= requested.latency;
+        }
+    };
+
+    static constexpr size_t kDefaultHighWatermark = 8;                  // notifications
+    static constexpr std::chrono::milliseconds kDefaultIdleTimeout{5000};
+    static constexpr std::chrono::milliseconds kEvaluationInterval{250};
+    static constexpr size_t kNotificationsPerEvent = 4;                 // 연결 이벤트당 처리 가능한 알림 수 (추정)
+
+    static const uint16_t CMD_LE_CONNECTION_UPDATE = 0x2013;
+
+    // Registers with the adapter's connection tracker and event decoder (call before the adapter is initialized); the controller
+    // must outlive the adapter's event thread
+    explicit ConnectionParameterController(HciAdapter& adapter);
+    ~ConnectionParameterController();
+
+    ConnectionParameterController(const ConnectionParameterController&) = delete;
+    ConnectionParameterController& operator=(const ConnectionParameterController&) = delete;
+
+    // Starts / stops the evaluation thread used by automatic mode
+    void start();
+    void stop();
+
+    // Selects a profile for all connections and switches to manual mode
+    void setProfile(Profile profile);
+
+    // Automatic profile selection based on notification backlog
+    void setAutomatic(bool enabled);
+    void setThresholds(size_t highWatermark, std::chrono::milliseconds idleTimeout);
+
+    // Returns a callback for GattCharacteristic::setTrafficCallback()
+    GattTrafficCallback trafficCallback();
+
+    // Reports an externally measured backlog (e.g. outstanding ACL packets)
+    void reportQueueDepth(size_t depth);
+
+    // Runs one evaluation step (called by the evaluation thread; public for tests)
+    void evaluate();
+
+    Profile getActiveProfile() const { return activeProfile.load(); }
+    bool isAutomatic() const { return automatic.load(); }
+    size_t getEstimatedQueueDepth() const { return estimatedDepth.load(); }
+
+    // Returns false if no profile was ever requested for the connection
+    bool getOutcome(uint16_t handle, Outcome& outcome) const;
+
+    static std::string profileName(Profile profile);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        Outcome outcome;
+        Clock::time_point requestedAt;
+        bool unsupported = false;     // 원격 기기가 파라미터 변경을 지원하지 않음 - 재시도하지 않음
+    };
+
+    void applyProfile(Profile profile);
+    void requestUpdate(const LinkState& state, Profile profile);
+    void handleLinkEvent(ConnectionTracker::LinkEvent event, const LinkState& state);
+    void run();
+
+    HciAdapter& adapter;
+
+    std::atomic<Profile> activeProfile;
+    std::atomic<bool> automatic;
+    std::atomic<size_t> queuedNotifications;
+    std::atomic<size_t> reportedDepth;
+    std::atomic<size_t> estimatedDepth;
+    std::atomic<size_t> highWatermark;
+    std::atomic<int64_t> idleTimeoutMS;
+
+    Clock::time_point lastEvaluation;
+    Clock::time_point lastBusy;
+    size_t lastLinkCount;
+    std::atomic<bool> profileSelected;     // 한 번이라도 프로파일이 선택(수동/자동)되었는지
+
+    std::map<uint16_t, Request> requests;
+    mutable std::mutex requestsMutex;
+
+    std::atomic<bool> isRunning;
+    std::thread evaluationThread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+};
+
+} // namespace ggk
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "HciEventDecoder.h"
+
+namespace ggk {
+
+// Outcome of a link optimization request made by the host (data length / PHY)
+enum class LinkRequestOutcome : uint8_t {
+    NotRequested,
+    Pending,     // 명령은 수락되었고 컨트롤러 이벤트를 기다리는 중
+    Accepted,
+    Rejected     // 상태 코드는 LinkState의 *Status 필드에 기록됨
+};
+
+// Link parameters of one LE connection, as last reported by the controller (or the GATT layer for the MTU)
+//
+// Plain data so it can be copied in and out of the tracker's seqlock slots.
+struct LinkState {
+    static constexpr uint16_t kInvalidHandle = 0xFFFF;
+    static constexpr uint16_t kDefaultMtu = 23;
+    static constexpr uint16_t kDefaultDataLength = 27;    // LL payload octets before Data Length Extension
+    static constexpr uint16_t kDefaultDataTime = 328;     // us
+    static constexpr uint8_t kPhy1M = 0x01;
+    static constexpr uint8_t kPhy2M = 0x02;
+    static constexpr uint8_t kPhyCoded = 0x03;
+
+    uint16_t handle = kInvalidHandle;
+    uint16_t interval = 0;            // 1.25 ms 단위
+    uint16_t latency = 0;             // 연결 이벤트 수
+    uint16_t supervisionTimeout = 0;  // 10 ms 단위
+    uint16_t mtu = kDefaultMtu;
+    uint16_t maxTxOctets = kDefaultDataLength;
+    uint16_t maxTxTime = kDefaultDataTime;
+    uint16_t maxRxOctets = kDefaultDataLength;
+    uint16_t maxRxTime = kDefaultDataTime;
+    uint8_t txPhy = kPhy1M;
+    uint8_t rxPhy = kPhy1M;
+    uint8_t role = 0;                 // 0 = central, 1 = peripheral (local role)
+    uint8_t addressType = 0;
+    uint8_t address[6] = {};          // 리틀 엔디안 (HCI 순서)
+
+    // HciAdapter 링크 정책 요청 결과
+    LinkRequestOutcome dataLengthOutcome = LinkRequestOutcome::NotRequested;
+    uint8_t dataLengthStatus = 0;
+    LinkRequestOutcome phyOutcome = LinkRequestOutcome::NotRequested;
+    uint8_t phyStatus = 0;
+
+    bool isValid() const { return handle != kInvalidHandle; }
+
+    // Connection interval in microseconds
+    uint32_t intervalMicros() const { return interval * 1250u; }
+
+    // Largest ATT payload that fits in one notification (MTU minus the 3-byte ATT header)
+    uint16_t maxNotificationPayload() const { return mtu > 3 ? mtu - 3 : 0; }
+
+    std::string addressString() const { return hciAddressString(address); }
+};
+
+static_assert(std::is_trivially_copyable<LinkState>::value, "LinkState is copied through seqlock slots");
+
+// Table of active LE connections keyed by connection handle and device address
+//
+// The tracker is fed from HCI events (LE Connection Complete, Connection Update, Data Length Change, PHY Update and
+// Disconnection Complete) once attached to an HciEventDecoder; GattCharacteristic reports the MTU that BlueZ passes with each
+// ReadValue / WriteValue through `updateMtu()` (see GattApplication::setConnectionTracker()).
+//
+// Each connection lives in a fixed slot guarded by a seqlock, so readers never block and never allocate (besides
+// `snapshot()`): they copy the slot and retry if a writer touched it meanwhile. Writers are serialized by a mutex; updates are
+// rare compared to reads from notification producers.
+class ConnectionTracker {
+public:
+    static constexpr size_t kMaxConnections = 16;
+
+    enum class LinkEvent {
+        Connected,
+        Disconnected,
+        ParametersUpdated,
+        DataLengthChanged,
+        PhyUpdated,
+        MtuChanged
+    };
+
+    using Listener = std::function<void(LinkEvent event, const LinkState& state)>;
+
+    ConnectionTracker();
+
+    ConnectionTracker(const ConnectionTracker&) = delete;
+    ConnectionTracker& operator=(const ConnectionTracker&) = delete;
+
+    // Registers the HCI event handlers that keep the table up to date
+    void attach(HciEventDecoder& decoder);
+
+    // Listeners are called on the writer's thread after the table was updated (register before events flow)
+    void addListener(Listener listener);
+
+    // Lock-free lookups; return false if no such connection exists
+    bool getByHandle(uint16_t handle, LinkState& state) const;
+    bool getByAddress(const uint8_t* pAddress, LinkState& state) const;
+    bool getByAddress(const std::string& address, LinkState& state) const;
+
+    // Copies of all active connections
+    std::vector<LinkState> snapshot() const;
+
+    size_t connectionCount() const { return activeCount.load(std::memory_order_acquire); }
+    bool isConnected() const { return connectionCount() > 0; }
+
+    // Updates the ATT MTU of a connection (reported by the GATT layer)
+    // The address variants only take the write lock and notify MtuChanged when the MTU differs from the stored one.
+    bool updateMtu(uint16_t handle, uint16_t mtu);
+    bool updateMtu(const uint8_t* pAddress, uint16_t mtu);
+    bool updateMtu(const std::string& address, uint16_t mtu);
+
+    // Table updates - called from the HCI event handlers, public for the GATT layer and tests
+    void connectionComplete(const LinkState& state);
+    void disconnectionComplete(uint16_t handle);
+
+    // Applies `update` to the connection with the given handle and notifies listeners with `event`
+    bool modify(uint16_t handle, LinkEvent event, const std::function<void(LinkState&)>& update);
+
+    // Applies `update` without notifying listeners, for host-side bookkeeping (e.g. request outcomes) that is not a link change
+    bool update(uint16_t handle, const std::function<void(LinkState&)>& update);
+
+    // Forgets every connection (e.g. after the controller went down)
+    void clear();
+
+    // Parses "AA:BB:CC:DD:EE:FF" into little endian HCI order
+    static bool parseAddress(const std::string& address, uint8_t* pAddress);
+
+    // Parses a BlueZ device object path ("/org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF") into little endian HCI order
+    static bool parseDevicePath(const char* pPath, uint8_t* pAddress);
+
+private:
+    static constexpr size_t kWords = (sizeof(LinkState) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};
+        std::array<std::atomic<uint64_t>, kWords> words;
+    };
+
+    void readSlot(const Slot& slot, LinkState& state) const;
+    void writeSlot(Slot& slot, const LinkState& state);
+
+    // Returns the slot holding `handle` (caller holds writeMutex)
+    Slot* findSlotLocked(uint16_t handle);
+
+    void notify(LinkEvent event, const LinkState& state) const;
+
+    // Applies `update` under the write lock and returns the new state
+    bool apply(uint16_t handle, const std::function<void(LinkState&)>& update, LinkState& state);
+
+    std::array<Slot, kMaxConnections> slots;
+    std::array<uint16_t, kMaxConnections> slotHandles;   // writer-side copy of each slot's handle
+    std::atomic<size_t> activeCount;
+    std::mutex writeMutex;
+    std::vector<Listener> listeners;
+};
+
+} // namespace ggk
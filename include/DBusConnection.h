@@ -3,6 +3,7 @@
 #include <gio/gio.h>
 #include <string>
 #include <map>
+#include <vector>
 #include <functional>
 #include <mutex>
 #include "Logger.h"
@@ -17,11 +18,18 @@ public:
     // 콜백 타입 정의
     using MethodHandler = std::function<void(const DBusMethodCall&)>;
     using SignalHandler = std::function<void(const std::string&, GVariantPtr)>;
+    using ReplyHandler = std::function<void(GVariantPtr result)>;  // 실패 시 null (오류는 로그에 기록)
     
     // 생성자 및 소멸자
     DBusConnection(GBusType busType = G_BUS_TYPE_SYSTEM);
+    // 이미 열린 연결 사용 (피어 간 연결, 개인 버스 등); 참조를 넘겨받음
+    explicit DBusConnection(GDBusConnectionPtr connection);
     ~DBusConnection();
     
+    // Two ends of a peer-to-peer connection over a socketpair, without a bus daemon (tests, benchmarks, ble_loadgen).
+    // Iterates the global default main context while the server end authenticates.
+    static bool openPeerPair(GDBusConnectionPtr& server, GDBusConnectionPtr& client);
+    
     // 연결 관리
     bool connect();
     bool disconnect();
@@ -38,6 +46,18 @@ public:
         int timeoutMs = -1
     );
     
+    // Sends a method call without blocking; `handler` runs on the caller's thread-default main context when the reply (or an
+    // error or timeout) arrives. Returns false, without calling `handler`, if the call could not be sent.
+    bool callMethodAsync(
+        const std::string& destination,
+        const DBusObjectPath& path,
+        const std::string& interface,
+        const std::string& method,
+        GVariantPtr parameters,
+        ReplyHandler handler,
+        int timeoutMs = -1
+    );
+    
     bool emitSignal(
         const DBusObjectPath& path,
         const std::string& interface,
@@ -82,8 +102,8 @@ private:
     GBusType busType;
     GDBusConnectionPtr connection;
     
-    // 등록된 객체 추적
-    std::map<std::string, guint> registeredObjects;
+    // 등록된 객체 추적 (경로별로 인터페이스마다 등록 ID 하나)
+    std::map<std::string, std::vector<guint>> registeredObjects;
     std::map<guint, SignalHandler> signalHandlers;
     
     // 스레드 안전성
@@ -123,6 +143,9 @@ private:
         gpointer userData
     );
     
+    // 비동기 호출 응답
+    static void handleReply(GObject* source, GAsyncResult* result, gpointer userData);
+    
     // 시그널 핸들러
     static void handleSignal(
         GDBusConnection* connection,
@@ -21,7 +21,9 @@ public:
     
     // 인터페이스 및 메서드 등록
     bool addInterface(const std::string& interface, const std::vector<DBusProperty>& properties = {});
-    bool addMethod(const std::string& interface, const std::string& method, DBusConnection::MethodHandler handler);
+    // `arguments` are declared in the introspection data; GDBus rejects calls and replies that do not match them
+    bool addMethod(const std::string& interface, const std::string& method, DBusConnection::MethodHandler handler,
+                   const std::vector<DBusArgument>& arguments = {});
     
     // 속성 관련
     bool setProperty(const std::string& interface, const std::string& name, GVariantPtr value);
@@ -53,6 +55,7 @@ private:
     // 인터페이스 관리
     std::map<std::string, std::vector<DBusProperty>> interfaces;
     std::map<std::string, std::map<std::string, DBusConnection::MethodHandler>> methodHandlers;
+    std::map<std::string, std::map<std::string, std::vector<DBusArgument>>> methodArguments;
 };
 
 } // namespace ggk
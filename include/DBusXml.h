@@ -1,6 +1,7 @@
 // DBusXml.h
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 #include "DBusTypes.h"
@@ -18,6 +19,16 @@ public:
         int indentLevel = 0
     );
 
+    // 메서드 이름 -> 인자 목록 (방향은 DBusArgument::direction, "in" 또는 "out")
+    // GDBus는 호출 인자와 응답을 이 선언과 비교하므로 인자가 있는 메서드는 반드시 선언해야 함
+    static std::string createInterface(
+        const std::string& name,
+        const std::vector<DBusProperty>& properties,
+        const std::map<std::string, std::vector<DBusArgument>>& methods,
+        const std::vector<DBusSignal>& signals,
+        int indentLevel = 0
+    );
+
     // 프로퍼티 XML 생성
     static std::string createProperty(
         const DBusProperty& property,
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "HciAdapter.h"
+
+namespace ggk {
+
+// Parameters of one extended advertising set (LE Set Extended Advertising Parameters)
+struct AdvertisingSetParameters {
+    // Advertising_Event_Properties 비트
+    static constexpr uint16_t kPropConnectable = 0x0001;
+    static constexpr uint16_t kPropScannable = 0x0002;
+    static constexpr uint16_t kPropDirected = 0x0004;
+    static constexpr uint16_t kPropHighDutyCycle = 0x0008;
+    static constexpr uint16_t kPropLegacy = 0x0010;
+    static constexpr uint16_t kPropAnonymous = 0x0020;
+    static constexpr uint16_t kPropIncludeTxPower = 0x0040;
+
+    // PHY 값
+    static constexpr uint8_t kPhy1M = 0x01;
+    static constexpr uint8_t kPhy2M = 0x02;
+    static constexpr uint8_t kPhyCoded = 0x03;
+
+    static constexpr int8_t kTxPowerNoPreference = 0x7F;
+
+    uint16_t eventProperties = 0x0000;  // 비연결/비스캔 (비콘)
+    uint32_t minInterval = 0x0000A0;    // 0.625 ms 단위 (100 ms), 24비트
+    uint32_t maxInterval = 0x0000A0;
+    uint8_t channelMap = 0x07;          // 37, 38, 39
+    uint8_t ownAddressType = 0x00;      // 0 = public, 1 = random (randomAddress 사용)
+    uint8_t filterPolicy = 0x00;
+    int8_t txPower = kTxPowerNoPreference;
+    uint8_t primaryPhy = kPhy1M;        // 1M 또는 Coded
+    uint8_t secondaryMaxSkip = 0;
+    uint8_t secondaryPhy = kPhy1M;      // 1M, 2M 또는 Coded
+    uint8_t sid = 0;                    // Advertising SID (0x00-0x0F)
+    bool scanRequestNotifications = false;
+
+    bool hasRandomAddress = false;
+    uint8_t randomAddress[6] = {};      // 리틀 엔디안
+
+    // Sets both interval bounds from milliseconds
+    void setIntervalMs(uint32_t minMs, uint32_t maxMs) {
+        minInterval = minMs * 8 / 5;
+        maxInterval = maxMs * 8 / 5;
+    }
+
+    bool isLegacy() const { return (eventProperties & kPropLegacy) != 0; }
+};
+
+// LE extended advertising with several concurrent advertising sets
+//
+// Each set has its own parameters (interval, PHYs, SID, address) and payload, and the controller schedules all enabled sets by
+// itself. Advertising and scan response data of up to 1650 bytes are split into 251-byte LE Set Extended Advertising Data
+// fragments automatically and sent as one pipelined batch.
+//
+// All methods block until the controller answered and must not be called from the HCI event thread.
+class ExtendedAdvertiser {
+public:
+    static constexpr uint16_t CMD_LE_SET_ADV_SET_RANDOM_ADDRESS = 0x2035;
+    static constexpr uint16_t CMD_LE_SET_EXT_ADV_PARAMETERS = 0x2036;
+    static constexpr uint16_t CMD_LE_SET_EXT_ADV_DATA = 0x2037;
+    static constexpr uint16_t CMD_LE_SET_EXT_SCAN_RESPONSE_DATA = 0x2038;
+    static constexpr uint16_t CMD_LE_SET_EXT_ADV_ENABLE = 0x2039;
+    static constexpr uint16_t CMD_LE_READ_MAX_ADV_DATA_LENGTH = 0x203A;
+    static constexpr uint16_t CMD_LE_READ_NUM_ADV_SETS = 0x203B;
+    static constexpr uint16_t CMD_LE_REMOVE_ADV_SET = 0x203C;
+    static constexpr uint16_t CMD_LE_CLEAR_ADV_SETS = 0x203D;
+
+    // Operation values of LE Set Extended Advertising/Scan Response Data
+    static constexpr uint8_t kOperationIntermediate = 0x00;
+    static constexpr uint8_t kOperationFirst = 0x01;
+    static constexpr uint8_t kOperationLast = 0x02;
+    static constexpr uint8_t kOperationComplete = 0x03;
+    static constexpr uint8_t kOperationUnchanged = 0x04;
+
+    static constexpr size_t kMaxDataLength = 1650;
+    static constexpr size_t kMaxFragmentLength = 251;
+    static constexpr size_t kMaxLegacyDataLength = 31;
+    static constexpr uint8_t kMaxHandle = 0xEF;
+
+    explicit ExtendedAdvertiser(HciAdapter& adapter);
+    ~ExtendedAdvertiser();
+
+    ExtendedAdvertiser(const ExtendedAdvertiser&) = delete;
+    ExtendedAdvertiser& operator=(const ExtendedAdvertiser&) = delete;
+
+    // Reads the controller's limits (number of sets, maximum data length)
+    // Returns false if the controller does not support extended advertising
+    bool initialize();
+
+    // Creates an advertising set and returns its handle, or -1 on failure
+    int createSet(const AdvertisingSetParameters& parameters);
+
+    // Changes the parameters of a (disabled) set
+    bool setParameters(uint8_t handle, const AdvertisingSetParameters& parameters);
+
+    // Replaces the advertising / scan response data of a set, fragmenting as needed
+    // Sets that are advertising are paused while multi-fragment data is written.
+    bool setData(uint8_t handle, const std::vector<uint8_t>& data);
+    bool setScanResponseData(uint8_t handle, const std::vector<uint8_t>& data);
+
+    // Starts / stops sets; several sets can be started with one command
+    // `durationMs` (10 ms resolution) and `maxEvents` of 0 advertise until disabled
+    bool enable(uint8_t handle, uint32_t durationMs = 0, uint8_t maxEvents = 0);
+    bool enable(const std::vector<uint8_t>& handles);
+    bool disable(uint8_t handle);
+    bool disableAll();
+
+    bool removeSet(uint8_t handle);
+    bool clear();
+
+    bool isEnabled(uint8_t handle) const;
+    std::vector<uint8_t> getSets() const;
+
+    // TX power selected by the controller for the set (0x7F if unknown)
+    int8_t getSelectedTxPower(uint8_t handle) const;
+
+    size_t getMaxDataLength() const { return maxDataLength; }
+    size_t getSupportedSets() const { return supportedSets; }
+
+    HciAdapter& getAdapter() { return adapter; }
+
+    // Builds the LE Set Extended Advertising/Scan Response Data commands for `data`
+    //
+    // Empty data yields a single complete operation with no data (clears the payload).
+    static std::vector<HciCommand> fragmentData(uint16_t opcode, uint8_t handle, const uint8_t* pData, size_t size);
+
+    // Encodes LE Set Extended Advertising Parameters
+    static std::vector<uint8_t> encodeParameters(uint8_t handle, const AdvertisingSetParameters& parameters);
+
+private:
+    struct AdvertisingSet {
+        AdvertisingSetParameters parameters;
+        bool enabled = false;
+        int8_t selectedTxPower = AdvertisingSetParameters::kTxPowerNoPreference;
+    };
+
+    // Caller holds setsMutex
+    bool setParametersLocked(uint8_t handle, const AdvertisingSetParameters& parameters);
+
+    bool writeData(uint16_t opcode, uint8_t handle, const std::vector<uint8_t>& data);
+    bool sendEnable(bool enable, const std::vector<uint8_t>& handles, uint32_t durationMs, uint8_t maxEvents);
+
+    HciAdapter& adapter;
+    std::map<uint8_t, AdvertisingSet> sets;
+    mutable std::mutex setsMutex;
+    size_t maxDataLength;
+    size_t supportedSets;
+};
+
+} // namespace ggk
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "Logger.h"
+
+namespace ggk {
+
+// Always-on flight recorder
+//
+// A fixed ring of the most recent events (Logger messages at or above a level, GATT operations, D-Bus method calls, HCI commands
+// and events, connection and advertising state changes) kept in memory for post-mortem debugging. `record()` claims a slot with
+// one atomic increment and fills it in place, so it is cheap enough to leave on in production and never allocates or locks.
+//
+// The ring is written out on SIGUSR1, on a fatal signal (SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT) and on demand through the
+// `kDBusInterface.Dump` method exposed by GattApplication. Dumping only uses async-signal-safe calls, so it works from the signal
+// handlers; each slot is a seqlock, and a slot that is being rewritten while the dump reads it is skipped.
+class FlightRecorder {
+public:
+    enum class Category : uint8_t {
+        Log = 0,            // code: LogLevel
+        Gatt,               // code: GattOperation, value: 길이
+        DBus,               // text: "interface.method path sender"
+        HciCommand,         // code: opcode, value: 파라미터 길이
+        HciEvent,           // code: 이벤트 코드 (LE Meta는 0x3E00 | subevent), value: 길이 또는 (opcode << 8) | status
+        State,              // code: StateEvent
+        HciEventCount,      // code: HciEvent과 같음, value: 개별 기록 대신 센 이벤트 수
+        Count
+    };
+
+    enum class GattOperation : uint16_t {
+        Read = 1,
+        Write,
+        StartNotify,
+        StopNotify,
+        Notify
+    };
+
+    enum class StateEvent : uint16_t {
+        Connected = 1,      // value: 연결 핸들
+        Disconnected,       // value: 연결 핸들
+        AdvertisingStarted,
+        AdvertisingStopped,
+        Signal              // value: 시그널 번호
+    };
+
+    // One event as returned by snapshot()
+    struct Record {
+        uint64_t sequence = 0;
+        uint64_t timestampUs = 0;       // Unix epoch
+        uint32_t threadId = 0;
+        Category category = Category::Log;
+        uint16_t code = 0;
+        uint32_t value = 0;
+        std::string text;
+    };
+
+    static constexpr size_t kCapacity = 4096;           // 2의 거듭제곱
+    static constexpr size_t kTextLength = 100;          // 초과분은 잘림
+    static constexpr size_t kMaxPathLength = 256;
+    static constexpr const char* kDefaultDumpPath = "/tmp/ble-flight-recorder.txt";
+    static constexpr const char* kDBusInterface = "com.example.gatt.FlightRecorder1";
+
+    // Records one event; `pText` may be nullptr
+    static void record(Category category, uint16_t code, uint32_t value, const char* pText = nullptr);
+    static void record(Category category, uint16_t code, uint32_t value, const std::string& text);
+
+    // Records one event whose text is the concatenation of `parts` (nullptr parts are skipped), without building a string
+    static void record(Category category, uint16_t code, uint32_t value, std::initializer_list<const char*> parts);
+
+    // Taps the Logger at `logLevel` and above and installs the SIGUSR1 and fatal signal handlers; dumps go to `dumpPath`
+    static bool install(const std::string& dumpPath = kDefaultDumpPath, LogLevel logLevel = LogLevel::Info);
+
+    // Removes the Logger tap and restores the previous signal handlers (recording continues)
+    static void uninstall();
+
+    // Writes the ring, oldest first, to the configured path or to `path`; both are async-signal-safe
+    static bool dump();
+    static bool dump(const char* pPath);
+
+    // Writes the ring to an open descriptor; returns the number of events written
+    static size_t dumpToFd(int fd);
+
+    // Copies the events currently in the ring, oldest first
+    static std::vector<Record> snapshot();
+
+    // Total events recorded since start (including those already overwritten)
+    static uint64_t getRecordedCount();
+
+    static const char* getDumpPath();
+    static const char* categoryName(Category category);
+
+    // Renders one event as a dump line (without the trailing newline)
+    static std::string toText(const Record& record);
+
+private:
+    FlightRecorder() = delete;
+};
+
+} // namespace ggk
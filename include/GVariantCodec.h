@@ -0,0 +1,365 @@
+#pragma once
+
+#include <glib.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DBusObjectPath.h"
+#include "DBusTypes.h"
+
+namespace ggk {
+
+// Compile-time GVariant marshalling
+//
+// GVariantTraits<T> gives the D-Bus signature of T as a constexpr string and converts values in both directions:
+//
+//   bool b, uint8_t y, int16_t n, uint16_t q, int32_t i, uint32_t u, int64_t x, uint64_t t, double d, std::string s,
+//   DBusObjectPath o, GVariantPtr v, std::vector<T> aT, GVariantSpan<T> aT, std::map / std::unordered_map<K, V> a{KV},
+//   std::tuple<T...> (T...), and structs that list their members with gvariantFields():
+//
+//     struct Peer {
+//         std::string address;
+//         uint16_t mtu;
+//         auto gvariantFields() { return std::tie(address, mtu); }
+//         auto gvariantFields() const { return std::tie(address, mtu); }
+//     };
+//     gvariantSignature<std::vector<Peer>>()      // "a(sq)"
+//
+// Arrays of fixed-width numbers are converted as one block instead of element by element: one copy into a GBytes when encoding
+// (cheaper than g_variant_new_fixed_array, which also allocates the array type), g_variant_get_fixed_array when decoding.
+// GVariantSpan reads such an array without copying: the view points into the GVariant, which must stay alive while the view is
+// used.
+//
+// toGVariant() returns a floating reference, like the Utils::gvariantFrom* helpers.
+
+// Null-terminated signature of length N, built at compile time
+template <size_t N>
+struct GVariantSignature {
+    char text[N + 1] = {};
+
+    constexpr const char* c_str() const { return text; }
+    static constexpr size_t length() { return N; }
+};
+
+template <size_t N>
+constexpr GVariantSignature<N - 1> makeGVariantSignature(const char (&text)[N]) {
+    GVariantSignature<N - 1> signature;
+    for (size_t i = 0; i < N - 1; ++i) {
+        signature.text[i] = text[i];
+    }
+    return signature;
+}
+
+template <size_t A, size_t B>
+constexpr GVariantSignature<A + B> operator+(const GVariantSignature<A>& lhs, const GVariantSignature<B>& rhs) {
+    GVariantSignature<A + B> signature;
+    for (size_t i = 0; i < A; ++i) {
+        signature.text[i] = lhs.text[i];
+    }
+    for (size_t i = 0; i < B; ++i) {
+        signature.text[A + i] = rhs.text[i];
+    }
+    return signature;
+}
+
+// Read-only view of an array of fixed-width values (no ownership)
+template <typename T>
+struct GVariantSpan {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    GVariantSpan() = default;
+    GVariantSpan(const T* pData, size_t count) : data(pData), size(count) {}
+    GVariantSpan(const std::vector<T>& values) : data(values.data()), size(values.size()) {}
+
+    bool empty() const { return size == 0; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](size_t index) const { return data[index]; }
+};
+
+using GVariantBytes = GVariantSpan<uint8_t>;
+
+// Specialized below for every supported type; an unsupported type fails to compile
+template <typename T, typename Enable = void>
+struct GVariantTraits;
+
+template <typename T>
+constexpr const char* gvariantSignature() {
+    return GVariantTraits<T>::signature.c_str();
+}
+
+// Returns a floating reference
+template <typename T>
+GVariant* toGVariant(const T& value) {
+    return GVariantTraits<T>::to(value);
+}
+
+// Returns false (leaving `value` unspecified) if `pVariant` is null or its type does not match T
+template <typename T>
+bool fromGVariant(GVariant* pVariant, T& value) {
+    if (pVariant == nullptr || !g_variant_is_of_type(pVariant, G_VARIANT_TYPE(gvariantSignature<T>()))) {
+        return false;
+    }
+    GVariantTraits<T>::from(pVariant, value);
+    return true;
+}
+
+namespace detail {
+
+// GVariantPtr는 기본 생성이 불가능하므로 빈 값 생성을 분리
+template <typename T>
+T emptyGVariantValue() {
+    return T();
+}
+
+template <>
+inline GVariantPtr emptyGVariantValue<GVariantPtr>() {
+    return makeNullGVariantPtr();
+}
+
+template <typename T>
+void readChild(GVariant* pContainer, size_t index, T& value) {
+    GVariant* pChild = g_variant_get_child_value(pContainer, index);
+    GVariantTraits<T>::from(pChild, value);
+    g_variant_unref(pChild);
+}
+
+// Copies `count` fixed-width values into a new array GVariant in one block
+template <typename T>
+GVariant* newFixedArray(const T* pValues, size_t count) {
+    static constexpr auto kSignature = makeGVariantSignature("a") + GVariantTraits<T>::signature;
+    GBytes* pBytes = g_bytes_new(pValues, count * sizeof(T));
+    GVariant* pVariant = g_variant_new_from_bytes(G_VARIANT_TYPE(kSignature.c_str()), pBytes, TRUE);
+    g_bytes_unref(pBytes);
+    return pVariant;
+}
+
+template <typename Tuple, size_t... I>
+GVariant* newTuple(const Tuple& fields, std::index_sequence<I...>) {
+    GVariant* children[] = {GVariantTraits<std::decay_t<std::tuple_element_t<I, Tuple>>>::to(std::get<I>(fields))...};
+    return g_variant_new_tuple(children, sizeof...(I));
+}
+
+template <typename Tuple, size_t... I>
+void readTuple(GVariant* pVariant, Tuple&& fields, std::index_sequence<I...>) {
+    (readChild(pVariant, I, std::get<I>(fields)), ...);
+}
+
+} // namespace detail
+
+//
+// Scalars
+//
+
+#define GGK_GVARIANT_SCALAR(Type, Code, FixedArray, New, Get)                                                                  \
+    template <>                                                                                                                \
+    struct GVariantTraits<Type> {                                                                                              \
+        static constexpr auto signature = makeGVariantSignature(Code);                                                         \
+        static constexpr bool kFixedArray = FixedArray;                                                                        \
+        static GVariant* to(Type value) { return New(value); }                                                                 \
+        static void from(GVariant* pVariant, Type& value) { value = static_cast<Type>(Get(pVariant)); }                        \
+    };
+
+GGK_GVARIANT_SCALAR(bool, "b", false, g_variant_new_boolean, g_variant_get_boolean)
+GGK_GVARIANT_SCALAR(uint8_t, "y", true, g_variant_new_byte, g_variant_get_byte)
+GGK_GVARIANT_SCALAR(int16_t, "n", true, g_variant_new_int16, g_variant_get_int16)
+GGK_GVARIANT_SCALAR(uint16_t, "q", true, g_variant_new_uint16, g_variant_get_uint16)
+GGK_GVARIANT_SCALAR(int32_t, "i", true, g_variant_new_int32, g_variant_get_int32)
+GGK_GVARIANT_SCALAR(uint32_t, "u", true, g_variant_new_uint32, g_variant_get_uint32)
+GGK_GVARIANT_SCALAR(int64_t, "x", true, g_variant_new_int64, g_variant_get_int64)
+GGK_GVARIANT_SCALAR(uint64_t, "t", true, g_variant_new_uint64, g_variant_get_uint64)
+GGK_GVARIANT_SCALAR(double, "d", true, g_variant_new_double, g_variant_get_double)
+
+#undef GGK_GVARIANT_SCALAR
+
+template <>
+struct GVariantTraits<std::string> {
+    static constexpr auto signature = makeGVariantSignature("s");
+    static constexpr bool kFixedArray = false;
+    static GVariant* to(const std::string& value) { return g_variant_new_string(value.c_str()); }
+    static void from(GVariant* pVariant, std::string& value) {
+        gsize length = 0;
+        const gchar* pText = g_variant_get_string(pVariant, &length);
+        value.assign(pText, length);
+    }
+};
+
+template <>
+struct GVariantTraits<DBusObjectPath> {
+    static constexpr auto signature = makeGVariantSignature("o");
+    static constexpr bool kFixedArray = false;
+    static GVariant* to(const DBusObjectPath& value) { return g_variant_new_object_path(value.c_str()); }
+    static void from(GVariant* pVariant, DBusObjectPath& value) {
+        gsize length = 0;
+        const gchar* pText = g_variant_get_string(pVariant, &length);
+        value = DBusObjectPath(std::string(pText, length));
+    }
+};
+
+// 임의 타입 값 ("v"); 변환 시 내부 값에 참조를 추가
+template <>
+struct GVariantTraits<GVariantPtr> {
+    static constexpr auto signature = makeGVariantSignature("v");
+    static constexpr bool kFixedArray = false;
+    static GVariant* to(const GVariantPtr& value) { return g_variant_new_variant(value.get()); }
+    static void from(GVariant* pVariant, GVariantPtr& value) { value = makeGVariantPtr(g_variant_get_variant(pVariant)); }
+};
+
+//
+// Arrays
+//
+
+template <typename T>
+struct GVariantTraits<GVariantSpan<T>> {
+    static_assert(GVariantTraits<T>::kFixedArray, "GVariantSpan needs a fixed-width element type");
+
+    static constexpr auto signature = makeGVariantSignature("a") + GVariantTraits<T>::signature;
+    static constexpr bool kFixedArray = false;
+
+    static GVariant* to(const GVariantSpan<T>& values) {
+        return detail::newFixedArray(values.data, values.size);
+    }
+
+    // 복사 없음: pVariant가 살아 있는 동안만 유효
+    static void from(GVariant* pVariant, GVariantSpan<T>& values) {
+        gsize count = 0;
+        values.data = static_cast<const T*>(g_variant_get_fixed_array(pVariant, &count, sizeof(T)));
+        values.size = count;
+    }
+};
+
+template <typename T, typename Allocator>
+struct GVariantTraits<std::vector<T, Allocator>> {
+    static constexpr auto signature = makeGVariantSignature("a") + GVariantTraits<T>::signature;
+    static constexpr bool kFixedArray = false;
+
+    static GVariant* to(const std::vector<T, Allocator>& values) {
+        if constexpr (GVariantTraits<T>::kFixedArray) {
+            return detail::newFixedArray(values.data(), values.size());
+        } else {
+            GVariantBuilder builder;
+            g_variant_builder_init(&builder, G_VARIANT_TYPE(signature.c_str()));
+            for (const auto& value : values) {
+                g_variant_builder_add_value(&builder, GVariantTraits<T>::to(value));
+            }
+            return g_variant_builder_end(&builder);
+        }
+    }
+
+    static void from(GVariant* pVariant, std::vector<T, Allocator>& values) {
+        if constexpr (GVariantTraits<T>::kFixedArray) {
+            gsize count = 0;
+            const T* pData = static_cast<const T*>(g_variant_get_fixed_array(pVariant, &count, sizeof(T)));
+            values.assign(pData, pData + count);
+        } else {
+            size_t count = g_variant_n_children(pVariant);
+            values.clear();
+            values.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                T value = detail::emptyGVariantValue<T>();
+                detail::readChild(pVariant, i, value);
+                values.push_back(std::move(value));
+            }
+        }
+    }
+};
+
+// Dictionaries ("a{KV}"); D-Bus requires a basic key type
+template <typename Map>
+struct GVariantMapTraits {
+    using Key = typename Map::key_type;
+    using Value = typename Map::mapped_type;
+
+    static_assert(GVariantTraits<Key>::signature.length() == 1 && GVariantTraits<Key>::signature.text[0] != 'v',
+                  "D-Bus dictionary keys must be a basic type");
+
+    static constexpr auto signature = makeGVariantSignature("a{") + GVariantTraits<Key>::signature +
+                                      GVariantTraits<Value>::signature + makeGVariantSignature("}");
+    static constexpr bool kFixedArray = false;
+
+    static GVariant* to(const Map& values) {
+        GVariantBuilder builder;
+        g_variant_builder_init(&builder, G_VARIANT_TYPE(signature.c_str()));
+        for (const auto& entry : values) {
+            g_variant_builder_add_value(&builder, g_variant_new_dict_entry(GVariantTraits<Key>::to(entry.first),
+                                                                           GVariantTraits<Value>::to(entry.second)));
+        }
+        return g_variant_builder_end(&builder);
+    }
+
+    static void from(GVariant* pVariant, Map& values) {
+        values.clear();
+        size_t count = g_variant_n_children(pVariant);
+        for (size_t i = 0; i < count; ++i) {
+            GVariant* pEntry = g_variant_get_child_value(pVariant, i);
+            Key key = detail::emptyGVariantValue<Key>();
+            Value value = detail::emptyGVariantValue<Value>();
+            detail::readChild(pEntry, 0, key);
+            detail::readChild(pEntry, 1, value);
+            g_variant_unref(pEntry);
+            values.insert_or_assign(std::move(key), std::move(value));
+        }
+    }
+};
+
+template <typename K, typename V, typename Compare, typename Allocator>
+struct GVariantTraits<std::map<K, V, Compare, Allocator>> : GVariantMapTraits<std::map<K, V, Compare, Allocator>> {};
+
+template <typename K, typename V, typename Hash, typename Equal, typename Allocator>
+struct GVariantTraits<std::unordered_map<K, V, Hash, Equal, Allocator>>
+    : GVariantMapTraits<std::unordered_map<K, V, Hash, Equal, Allocator>> {};
+
+//
+// Structs
+//
+
+template <typename... Ts>
+struct GVariantTraits<std::tuple<Ts...>> {
+    static_assert(sizeof...(Ts) > 0, "D-Bus structs need at least one field");
+
+    static constexpr auto signature = (makeGVariantSignature("(") + ... + GVariantTraits<Ts>::signature) +
+                                      makeGVariantSignature(")");
+    static constexpr bool kFixedArray = false;
+
+    static GVariant* to(const std::tuple<Ts...>& value) {
+        return detail::newTuple(value, std::index_sequence_for<Ts...>());
+    }
+
+    static void from(GVariant* pVariant, std::tuple<Ts...>& value) {
+        detail::readTuple(pVariant, value, std::index_sequence_for<Ts...>());
+    }
+};
+
+// 사용자 구조체: gvariantFields()가 반환하는 멤버 참조 튜플을 D-Bus 구조체로 변환
+template <typename T>
+struct GVariantTraits<T, std::void_t<decltype(std::declval<const T&>().gvariantFields())>> {
+    using Fields = decltype(std::declval<const T&>().gvariantFields());
+
+    template <typename Tuple>
+    struct Values;
+    template <typename... Fs>
+    struct Values<std::tuple<Fs...>> {
+        using Type = std::tuple<std::decay_t<Fs>...>;
+    };
+
+    static constexpr auto signature = GVariantTraits<typename Values<Fields>::Type>::signature;
+    static constexpr bool kFixedArray = false;
+
+    static GVariant* to(const T& value) {
+        return detail::newTuple(value.gvariantFields(), std::make_index_sequence<std::tuple_size<Fields>::value>());
+    }
+
+    static void from(GVariant* pVariant, T& value) {
+        detail::readTuple(pVariant, value.gvariantFields(), std::make_index_sequence<std::tuple_size<Fields>::value>());
+    }
+};
+
+} // namespace ggk
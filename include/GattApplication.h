@@ -24,13 +24,17 @@ public:
     bool removeService(const GattUuid& uuid);
     GattServicePtr getService(const GattUuid& uuid) const;
     
-    // BlueZ 등록
+    // BlueZ 등록 (RegisterApplication 응답을 기다리는 동안 이 스레드의 메인 컨텍스트를 돌려 GetManagedObjects에 응답)
     bool registerWithBlueZ();
     bool unregisterFromBlueZ();
     bool isRegistered() const { return registered; }
     
     // 서비스 조회
     std::vector<GattServicePtr> getServices() const;
+
+    // Hands the adapter's connection table to every characteristic, including those of services added later
+    // (see GattCharacteristic::setConnectionTracker())
+    void setConnectionTracker(ConnectionTracker* pTracker);
     
 //private:
     // D-Bus 인터페이스 설정
@@ -38,13 +42,18 @@ public:
     
     // D-Bus 메서드 핸들러
     void handleGetManagedObjects(const DBusMethodCall& call);
+    static void handleDumpFlightRecorder(const DBusMethodCall& call);
     
     // 관리 객체 딕셔너리 생성
     GVariantPtr createManagedObjectsDict() const;
     
+    // RegisterApplication 비동기 호출 후 응답 대기
+    bool callRegisterApplication(GVariantPtr parameters);
+    
     // 속성
     std::vector<GattServicePtr> services;
     mutable std::mutex servicesMutex;
+    ConnectionTracker* pConnectionTracker = nullptr;
     bool registered;
 };
 
@@ -1,5 +1,6 @@
 // GattCallbacks.h
 #pragma once
+#include <chrono>
 #include <functional>
 #include <vector>
 
@@ -10,4 +11,10 @@ using GattReadCallback = std::function<std::vector<uint8_t>()>;
 using GattWriteCallback = std::function<bool(const std::vector<uint8_t>&)>;
 using GattNotifyCallback = std::function<void()>;
 
+// 알림 전송 시마다 호출됨 (페이로드 크기) - 트래픽 기반 스케줄링용
+using GattTrafficCallback = std::function<void(size_t bytes)>;
+
+// 알림 전송 전 ACL 버퍼 크레딧 대기/확보 (페이로드 크기, 최대 대기 시간) - 크레딧이 없으면 false
+using GattCreditCallback = std::function<bool(size_t bytes, std::chrono::milliseconds timeout)>;
+
 } // namespace ggk
\ No newline at end of file
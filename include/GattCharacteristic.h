@@ -3,6 +3,7 @@
 
 #include "GattTypes.h"
 #include "GattCallbacks.h"
+#include "GattWriteRequest.h"
 #include "DBusObject.h"
 #include "GattService.h" 
 #include "BlueZConstants.h"
@@ -15,6 +16,7 @@ namespace ggk {
 
 // 전방 선언 - 필요한 것만
 class GattDescriptor;
+class ConnectionTracker;
 
 // 파일 내에서만 사용하는 포인터 타입
 using GattDescriptorPtr = std::shared_ptr<GattDescriptor>;
@@ -46,6 +48,10 @@ public:
     
     // 값 설정
     void setValue(const std::vector<uint8_t>& value);
+
+    // Sets the value once the credit callback grants ACL buffer space for the notification
+    // Returns false (value unchanged) if no credit became available within `timeout`; a timeout of 0 only polls.
+    bool notifyValue(const std::vector<uint8_t>& value, std::chrono::milliseconds timeout);
     
     // 설명자 관리
     GattDescriptorPtr createDescriptor(
@@ -79,11 +85,40 @@ public:
         std::lock_guard<std::mutex> lock(callbackMutex);
         writeCallback = callback;
     }
+
+    // Zero-copy variant of the write callback: receives a view of the written bytes plus the BlueZ options, and the stored value
+    // is only updated when the callback sets `request.store`. Takes precedence over the write callback.
+    void setWriteRequestCallback(GattWriteRequestCallback callback) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        writeRequestCallback = callback;
+    }
     
     void setNotifyCallback(GattNotifyCallback callback) {
         std::lock_guard<std::mutex> lock(callbackMutex);
         notifyCallback = callback;
     }
+
+    void setTrafficCallback(GattTrafficCallback callback) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        trafficCallback = callback;
+    }
+
+    void setCreditCallback(GattCreditCallback callback) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        creditCallback = callback;
+    }
+
+    // Connection table of the adapter: ReadValue / WriteValue report the MTU BlueZ passes for the calling device, and
+    // notification producers can size values from its link snapshots (nullptr = not tracked)
+    void setConnectionTracker(ConnectionTracker* pTracker) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        pConnectionTracker = pTracker;
+    }
+
+    ConnectionTracker* getConnectionTracker() const {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        return pConnectionTracker;
+    }
     
     // BlueZ D-Bus 인터페이스 설정
     bool setupDBusInterfaces();
@@ -110,12 +145,22 @@ public:
     // 콜백
     GattReadCallback readCallback;
     GattWriteCallback writeCallback;
+    GattWriteRequestCallback writeRequestCallback;
     GattNotifyCallback notifyCallback;
+    GattTrafficCallback trafficCallback;
+    GattCreditCallback creditCallback;
+    ConnectionTracker* pConnectionTracker = nullptr;
     mutable std::mutex callbackMutex;
     
     // D-Bus 메서드 핸들러
     void handleReadValue(const DBusMethodCall& call);
     void handleWriteValue(const DBusMethodCall& call);
+
+    // 요청 옵션의 device/mtu를 연결 테이블에 반영
+    void reportMtu(const char* pDevice, uint16_t mtu);
+
+    // 저장된 값을 offset부터 교체 (offset이 현재 길이를 넘으면 false)
+    bool storeWrittenValue(const uint8_t* pData, size_t size, uint16_t offset);
     void handleStartNotify(const DBusMethodCall& call);
     void handleStopNotify(const DBusMethodCall& call);
     
@@ -15,8 +15,8 @@ public:
     // 16비트 UUID에서 변환 (표준 BT UUID)
     static GattUuid fromShortUuid(uint16_t uuid);
     
-    // 문자열 변환
-    std::string toString() const;
+    // 문자열 변환 (복사 없음)
+    const std::string& toString() const;
     
     // BlueZ에서 사용하는 형식으로 반환
     std::string toBlueZFormat() const;
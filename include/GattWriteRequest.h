@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "DBusTypes.h"
+
+namespace ggk {
+
+// Options dictionary ("a{sv}") of a ReadValue / WriteValue call
+//
+// The strings point into the dictionary, so they are valid while the method call's parameters are alive.
+struct GattRequestOptions {
+    const char* pDevice = "";
+    const char* pType = "";
+    uint16_t offset = 0;
+    uint16_t mtu = 0;
+    bool preparedWrite = false;
+
+    static GattRequestOptions parse(GVariant* pDictionary);
+};
+
+// One WriteValue call from BlueZ, parsed without copying the value
+//
+// `pData` points into the method call's parameters ("(aya{sv})") and the option strings into its options dictionary, so they are
+// valid while the callback runs. A callback that needs the value afterwards (for example to hand it to another thread) keeps the
+// parameters alive with hold() instead of copying.
+//
+// The options are only unpacked on the first accessor call: every dictionary entry costs several GVariant allocations, which is
+// more than the rest of the write for a short value.
+//
+// The characteristic only replaces its stored value (returned by later ReadValue calls) when the callback sets `store`.
+struct GattWriteRequest {
+    const uint8_t* pData = nullptr;
+    size_t size = 0;
+
+    bool store = false;                 // 콜백이 true로 설정하면 저장된 값을 offset부터 교체
+
+    // Device object path (e.g. /org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF), "" if not given
+    const char* device() const;
+
+    // "request", "command" (write without response) or "reliable"; "" with older BlueZ
+    const char* type() const;
+
+    uint16_t offset() const;
+
+    // ATT MTU of the link, 0 if BlueZ does not report it
+    uint16_t mtu() const;
+
+    // "prepare-authorize": BlueZ only asks whether a prepared write would be accepted
+    bool isPreparedWrite() const;
+
+    // True for a write without response (the peer does not wait for the result)
+    bool isCommand() const;
+
+    // Returns a new reference to the parameters that back `pData`
+    GVariantPtr hold() const;
+
+    // Fills `request` from WriteValue parameters; returns false if they are not "(aya{sv})"
+    // `pParameters` must outlive the request.
+    static bool parse(GVariant* pParameters, GattWriteRequest& request);
+
+private:
+    const GattRequestOptions& options() const;
+
+    GVariant* pParameters = nullptr;
+    mutable GattRequestOptions parsedOptions;
+    mutable bool optionsParsed = false;
+};
+
+// Returns false to reject the write (BlueZ reports an error to the peer)
+using GattWriteRequestCallback = std::function<bool(GattWriteRequest& request)>;
+
+} // namespace ggk
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 #include <bluetooth/bluetooth.h>
@@ -8,6 +13,10 @@
 #include <bluetooth/hci_lib.h>
 
 #include "HciSocket.h"
+#include "HciCommandQueue.h"
+#include "HciEventDecoder.h"
+#include "ConnectionTracker.h"
+#include "AclFlowControl.h"
 #include "Logger.h"
 #include "Utils.h"
 
@@ -30,7 +39,7 @@ public:
     static const uint16_t CMD_SET_POWERED = 0x0C03;           // OGF=0x03, OCF=0x03
     static const uint16_t CMD_SET_BREDR = 0x0C28;            // OGF=0x03, OCF=0x28
     static const uint16_t CMD_SET_LE = 0x0C20;               // OGF=0x03, OCF=0x20
-    static const uint16_t CMD_SET_ADVERTISING = 0x0C08;       // OGF=0x03, OCF=0x08
+    static const uint16_t CMD_SET_ADVERTISING = 0x200A;       // OGF=0x08, OCF=0x0A (LE Set Advertising Enable)
     static const uint16_t CMD_SET_LOCAL_NAME = 0x0C13;        // OGF=0x03, OCF=0x13
     static const uint16_t CMD_SET_ADVERTISING_DATA = 0x2008;  // OGF=0x08, OCF=0x08
     static const uint16_t CMD_SET_DISCOVERABLE = 0x0C1E;      // OGF=0x03, OCF=0x1E
@@ -38,32 +47,152 @@ public:
     static const uint16_t CMD_SET_BONDABLE = 0x0C45;          // OGF=0x03, OCF=0x45
     static const uint16_t CMD_SET_CONNECTABLE = 0x0C26;       // OGF=0x03, OCF=0x26
 
-    HciAdapter();
+    // LE 링크 최적화 명령
+    static const uint16_t CMD_LE_SET_DATA_LENGTH = 0x2022;
+    static const uint16_t CMD_LE_WRITE_SUGGESTED_DATA_LENGTH = 0x2024;
+    static const uint16_t CMD_LE_READ_MAX_DATA_LENGTH = 0x202F;
+    static const uint16_t CMD_LE_SET_DEFAULT_PHY = 0x2031;
+    static const uint16_t CMD_LE_SET_PHY = 0x2032;
+
+    // PHY 비트마스크 (LE Set Default PHY / LE Set PHY)
+    static const uint8_t PHY_MASK_1M = 0x01;
+    static const uint8_t PHY_MASK_2M = 0x02;
+    static const uint8_t PHY_MASK_CODED = 0x04;
+
+    // Data length and PHY preferences negotiated on every new connection of a device class
+    struct LinkPolicy {
+        bool requestDataLength = true;
+        uint16_t txOctets = 251;          // 27..251, clamped to what the controller supports
+        uint16_t txTime = 2120;           // us, 328..17040
+
+        bool requestPhy = true;
+        uint8_t txPhys = PHY_MASK_2M;     // preferred PHYs (PHY_MASK_*)
+        uint8_t rxPhys = PHY_MASK_2M;
+        uint16_t phyOptions = 0;          // Coded PHY: 0 = no preference, 1 = S2, 2 = S8
+
+        // 최대 처리량: 251바이트 페이로드 + 2M PHY
+        static LinkPolicy throughput() { return LinkPolicy(); }
+
+        // 장거리: Coded PHY (S8), 큰 페이로드는 전송 시간이 길어지므로 Coded 기준 최대 시간 사용
+        static LinkPolicy longRange() {
+            LinkPolicy policy;
+            policy.txTime = 17040;
+            policy.txPhys = PHY_MASK_CODED;
+            policy.rxPhys = PHY_MASK_CODED;
+            policy.phyOptions = 2;
+            return policy;
+        }
+
+        // 협상하지 않음 (구형 central 호환용)
+        static LinkPolicy legacy() {
+            LinkPolicy policy;
+            policy.requestDataLength = false;
+            policy.requestPhy = false;
+            return policy;
+        }
+    };
+
+    // Maps a new connection to a device class name; the class selects the LinkPolicy
+    using DeviceClassifier = std::function<std::string(const LinkState& state)>;
+
+    static constexpr const char* kDefaultDeviceClass = "default";
+
+    // `deviceIndex` selects the controller (0 = hci0)
+    explicit HciAdapter(uint16_t deviceIndex = HciSocket::kDefaultDeviceIndex);
     ~HciAdapter();
 
     bool initialize();
     void stop();
     
     bool sendCommand(HciHeader& request);
+
+    // 명령 큐를 통한 전송 - 컨트롤러 크레딧이 있을 때만 실제로 전송됨
+    std::future<HciCommandResult> sendCommandAsync(uint16_t opcode, std::vector<uint8_t> parameters,
+        std::chrono::milliseconds timeout = HciCommandQueue::kDefaultTimeout);
+    void sendCommandAsync(uint16_t opcode, std::vector<uint8_t> parameters, HciCommandCallback callback,
+        std::chrono::milliseconds timeout = HciCommandQueue::kDefaultTimeout);
+
+    // 전송 후 Command Complete/Status를 기다림
+    HciCommandResult sendCommandSync(uint16_t opcode, std::vector<uint8_t> parameters,
+        std::chrono::milliseconds timeout = HciCommandQueue::kDefaultTimeout);
+
+    // 여러 명령을 한 번에 큐에 넣고(파이프라인) 모두 끝날 때까지 대기
+    // 모든 명령이 성공하면 true. `pResults`가 주어지면 명령 순서대로 결과를 채움
+    bool sendCommandBatch(const std::vector<HciCommand>& commands, std::vector<HciCommandResult>* pResults = nullptr);
+
     bool setAdapterName(const std::string& name);
     bool setAdvertisingEnabled(bool enabled);
     bool setPowered(bool powered);
     bool setLEEnabled(bool enabled);
 
+    // 기기 클래스별 링크 정책 (kDefaultDeviceClass는 분류되지 않은 모든 기기에 적용)
+    void setLinkPolicy(const std::string& deviceClass, const LinkPolicy& policy);
+    void setDeviceClassifier(DeviceClassifier classifier);
+
     void handleCommandComplete(const uint8_t* data, uint8_t length);
     void handleCommandStatus(const uint8_t* data, uint8_t length);
 
+    uint16_t getDeviceIndex() const { return deviceIndex; }
     HciSocket& getSocket() { return hciSocket; }
+    HciCommandQueue& getCommandQueue() { return commandQueue; }
+
+    // 이벤트 핸들러 등록용 - initialize() 전에 등록해야 함
+    HciEventDecoder& getEventDecoder() { return eventDecoder; }
+
+    // 연결별 링크 상태 (HCI 이벤트로 갱신)
+    ConnectionTracker& getConnectionTracker() { return connectionTracker; }
+
+    // 연결별 ACL 버퍼 크레딧 (Number of Completed Packets로 갱신)
+    AclFlowControl& getAclFlowControl() { return aclFlowControl; }
 
 private:
+    uint16_t deviceIndex;
     HciSocket hciSocket;
+    HciCommandQueue commandQueue;
+    HciEventDecoder eventDecoder;
+    ConnectionTracker connectionTracker;
+    AclFlowControl aclFlowControl;
     std::atomic<bool> isRunning;
     std::thread eventThread;
     AdapterSettings settings;
     
     void processEvents();
+    void recordEvent(uint8_t eventCode, const uint8_t* parameters, uint8_t length);
+    void flushCoalescedEvents();
+
+    // 스캔이나 스트리밍 중 초당 수백 개씩 오는 이벤트는 플라이트 레코더에 하나씩 넣지 않고 개수만 셈
+    // (연결/명령 이벤트가 링에서 밀려나지 않도록). 다른 이벤트를 기록하기 직전이나 kCoalescedFlushCount마다 합계를 기록
+    struct CoalescedEvent {
+        uint16_t code;                  // 이벤트 코드 (LE Meta는 0x3E00 | subevent)
+        uint32_t count;
+    };
+    static constexpr uint32_t kCoalescedFlushCount = 1024;
+    std::array<CoalescedEvent, 4> coalescedEvents = {{
+        {0x13, 0},                      // Number of Completed Packets
+        {0x3E02, 0},                    // LE Advertising Report
+        {0x3E0B, 0},                    // LE Directed Advertising Report
+        {0x3E0D, 0}                     // LE Extended Advertising Report
+    }};                                 // 이벤트 스레드 전용
+
+    // 컨트롤러 기본값(제안 데이터 길이, 기본 PHY) 설정
+    void configureLinkDefaults();
+
+    // 컨트롤러 ACL 버퍼 크기 조회 (LE 전용 버퍼가 없으면 BR/EDR 공유 버퍼)
+    void readBufferSize();
+
+    // 새 연결에 링크 정책 적용 - 이벤트 스레드에서 호출되므로 비동기 명령만 사용
+    void applyLinkPolicy(const LinkState& state);
+    LinkPolicy policyFor(const LinkState& state);
+
+    std::map<std::string, LinkPolicy> linkPolicies;
+    DeviceClassifier deviceClassifier;
+    std::mutex policyMutex;
+    std::atomic<uint16_t> maxSupportedTxOctets;
+    std::atomic<uint16_t> maxSupportedTxTime;
 
     static constexpr int MAX_EVENT_WAIT_MS = 1000;
+    static constexpr size_t kEventBatchSize = 16;
+    static constexpr int kCommandTimeoutPollMS = 20;
     static constexpr uint16_t NON_CONTROLLER_ID = 0xffff;
 };
 
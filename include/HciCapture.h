@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/uio.h>
+
+#include "SpscRing.h"
+
+namespace ggk {
+
+// HCI traffic capture to btsnoop or pcap files
+//
+// HciSocket hands every packet it reads or writes to `capturePacket()`, which copies it with a timestamp into a preallocated
+// lock-free ring and returns; nothing is formatted or written on the HCI path. A background thread drains the ring into the
+// capture file and rotates it once it reaches the size limit (`path`, `path.1`, ... `path.N-1`, oldest last). Packets that do not
+// fit in the ring are dropped and counted (btsnoop records carry the cumulative drop count).
+//
+// Writes can come from any thread that sends HCI commands, so producers take a short spin lock among themselves; the writer thread
+// never blocks them.
+class HciCapture {
+public:
+    enum class Format {
+        Btsnoop,        // btmon / Wireshark, datalink 1002 (HCI UART H4)
+        Pcap            // LINKTYPE_BLUETOOTH_HCI_H4_WITH_PHDR (201)
+    };
+
+    static constexpr size_t kRingCapacity = 1024;
+    static constexpr size_t kSnapLength = 1032;          // HciPacketPool 슬랩 크기와 같음
+    static constexpr size_t kDefaultMaxFileBytes = 16 * 1024 * 1024;
+    static constexpr size_t kDefaultMaxFiles = 4;
+
+    static constexpr uint32_t kBtsnoopDatalinkH4 = 1002;
+    static constexpr uint32_t kPcapLinktypeH4WithPhdr = 201;
+
+    HciCapture(const std::string& path, Format format, size_t maxFileBytes = kDefaultMaxFileBytes,
+               size_t maxFiles = kDefaultMaxFiles);
+    ~HciCapture();
+
+    HciCapture(const HciCapture&) = delete;
+    HciCapture& operator=(const HciCapture&) = delete;
+
+    // Opens the capture file and starts the writer thread
+    bool start();
+
+    // Writes everything still queued and closes the file
+    void stop();
+
+    bool isRunning() const { return running.load(); }
+
+    // Queues one H4 packet (type byte first); `received` is true for controller to host traffic
+    void capturePacket(bool received, const uint8_t* pData, size_t size);
+    void capturePacket(bool received, const struct iovec* pVectors, int count);
+
+    uint64_t getCapturedCount() const { return captured.load(); }
+    uint64_t getDroppedCount() const { return dropped.load(); }
+
+    // Encoders for the file formats (public for tests and offline conversion)
+    static size_t encodeFileHeader(Format format, uint8_t* pOut);
+    static size_t encodeRecordHeader(Format format, bool received, uint8_t packetType, uint64_t timestampUs,
+                                     uint32_t length, uint32_t originalLength, uint32_t drops, uint8_t* pOut);
+
+private:
+    struct Record {
+        uint64_t timestampUs;           // Unix epoch
+        uint32_t originalLength;
+        uint16_t length;
+        bool received;
+        uint8_t data[kSnapLength];
+    };
+
+    template <typename Fill>
+    void push(bool received, size_t size, Fill fill);
+    bool openFile();
+    void rotate();
+    void writeRecord(const Record& record);
+    void run();
+
+    std::string path;
+    Format format;
+    size_t maxFileBytes;
+    size_t maxFiles;
+
+    SpscRing<Record, kRingCapacity> ring;
+    std::atomic_flag producerLock = ATOMIC_FLAG_INIT;
+
+    FILE* pFile;
+    size_t fileBytes;
+
+    std::atomic<uint64_t> captured;
+    std::atomic<uint64_t> dropped;
+
+    std::atomic<bool> running;
+    std::thread writerThread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+};
+
+} // namespace ggk
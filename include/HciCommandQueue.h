@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "HciSocket.h"
+
+namespace ggk {
+
+// Outcome of a single HCI command
+struct HciCommandResult {
+    uint16_t opcode = 0;
+
+    // HCI status code (0x00 = success) or one of the HciCommandQueue::kStatus* codes
+    uint8_t status = 0;
+
+    // true if the command finished with Command Complete, false for Command Status
+    bool complete = false;
+
+    // Return parameters that followed the status byte in Command Complete
+    std::vector<uint8_t> returnParameters;
+
+    bool succeeded() const { return status == 0x00; }
+};
+
+using HciCommandCallback = std::function<void(const HciCommandResult&)>;
+
+// A command waiting to be sent as part of a batch
+struct HciCommand {
+    uint16_t opcode;
+    std::vector<uint8_t> parameters;
+};
+
+// Queue of outgoing HCI commands with Num_HCI_Command_Packets flow control
+//
+// Commands are only written while the controller has command credits. Every Command Complete / Command Status event refreshes
+// the credit count and resolves the oldest in-flight command with a matching opcode. Commands that do not get an answer within
+// their timeout are failed with kStatusTimeout.
+//
+// `handleEvent()` and `checkTimeouts()` are expected to be called from the HCI event thread. `submit()` may be called from any
+// thread. Callbacks are invoked without the queue lock held, on whichever thread resolved the command.
+class HciCommandQueue {
+public:
+    // Host-side status codes (not used by the Bluetooth specification)
+    static constexpr uint8_t kStatusCancelled = 0xFD;
+    static constexpr uint8_t kStatusSendFailed = 0xFE;
+    static constexpr uint8_t kStatusTimeout = 0xFF;
+
+    static constexpr std::chrono::milliseconds kDefaultTimeout{2000};
+
+    explicit HciCommandQueue(HciSocket& socket);
+    ~HciCommandQueue();
+
+    HciCommandQueue(const HciCommandQueue&) = delete;
+    HciCommandQueue& operator=(const HciCommandQueue&) = delete;
+
+    // Queues a command and returns a future for its result
+    std::future<HciCommandResult> submit(uint16_t opcode, std::vector<uint8_t> parameters,
+                                         std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // Queues a command and invokes `callback` with its result
+    void submit(uint16_t opcode, std::vector<uint8_t> parameters, HciCommandCallback callback,
+                std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // Feeds a Command Complete (0x0E) or Command Status (0x0F) event into the queue
+    //
+    // Returns true if the event was one of those two events.
+    bool handleEvent(uint8_t eventCode, const uint8_t* pParameters, uint8_t length);
+
+    // Fails in-flight and queued commands whose deadline has passed
+    void checkTimeouts();
+
+    // Fails every outstanding command with kStatusCancelled
+    void cancelAll();
+
+    // Number of commands queued or in flight
+    size_t pendingCount() const;
+
+    // Number of commands the controller currently accepts
+    uint8_t getCredits() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        uint16_t opcode;
+        std::vector<uint8_t> parameters;
+        std::chrono::milliseconds timeout;
+        Clock::time_point deadline;
+        HciCommandCallback callback;
+    };
+
+    // Sends queued commands while credits remain (caller holds the mutex)
+    //
+    // Commands that could not be written are moved to `failed` so their callbacks can run after the lock is released.
+    void issueLocked(std::vector<std::pair<Entry, HciCommandResult>>& failed);
+
+    // Runs the callbacks collected while the lock was held
+    static void dispatch(std::vector<std::pair<Entry, HciCommandResult>>& results);
+
+    HciSocket& socket;
+    std::deque<Entry> waiting;
+    std::deque<Entry> inFlight;
+    uint8_t credits;
+    mutable std::mutex mutex;
+};
+
+} // namespace ggk
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "HciPacketPool.h"
+
+namespace ggk {
+
+// Little endian field readers and writer for HCI packets (HCI is always little endian, regardless of the host)
+inline uint16_t hciLe16(const uint8_t *p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+inline uint32_t hciLe24(const uint8_t *p) { return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16)); }
+inline void hciAppendLe16(std::vector<uint8_t> &buffer, uint16_t value) {
+    buffer.push_back(static_cast<uint8_t>(value & 0xFF));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+// Formats a 6-byte little endian Bluetooth address as "AA:BB:CC:DD:EE:FF"
+std::string hciAddressString(const uint8_t *pAddress);
+
+//
+// Event views
+//
+// Each view points into the event parameters of a received packet; nothing is copied. Views are only valid inside the handler
+// they are passed to, because the underlying slab goes back to the pool afterwards. `kSize` is the minimum parameter length
+// the decoder checks before constructing the view.
+//
+
+// Disconnection Complete (0x05): [Status][Handle(2)][Reason]
+struct HciDisconnectionCompleteView {
+    static constexpr size_t kSize = 4;
+
+    explicit HciDisconnectionCompleteView(const uint8_t *pData) : p(pData) {}
+
+    uint8_t status() const { return p[0]; }
+    uint16_t connectionHandle() const { return hciLe16(p + 1) & 0x0FFF; }
+    uint8_t reason() const { return p[3]; }
+
+    const uint8_t *p;
+};
+
+// Number of Completed Packets (0x13): [Num_Handles]{[Handle(2)][Num_Completed_Packets(2)]}...
+struct HciNumberOfCompletedPacketsView {
+    static constexpr size_t kSize = 1;
+
+    HciNumberOfCompletedPacketsView(const uint8_t *pData, size_t length) : p(pData), length(length) {}
+
+    // Number of complete handle/count pairs present in the event
+    size_t count() const {
+        size_t available = (length - 1) / 4;
+        return p[0] < available ? p[0] : available;
+    }
+    uint16_t connectionHandle(size_t index) const { return hciLe16(p + 1 + index * 4) & 0x0FFF; }
+    uint16_t completedPackets(size_t index) const { return hciLe16(p + 3 + index * 4); }
+
+    const uint8_t *p;
+    size_t length;
+};
+
+// LE Connection Complete (0x01) and LE Enhanced Connection Complete (0x0A)
+//
+// Legacy:   [Status][Handle(2)][Role][Peer_Address_Type][Peer_Address(6)][Interval(2)][Latency(2)][Timeout(2)][Clock_Accuracy]
+// Enhanced: same as legacy, with [Local_RPA(6)][Peer_RPA(6)] inserted after Peer_Address
+struct HciLeConnectionCompleteView {
+    static constexpr size_t kSize = 18;
+    static constexpr size_t kEnhancedSize = 30;
+
+    HciLeConnectionCompleteView(const uint8_t *pData, bool enhanced) : p(pData), enhanced(enhanced) {}
+
+    bool isEnhanced() const { return enhanced; }
+    uint8_t status() const { return p[0]; }
+    uint16_t connectionHandle() const { return hciLe16(p + 1) & 0x0FFF; }
+    uint8_t role() const { return p[3]; }
+    uint8_t peerAddressType() const { return p[4]; }
+    const uint8_t *peerAddress() const { return p + 5; }
+    const uint8_t *localResolvablePrivateAddress() const { return enhanced ? p + 11 : nullptr; }
+    const uint8_t *peerResolvablePrivateAddress() const { return enhanced ? p + 17 : nullptr; }
+    uint16_t connectionInterval() const { return hciLe16(p + tail()); }
+    uint16_t peripheralLatency() const { return hciLe16(p + tail() + 2); }
+    uint16_t supervisionTimeout() const { return hciLe16(p + tail() + 4); }
+    uint8_t centralClockAccuracy() const { return p[tail() + 6]; }
+
+    const uint8_t *p;
+    bool enhanced;
+
+private:
+    size_t tail() const { return enhanced ? 23 : 11; }
+};
+
+// LE Connection Update Complete (0x03): [Status][Handle(2)][Interval(2)][Latency(2)][Timeout(2)]
+struct HciLeConnectionUpdateCompleteView {
+    static constexpr size_t kSize = 9;
+
+    explicit HciLeConnectionUpdateCompleteView(const uint8_t *pData) : p(pData) {}
+
+    uint8_t status() const { return p[0]; }
+    uint16_t connectionHandle() const { return hciLe16(p + 1) & 0x0FFF; }
+    uint16_t connectionInterval() const { return hciLe16(p + 3); }
+    uint16_t peripheralLatency() const { return hciLe16(p + 5); }
+    uint16_t supervisionTimeout() const { return hciLe16(p + 7); }
+
+    const uint8_t *p;
+};
+
+// LE Data Length Change (0x07): [Handle(2)][Max_TX_Octets(2)][Max_TX_Time(2)][Max_RX_Octets(2)][Max_RX_Time(2)]
+struct HciLeDataLengthChangeView {
+    static constexpr size_t kSize = 10;
+
+    explicit HciLeDataLengthChangeView(const uint8_t *pData) : p(pData) {}
+
+    uint16_t connectionHandle() const { return hciLe16(p) & 0x0FFF; }
+    uint16_t maxTxOctets() const { return hciLe16(p + 2); }
+    uint16_t maxTxTime() const { return hciLe16(p + 4); }
+    uint16_t maxRxOctets() const { return hciLe16(p + 6); }
+    uint16_t maxRxTime() const { return hciLe16(p + 8); }
+
+    const uint8_t *p;
+};
+
+// LE PHY Update Complete (0x0C): [Status][Handle(2)][TX_PHY][RX_PHY]
+struct HciLePhyUpdateCompleteView {
+    static constexpr size_t kSize = 5;
+
+    explicit HciLePhyUpdateCompleteView(const uint8_t *pData) : p(pData) {}
+
+    uint8_t status() const { return p[0]; }
+    uint16_t connectionHandle() const { return hciLe16(p + 1) & 0x0FFF; }
+    uint8_t txPhy() const { return p[3]; }
+    uint8_t rxPhy() const { return p[4]; }
+
+    const uint8_t *p;
+};
+
+// One report of an LE Advertising Report event (0x02)
+//
+// [Event_Type][Address_Type][Address(6)][Data_Length][Data...][RSSI]
+struct HciLeAdvertisingReportView {
+    static constexpr size_t kSize = 10;
+
+    explicit HciLeAdvertisingReportView(const uint8_t *pData) : p(pData) {}
+
+    uint8_t eventType() const { return p[0]; }
+    uint8_t addressType() const { return p[1]; }
+    const uint8_t *address() const { return p + 2; }
+    HciByteView data() const { return HciByteView(p + 9, p[8]); }
+    int8_t rssi() const { return static_cast<int8_t>(p[9 + p[8]]); }
+
+    // Number of bytes this report occupies in the event
+    size_t encodedSize() const { return kSize + p[8]; }
+
+    const uint8_t *p;
+};
+
+// One report of an LE Extended Advertising Report event (0x0D)
+//
+// [Event_Type(2)][Address_Type][Address(6)][Primary_PHY][Secondary_PHY][SID][TX_Power][RSSI][Periodic_Interval(2)]
+// [Direct_Address_Type][Direct_Address(6)][Data_Length][Data...]
+struct HciLeExtendedAdvertisingReportView {
+    static constexpr size_t kSize = 24;
+
+    // Data_Status values (bits 5-6 of Event_Type)
+    static constexpr uint8_t kDataComplete = 0;
+    static constexpr uint8_t kDataIncomplete = 1;
+    static constexpr uint8_t kDataTruncated = 2;
+
+    explicit HciLeExtendedAdvertisingReportView(const uint8_t *pData) : p(pData) {}
+
+    uint16_t eventType() const { return hciLe16(p); }
+    uint8_t dataStatus() const { return (eventType() >> 5) & 0x03; }
+    uint8_t addressType() const { return p[2]; }
+    const uint8_t *address() const { return p + 3; }
+    uint8_t primaryPhy() const { return p[9]; }
+    uint8_t secondaryPhy() const { return p[10]; }
+    uint8_t advertisingSid() const { return p[11]; }
+    int8_t txPower() const { return static_cast<int8_t>(p[12]); }
+    int8_t rssi() const { return static_cast<int8_t>(p[13]); }
+    uint16_t periodicAdvertisingInterval() const { return hciLe16(p + 14); }
+    uint8_t directAddressType() const { return p[16]; }
+    const uint8_t *directAddress() const { return p + 17; }
+    HciByteView data() const { return HciByteView(p + kSize, p[23]); }
+
+    // Number of bytes this report occupies in the event
+    size_t encodedSize() const { return kSize + p[23]; }
+
+    const uint8_t *p;
+};
+
+// Table-driven decoder for HCI events
+//
+// Handlers are stored in two 256-entry tables, one keyed by event code and one keyed by LE Meta subevent code, so dispatching an
+// event is two array lookups. Typed handlers receive views over the event parameters (see above); events that are too short for
+// their view are dropped with a log message rather than read out of bounds. Multi-report events (advertising reports) invoke the
+// handler once per report.
+//
+// Handlers must be registered before events start flowing (i.e. before HciAdapter::initialize()); `decode()` takes no locks.
+class HciEventDecoder {
+public:
+    // Event codes
+    static const uint8_t EVT_DISCONNECTION_COMPLETE = 0x05;
+    static const uint8_t EVT_COMMAND_COMPLETE = 0x0E;
+    static const uint8_t EVT_COMMAND_STATUS = 0x0F;
+    static const uint8_t EVT_NUMBER_OF_COMPLETED_PACKETS = 0x13;
+    static const uint8_t EVT_LE_META = 0x3E;
+
+    // LE Meta subevent codes
+    static const uint8_t LE_CONNECTION_COMPLETE = 0x01;
+    static const uint8_t LE_ADVERTISING_REPORT = 0x02;
+    static const uint8_t LE_CONNECTION_UPDATE_COMPLETE = 0x03;
+    static const uint8_t LE_DATA_LENGTH_CHANGE = 0x07;
+    static const uint8_t LE_ENHANCED_CONNECTION_COMPLETE = 0x0A;
+    static const uint8_t LE_PHY_UPDATE_COMPLETE = 0x0C;
+    static const uint8_t LE_EXTENDED_ADVERTISING_REPORT = 0x0D;
+
+    // Raw handlers receive the event parameters (for LE Meta events: the parameters after the subevent code)
+    using RawHandler = std::function<void(HciByteView parameters)>;
+
+    template <typename View>
+    using Handler = std::function<void(const View &view)>;
+
+    // Registers a handler for the raw parameters of an event / LE Meta subevent
+    void onEvent(uint8_t eventCode, RawHandler handler);
+    void onLeMetaEvent(uint8_t subeventCode, RawHandler handler);
+
+    // Typed handlers
+    void onDisconnectionComplete(Handler<HciDisconnectionCompleteView> handler);
+    void onNumberOfCompletedPackets(Handler<HciNumberOfCompletedPacketsView> handler);
+    void onLeConnectionComplete(Handler<HciLeConnectionCompleteView> handler);    // both legacy and enhanced
+    void onLeConnectionUpdateComplete(Handler<HciLeConnectionUpdateCompleteView> handler);
+    void onLeDataLengthChange(Handler<HciLeDataLengthChangeView> handler);
+    void onLePhyUpdateComplete(Handler<HciLePhyUpdateCompleteView> handler);
+    void onLeAdvertisingReport(Handler<HciLeAdvertisingReportView> handler);
+    void onLeExtendedAdvertisingReport(Handler<HciLeExtendedAdvertisingReportView> handler);
+
+    // Dispatches an event to the registered handlers
+    //
+    // Returns true if at least one handler was registered for the event.
+    bool decode(uint8_t eventCode, HciByteView parameters) const;
+
+    // Returns true if any handler is registered for the event (or, for LE Meta events, for the subevent)
+    bool hasHandlers(uint8_t eventCode) const { return !eventHandlers[eventCode].empty(); }
+    bool hasLeMetaHandlers(uint8_t subeventCode) const { return !leMetaHandlers[subeventCode].empty(); }
+
+private:
+    static bool dispatch(const std::vector<RawHandler> &handlers, HciByteView parameters);
+
+    std::array<std::vector<RawHandler>, 256> eventHandlers;
+    std::array<std::vector<RawHandler>, 256> leMetaHandlers;
+};
+
+} // namespace ggk
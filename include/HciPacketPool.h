@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace ggk {
+
+class HciPacketPool;
+
+// A read-only view over bytes owned by someone else (typically a pooled slab)
+//
+// Views are only valid for as long as the owning HciPacket is alive.
+struct HciByteView {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    HciByteView() = default;
+    HciByteView(const uint8_t *pData, size_t count) : data(pData), size(count) {}
+
+    bool empty() const { return size == 0; }
+    uint8_t operator[](size_t index) const { return data[index]; }
+
+    // Returns the view starting `offset` bytes in (empty if out of range)
+    HciByteView subview(size_t offset) const {
+        return offset >= size ? HciByteView() : HciByteView(data + offset, size - offset);
+    }
+};
+
+// A single received packet stored in a slab borrowed from an HciPacketPool
+//
+// The slab is returned to its pool when the packet is destroyed or reset. Packets are move-only and must not outlive the pool
+// (and therefore the HciSocket) they came from.
+class HciPacket {
+public:
+    HciPacket() = default;
+    ~HciPacket() { reset(); }
+
+    HciPacket(HciPacket &&other) noexcept;
+    HciPacket &operator=(HciPacket &&other) noexcept;
+
+    HciPacket(const HciPacket &) = delete;
+    HciPacket &operator=(const HciPacket &) = delete;
+
+    // Returns true if this packet currently owns a slab
+    bool isValid() const { return pSlab != nullptr; }
+
+    const uint8_t *data() const { return pSlab; }
+    size_t size() const { return length; }
+    HciByteView view() const { return HciByteView(pSlab, length); }
+
+    // Returns the slab to the pool
+    void reset();
+
+private:
+    friend class HciPacketPool;
+    friend class HciSocket;
+
+    HciPacketPool *pPool = nullptr;
+    uint8_t *pSlab = nullptr;
+    size_t length = 0;
+};
+
+// Fixed-size pool of packet slabs used for HCI receive
+//
+// All slabs are allocated once up-front and handed out without zero-filling, so the receive path does no allocation.
+class HciPacketPool {
+public:
+    // H4 packet type byte + HCI_MAX_FRAME_SIZE (1028), rounded up to an 8-byte boundary
+    static constexpr size_t kSlabSize = 1032;
+    static constexpr size_t kDefaultSlabCount = 64;
+
+    explicit HciPacketPool(size_t slabCount = kDefaultSlabCount);
+
+    HciPacketPool(const HciPacketPool &) = delete;
+    HciPacketPool &operator=(const HciPacketPool &) = delete;
+
+    // Borrows a slab from the pool
+    //
+    // Returns an invalid packet if every slab is currently in use.
+    HciPacket acquire();
+
+    // Number of slabs currently available
+    size_t available() const;
+
+    // Total number of slabs owned by this pool
+    size_t capacity() const { return slabCount; }
+
+private:
+    friend class HciPacket;
+
+    void release(uint8_t *pSlab);
+
+    size_t slabCount;
+    std::vector<uint8_t> storage;
+    std::vector<uint8_t *> freeList;
+    mutable std::mutex mutex;
+};
+
+} // namespace ggk
@@ -3,11 +3,19 @@
 #include <vector>
 #include <atomic>
 #include <cstdint>
+#include <sys/uio.h>
+
+#include "HciPacketPool.h"
 
 namespace ggk {
 
+class HciCapture;
+
 class HciSocket {
 public:
+    static constexpr uint16_t kDefaultDeviceIndex = 0;
+    static constexpr int kDeviceUpTimeoutMS = 5000;
+
     // Initializes an unconnected socket
     HciSocket();
 
@@ -15,9 +23,21 @@ public:
     // This will automatically disconnect the socket if it is currently connected
     ~HciSocket();
 
-    // Connects to an HCI socket using the Bluetooth Management API protocol
+    // Connects to the HCI device `deviceIndex` (0 = hci0) using a raw HCI socket, bringing the controller up if needed
+    // Returns true on success, otherwise false
+    bool connect(uint16_t deviceIndex = kDefaultDeviceIndex);
+
+    // Brings the controller up with HCIDEVUP and waits until the kernel reports it as up
+    // Returns true if the controller is up, otherwise false
+    static bool bringUpDevice(uint16_t deviceIndex, int timeoutMS = kDeviceUpTimeoutMS);
+
+    // Connects to the Bluetooth Management API control channel (HCI_CHANNEL_CONTROL)
     // Returns true on success, otherwise false
-    bool connect();
+    bool connectManagement();
+
+    // Takes ownership of an already-open descriptor instead of creating an HCI socket
+    // Used to drive the socket through a socketpair() in tests.
+    bool adopt(int fd);
 
     // Returns true if the socket is currently connected, otherwise false
     bool isConnected() const;
@@ -30,23 +50,53 @@ public:
 
     // Reads data from the HCI socket
     // Raw data is read and returned in `response`.
-    bool read(std::vector<uint8_t> &response) const;
+    bool read(std::vector<uint8_t> &response);
+
+    // Reads up to `maxPackets` packets in a single recvmmsg() call
+    // Each packet is stored in a pooled slab and appended to `packets`. Returns the number of packets read.
+    // With a non-negative `timeoutMS`, returns 0 if no data arrived within that time.
+    size_t readBatch(std::vector<HciPacket> &packets, size_t maxPackets = kMaxBatchSize, int timeoutMS = -1);
 
     // Writes the array of bytes
-    bool write(std::vector<uint8_t> buffer) const;
+    bool write(const std::vector<uint8_t> &buffer) const;
     bool write(const uint8_t *pBuffer, size_t count) const;
 
+    // Writes a header and payload as a single packet using writev(), without copying them together first
+    bool write(const uint8_t *pHeader, size_t headerSize, const uint8_t *pPayload, size_t payloadSize) const;
+
+    // Writes an HCI command packet (H4 type + opcode + parameter length) followed by its parameters
+    bool writeCommand(uint16_t opcode, const uint8_t *pParameters, uint8_t parameterLength) const;
+
+    // Pool that received packets are borrowed from
+    HciPacketPool &getPacketPool() { return packetPool; }
+
+    // Copies every packet read or written to `pCapture` (nullptr disables capturing); the capture must outlive the socket or be
+    // removed first
+    void setCapture(HciCapture *pCapture) { capture.store(pCapture, std::memory_order_release); }
+
+    // Capture that HCI device sockets attach when `connect()` succeeds, unless one was already set, so the setup commands sent
+    // right after (e.g. by HciAdapter::initialize()) are captured too; nullptr = none. Management sockets never use it.
+    static void setDefaultCapture(HciCapture *pCapture) { defaultCapture.store(pCapture, std::memory_order_release); }
+
 private:
     // Wait for data to arrive, or for a shutdown event
-    bool waitForDataOrShutdown() const;
+    // A negative `timeoutMS` waits until one of the two happens
+    bool waitForDataOrShutdown(int timeoutMS = -1) const;
 
     // Utilitarian function for logging errors for the given operation
     void logErrno(const char *pOperation) const;
 
+    // Writes the given buffers as one packet
+    bool writeVectors(const struct iovec *pVectors, int count, size_t totalSize) const;
+
     int fdSocket;
     std::atomic<bool> isRunning;
-    
-    static constexpr size_t kResponseMaxSize = 64 * 1024;
+    HciPacketPool packetPool;
+    std::atomic<HciCapture *> capture;
+
+    static std::atomic<HciCapture *> defaultCapture;
+
+    static constexpr size_t kMaxBatchSize = 16;
     static constexpr int kDataWaitTimeMS = 10;
 };
 
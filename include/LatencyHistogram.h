@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ggk {
+
+// Latency histogram in the HdrHistogram layout: every value from 0 to `highestValue` is kept with `significantDigits` decimal
+// digits of precision, recording is O(1) and the memory does not grow with the number of samples
+//
+// Values are split into power-of-two buckets, each with the same number of linear sub-buckets, so the absolute resolution
+// doubles with every bucket while the relative error stays below 10^-significantDigits. Percentiles return the highest value
+// that is equivalent (same sub-bucket) to the recorded one, as HdrHistogram does. Values above `highestValue` are recorded
+// as `highestValue` and counted in saturated().
+//
+// Not thread-safe: give each thread its own histogram and merge() them.
+class LatencyHistogram {
+public:
+    // Defaults cover 1 ns to 60 s at 3 digits (about 220 KiB)
+    explicit LatencyHistogram(uint64_t highestValue = 60000000000ULL, int significantDigits = 3);
+
+    void record(uint64_t value);
+
+    // Adds the counts of `other`; returns false if the two were built with different ranges or precision
+    bool merge(const LatencyHistogram& other);
+
+    void reset();
+
+    uint64_t count() const { return totalCount; }
+    uint64_t saturated() const { return saturatedCount; }
+    uint64_t min() const { return totalCount == 0 ? 0 : minValue; }
+    uint64_t max() const { return maxValue; }
+    double mean() const;
+
+    // Smallest value that at least `percent` (0-100) percent of the recorded values are equivalent to or below
+    uint64_t percentile(double percent) const;
+
+    uint64_t getHighestValue() const { return highestValue; }
+
+private:
+    size_t indexOf(uint64_t value) const;
+    uint64_t valueAt(size_t index) const;
+    uint64_t highestEquivalentValue(uint64_t value) const;
+
+    uint64_t highestValue;
+    int significantDigits;
+    int subBucketHalfCountMagnitude = 0;
+    uint64_t subBucketHalfCount = 0;
+    uint64_t subBucketMask = 0;
+
+    std::vector<uint64_t> counts;
+    uint64_t totalCount = 0;
+    uint64_t saturatedCount = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+    long double sum = 0;                // 평균 계산용 (정확한 값의 합)
+};
+
+} // namespace ggk
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HciAdapter.h"
+#include "ScanDuplicateFilter.h"
+#include "SpscRing.h"
+
+namespace ggk {
+
+// One received advertising report (legacy or extended), stored by value for delivery through the report ring
+struct ScanReport {
+    // 이벤트 하나에 담길 수 있는 최대 광고 데이터 (255 - 헤더 - 보고서 고정 필드)
+    static constexpr size_t kMaxDataLength = 229;
+
+    // Legacy reports have no PHY / SID / TX power information
+    static constexpr uint8_t kNoSid = 0xFF;
+    static constexpr int8_t kTxPowerUnavailable = 0x7F;
+
+    uint64_t timestampUs = 0;           // steady clock
+    uint16_t eventType = 0;             // legacy: 0x00-0x04, extended: Event_Type bit field
+    uint8_t addressType = 0;
+    uint8_t address[6] = {};            // 리틀 엔디안
+    int8_t rssi = 0;
+    int8_t txPower = kTxPowerUnavailable;
+    uint8_t primaryPhy = 0x01;
+    uint8_t secondaryPhy = 0x00;
+    uint8_t sid = kNoSid;
+    uint8_t dataStatus = 0;             // extended: complete / incomplete / truncated
+    bool extended = false;
+    uint8_t dataLength = 0;
+    std::array<uint8_t, kMaxDataLength> data;
+
+    std::string addressString() const;
+};
+
+// Scan parameters in HCI units (0.625 ms)
+struct ScanParameters {
+    static constexpr uint8_t kPhy1M = 0x01;
+    static constexpr uint8_t kPhyCoded = 0x04;
+
+    bool active = false;                // 능동 스캔 (Scan Request 전송)
+    uint16_t interval = 0x0060;         // 60 ms
+    uint16_t window = 0x0060;           // interval과 같으면 연속 스캔
+    uint8_t ownAddressType = 0x00;
+    uint8_t filterPolicy = 0x00;
+    uint8_t phys = kPhy1M;              // 확장 스캔만 해당 (비트마스크)
+
+    void setIntervalMs(uint32_t intervalMs, uint32_t windowMs) {
+        interval = static_cast<uint16_t>(intervalMs * 8 / 5);
+        window = static_cast<uint16_t>(windowMs * 8 / 5);
+    }
+};
+
+// LE scanner / observer
+//
+// Advertising reports are decoded in place on the HCI event thread (HciEventDecoder views), run through a hashed duplicate filter
+// and copied once into a lock-free single-producer/single-consumer ring. A delivery thread drains the ring and hands the reports to
+// subscribers, so slow subscribers never stall HCI event processing; if the ring overflows, reports are dropped and counted.
+//
+// The controller's own duplicate filtering is disabled because it has no TTL and forgets nothing until scanning restarts.
+class LeScanner {
+public:
+    static constexpr uint16_t CMD_LE_SET_SCAN_PARAMETERS = 0x200B;
+    static constexpr uint16_t CMD_LE_SET_SCAN_ENABLE = 0x200C;
+    static constexpr uint16_t CMD_LE_SET_EXT_SCAN_PARAMETERS = 0x2041;
+    static constexpr uint16_t CMD_LE_SET_EXT_SCAN_ENABLE = 0x2042;
+
+    static constexpr size_t kRingCapacity = 4096;
+
+    using ReportHandler = std::function<void(const ScanReport&)>;
+
+    struct Statistics {
+        uint64_t received = 0;
+        uint64_t duplicates = 0;
+        uint64_t dropped = 0;           // 링이 가득 차 버려진 보고서
+        uint64_t delivered = 0;
+    };
+
+    // Registers with the adapter's event decoder (call before the adapter is initialized); the scanner must outlive the adapter's
+    // event thread
+    explicit LeScanner(HciAdapter& adapter);
+    ~LeScanner();
+
+    LeScanner(const LeScanner&) = delete;
+    LeScanner& operator=(const LeScanner&) = delete;
+
+    // Subscribers are called on the delivery thread
+    void subscribe(ReportHandler handler);
+
+    // Duplicate filtering in user space; a TTL of 0 disables it
+    void setDuplicateFilter(std::chrono::milliseconds ttl);
+
+    // Configures and enables scanning; `extended` uses the LE extended scanning commands (required for reports on secondary PHYs)
+    bool start(const ScanParameters& parameters = ScanParameters(), bool extended = false);
+    bool stop();
+    bool isScanning() const { return scanning.load(); }
+
+    // Delivers queued reports on the calling thread and returns how many were delivered (used by the delivery thread; public for
+    // tests)
+    size_t drain();
+
+    Statistics getStatistics() const;
+
+    // Encoders for the scan commands
+    static std::vector<uint8_t> encodeParameters(const ScanParameters& parameters);
+    static std::vector<uint8_t> encodeExtendedParameters(const ScanParameters& parameters);
+
+private:
+    void handleLegacyReport(const HciLeAdvertisingReportView& report);
+    void handleExtendedReport(const HciLeExtendedAdvertisingReportView& report);
+    bool accept(uint8_t addressType, const uint8_t* pAddress, HciByteView data);
+    template <typename Fill>
+    void enqueue(Fill fill);
+    bool sendEnable(bool enable);
+    void run();
+
+    HciAdapter& adapter;
+
+    SpscRing<ScanReport, kRingCapacity> ring;
+    ScanDuplicateFilter duplicateFilter;
+    std::atomic<int64_t> filterTtlMS;      // 0이면 필터 비활성화, 이벤트 스레드에서 필터에 반영
+
+    std::vector<ReportHandler> handlers;
+    std::mutex handlersMutex;
+
+    std::atomic<uint64_t> received;
+    std::atomic<uint64_t> duplicates;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> delivered;
+
+    std::atomic<bool> scanning;
+    std::atomic<bool> extendedScan;
+    std::atomic<bool> running;
+    std::atomic<bool> consumerWaiting;
+    std::thread deliveryThread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+};
+
+} // namespace ggk
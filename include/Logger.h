@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <sstream>
+#include <string>
 #include <functional>
 
 namespace ggk {
@@ -8,6 +11,55 @@ namespace ggk {
 // Our handy stringstream macro
 #define SSTR std::ostringstream().flush()
 
+// Severity levels, lowest first; a module logs messages at or above its level
+enum class LogLevel : uint8_t {
+    Trace = 0,
+    Debug,
+    Info,
+    Status,
+    Warn,
+    Error,
+    Fatal,
+    Always,
+    Off
+};
+
+// Subsystems with independent runtime levels
+enum class LogModule : uint8_t {
+    General = 0,
+    Hci,
+    DBus,
+    Gatt,
+    Server,
+    Count
+};
+
+// Compile-time floor (a LogLevel value): the GGK_LOG_* macros below it compile to nothing, arguments included
+#ifndef GGK_LOG_MIN_LEVEL
+#define GGK_LOG_MIN_LEVEL 0
+#endif
+
+// True if `level` (a LogLevel value) is at or above the compile-time floor
+constexpr bool isLogLevelCompiled(int level) { return level >= GGK_LOG_MIN_LEVEL; }
+
+// Level-gated logging: `message` is a stream expression (`"value: " << x`) that is only evaluated and formatted when the level is
+// compiled in, enabled for the module and has a receiver. Formatting reuses a per-thread stream.
+#define GGK_LOG(level, module, message)                                                                   \
+    do {                                                                                                  \
+        if (::ggk::isLogLevelCompiled(static_cast<int>(level)) && ::ggk::Logger::isEnabled(level, module)) { \
+            ::ggk::Logger::ScopedStream logStream_;                                                       \
+            logStream_.stream() << message;                                                               \
+            ::ggk::Logger::log(level, logStream_.stream());                                               \
+        }                                                                                                 \
+    } while (0)
+
+#define GGK_LOG_TRACE(module, message) GGK_LOG(::ggk::LogLevel::Trace, ::ggk::LogModule::module, message)
+#define GGK_LOG_DEBUG(module, message) GGK_LOG(::ggk::LogLevel::Debug, ::ggk::LogModule::module, message)
+#define GGK_LOG_INFO(module, message) GGK_LOG(::ggk::LogLevel::Info, ::ggk::LogModule::module, message)
+#define GGK_LOG_STATUS(module, message) GGK_LOG(::ggk::LogLevel::Status, ::ggk::LogModule::module, message)
+#define GGK_LOG_WARN(module, message) GGK_LOG(::ggk::LogLevel::Warn, ::ggk::LogModule::module, message)
+#define GGK_LOG_ERROR(module, message) GGK_LOG(::ggk::LogLevel::Error, ::ggk::LogModule::module, message)
+
 class Logger {
 public:
     // Define our own log receiver type using std::function
@@ -23,7 +75,62 @@ public:
     static void registerAlwaysReceiver(LogReceiver receiver);
     static void registerTraceReceiver(LogReceiver receiver);
 
-    // Logging actions
+    // Receiver currently registered for `level` (empty if none)
+    static LogReceiver getReceiver(LogLevel level);
+
+    // Observer that sees every message at or above `minimum` in addition to the receiver for its level (used by FlightRecorder).
+    // A plain function pointer so it can be swapped without a lock; nullptr removes it
+    using LogTap = void (*)(LogLevel level, const char* pText);
+    static void setTap(LogTap tap, LogLevel minimum = LogLevel::Info);
+
+    // Runtime levels (default Trace: everything with a receiver is logged)
+    static void setLevel(LogLevel level);
+    static void setLevel(LogModule module, LogLevel level);
+    static LogLevel getLevel(LogModule module);
+
+    // Applies a level specification such as "info,hci=debug,gatt=trace" (a bare level applies to every module)
+    // Returns false if any entry is not recognized; the valid entries are still applied
+    static bool setLevels(const std::string& spec);
+
+    static const char* levelName(LogLevel level);
+    static const char* moduleName(LogModule module);
+
+    // Returns true if `level` passes the module's runtime level and a receiver (or the tap) takes it, so callers can skip building
+    // expensive messages
+    static bool isEnabled(LogLevel level, LogModule module = LogModule::General) {
+        return isLevelEnabled(level, module) && (hasReceiver(level) || isTapped(level));
+    }
+
+    // Runtime level check only (for outputs that do not go through the receivers, such as BinaryLog)
+    static bool isLevelEnabled(LogLevel level, LogModule module) {
+        return static_cast<uint8_t>(level) >= moduleLevels[static_cast<size_t>(module)].load(std::memory_order_relaxed);
+    }
+    static bool isDebugEnabled() { return isEnabled(LogLevel::Debug); }
+    static bool isTraceEnabled() { return isEnabled(LogLevel::Trace); }
+
+    // Per-thread formatting stream for the GGK_LOG macros; a nested log statement (one evaluated while formatting another) gets a
+    // fresh stream instead of the busy one
+    class ScopedStream {
+    public:
+        ScopedStream();
+        ~ScopedStream();
+
+        ScopedStream(const ScopedStream&) = delete;
+        ScopedStream& operator=(const ScopedStream&) = delete;
+
+        std::ostringstream& stream() { return *pStream; }
+
+    private:
+        std::ostringstream* pStream;
+        bool owned;
+    };
+
+    // Logs at a level chosen at runtime (used by the GGK_LOG macros)
+    static void log(LogLevel level, const char* pText);
+    static void log(LogLevel level, const std::string& text);
+    static void log(LogLevel level, const std::ostream& text);
+
+    // Logging actions, gated by the General module's runtime level
     static void debug(const char* pText);
     static void debug(const std::string& text);
     static void debug(const std::ostream& text);
@@ -57,6 +164,30 @@ public:
     static void trace(const std::ostream& text);
 
 private:
+    static bool isTapped(LogLevel level) {
+        return static_cast<uint8_t>(level) >= tapLevel.load(std::memory_order_relaxed);
+    }
+    static void notifyTap(LogLevel level, const char* pText);
+    static void write(LogLevel level, const char* pText);
+
+    static bool hasReceiver(LogLevel level) {
+        switch (level) {
+            case LogLevel::Trace: return static_cast<bool>(logReceiverTrace);
+            case LogLevel::Debug: return static_cast<bool>(logReceiverDebug);
+            case LogLevel::Info: return static_cast<bool>(logReceiverInfo);
+            case LogLevel::Status: return static_cast<bool>(logReceiverStatus);
+            case LogLevel::Warn: return static_cast<bool>(logReceiverWarn);
+            case LogLevel::Error: return static_cast<bool>(logReceiverError);
+            case LogLevel::Fatal: return static_cast<bool>(logReceiverFatal);
+            case LogLevel::Always: return static_cast<bool>(logReceiverAlways);
+            default: return false;
+        }
+    }
+
+    static std::atomic<uint8_t> moduleLevels[static_cast<size_t>(LogModule::Count)];
+    static std::atomic<LogTap> logTap;
+    static std::atomic<uint8_t> tapLevel;
+
     static LogReceiver logReceiverDebug;
     static LogReceiver logReceiverInfo;
     static LogReceiver logReceiverStatus;
@@ -1,21 +1,102 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
-#include "HciAdapter.h"
+#include <thread>
+#include <vector>
+#include "HciSocket.h"
 #include "Utils.h"
 
 namespace ggk {
 
+// Bluetooth Management API client (HCI_CHANNEL_CONTROL)
+//
+// Commands are sent as MGMT packets ([opcode][controller index][length][parameters], little endian) and matched to their
+// Command Complete / Command Status replies, so each setter costs exactly one round-trip to the kernel. Unsolicited events
+// (new settings, device connected/disconnected, new connection parameters) are delivered to subscribed handlers on the Mgmt
+// event thread.
 class Mgmt {
 public:
     // 상수 정의
     static const int kMaxAdvertisingNameLength = 248;
     static const int kMaxAdvertisingShortNameLength = 10;
     static const uint16_t kDefaultControllerIndex = 0;
+    static const uint16_t kNonControllerIndex = 0xFFFF;
 
-    // 생성자에서 HciAdapter 인스턴스를 받도록 수정
-    Mgmt(HciAdapter& adapter, uint16_t controllerIndex = kDefaultControllerIndex);
+    // MGMT 명령 코드
+    static const uint16_t CMD_READ_CONTROLLER_INFO = 0x0004;
+    static const uint16_t CMD_SET_POWERED = 0x0005;
+    static const uint16_t CMD_SET_DISCOVERABLE = 0x0006;
+    static const uint16_t CMD_SET_CONNECTABLE = 0x0007;
+    static const uint16_t CMD_SET_BONDABLE = 0x0009;
+    static const uint16_t CMD_SET_LE = 0x000D;
+    static const uint16_t CMD_SET_LOCAL_NAME = 0x000F;
+    static const uint16_t CMD_SET_ADVERTISING = 0x0029;
+    static const uint16_t CMD_SET_BREDR = 0x002A;
+    static const uint16_t CMD_SET_SECURE_CONNECTIONS = 0x002D;
+
+    // MGMT 이벤트 코드
+    static const uint16_t EVT_CMD_COMPLETE = 0x0001;
+    static const uint16_t EVT_CMD_STATUS = 0x0002;
+    static const uint16_t EVT_NEW_SETTINGS = 0x0006;
+    static const uint16_t EVT_DEVICE_CONNECTED = 0x000B;
+    static const uint16_t EVT_DEVICE_DISCONNECTED = 0x000C;
+    static const uint16_t EVT_NEW_CONN_PARAM = 0x001C;
+
+    // Host-side status codes (MGMT status codes stop at 0x14)
+    static const uint8_t kStatusCancelled = 0xFD;
+    static const uint8_t kStatusSendFailed = 0xFE;
+    static const uint8_t kStatusTimeout = 0xFF;
+
+    static constexpr std::chrono::milliseconds kDefaultTimeout{2000};
+
+    struct MgmtHeader {
+        uint16_t code;          // 명령 또는 이벤트 코드
+        uint16_t controllerId;  // 컨트롤러 인덱스 (0xFFFF = 없음)
+        uint16_t dataSize;      // 파라미터 길이
+    } __attribute__((packed));
+
+    struct CommandResult {
+        uint16_t command = 0;
+        uint8_t status = 0;
+        std::vector<uint8_t> data;   // Command Complete 반환 파라미터
+
+        bool succeeded() const { return status == 0x00; }
+    };
+
+    // 연결된 기기의 LE 연결 파라미터 (EVT_NEW_CONN_PARAM)
+    struct ConnectionParameters {
+        std::string address;
+        uint8_t addressType;
+        uint16_t minInterval;
+        uint16_t maxInterval;
+        uint16_t latency;
+        uint16_t timeout;
+    };
+
+    using EventHandler = std::function<void(uint16_t controllerIndex, HciByteView data)>;
+    using SettingsHandler = std::function<void(uint32_t currentSettings)>;
+    using DeviceConnectedHandler = std::function<void(const std::string& address, uint8_t addressType)>;
+    using DeviceDisconnectedHandler = std::function<void(const std::string& address, uint8_t addressType, uint8_t reason)>;
+    using ConnectionParametersHandler = std::function<void(const ConnectionParameters& parameters)>;
+
+    explicit Mgmt(uint16_t controllerIndex = kDefaultControllerIndex);
+    ~Mgmt();
+
+    Mgmt(const Mgmt&) = delete;
+    Mgmt& operator=(const Mgmt&) = delete;
+
+    // 제어 채널 연결 및 이벤트 스레드 시작 (명령 전송 시 자동으로 호출됨)
+    bool initialize();
+    void stop();
+    bool isInitialized() const { return isRunning; }
 
     // 기본 BLE 설정 메서드들
     bool setName(std::string name, std::string shortName);
@@ -28,15 +109,56 @@ public:
     bool setLE(bool newState);
     bool setAdvertising(uint8_t newState);
 
+    // 명령 전송 - 응답(Command Complete/Status)까지 대기
+    CommandResult sendCommand(uint16_t command, const std::vector<uint8_t>& parameters,
+                              std::chrono::milliseconds timeout = kDefaultTimeout);
+
+    // 명령 전송 - 응답은 future로 전달됨
+    std::future<CommandResult> sendCommandAsync(uint16_t command, const std::vector<uint8_t>& parameters);
+
+    // 이벤트 구독
+    void subscribe(uint16_t eventCode, EventHandler handler);
+    void onNewSettings(SettingsHandler handler);
+    void onDeviceConnected(DeviceConnectedHandler handler);
+    void onDeviceDisconnected(DeviceDisconnectedHandler handler);
+    void onConnectionParameters(ConnectionParametersHandler handler);
+
+    // 마지막으로 보고된 컨트롤러 설정 (MGMT_SETTING_* 비트마스크)
+    uint32_t getCurrentSettings() const { return currentSettings; }
+
     // 유틸리티 메서드
     static std::string truncateName(const std::string& name);
     static std::string truncateShortName(const std::string& name);
 
 private:
-    bool setState(uint16_t commandCode, uint16_t controllerId, uint8_t newState);
-    
-    HciAdapter& hciAdapter;  // unique_ptr 대신 참조로 변경
+    struct PendingCommand {
+        uint16_t command;
+        std::shared_ptr<std::promise<CommandResult>> promise;
+    };
+
+    bool setState(uint16_t commandCode, uint8_t newState);
+
+    // 대기 중인 명령을 찾아 결과 전달
+    void completeCommand(uint16_t command, uint16_t controllerId, CommandResult result);
+    void processEvents();
+    void dispatchEvent(uint16_t eventCode, uint16_t controllerId, HciByteView data);
+
+    HciSocket mgmtSocket;
     uint16_t controllerIndex;
+    std::atomic<bool> isRunning;
+    std::atomic<uint32_t> currentSettings;
+    std::thread eventThread;
+
+    std::list<PendingCommand> pendingCommands;
+    std::mutex pendingMutex;
+    std::mutex writeMutex;
+    std::mutex initMutex;
+
+    std::map<uint16_t, std::vector<EventHandler>> eventHandlers;
+    std::mutex handlersMutex;
+
+    static constexpr size_t kEventBatchSize = 16;
+    static constexpr int kEventWaitMS = 100;
 };
 
-} // namespace ggk
\ No newline at end of file
+} // namespace ggk
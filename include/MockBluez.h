@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BlueZConstants.h"
+#include "DBusConnection.h"
+#include "DBusObject.h"
+#include "LatencyHistogram.h"
+
+namespace ggk {
+
+// Stand-in for bluetoothd, for end-to-end load tests on a private bus without a radio
+//
+// Exports org.bluez.GattManager1 and org.bluez.LEAdvertisingManager1 at the adapter path. When an application registers, the
+// mock walks its GetManagedObjects reply the way bluetoothd does and then plays the connected devices: ReadValue and WriteValue
+// with the options BlueZ sends, StartNotify on every characteristic that can notify, and it counts the PropertiesChanged
+// signals that carry a new Value.
+//
+// The load is a list of phases, each with its own client count, rate and read/write/write-command mix, so a run can ramp up or
+// hold a steady load. A client is one connected device and, like an ATT bearer, has at most one request outstanding: `clients`
+// is the concurrency. Write commands (write-without-response) are sent without expecting a reply, as bluetoothd does, so they
+// are counted but have no latency.
+//
+// Latencies go into HDR histograms. With a rate, a request is timed from the moment it was scheduled rather than sent, so a
+// server that falls behind shows up in the percentiles instead of silently slowing the clients down (coordinated omission).
+//
+// Works on a message bus connection (it then owns org.bluez) or on a peer-to-peer connection. Handlers, calls and timers all
+// run on the thread-default main context of the thread that calls start(). An application in the same process keeps its own
+// context (GattApplication::registerWithBlueZ() runs it while waiting for the reply, or another thread does).
+class MockBluez {
+public:
+    struct Phase {
+        std::string name;
+        size_t clients = 1;
+        double ratePerClient = 0;           // 클라이언트당 초당 요청 수, 0이면 응답 즉시 다음 요청
+        double durationSeconds = 1;
+        unsigned readPercent = 50;
+        unsigned commandPercent = 0;        // 응답 없는 쓰기; 나머지(100 - read - command)는 응답 있는 쓰기
+        size_t writeSize = 20;
+        uint16_t mtu = 247;
+    };
+
+    struct Config {
+        std::string adapterPath = BlueZConstants::ADAPTER_PATH;
+
+        // Like bluetoothd, RegisterApplication is answered only after the GetManagedObjects walk. Clearing this replies first,
+        // which hides an application that cannot answer the walk while it waits for the reply (lenient mode)
+        bool replyAfterWalk = true;
+
+        bool subscribe = true;              // 알림 가능한 특성마다 StartNotify
+
+        // Notified values start with the sender's std::chrono::steady_clock time in nanoseconds (8 bytes, little endian):
+        // record the delivery lag. CLOCK_MONOTONIC is shared by the processes of one host.
+        bool timestampedValues = false;
+        std::vector<Phase> phases;
+    };
+
+    struct OperationStats {
+        size_t completed = 0;
+        size_t failed = 0;
+        LatencyHistogram latency;           // ns, 실패한 요청 포함
+
+        void add(uint64_t latencyNs, bool ok);
+        double meanLatencyUs() const { return latency.mean() / 1000.0; }
+        double percentileUs(double percent) const { return latency.percentile(percent) / 1000.0; }
+    };
+
+    struct Report {
+        std::string phase;
+        size_t clients = 0;
+        double targetRate = 0;              // 전체 목표 req/s, 0이면 폐루프
+        double elapsedSeconds = 0;
+        OperationStats reads;
+        OperationStats writes;
+        size_t commands = 0;                // 응답 없는 쓰기
+        size_t notifications = 0;           // Value가 담긴 PropertiesChanged 수
+        LatencyHistogram notificationLag;   // ns, timestampedValues일 때만
+        size_t lateRequests = 0;            // 예정 시각에 이전 요청이 끝나지 않아 늦게 보낸 요청
+
+        double requestsPerSecond() const;
+    };
+
+    // One characteristic found by the walk
+    struct Characteristic {
+        std::string path;
+        std::string uuid;
+        bool readable = false;
+        bool writable = false;
+        bool writableWithoutResponse = false;
+        bool notifiable = false;            // "notify" 또는 "indicate"
+    };
+
+    MockBluez(DBusConnection& connection, Config config);
+    ~MockBluez();
+
+    MockBluez(const MockBluez&) = delete;
+    MockBluez& operator=(const MockBluez&) = delete;
+
+    // Owns org.bluez (on a message bus) and exports the adapter object
+    bool start();
+
+    // Stops the load and waits for outstanding calls; must run on the thread that called start()
+    void stop();
+
+    // Called on the start() thread when the last phase ends (or the walk fails)
+    void setFinishedCallback(std::function<void()> callback) { finishedCallback = std::move(callback); }
+
+    // The following may be called from any thread
+    bool isApplicationRegistered() const { return applicationRegistered.load(); }
+    bool isFinished() const { return finished.load(); }
+    size_t getAdvertisementCount() const { return advertisementCount.load(); }
+    size_t getNotificationCount() const { return notifications.load(); }
+    std::vector<Characteristic> getCharacteristics() const;
+    std::vector<Report> getReports() const;
+
+    // Parses "name=ramp,clients=8,rate=50,duration=10,read=70,command=10,size=20,mtu=247"; omitted keys keep their defaults
+    static bool parsePhase(const std::string& text, Phase& phase);
+
+    // One line per report, for the console
+    static std::string formatReport(const Report& report);
+
+    // One JSON object per report: counts, throughput and p50/p99/p999 latencies in microseconds
+    static std::string toJson(const Report& report);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Client {
+        MockBluez* pOwner = nullptr;
+        std::string devicePath;
+        GVariantPtr readParameters = makeNullGVariantPtr();
+        GVariantPtr writeParameters = makeNullGVariantPtr();
+        GVariantPtr commandParameters = makeNullGVariantPtr();
+        bool busy = false;
+        bool reading = false;
+        Clock::time_point nextSend;
+        Clock::time_point sent;             // 일정이 있으면 예정 시각
+        size_t sequence = 0;
+    };
+
+    // GattManager1 / LEAdvertisingManager1 handlers
+    void handleRegisterApplication(const DBusMethodCall& call);
+    void handleUnregisterApplication(const DBusMethodCall& call);
+    void handleRegisterAdvertisement(const DBusMethodCall& call);
+    void handleUnregisterAdvertisement(const DBusMethodCall& call);
+
+    // GetManagedObjects walk
+    void walkApplication();
+    void onManagedObjects(GVariant* pObjects, const GError* pError);
+    void subscribeNotifications();
+    void finishRegistration(bool success, const std::string& message);
+
+    // Load phases
+    void startPhase(size_t index);
+    void endPhase();
+    void finish();
+    void sendRequest(Client& client);
+    void sendCommand(Client& client, const std::string& path);
+    void onReply(Client& client, bool ok);
+    bool onTick();
+    void onPropertiesChanged(GVariant* pParameters);
+    void stopLoad();
+
+    const char* peerName() const { return applicationOwner.empty() ? nullptr : applicationOwner.c_str(); }
+
+    DBusConnection& connection;
+    Config config;
+    std::unique_ptr<DBusObject> adapter;
+    GMainContext* pContext = nullptr;
+    GCancellable* pCancellable = nullptr;
+    GDBusMethodInvocation* pPendingRegistration = nullptr;
+    GSource* pTickSource = nullptr;
+    guint signalSubscription = 0;
+    size_t inFlight = 0;                    // 응답을 기다리는 모든 호출 (stop()이 기다림)
+
+    // 등록된 애플리케이션 (한 번에 하나)
+    std::string applicationOwner;
+    std::string applicationPath;
+    std::vector<Characteristic> characteristics;
+    std::vector<size_t> readTargets;
+    std::vector<size_t> writeTargets;
+    std::vector<size_t> commandTargets;
+
+    std::vector<std::pair<std::string, std::string>> advertisements;   // (소유자, 경로)
+
+    // 현재 단계
+    size_t phaseIndex = 0;
+    bool phaseActive = false;               // 보고서 집계 중 (남은 응답을 기다리는 동안 포함)
+    bool phaseRunning = false;              // 새 요청을 보내는 중
+    bool stopRequested = false;
+    size_t outstanding = 0;                 // 응답을 기다리는 부하 요청
+    Clock::time_point phaseStart;
+    Clock::time_point phaseEnd;
+    std::vector<Client> clients;
+    std::minstd_rand random;
+    Report current;
+
+    std::function<void()> finishedCallback;
+    std::atomic<bool> applicationRegistered{false};
+    std::atomic<bool> finished{false};
+    std::atomic<size_t> advertisementCount{0};
+    std::atomic<size_t> notifications{0};
+    mutable std::mutex mutex;               // reports, characteristics
+    std::vector<Report> reports;
+};
+
+} // namespace ggk
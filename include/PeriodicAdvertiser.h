@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ExtendedAdvertiser.h"
+
+namespace ggk {
+
+// LE periodic advertising on top of extended advertising sets
+//
+// A periodic advertising train broadcasts its payload at a fixed interval to any number of synchronized observers, so the airtime
+// cost does not grow with the number of listeners. Each train owns one non-connectable, non-scannable extended advertising set
+// (which carries the SyncInfo observers need to find the train).
+//
+// Payloads are usually fed through a DataSource: like a GattCharacteristic value, every `setValue()` replaces the broadcast
+// payload. Updates are rate limited per train; values written faster than the minimum update interval are coalesced and only
+// the latest one is sent.
+class PeriodicAdvertiser {
+public:
+    static constexpr uint16_t CMD_LE_SET_PERIODIC_ADV_PARAMETERS = 0x203E;
+    static constexpr uint16_t CMD_LE_SET_PERIODIC_ADV_DATA = 0x203F;
+    static constexpr uint16_t CMD_LE_SET_PERIODIC_ADV_ENABLE = 0x2040;
+
+    static constexpr size_t kMaxFragmentLength = 252;
+    static constexpr uint16_t kPropIncludeTxPower = 0x0040;
+    static constexpr std::chrono::milliseconds kDefaultMinUpdateInterval{100};
+
+    // Periodic advertising interval in 1.25 ms units (7.5 ms - 81.91875 s)
+    struct Parameters {
+        uint16_t minInterval = 0x0050;      // 100 ms
+        uint16_t maxInterval = 0x0050;
+        bool includeTxPower = false;
+        std::chrono::milliseconds minUpdateInterval = kDefaultMinUpdateInterval;
+
+        void setIntervalMs(uint32_t minMs, uint32_t maxMs) {
+            minInterval = static_cast<uint16_t>(minMs * 4 / 5);
+            maxInterval = static_cast<uint16_t>(maxMs * 4 / 5);
+        }
+    };
+
+    // Characteristic-like value source of one periodic train; must not outlive its PeriodicAdvertiser
+    class DataSource {
+    public:
+        DataSource(PeriodicAdvertiser& owner, uint8_t handle) : owner(owner), handle(handle) {}
+
+        void setValue(const std::vector<uint8_t>& value) { owner.valueChanged(handle, value); }
+        void setValue(const uint8_t* pData, size_t size) { setValue(std::vector<uint8_t>(pData, pData + size)); }
+        std::vector<uint8_t> getValue() const { return owner.getValue(handle); }
+        uint8_t getHandle() const { return handle; }
+
+    private:
+        PeriodicAdvertiser& owner;
+        uint8_t handle;
+    };
+
+    struct Statistics {
+        uint64_t updatesSent = 0;
+        uint64_t updatesCoalesced = 0;      // 전송 전에 새 값으로 대체된 갱신
+        uint64_t failures = 0;
+    };
+
+    explicit PeriodicAdvertiser(ExtendedAdvertiser& advertiser);
+    ~PeriodicAdvertiser();
+
+    PeriodicAdvertiser(const PeriodicAdvertiser&) = delete;
+    PeriodicAdvertiser& operator=(const PeriodicAdvertiser&) = delete;
+
+    // Creates an advertising set configured for periodic advertising and returns its handle, or -1 on failure
+    // Connectable, scannable, legacy and anonymous properties of `setParameters` are cleared.
+    int createTrain(const Parameters& parameters, AdvertisingSetParameters setParameters = AdvertisingSetParameters());
+
+    // Starts / stops the periodic train together with its extended advertising set
+    bool enable(uint8_t handle);
+    bool disable(uint8_t handle);
+    bool removeTrain(uint8_t handle);
+
+    // Replaces the periodic payload immediately (bypasses rate limiting)
+    bool setData(uint8_t handle, const std::vector<uint8_t>& data);
+
+    // Returns the data source of a train, or nullptr for unknown handles
+    std::shared_ptr<DataSource> getDataSource(uint8_t handle);
+
+    bool isEnabled(uint8_t handle) const;
+    bool getStatistics(uint8_t handle, Statistics& statistics) const;
+
+    // Builds the LE Set Periodic Advertising Data commands for `data`
+    static std::vector<HciCommand> fragmentData(uint8_t handle, const uint8_t* pData, size_t size);
+
+    // Encodes LE Set Periodic Advertising Parameters
+    static std::vector<uint8_t> encodeParameters(uint8_t handle, const Parameters& parameters);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Train {
+        Parameters parameters;
+        bool enabled = false;
+        std::vector<uint8_t> value;
+        bool dirty = false;                 // value가 아직 컨트롤러에 전송되지 않음
+        Clock::time_point lastSent;
+        Statistics statistics;
+        std::shared_ptr<DataSource> source;
+    };
+
+    void valueChanged(uint8_t handle, const std::vector<uint8_t>& value);
+    std::vector<uint8_t> getValue(uint8_t handle) const;
+    bool writeData(uint8_t handle, const std::vector<uint8_t>& data);
+    bool sendEnable(bool enable, uint8_t handle);
+    void run();
+
+    ExtendedAdvertiser& advertiser;
+    HciAdapter& adapter;
+
+    std::map<uint8_t, Train> trains;
+    mutable std::mutex trainsMutex;
+    std::mutex writeMutex;                  // 데이터 쓰기(일시 정지/재개 포함)를 직렬화
+
+    bool running;
+    std::thread updateThread;
+    std::condition_variable updateCondition;
+};
+
+} // namespace ggk
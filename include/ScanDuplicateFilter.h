@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ggk {
+
+// Time-limited duplicate filter for advertising reports
+//
+// Reports are identified by a 64-bit digest of (address type, address, payload), so a beacon that changes its payload is reported
+// again immediately. A digest seen within the TTL is a duplicate; after the TTL the report passes once more and the timer restarts.
+// Digests live in a fixed open-addressing table with short probe sequences: when a probe window is full the oldest entry is
+// evicted, so memory stays bounded no matter how many advertisers are around.
+//
+// Not thread-safe; meant to be used from the HCI event thread only.
+class ScanDuplicateFilter {
+public:
+    static constexpr size_t kDefaultCapacity = 4096;
+    static constexpr std::chrono::milliseconds kDefaultTtl{1000};
+
+    explicit ScanDuplicateFilter(size_t capacity = kDefaultCapacity, std::chrono::milliseconds ttl = kDefaultTtl);
+
+    // Returns true if the report was seen within the TTL, otherwise records it and returns false
+    bool isDuplicate(uint64_t digest, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    void setTtl(std::chrono::milliseconds newTtl) { ttl = newTtl; }
+    std::chrono::milliseconds getTtl() const { return ttl; }
+    void clear();
+
+    // FNV-1a digest of the report identity; never 0 (0 marks empty slots)
+    static uint64_t digest(uint8_t addressType, const uint8_t* pAddress, const uint8_t* pData, size_t size);
+
+private:
+    static constexpr size_t kProbeLength = 8;
+
+    struct Entry {
+        uint64_t digest = 0;
+        std::chrono::steady_clock::time_point seen;
+    };
+
+    std::vector<Entry> entries;
+    size_t mask;
+    std::chrono::milliseconds ttl;
+};
+
+} // namespace ggk
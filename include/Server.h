@@ -53,7 +53,8 @@ public:
     bool isAdvertising() const { return advertising; }
     
     // 연결 관리 (옵션)
-    bool isConnected() const { return connected; }
+    bool isConnected() const { return hciAdapter && hciAdapter->getConnectionTracker().isConnected(); }
+    size_t getConnectionCount() const { return hciAdapter ? hciAdapter->getConnectionTracker().connectionCount() : 0; }
     bool disconnectClient();
     
     // 어댑터 접근
@@ -73,7 +74,6 @@ private:
     
     // 상태 플래그
     std::atomic<bool> advertising;
-    std::atomic<bool> connected;
     DBusObjectPath advertisingPath;
     
     // 상수
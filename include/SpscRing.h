@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace ggk {
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread
+//
+// Slots are preallocated, so neither side allocates or blocks. `Capacity` must be a power of two. Head and tail live on separate
+// cache lines to keep the two threads from false sharing.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: copies `value` into the next slot; returns false if the ring is full
+    bool push(const T& value) {
+        return pushWith([&value](T& slot) { slot = value; });
+    }
+
+    // Producer: lets `fill(T&)` write the next slot in place; returns false if the ring is full
+    template <typename Fill>
+    bool pushWith(Fill fill) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        fill(slots[currentTail & (Capacity - 1)]);
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: moves the oldest element into `value`; returns false if the ring is empty
+    bool pop(T& value) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = slots[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: returns the oldest element without removing it (nullptr if empty); valid until `discard()`
+    const T* front() const {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots[currentHead & (Capacity - 1)];
+    }
+
+    // Consumer: removes the element returned by `front()`
+    void discard() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Approximate when called from a thread other than the producer or consumer
+    size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    alignas(64) std::atomic<size_t> head;   // 소비자만 기록
+    alignas(64) std::atomic<size_t> tail;   // 생산자만 기록
+    alignas(64) std::array<T, Capacity> slots;
+};
+
+} // namespace ggk
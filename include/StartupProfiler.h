@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ggk {
+
+// Startup phase timing
+//
+// Times each step from process start to "ready" (D-Bus name request, HCI bring-up, object registration, RegisterApplication,
+// advertising) as a tree of named phases and renders them as one report: a table for the log and JSON for tooling. Steps that
+// run once are timed with a Scope. Steps that run once per object (introspection XML, object registration) go through an
+// Accumulator into a single entry with a call count, so a tree of 10k attributes still gives a short report.
+//
+// The clock starts at begin(), or at the first recorded phase. finish() closes the report; after that scopes only cost one
+// atomic load, so the instrumentation can stay in code that also runs after startup. Thread-safe; nesting is tracked per thread.
+class StartupProfiler {
+public:
+    struct Phase {
+        std::string component;          // "server", "gatt", "dbus", "hci"
+        std::string name;
+        uint64_t startNs = 0;           // begin() 기준 (누적 항목은 첫 호출)
+        uint64_t durationNs = 0;        // 누적 항목은 합계
+        size_t count = 1;               // 누적 항목의 호출 횟수
+        unsigned depth = 0;
+        bool ok = true;
+    };
+
+    // Times the enclosing block as one phase
+    class Scope {
+    public:
+        Scope(const char* pComponent, const char* pName);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        void fail() { ok = false; }
+
+    private:
+        const char* pComponent;
+        const char* pName;
+        uint64_t startNs = 0;
+        unsigned depth = 0;
+        bool active = false;
+        bool ok = true;
+    };
+
+    // Adds the time of the enclosing block to one entry per (component, name)
+    class Accumulator {
+    public:
+        Accumulator(const char* pComponent, const char* pName);
+        ~Accumulator();
+
+        Accumulator(const Accumulator&) = delete;
+        Accumulator& operator=(const Accumulator&) = delete;
+
+    private:
+        const char* pComponent;
+        const char* pName;
+        uint64_t startNs = 0;
+        unsigned depth = 0;
+        bool active = false;
+    };
+
+    // Starts a new report: clears the recorded phases and restarts the clock
+    static void begin();
+
+    // Records a zero-length milestone (e.g. "advertising")
+    static void mark(const char* pComponent, const char* pName);
+
+    // Stops recording; the report stays available
+    static void finish();
+
+    static bool isRecording();
+
+    // Phases ordered by start time, and the time from begin() to the end of the last one
+    static std::vector<Phase> getPhases();
+    static uint64_t getElapsedNs();
+
+    // Indented table, one phase per line
+    static std::string formatReport();
+
+    // {"total_ms": ..., "finished": ..., "phases": [{"component", "name", "start_ms", "duration_ms", "count", "depth", "ok"}]}
+    static std::string toJson();
+    static bool writeJson(const std::string& path);
+};
+
+} // namespace ggk
@@ -0,0 +1,266 @@
+#include "AclFlowControl.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace ggk {
+
+AclFlowControl::AclFlowControl()
+    : packetLength(kDefaultPacketLength)
+    , totalPackets(kDefaultTotalPackets)
+    , fixedBudget(0)
+    , chargeExpiry(kDefaultChargeExpiry)
+    , untrackedCompletions(0) {
+}
+
+void AclFlowControl::attach(HciEventDecoder& decoder, ConnectionTracker& tracker) {
+    decoder.onNumberOfCompletedPackets([this](const HciNumberOfCompletedPacketsView& view) {
+        for (size_t i = 0; i < view.count(); ++i) {
+            packetsCompleted(view.connectionHandle(i), view.completedPackets(i));
+        }
+    });
+
+    tracker.addListener([this](ConnectionTracker::LinkEvent event, const LinkState& state) {
+        if (event == ConnectionTracker::LinkEvent::Connected) {
+            addConnection(state.handle);
+        } else if (event == ConnectionTracker::LinkEvent::Disconnected) {
+            removeConnection(state.handle);
+        }
+    });
+}
+
+void AclFlowControl::setBufferSize(uint16_t newPacketLength, uint16_t newTotalPackets) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        packetLength = std::max<uint16_t>(newPacketLength, kDefaultPacketLength);
+        totalPackets = std::max<uint16_t>(newTotalPackets, 1);
+        rebalanceLocked();
+    }
+    creditCondition.notify_all();
+
+    Logger::info("LE ACL buffers: " + std::to_string(newTotalPackets) + " x " + std::to_string(newPacketLength) + " bytes");
+}
+
+uint16_t AclFlowControl::getPacketLength() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return packetLength;
+}
+
+uint16_t AclFlowControl::getTotalPackets() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalPackets;
+}
+
+void AclFlowControl::setConnectionBudget(size_t packets) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        fixedBudget = packets;
+        rebalanceLocked();
+    }
+    creditCondition.notify_all();
+}
+
+void AclFlowControl::setChargeExpiry(std::chrono::milliseconds expiry) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        chargeExpiry = expiry;
+    }
+    creditCondition.notify_all();
+}
+
+// 연결 수에 따라 버퍼를 균등 분배 (최소 1)
+size_t AclFlowControl::budgetLocked() const {
+    if (fixedBudget != 0) {
+        return fixedBudget;
+    }
+    return std::max<size_t>(totalPackets / std::max<size_t>(connections.size(), 1), 1);
+}
+
+void AclFlowControl::rebalanceLocked() {
+    size_t budget = budgetLocked();
+    for (auto& entry : connections) {
+        entry.second.credits.budget = budget;
+    }
+}
+
+void AclFlowControl::chargeLocked(Connection& connection, size_t count, Clock::time_point now) {
+    connection.credits.outstanding += count;
+    connection.credits.queued += count;
+    connection.charges.push_back(Charge{now, count});
+}
+
+// Drops charges older than the expiry and returns when the next remaining charge expires
+AclFlowControl::Clock::time_point AclFlowControl::expireChargesLocked(Clock::time_point now) {
+    Clock::time_point next = Clock::time_point::max();
+    for (auto& entry : connections) {
+        Connection& connection = entry.second;
+        if (connection.charges.empty()) {
+            continue;
+        }
+
+        if (now - connection.charges.front().time < chargeExpiry) {
+            next = std::min(next, connection.charges.front().time + chargeExpiry);
+            continue;
+        }
+
+        // 완료되지 않는 예약: 이 연결은 알림을 받지 않는 것으로 봄
+        GGK_LOG_DEBUG(Hci, "ACL charges on connection " << entry.first << " expired (" << connection.credits.outstanding
+                      << " packets)");
+        connection.credits.expired += connection.credits.outstanding;
+        connection.credits.outstanding = 0;
+        connection.credits.receiving = false;
+        connection.charges.clear();
+    }
+    return next;
+}
+
+size_t AclFlowControl::packetsForNotification(size_t bytes) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (bytes + kNotificationOverhead + packetLength - 1) / packetLength;
+}
+
+void AclFlowControl::packetsQueued(uint16_t handle, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = connections.find(handle);
+    if (it != connections.end()) {
+        chargeLocked(it->second, count, Clock::now());
+    }
+}
+
+void AclFlowControl::packetsCompleted(uint16_t handle, size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = connections.find(handle);
+        if (it == connections.end()) {
+            untrackedCompletions += count;
+            return;
+        }
+
+        Connection& connection = it->second;
+        size_t released = std::min(connection.credits.outstanding, count);
+        connection.credits.outstanding -= released;
+        connection.credits.completed += released;
+        untrackedCompletions += count - released;
+
+        for (size_t remaining = released; remaining != 0;) {
+            Charge& charge = connection.charges.front();
+            size_t taken = std::min(charge.packets, remaining);
+            charge.packets -= taken;
+            remaining -= taken;
+            if (charge.packets == 0) {
+                connection.charges.pop_front();
+            }
+        }
+
+        // 컨트롤러가 이 연결로 다시 전송함
+        if (count != 0) {
+            connection.credits.receiving = true;
+        }
+    }
+    creditCondition.notify_all();
+}
+
+bool AclFlowControl::hasCredit(uint16_t handle) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = connections.find(handle);
+    return it != connections.end() && it->second.credits.hasCredit();
+}
+
+bool AclFlowControl::waitForCredit(uint16_t handle, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return creditCondition.wait_for(lock, timeout, [this, handle] {
+        auto it = connections.find(handle);
+        return it == connections.end() || it->second.credits.hasCredit();
+    }) && connections.count(handle) != 0;
+}
+
+bool AclFlowControl::allHaveCreditLocked() const {
+    for (const auto& entry : connections) {
+        if (entry.second.credits.receiving && !entry.second.credits.hasCredit()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 예약이 만료되면 알림 없이도 크레딧이 생기므로 다음 만료 시각에도 깨어남
+bool AclFlowControl::waitForAllCreditLocked(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout) {
+    Clock::time_point deadline = Clock::now() + timeout;
+    for (;;) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point nextExpiry = expireChargesLocked(now);
+        if (allHaveCreditLocked()) {
+            return true;
+        }
+        if (now >= deadline) {
+            return false;
+        }
+        creditCondition.wait_until(lock, std::min(deadline, nextExpiry));
+    }
+}
+
+bool AclFlowControl::waitForAllCredit(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return waitForAllCreditLocked(lock, timeout);
+}
+
+bool AclFlowControl::getCredits(uint16_t handle, ConnectionCredits& credits) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = connections.find(handle);
+    if (it == connections.end()) {
+        return false;
+    }
+
+    credits = it->second.credits;
+    return true;
+}
+
+uint64_t AclFlowControl::getUntrackedCompletions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return untrackedCompletions;
+}
+
+GattCreditCallback AclFlowControl::creditCallback() {
+    return [this](size_t bytes, std::chrono::milliseconds timeout) {
+        size_t packets = packetsForNotification(bytes);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!waitForAllCreditLocked(lock, timeout)) {
+            return false;
+        }
+
+        Clock::time_point now = Clock::now();
+        for (auto& entry : connections) {
+            if (entry.second.credits.receiving) {
+                chargeLocked(entry.second, packets, now);
+            }
+        }
+        return true;
+    };
+}
+
+void AclFlowControl::addConnection(uint16_t handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    connections[handle] = Connection();
+    rebalanceLocked();
+}
+
+// 연결이 끊기면 컨트롤러가 해당 연결의 패킷을 모두 버림
+void AclFlowControl::removeConnection(uint16_t handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        connections.erase(handle);
+        rebalanceLocked();
+    }
+    creditCondition.notify_all();
+}
+
+void AclFlowControl::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        connections.clear();
+        untrackedCompletions = 0;
+    }
+    creditCondition.notify_all();
+}
+
+} // namespace ggk
@@ -0,0 +1,189 @@
+#include "AdvertisingPayload.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace ggk {
+
+namespace {
+
+// 블루투스 기본 UUID의 하위 96비트 (toBlueZFormat 기준 8번째 문자부터)
+const char* const kBaseUuidSuffix = "00001000800000805f9b34fb";
+
+class PayloadWriter {
+public:
+    PayloadWriter(AdvertisingPayload& payload, size_t limit)
+        : payload(payload), limit(std::min(limit, AdvertisingPayload::kCapacity)) {
+        payload.size = 0;
+    }
+
+    size_t remaining() const { return limit - payload.size; }
+
+    // 길이/타입 헤더 2바이트를 포함해 들어갈 때만 기록
+    bool append(uint8_t type, const uint8_t* pData, size_t size) {
+        if (size + 2 > remaining()) {
+            return false;
+        }
+
+        payload.data[payload.size++] = static_cast<uint8_t>(size + 1);
+        payload.data[payload.size++] = type;
+        std::copy(pData, pData + size, payload.data.begin() + payload.size);
+        payload.size = static_cast<uint8_t>(payload.size + size);
+        return true;
+    }
+
+private:
+    AdvertisingPayload& payload;
+    size_t limit;
+};
+
+} // namespace
+
+AdvertisingPayloadBuilder::AdvertisingPayloadBuilder()
+    : flags(kDefaultFlags)
+    , hasTxPower(false)
+    , txPower(0) {
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::setFlags(uint8_t newFlags) {
+    flags = newFlags;
+    return *this;
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::setLocalName(const std::string& name) {
+    localName = name;
+    return *this;
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::setTxPower(int8_t newTxPower) {
+    hasTxPower = true;
+    txPower = newTxPower;
+    return *this;
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::addServiceUuid(const GattUuid& uuid) {
+    serviceUuids.push_back(uuid);
+    return *this;
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::addServiceData(uint16_t uuid, const std::vector<uint8_t>& data) {
+    dataFields.push_back({AD_SERVICE_DATA_UUID16, uuid, data});
+    return *this;
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::addManufacturerData(uint16_t companyId, const std::vector<uint8_t>& data) {
+    dataFields.push_back({AD_MANUFACTURER_DATA, companyId, data});
+    return *this;
+}
+
+AdvertisingPayloadBuilder& AdvertisingPayloadBuilder::clearData() {
+    dataFields.clear();
+    return *this;
+}
+
+size_t AdvertisingPayloadBuilder::encodeUuid(const GattUuid& uuid, uint8_t* pOut) {
+    std::string hex = uuid.toBlueZFormat();
+    if (hex.length() != 32) {
+        return 0;
+    }
+
+    if (hex.compare(8, std::string::npos, kBaseUuidSuffix) == 0) {
+        uint32_t value = static_cast<uint32_t>(std::strtoul(hex.substr(0, 8).c_str(), nullptr, 16));
+        size_t width = value <= 0xFFFF ? 2 : 4;
+        for (size_t i = 0; i < width; ++i) {
+            pOut[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+        return width;
+    }
+
+    // 128비트 UUID는 리틀 엔디안 (문자열의 역순)
+    for (size_t i = 0; i < 16; ++i) {
+        pOut[15 - i] = static_cast<uint8_t>(std::strtoul(hex.substr(i * 2, 2).c_str(), nullptr, 16));
+    }
+    return 16;
+}
+
+bool AdvertisingPayloadBuilder::build(AdvertisingPayload& payload, size_t limit) const {
+    PayloadWriter writer(payload, limit);
+    uint8_t buffer[AdvertisingPayload::kCapacity];
+
+    // 1. 필수 필드: Flags, TX power, 서비스/제조사 데이터
+    if (flags != 0 && !writer.append(AD_FLAGS, &flags, 1)) {
+        return false;
+    }
+
+    if (hasTxPower) {
+        uint8_t value = static_cast<uint8_t>(txPower);
+        if (!writer.append(AD_TX_POWER, &value, 1)) {
+            return false;
+        }
+    }
+
+    for (const auto& field : dataFields) {
+        if (field.data.size() + 2 > sizeof(buffer)) {
+            Logger::error("Advertising data field too large: " + std::to_string(field.data.size()) + " bytes");
+            return false;
+        }
+
+        buffer[0] = static_cast<uint8_t>(field.id & 0xFF);
+        buffer[1] = static_cast<uint8_t>(field.id >> 8);
+        std::copy(field.data.begin(), field.data.end(), buffer + 2);
+        if (!writer.append(field.type, buffer, field.data.size() + 2)) {
+            Logger::warn("Advertising payload exceeds " + std::to_string(limit) + " bytes");
+            return false;
+        }
+    }
+
+    // 2. 서비스 UUID: 폭별로 하나의 목록, 들어가는 만큼만 (incomplete 목록)
+    static const struct {
+        size_t width;
+        uint8_t completeType;
+        uint8_t incompleteType;
+    } kUuidLists[] = {
+        {2, AD_COMPLETE_UUID16, AD_INCOMPLETE_UUID16},
+        {4, AD_COMPLETE_UUID32, AD_INCOMPLETE_UUID32},
+        {16, AD_COMPLETE_UUID128, AD_INCOMPLETE_UUID128},
+    };
+
+    for (const auto& list : kUuidLists) {
+        size_t total = 0;
+        size_t used = 0;
+        uint8_t encoded[16];
+
+        for (const auto& uuid : serviceUuids) {
+            if (encodeUuid(uuid, encoded) != list.width) {
+                continue;
+            }
+            ++total;
+            if (used + list.width + 2 <= writer.remaining()) {
+                std::copy(encoded, encoded + list.width, buffer + used);
+                used += list.width;
+            }
+        }
+
+        if (used > 0) {
+            writer.append(used / list.width == total ? list.completeType : list.incompleteType, buffer, used);
+        }
+    }
+
+    // 3. 이름은 남은 공간에 맞춰 축약 (UTF-8 문자 중간에서 자르지 않음)
+    if (!localName.empty() && writer.remaining() > 2) {
+        size_t length = localName.size();
+        uint8_t type = AD_COMPLETE_NAME;
+        if (length + 2 > writer.remaining()) {
+            length = writer.remaining() - 2;
+            while (length > 0 && (static_cast<uint8_t>(localName[length]) & 0xC0) == 0x80) {
+                --length;
+            }
+            type = AD_SHORTENED_NAME;
+        }
+
+        if (length > 0) {
+            writer.append(type, reinterpret_cast<const uint8_t*>(localName.data()), length);
+        }
+    }
+
+    return true;
+}
+
+} // namespace ggk
@@ -0,0 +1,177 @@
+#include "AdvertisingRotator.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace ggk {
+
+// 확장 페이로드는 항상 한 조각(complete)으로 전송됨
+static_assert(AdvertisingPayload::kCapacity <= ExtendedAdvertiser::kMaxFragmentLength,
+              "an extended advertising payload must fit in one fragment");
+
+AdvertisingRotator::AdvertisingRotator(HciAdapter& adapter)
+    : adapter(adapter)
+    , extended(false)
+    , setHandle(0)
+    , currentIndex(-1)
+    , commandState(std::make_shared<CommandState>())
+    , rotationCount(0)
+    , skippedCount(0)
+    , running(false) {
+}
+
+AdvertisingRotator::~AdvertisingRotator() {
+    stop();
+}
+
+void AdvertisingRotator::useExtendedSet(uint8_t handle) {
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    extended = true;
+    setHandle = handle;
+}
+
+void AdvertisingRotator::useLegacy() {
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    for (const auto& payload : payloads) {
+        if (payload.size > AdvertisingPayloadBuilder::kLegacyLimit) {
+            Logger::warn("Advertising payloads larger than 31 bytes will be truncated for legacy advertising");
+            break;
+        }
+    }
+    extended = false;
+}
+
+size_t AdvertisingRotator::maxPayloadSize() const {
+    return extended ? AdvertisingPayload::kCapacity : AdvertisingPayloadBuilder::kLegacyLimit;
+}
+
+int AdvertisingRotator::addPayload(const AdvertisingPayload& payload) {
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    if (payload.size > maxPayloadSize()) {
+        Logger::error("Advertising payload of " + std::to_string(payload.size) + " bytes exceeds " +
+                      std::to_string(maxPayloadSize()) + " bytes");
+        return -1;
+    }
+
+    payloads.push_back(payload);
+    return static_cast<int>(payloads.size() - 1);
+}
+
+bool AdvertisingRotator::updatePayload(size_t index, const AdvertisingPayload& payload) {
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    if (index >= payloads.size() || payload.size > maxPayloadSize()) {
+        return false;
+    }
+
+    payloads[index] = payload;
+    return true;
+}
+
+void AdvertisingRotator::clearPayloads() {
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    payloads.clear();
+    currentIndex = -1;
+}
+
+size_t AdvertisingRotator::getPayloadCount() const {
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    return payloads.size();
+}
+
+std::vector<uint8_t> AdvertisingRotator::encodeCommand(const AdvertisingPayload& payload, bool extended, uint8_t handle) {
+    if (extended) {
+        return std::move(ExtendedAdvertiser::fragmentData(ExtendedAdvertiser::CMD_LE_SET_EXT_ADV_DATA, handle,
+                                                          payload.data.data(), payload.size).front().parameters);
+    }
+
+    std::vector<uint8_t> command;
+    size_t size = std::min<size_t>(payload.size, AdvertisingPayloadBuilder::kLegacyLimit);
+    command.assign(1 + AdvertisingPayloadBuilder::kLegacyLimit, 0);
+    command[0] = static_cast<uint8_t>(size);
+    std::copy(payload.data.begin(), payload.data.begin() + size, command.begin() + 1);
+    return command;
+}
+
+bool AdvertisingRotator::rotate() {
+    // 이전 명령이 아직 응답을 받지 못했으면 이번 회전은 건너뜀
+    if (commandState->pending.exchange(true)) {
+        ++skippedCount;
+        return false;
+    }
+
+    uint16_t opcode;
+    std::vector<uint8_t> command;
+    {
+        std::lock_guard<std::mutex> lock(payloadsMutex);
+        if (payloads.empty()) {
+            commandState->pending = false;
+            return false;
+        }
+
+        int next = (currentIndex.load() + 1) % static_cast<int>(payloads.size());
+        currentIndex = next;
+        opcode = extended ? ExtendedAdvertiser::CMD_LE_SET_EXT_ADV_DATA : HciAdapter::CMD_SET_ADVERTISING_DATA;
+        command = encodeCommand(payloads[next], extended, setHandle);
+    }
+
+    ++rotationCount;
+    adapter.sendCommandAsync(opcode, std::move(command), [state = commandState](const HciCommandResult& result) {
+        if (!result.succeeded()) {
+            ++state->failures;
+            GGK_LOG_DEBUG(Hci, "Set Advertising Data failed with status " << static_cast<int>(result.status));
+        }
+        state->pending = false;
+    });
+
+    return true;
+}
+
+bool AdvertisingRotator::start(std::chrono::milliseconds period) {
+    if (period < kMinimumPeriod) {
+        Logger::error("Advertising rotation period must be at least " + std::to_string(kMinimumPeriod.count()) + " ms");
+        return false;
+    }
+
+    if (running.exchange(true)) {
+        return true;
+    }
+
+    rotationThread = std::thread(&AdvertisingRotator::run, this, period);
+    return true;
+}
+
+void AdvertisingRotator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    if (rotationThread.joinable()) {
+        rotationThread.join();
+    }
+}
+
+void AdvertisingRotator::run(std::chrono::milliseconds period) {
+    Logger::debug("Started advertising rotation every " + std::to_string(period.count()) + " ms");
+
+    // 절대 시각 기준으로 대기해 주기가 밀리지 않도록 함
+    Clock::time_point deadline = Clock::now();
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (running) {
+        lock.unlock();
+        rotate();
+        lock.lock();
+
+        deadline += period;
+        if (deadline < Clock::now()) {
+            deadline = Clock::now() + period;
+        }
+
+        wakeCondition.wait_until(lock, deadline, [this] { return !running; });
+    }
+
+    Logger::debug("Stopped advertising rotation");
+}
+
+} // namespace ggk
@@ -0,0 +1,441 @@
+#include "AsyncLogSink.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace ggk {
+
+namespace {
+
+std::atomic<uint64_t> g_nextSinkId(1);
+
+const char* const kLevelLabels[] = {"TRACE", "DEBUG", "INFO", "STATUS", "WARN", "ERROR", "FATAL", "ALWAYS", "OFF"};
+
+// syslog 우선순위 (journald PRIORITY)
+const int kJournalPriorities[] = {7, 7, 6, 5, 4, 3, 2, 5, 7};
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+constexpr std::chrono::milliseconds AsyncLogSink::kPollInterval;
+
+AsyncLogSink::AsyncLogSink()
+    : sinkId(g_nextSinkId.fetch_add(1))
+    , target(Target::Stdout)
+    , fd(STDOUT_FILENO)
+    , overflowPolicy(OverflowPolicy::Drop)
+    , installed(false)
+    , written(0)
+    , truncated(0)
+    , retiredSubmitted(0)
+    , retiredDropped(0)
+    , running(false)
+    , wakeRequested(false) {
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    if (installed) {
+        Logger::registerTraceReceiver(nullptr);
+        Logger::registerDebugReceiver(nullptr);
+        Logger::registerInfoReceiver(nullptr);
+        Logger::registerStatusReceiver(nullptr);
+        Logger::registerWarnReceiver(nullptr);
+        Logger::registerErrorReceiver(nullptr);
+        Logger::registerFatalReceiver(nullptr);
+        Logger::registerAlwaysReceiver(nullptr);
+    }
+
+    stop();
+    closeOutput();
+}
+
+void AsyncLogSink::closeOutput() {
+    if (fd >= 0 && fd != STDOUT_FILENO) {
+        close(fd);
+    }
+    fd = -1;
+}
+
+bool AsyncLogSink::openStdout() {
+    if (running) {
+        return false;
+    }
+
+    closeOutput();
+    target = Target::Stdout;
+    fd = STDOUT_FILENO;
+    return true;
+}
+
+bool AsyncLogSink::openFile(const std::string& path) {
+    if (running) {
+        return false;
+    }
+
+    closeOutput();
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        // 이 싱크가 로그 출력이므로 stderr로 보고
+        fprintf(stderr, "Failed to open log file %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    target = Target::File;
+    return true;
+}
+
+bool AsyncLogSink::openJournal(const std::string& identifier) {
+    if (running) {
+        return false;
+    }
+
+    closeOutput();
+    fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to create journal socket: %s\n", strerror(errno));
+        return false;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, kJournalSocketPath, sizeof(address.sun_path) - 1);
+
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0) {
+        fprintf(stderr, "Failed to connect to %s: %s\n", kJournalSocketPath, strerror(errno));
+        closeOutput();
+        return false;
+    }
+
+    target = Target::Journal;
+    journalIdentifier = identifier;
+    return true;
+}
+
+bool AsyncLogSink::start() {
+    if (running) {
+        return true;
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+    running = true;
+    writerThread = std::thread(&AsyncLogSink::run, this);
+    return true;
+}
+
+void AsyncLogSink::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+}
+
+void AsyncLogSink::install() {
+    Logger::registerTraceReceiver([this](const char* pText) { submit(LogLevel::Trace, pText); });
+    Logger::registerDebugReceiver([this](const char* pText) { submit(LogLevel::Debug, pText); });
+    Logger::registerInfoReceiver([this](const char* pText) { submit(LogLevel::Info, pText); });
+    Logger::registerStatusReceiver([this](const char* pText) { submit(LogLevel::Status, pText); });
+    Logger::registerWarnReceiver([this](const char* pText) { submit(LogLevel::Warn, pText); });
+    Logger::registerErrorReceiver([this](const char* pText) { submit(LogLevel::Error, pText); });
+    Logger::registerFatalReceiver([this](const char* pText) { submit(LogLevel::Fatal, pText); });
+    Logger::registerAlwaysReceiver([this](const char* pText) { submit(LogLevel::Always, pText); });
+    installed = true;
+}
+
+// 스레드마다 한 번만 등록 (스레드 id 조회도 이때 한 번)
+AsyncLogSink::Producer* AsyncLogSink::producerForThisThread() {
+    struct ThreadSlot {
+        uint64_t sinkId = 0;
+        std::shared_ptr<Producer> producer;
+
+        ~ThreadSlot() {
+            if (producer) {
+                producer->retired = true;
+            }
+        }
+    };
+    thread_local ThreadSlot slot;
+
+    if (slot.sinkId != sinkId || !slot.producer) {
+        if (slot.producer) {
+            slot.producer->retired = true;
+        }
+
+        auto producer = std::make_shared<Producer>();
+        producer->threadId = static_cast<uint32_t>(syscall(SYS_gettid));
+        {
+            std::lock_guard<std::mutex> lock(producersMutex);
+            producers.push_back(producer);
+        }
+
+        slot.sinkId = sinkId;
+        slot.producer = std::move(producer);
+    }
+
+    return slot.producer.get();
+}
+
+void AsyncLogSink::submit(LogLevel level, const char* pText) {
+    Producer* pProducer = producerForThisThread();
+
+    size_t length = strlen(pText);
+    if (length > kMaxMessageLength) {
+        length = kMaxMessageLength;
+        truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t timestampUs = nowMicros();
+    auto fill = [&](Record& record) {
+        record.timestampUs = timestampUs;
+        record.threadId = pProducer->threadId;
+        record.level = level;
+        record.notice = false;
+        record.length = static_cast<uint16_t>(length);
+        memcpy(record.text, pText, length);
+    };
+
+    while (!pProducer->ring.pushWith(fill)) {
+        if (overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::Drop || !running) {
+            pProducer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Block: 기록 스레드를 깨우고 공간이 생길 때까지 대기
+        requestWake();
+        std::this_thread::yield();
+    }
+
+    pProducer->submitted.fetch_add(1, std::memory_order_relaxed);
+
+    // 링이 절반 찼을 때만 기록 스레드를 깨움 (그 외에는 주기적 확인에 맡김)
+    if (pProducer->ring.size() == kRingCapacity / 2) {
+        requestWake();
+    }
+}
+
+void AsyncLogSink::requestWake() {
+    if (!wakeRequested.exchange(true)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+}
+
+uint64_t AsyncLogSink::submittedCount() const {
+    std::lock_guard<std::mutex> lock(producersMutex);
+    uint64_t total = retiredSubmitted.load();
+    for (const auto& producer : producers) {
+        total += producer->submitted.load();
+    }
+    return total;
+}
+
+bool AsyncLogSink::flush(std::chrono::milliseconds timeout) {
+    uint64_t expected = submittedCount();
+    requestWake();
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    return flushCondition.wait_for(lock, timeout, [this, expected] { return written.load() >= expected; });
+}
+
+AsyncLogSink::Statistics AsyncLogSink::getStatistics() const {
+    Statistics statistics;
+    statistics.written = written.load();
+    statistics.truncated = truncated.load();
+    statistics.dropped = retiredDropped.load();
+
+    std::lock_guard<std::mutex> lock(producersMutex);
+    for (const auto& producer : producers) {
+        statistics.dropped += producer->dropped.load();
+    }
+    statistics.producers = producers.size();
+    return statistics;
+}
+
+std::string AsyncLogSink::formatLine(uint64_t timestampUs, LogLevel level, uint32_t threadId, const char* pText,
+                                     size_t length) {
+    time_t seconds = static_cast<time_t>(timestampUs / 1000000);
+    struct tm local;
+    localtime_r(&seconds, &local);
+
+    char prefix[64];
+    size_t used = strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &local);
+    size_t levelIndex = std::min<size_t>(static_cast<size_t>(level), sizeof(kLevelLabels) / sizeof(kLevelLabels[0]) - 1);
+    snprintf(prefix + used, sizeof(prefix) - used, ".%06u %-6s [%u] ", static_cast<unsigned>(timestampUs % 1000000),
+             kLevelLabels[levelIndex], threadId);
+
+    std::string line(prefix);
+    line.append(pText, length);
+    line.push_back('\n');
+    return line;
+}
+
+// 모든 링에서 레코드를 모음 (링마다 최대 용량만큼 - 한 스레드가 독점하지 않도록)
+size_t AsyncLogSink::collect(std::vector<Record>& batch) {
+    std::vector<std::shared_ptr<Producer>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(producersMutex);
+        snapshot = producers;
+    }
+
+    batch.clear();
+    uint64_t newDrops = 0;
+
+    for (const auto& producer : snapshot) {
+        for (size_t i = 0; i < kRingCapacity; ++i) {
+            const Record* pRecord = producer->ring.front();
+            if (pRecord == nullptr) {
+                break;
+            }
+            batch.push_back(*pRecord);
+            producer->ring.discard();
+        }
+
+        uint64_t dropped = producer->dropped.load(std::memory_order_relaxed);
+        newDrops += dropped - producer->reportedDrops;
+        producer->reportedDrops = dropped;
+    }
+
+    // 종료된 스레드의 빈 링 정리
+    {
+        std::lock_guard<std::mutex> lock(producersMutex);
+        producers.erase(std::remove_if(producers.begin(), producers.end(), [this](const std::shared_ptr<Producer>& producer) {
+            if (!producer->retired || !producer->ring.empty()) {
+                return false;
+            }
+            retiredSubmitted += producer->submitted.load();
+            retiredDropped += producer->dropped.load();
+            return true;
+        }), producers.end());
+    }
+
+    std::stable_sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) {
+        return a.timestampUs < b.timestampUs;
+    });
+
+    if (newDrops > 0) {
+        Record notice;
+        notice.timestampUs = nowMicros();
+        notice.threadId = 0;
+        notice.level = LogLevel::Warn;
+        int length = snprintf(notice.text, sizeof(notice.text), "%llu log messages dropped (ring full)",
+                              static_cast<unsigned long long>(newDrops));
+        notice.length = static_cast<uint16_t>(std::max(length, 0));
+        notice.notice = true;
+        batch.push_back(notice);
+    }
+
+    return batch.size();
+}
+
+void AsyncLogSink::writeText(const std::string& text) {
+    size_t offset = 0;
+    while (offset < text.size()) {
+        ssize_t result = write(fd, text.data() + offset, text.size() - offset);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        offset += static_cast<size_t>(result);
+    }
+}
+
+// journald native protocol: KEY=value 줄, MESSAGE는 길이 접두 형식 (줄바꿈 포함 가능)
+void AsyncLogSink::writeJournal(const Record& record) {
+    size_t levelIndex = std::min<size_t>(static_cast<size_t>(record.level),
+                                         sizeof(kJournalPriorities) / sizeof(kJournalPriorities[0]) - 1);
+    std::string header = "PRIORITY=" + std::to_string(kJournalPriorities[levelIndex]) + "\n" +
+                         "SYSLOG_IDENTIFIER=" + journalIdentifier + "\n" +
+                         "TID=" + std::to_string(record.threadId) + "\n" +
+                         "MESSAGE\n";
+
+    uint64_t length = record.length;
+    uint8_t lengthLe[8];
+    for (int i = 0; i < 8; ++i) {
+        lengthLe[i] = static_cast<uint8_t>(length >> (8 * i));
+    }
+
+    struct iovec vectors[4];
+    vectors[0].iov_base = const_cast<char*>(header.data());
+    vectors[0].iov_len = header.size();
+    vectors[1].iov_base = lengthLe;
+    vectors[1].iov_len = sizeof(lengthLe);
+    vectors[2].iov_base = const_cast<char*>(record.text);
+    vectors[2].iov_len = record.length;
+    vectors[3].iov_base = const_cast<char*>("\n");
+    vectors[3].iov_len = 1;
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = vectors;
+    message.msg_iovlen = 4;
+    sendmsg(fd, &message, MSG_NOSIGNAL);
+}
+
+void AsyncLogSink::writeBatch(const std::vector<Record>& batch) {
+    if (target == Target::Journal) {
+        for (const Record& record : batch) {
+            writeJournal(record);
+        }
+    } else {
+        std::string text;
+        text.reserve(batch.size() * 96);
+        for (const Record& record : batch) {
+            text += formatLine(record.timestampUs, record.level, record.threadId, record.text, record.length);
+        }
+        writeText(text);
+    }
+
+    uint64_t records = static_cast<uint64_t>(std::count_if(batch.begin(), batch.end(), [](const Record& record) {
+        return !record.notice;
+    }));
+    written.fetch_add(records);
+}
+
+void AsyncLogSink::run() {
+    std::vector<Record> batch;
+    batch.reserve(kRingCapacity);
+
+    while (true) {
+        size_t count = collect(batch);
+        if (count > 0) {
+            writeBatch(batch);
+            // flush()가 조건 확인과 대기 사이에 알림을 놓치지 않도록 잠금을 거침
+            { std::lock_guard<std::mutex> lock(wakeMutex); }
+            flushCondition.notify_all();
+            continue;
+        }
+
+        if (!running) {
+            break;
+        }
+
+        // 생산자는 링이 절반 찼을 때만 깨우므로 주기적으로도 확인
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, kPollInterval, [this] { return !running || wakeRequested.load(); });
+        wakeRequested = false;
+    }
+
+    flushCondition.notify_all();
+}
+
+} // namespace ggk
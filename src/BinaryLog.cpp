@@ -0,0 +1,374 @@
+#include "BinaryLog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Bounds of the GGK_BLOG call-site descriptors, provided by the linker for the `ggk_blog_formats` section (weak: null when no
+// call site is linked)
+extern "C" {
+extern const ggk::BinaryLog::Format __start_ggk_blog_formats[] __attribute__((weak));
+extern const ggk::BinaryLog::Format __stop_ggk_blog_formats[] __attribute__((weak));
+}
+
+namespace ggk {
+
+constexpr char BinaryLog::kMagic[8];
+
+std::atomic<bool> BinaryLog::active(false);
+std::mutex BinaryLog::writeMutex;
+
+namespace {
+
+// Writer state, guarded by BinaryLog::writeMutex
+struct Writer {
+    uint8_t* pBase = nullptr;
+    size_t fileSize = 0;
+    size_t dataOffset = 0;
+    size_t blockCount = 0;
+    size_t block = 0;                   // 현재 블록
+    size_t offset = 0;                  // 현재 블록 안의 쓰기 위치
+    uint64_t sequence = 0;
+    uint8_t* pRecord = nullptr;         // beginRecord()와 endRecord() 사이의 레코드
+    BinaryLog::Statistics statistics;
+};
+
+Writer g_writer;
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+uint32_t currentThreadId() {
+    thread_local uint32_t threadId = static_cast<uint32_t>(syscall(SYS_gettid));
+    return threadId;
+}
+
+uint16_t clampLength(size_t length) {
+    return static_cast<uint16_t>(std::min<size_t>(length, UINT16_MAX));
+}
+
+// Starts the next block of the ring, erasing what it held
+void advanceBlock() {
+    g_writer.block = (g_writer.block + 1) % g_writer.blockCount;
+    uint8_t* pBlock = g_writer.pBase + g_writer.dataOffset + g_writer.block * BinaryLog::kBlockSize;
+
+    memset(pBlock, 0, BinaryLog::kBlockSize);
+    BinaryLog::BlockHeader header = {++g_writer.sequence};
+    memcpy(pBlock, &header, sizeof(header));
+
+    g_writer.offset = sizeof(header);
+    ++g_writer.statistics.blocks;
+}
+
+// Width of an integer type code in hex digits
+int hexDigits(char type) {
+    switch (type) {
+        case 'b': case 'B': case 'c': case '?': return 2;
+        case 'h': case 'H': return 4;
+        case 'i': case 'I': return 8;
+        default: return 16;
+    }
+}
+
+} // namespace
+
+bool BinaryLog::open(const std::string& path, size_t sizeBytes) {
+    close();
+
+    const Format* pFormats = getFormats();
+    size_t formatCount = getFormatCount();
+    if (formatCount > UINT16_MAX) {
+        Logger::error("Too many binary log call sites: " + std::to_string(formatCount));
+        return false;
+    }
+
+    // 헤더와 포맷 테이블 뒤에 블록이 옴
+    size_t tableSize = 0;
+    for (size_t i = 0; i < formatCount; ++i) {
+        tableSize += sizeof(FormatEntry) + clampLength(strlen(pFormats[i].pFormat)) + clampLength(strlen(pFormats[i].pTypes)) +
+                     clampLength(strlen(pFormats[i].pFile));
+    }
+    size_t dataOffset = (sizeof(FileHeader) + tableSize + kBlockSize - 1) / kBlockSize * kBlockSize;
+    size_t blockCount = std::max(kMinBlocks, sizeBytes > dataOffset ? (sizeBytes - dataOffset) / kBlockSize : 0);
+    size_t fileSize = dataOffset + blockCount * kBlockSize;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        Logger::error("Failed to open binary log " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(fileSize)) != 0) {
+        Logger::error("Failed to size binary log " + path + ": " + strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* pMap = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);     // 매핑은 유지됨
+    if (pMap == MAP_FAILED) {
+        Logger::error("Failed to map binary log " + path + ": " + strerror(errno));
+        return false;
+    }
+    uint8_t* pBase = static_cast<uint8_t*>(pMap);
+
+    FileHeader header = {};
+    memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.blockSize = static_cast<uint32_t>(kBlockSize);
+    header.blockCount = static_cast<uint32_t>(blockCount);
+    header.dataOffset = static_cast<uint32_t>(dataOffset);
+    header.formatCount = static_cast<uint32_t>(formatCount);
+    header.formatTableOffset = sizeof(FileHeader);
+    header.createdUs = nowMicros();
+    header.pid = static_cast<uint32_t>(getpid());
+    memcpy(pBase, &header, sizeof(header));
+
+    uint8_t* pOut = pBase + header.formatTableOffset;
+    for (size_t i = 0; i < formatCount; ++i) {
+        const Format& format = pFormats[i];
+        FormatEntry entry = {};
+        entry.line = format.line;
+        entry.level = static_cast<uint8_t>(format.level);
+        entry.module = static_cast<uint8_t>(format.module);
+        entry.formatLength = clampLength(strlen(format.pFormat));
+        entry.typesLength = clampLength(strlen(format.pTypes));
+        entry.fileLength = clampLength(strlen(format.pFile));
+
+        memcpy(pOut, &entry, sizeof(entry));
+        pOut += sizeof(entry);
+        memcpy(pOut, format.pFormat, entry.formatLength);
+        pOut += entry.formatLength;
+        memcpy(pOut, format.pTypes, entry.typesLength);
+        pOut += entry.typesLength;
+        memcpy(pOut, format.pFile, entry.fileLength);
+        pOut += entry.fileLength;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        g_writer = Writer();
+        g_writer.pBase = pBase;
+        g_writer.fileSize = fileSize;
+        g_writer.dataOffset = dataOffset;
+        g_writer.blockCount = blockCount;
+        g_writer.block = blockCount - 1;
+        advanceBlock();
+    }
+    active = true;
+
+    Logger::info("Binary log: " + path + " (" + std::to_string(fileSize / 1024) + " KiB, " + std::to_string(formatCount) +
+                 " formats)");
+    return true;
+}
+
+void BinaryLog::close() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    active = false;
+    if (g_writer.pBase != nullptr) {
+        munmap(g_writer.pBase, g_writer.fileSize);
+        g_writer.pBase = nullptr;
+    }
+}
+
+BinaryLog::Statistics BinaryLog::getStatistics() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    return g_writer.statistics;
+}
+
+const BinaryLog::Format* BinaryLog::getFormats() {
+    return __start_ggk_blog_formats;
+}
+
+size_t BinaryLog::getFormatCount() {
+    if (__start_ggk_blog_formats == nullptr || __stop_ggk_blog_formats == nullptr) {
+        return 0;
+    }
+    return static_cast<size_t>(__stop_ggk_blog_formats - __start_ggk_blog_formats);
+}
+
+uint8_t* BinaryLog::beginRecord(std::unique_lock<std::mutex>& lock, size_t payloadLength) {
+    lock.lock();
+    if (g_writer.pBase == nullptr) {
+        lock.unlock();
+        return nullptr;
+    }
+
+    if (payloadLength > kMaxPayloadLength) {
+        ++g_writer.statistics.dropped;
+        lock.unlock();
+        return nullptr;
+    }
+
+    // 레코드는 블록 경계를 넘지 않음
+    if (g_writer.offset + sizeof(RecordHeader) + payloadLength > kBlockSize) {
+        advanceBlock();
+    }
+
+    g_writer.pRecord = g_writer.pBase + g_writer.dataOffset + g_writer.block * kBlockSize + g_writer.offset;
+    return g_writer.pRecord + sizeof(RecordHeader);
+}
+
+void BinaryLog::endRecord(std::unique_lock<std::mutex>& lock, const Format& format, size_t payloadLength) {
+    RecordHeader header = {};
+    header.formatId = static_cast<uint16_t>(&format - getFormats() + 1);
+    header.payloadLength = static_cast<uint16_t>(payloadLength);
+    header.threadId = currentThreadId();
+    header.timestampUs = nowMicros();
+
+    // 포맷 id를 마지막에 기록: 기록 중 프로세스가 죽으면 디코더는 이 레코드에서 멈춤
+    memcpy(g_writer.pRecord + sizeof(header.formatId), reinterpret_cast<const uint8_t*>(&header) + sizeof(header.formatId),
+           sizeof(header) - sizeof(header.formatId));
+    std::atomic_signal_fence(std::memory_order_release);
+    memcpy(g_writer.pRecord, &header.formatId, sizeof(header.formatId));
+
+    g_writer.offset += (sizeof(header) + payloadLength + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+    ++g_writer.statistics.records;
+    lock.unlock();
+}
+
+void BinaryLogBytes::copy(uint8_t* pOut, const void* pData, size_t length) {
+    memcpy(pOut, pData, length);
+}
+
+void BinaryLog::writeText(const Format& format, const uint8_t* pPayload, size_t length) {
+    Logger::log(format.level, formatMessage(format.pFormat, format.pTypes, pPayload, length));
+}
+
+bool BinaryLog::decodeArguments(const char* pTypes, const uint8_t* pPayload, size_t length, std::vector<Argument>& arguments) {
+    arguments.clear();
+    size_t position = 0;
+
+    auto take = [&](void* pValue, size_t size) {
+        if (position + size > length) {
+            return false;
+        }
+        memcpy(pValue, pPayload + position, size);
+        position += size;
+        return true;
+    };
+
+    for (const char* pType = pTypes; *pType != '\0'; ++pType) {
+        Argument argument;
+        argument.type = *pType;
+        bool ok = true;
+
+        switch (*pType) {
+            case '?':
+            case 'B': { uint8_t value = 0; ok = take(&value, sizeof(value)); argument.unsignedInteger = value; break; }
+            case 'H': { uint16_t value = 0; ok = take(&value, sizeof(value)); argument.unsignedInteger = value; break; }
+            case 'I': { uint32_t value = 0; ok = take(&value, sizeof(value)); argument.unsignedInteger = value; break; }
+            case 'Q': { uint64_t value = 0; ok = take(&value, sizeof(value)); argument.unsignedInteger = value; break; }
+            case 'c':
+            case 'b': { int8_t value = 0; ok = take(&value, sizeof(value)); argument.integer = value; break; }
+            case 'h': { int16_t value = 0; ok = take(&value, sizeof(value)); argument.integer = value; break; }
+            case 'i': { int32_t value = 0; ok = take(&value, sizeof(value)); argument.integer = value; break; }
+            case 'q': { int64_t value = 0; ok = take(&value, sizeof(value)); argument.integer = value; break; }
+            case 'd': ok = take(&argument.real, sizeof(argument.real)); break;
+            case 's':
+            case 'x': {
+                uint16_t size = 0;
+                ok = take(&size, sizeof(size)) && position + size <= length;
+                if (ok) {
+                    argument.pData = pPayload + position;
+                    argument.length = size;
+                    position += size;
+                }
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+
+        if (!ok) {
+            return false;
+        }
+        arguments.push_back(argument);
+    }
+
+    return position == length;
+}
+
+std::string BinaryLog::formatArgument(const Argument& argument, bool hex) {
+    char buffer[32];
+
+    switch (argument.type) {
+        case '?':
+            return argument.unsignedInteger != 0 ? "true" : "false";
+        case 'c':
+            if (!hex) {
+                return std::string(1, static_cast<char>(argument.integer));
+            }
+            // fall through
+        case 'b': case 'h': case 'i': case 'q':
+            if (hex) {
+                int digits = hexDigits(argument.type);
+                uint64_t mask = digits == 16 ? UINT64_MAX : (UINT64_C(1) << (digits * 4)) - 1;
+                snprintf(buffer, sizeof(buffer), "0x%0*" PRIX64, digits, static_cast<uint64_t>(argument.integer) & mask);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%" PRId64, argument.integer);
+            }
+            return buffer;
+        case 'B': case 'H': case 'I': case 'Q':
+            if (hex) {
+                snprintf(buffer, sizeof(buffer), "0x%0*" PRIX64, hexDigits(argument.type), argument.unsignedInteger);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%" PRIu64, argument.unsignedInteger);
+            }
+            return buffer;
+        case 'd':
+            snprintf(buffer, sizeof(buffer), "%g", argument.real);
+            return buffer;
+        case 's':
+            return std::string(reinterpret_cast<const char*>(argument.pData), argument.length);
+        case 'x': {
+            std::string text;
+            text.reserve(argument.length * 3);
+            for (size_t i = 0; i < argument.length; ++i) {
+                snprintf(buffer, sizeof(buffer), i == 0 ? "%02X" : " %02X", argument.pData[i]);
+                text += buffer;
+            }
+            return text;
+        }
+        default:
+            return "?";
+    }
+}
+
+std::string BinaryLog::formatMessage(const char* pFormat, const char* pTypes, const uint8_t* pPayload, size_t length) {
+    std::vector<Argument> arguments;
+    bool valid = decodeArguments(pTypes, pPayload, length, arguments);
+
+    std::string text;
+    size_t next = 0;
+    for (const char* p = pFormat; *p != '\0'; ++p) {
+        if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+            text += *p++;
+        } else if (p[0] == '{') {
+            const char* pEnd = strchr(p, '}');
+            if (pEnd == nullptr) {
+                text += p;
+                break;
+            }
+
+            bool hex = pEnd - p == 2 && p[1] == 'x';
+            text += valid && next < arguments.size() ? formatArgument(arguments[next], hex) : "{?}";
+            ++next;
+            p = pEnd;
+        } else {
+            text += *p;
+        }
+    }
+    return text;
+}
+
+} // namespace ggk
@@ -0,0 +1,210 @@
+#include "BinaryLogReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "AsyncLogSink.h"
+
+namespace ggk {
+
+namespace {
+
+template <typename T>
+bool readAt(const std::vector<uint8_t>& data, size_t offset, T& value) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, data.data() + offset, sizeof(T));
+    return true;
+}
+
+void appendJsonString(std::string& out, const char* pText, size_t length) {
+    out += '"';
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(pText[i]);
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(c);
+                }
+                break;
+        }
+    }
+    out += '"';
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    appendJsonString(out, text.data(), text.size());
+}
+
+} // namespace
+
+bool BinaryLogReader::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        Logger::error("Cannot open binary log: " + path);
+        return false;
+    }
+    return load(std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+}
+
+bool BinaryLogReader::load(std::vector<uint8_t> fileData) {
+    data = std::move(fileData);
+    formats.clear();
+
+    BinaryLog::FileHeader header;
+    if (!readAt(data, 0, header) || memcmp(header.magic, BinaryLog::kMagic, sizeof(header.magic)) != 0) {
+        Logger::error("Not a binary log file");
+        return false;
+    }
+    if (header.version != BinaryLog::kVersion) {
+        Logger::error("Unsupported binary log version: " + std::to_string(header.version));
+        return false;
+    }
+    if (header.blockSize <= sizeof(BinaryLog::BlockHeader) + sizeof(BinaryLog::RecordHeader) ||
+        header.dataOffset > data.size() ||
+        (data.size() - header.dataOffset) / header.blockSize < header.blockCount) {
+        Logger::error("Binary log is truncated or corrupt");
+        return false;
+    }
+
+    size_t offset = header.formatTableOffset;
+    for (uint32_t i = 0; i < header.formatCount; ++i) {
+        BinaryLog::FormatEntry entry;
+        if (!readAt(data, offset, entry)) {
+            Logger::error("Binary log format table is truncated");
+            return false;
+        }
+        offset += sizeof(entry);
+
+        size_t stringsLength = static_cast<size_t>(entry.formatLength) + entry.typesLength + entry.fileLength;
+        if (offset + stringsLength > header.dataOffset) {
+            Logger::error("Binary log format table is truncated");
+            return false;
+        }
+
+        FormatInfo format;
+        const char* pStrings = reinterpret_cast<const char*>(data.data() + offset);
+        format.format.assign(pStrings, entry.formatLength);
+        format.types.assign(pStrings + entry.formatLength, entry.typesLength);
+        format.file.assign(pStrings + entry.formatLength + entry.typesLength, entry.fileLength);
+        format.line = entry.line;
+        format.level = static_cast<LogLevel>(std::min<uint8_t>(entry.level, static_cast<uint8_t>(LogLevel::Off)));
+        format.module = entry.module < static_cast<uint8_t>(LogModule::Count) ? static_cast<LogModule>(entry.module)
+                                                                                : LogModule::General;
+        formats.push_back(std::move(format));
+        offset += stringsLength;
+    }
+
+    dataOffset = header.dataOffset;
+    blockSize = header.blockSize;
+    blockCount = header.blockCount;
+    pid = header.pid;
+    createdUs = header.createdUs;
+    return true;
+}
+
+size_t BinaryLogReader::forEach(const std::function<void(const Entry&)>& callback) const {
+    // 시퀀스 순서로 블록 정렬 (링이 한 바퀴 돌았으면 가장 오래된 블록부터)
+    std::vector<std::pair<uint64_t, size_t>> blocks;
+    for (size_t i = 0; i < blockCount; ++i) {
+        BinaryLog::BlockHeader header;
+        if (readAt(data, dataOffset + i * blockSize, header) && header.sequence != 0) {
+            blocks.emplace_back(header.sequence, dataOffset + i * blockSize);
+        }
+    }
+    std::sort(blocks.begin(), blocks.end());
+
+    size_t count = 0;
+    for (const auto& block : blocks) {
+        size_t offset = block.second + sizeof(BinaryLog::BlockHeader);
+        size_t blockEnd = block.second + blockSize;
+
+        BinaryLog::RecordHeader header;
+        while (offset + sizeof(header) <= blockEnd && readAt(data, offset, header) && header.formatId != 0) {
+            size_t recordEnd = offset + sizeof(header) + header.payloadLength;
+            if (header.formatId > formats.size() || recordEnd > blockEnd) {
+                break;      // 손상된 레코드: 블록의 나머지를 건너뜀
+            }
+
+            Entry entry;
+            entry.timestampUs = header.timestampUs;
+            entry.threadId = header.threadId;
+            entry.pFormat = &formats[header.formatId - 1];
+            entry.pPayload = data.data() + offset + sizeof(header);
+            entry.payloadLength = header.payloadLength;
+            callback(entry);
+
+            ++count;
+            offset = (recordEnd + BinaryLog::kRecordAlignment - 1) & ~(BinaryLog::kRecordAlignment - 1);
+        }
+    }
+    return count;
+}
+
+std::string BinaryLogReader::toText(const Entry& entry) {
+    std::string message = BinaryLog::formatMessage(entry.pFormat->format.c_str(), entry.pFormat->types.c_str(), entry.pPayload,
+                                                   entry.payloadLength);
+    std::string line = AsyncLogSink::formatLine(entry.timestampUs, entry.pFormat->level, entry.threadId, message.data(),
+                                                message.size());
+    line.pop_back();
+    return line;
+}
+
+std::string BinaryLogReader::toJson(const Entry& entry) {
+    const FormatInfo& format = *entry.pFormat;
+
+    std::string json = "{\"timestamp_us\":" + std::to_string(entry.timestampUs);
+    json += ",\"thread\":" + std::to_string(entry.threadId);
+    json += ",\"level\":";
+    appendJsonString(json, Logger::levelName(format.level));
+    json += ",\"module\":";
+    appendJsonString(json, Logger::moduleName(format.module));
+    json += ",\"file\":";
+    appendJsonString(json, format.file);
+    json += ",\"line\":" + std::to_string(format.line);
+    json += ",\"message\":";
+    appendJsonString(json, BinaryLog::formatMessage(format.format.c_str(), format.types.c_str(), entry.pPayload,
+                                                    entry.payloadLength));
+
+    // 인자는 타입을 유지 (숫자, bool, 문자열, 바이트 배열은 16진 문자열)
+    json += ",\"args\":[";
+    std::vector<BinaryLog::Argument> arguments;
+    if (BinaryLog::decodeArguments(format.types.c_str(), entry.pPayload, entry.payloadLength, arguments)) {
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            const BinaryLog::Argument& argument = arguments[i];
+            if (i > 0) {
+                json += ',';
+            }
+            switch (argument.type) {
+                case 's':
+                case 'x':
+                case 'c':
+                    appendJsonString(json, BinaryLog::formatArgument(argument));
+                    break;
+                case 'd':
+                    json += std::isfinite(argument.real) ? BinaryLog::formatArgument(argument) : "null";
+                    break;
+                default:
+                    json += BinaryLog::formatArgument(argument);
+                    break;
+            }
+        }
+    }
+    json += "]}";
+    return json;
+}
+
+} // namespace ggk
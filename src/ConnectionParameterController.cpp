@@ -0,0 +1,329 @@
+#include "ConnectionParameterController.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace ggk {
+
+constexpr std::chrono::milliseconds ConnectionParameterController::kDefaultIdleTimeout;
+constexpr std::chrono::milliseconds ConnectionParameterController::kEvaluationInterval;
+
+namespace {
+
+// HCI status codes meaning the peer or controller cannot change parameters at all
+bool isUnsupportedStatus(uint8_t status) {
+    return status == 0x11      // Unsupported Feature or Parameter Value
+        || status == 0x1A      // Unsupported Remote Feature
+        || status == 0x3B;     // Unacceptable Connection Parameters
+}
+
+} // namespace
+
+ConnectionParameterController::ProfileParameters ConnectionParameterController::ProfileParameters::forProfile(Profile profile) {
+    switch (profile) {
+        case Profile::LowLatency:
+            return {6, 12, 0, 200};         // 7.5-15 ms, 2 s
+        case Profile::HighThroughput:
+            return {12, 24, 0, 400};        // 15-30 ms, 4 s
+        case Profile::LowPower:
+        default:
+            return {80, 160, 4, 600};       // 100-200 ms, latency 4, 6 s
+    }
+}
+
+std::string ConnectionParameterController::profileName(Profile profile) {
+    switch (profile) {
+        case Profile::LowLatency: return "low-latency";
+        case Profile::HighThroughput: return "high-throughput";
+        case Profile::LowPower: return "low-power";
+    }
+    return "unknown";
+}
+
+ConnectionParameterController::ConnectionParameterController(HciAdapter& adapter)
+    : adapter(adapter)
+    , activeProfile(Profile::LowPower)
+    , automatic(true)
+    , queuedNotifications(0)
+    , reportedDepth(0)
+    , estimatedDepth(0)
+    , highWatermark(kDefaultHighWatermark)
+    , idleTimeoutMS(kDefaultIdleTimeout.count())
+    , lastEvaluation(Clock::now())
+    , lastBusy(Clock::now())
+    , lastLinkCount(0)
+    , profileSelected(false)
+    , isRunning(false) {
+    adapter.getConnectionTracker().addListener([this](ConnectionTracker::LinkEvent event, const LinkState& state) {
+        handleLinkEvent(event, state);
+    });
+
+    // 실패한 Connection Update는 트래커에 반영되지 않으므로 직접 기록
+    adapter.getEventDecoder().onLeConnectionUpdateComplete([this](const HciLeConnectionUpdateCompleteView& view) {
+        if (view.status() == 0x00) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(requestsMutex);
+        auto it = requests.find(view.connectionHandle());
+        if (it != requests.end() && it->second.outcome.outcome == LinkRequestOutcome::Pending) {
+            it->second.outcome.outcome = LinkRequestOutcome::Rejected;
+            it->second.outcome.status = view.status();
+            it->second.unsupported = isUnsupportedStatus(view.status());
+        }
+    });
+}
+
+ConnectionParameterController::~ConnectionParameterController() {
+    stop();
+}
+
+void ConnectionParameterController::start() {
+    if (isRunning.exchange(true)) {
+        return;
+    }
+
+    evaluationThread = std::thread(&ConnectionParameterController::run, this);
+}
+
+void ConnectionParameterController::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        isRunning = false;
+    }
+    wakeCondition.notify_all();
+
+    if (evaluationThread.joinable()) {
+        evaluationThread.join();
+    }
+}
+
+void ConnectionParameterController::setProfile(Profile profile) {
+    automatic = false;
+    profileSelected = true;
+    activeProfile = profile;
+
+    Logger::info("Connection parameter profile set to " + profileName(profile));
+    applyProfile(profile);
+}
+
+void ConnectionParameterController::setAutomatic(bool enabled) {
+    automatic = enabled;
+}
+
+void ConnectionParameterController::setThresholds(size_t newHighWatermark, std::chrono::milliseconds idleTimeout) {
+    highWatermark = std::max<size_t>(newHighWatermark, 1);
+    idleTimeoutMS = idleTimeout.count();
+}
+
+GattTrafficCallback ConnectionParameterController::trafficCallback() {
+    return [this](size_t) {
+        queuedNotifications.fetch_add(1, std::memory_order_relaxed);
+    };
+}
+
+void ConnectionParameterController::reportQueueDepth(size_t depth) {
+    reportedDepth = depth;
+}
+
+// Updates the backlog estimate and, in automatic mode, picks the profile for all connections
+//
+// The backlog grows by the notifications produced since the last step and drains by what the slowest link can carry in the
+// same time (kNotificationsPerEvent per connection event). A depth reported through `reportQueueDepth()` takes precedence when
+// it is larger.
+void ConnectionParameterController::evaluate() {
+    Clock::time_point now = Clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - lastEvaluation);
+    lastEvaluation = now;
+
+    size_t queued = queuedNotifications.exchange(0, std::memory_order_relaxed);
+    std::vector<LinkState> links = adapter.getConnectionTracker().snapshot();
+
+    size_t depth = 0;
+    if (!links.empty()) {
+        uint32_t slowestInterval = 0;
+        for (const LinkState& link : links) {
+            slowestInterval = std::max(slowestInterval, link.intervalMicros());
+        }
+        if (slowestInterval == 0) {
+            slowestInterval = 7500;
+        }
+
+        size_t capacity = static_cast<size_t>(elapsed.count() / slowestInterval) * kNotificationsPerEvent;
+        size_t backlog = estimatedDepth + queued;
+        depth = backlog > capacity ? backlog - capacity : 0;
+    }
+    depth = std::max(depth, reportedDepth.load());
+    estimatedDepth = depth;
+
+    if (!automatic || links.empty()) {
+        lastLinkCount = links.size();
+        return;
+    }
+
+    // 새 연결(서비스 탐색 중)이나 트래픽이 있으면 busy로 간주
+    Profile target = activeProfile;
+    if (depth >= highWatermark) {
+        lastBusy = now;
+        target = Profile::HighThroughput;
+    } else if (depth > 0 || links.size() > lastLinkCount) {
+        lastBusy = now;
+    } else if (now - lastBusy >= std::chrono::milliseconds(idleTimeoutMS.load())) {
+        target = Profile::LowPower;
+    }
+    lastLinkCount = links.size();
+
+    if (target != activeProfile) {
+        Logger::info("Switching connection parameter profile to " + profileName(target) +
+                     " (backlog " + std::to_string(depth) + ")");
+        activeProfile = target;
+        profileSelected = true;
+    }
+
+    if (!profileSelected) {
+        return;
+    }
+
+    for (const LinkState& link : links) {
+        bool needed;
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex);
+            auto it = requests.find(link.handle);
+            needed = it == requests.end() ||
+                     (!it->second.unsupported && it->second.outcome.profile != target);
+        }
+
+        if (needed) {
+            requestUpdate(link, target);
+        }
+    }
+}
+
+bool ConnectionParameterController::getOutcome(uint16_t handle, Outcome& outcome) const {
+    std::lock_guard<std::mutex> lock(requestsMutex);
+    auto it = requests.find(handle);
+    if (it == requests.end()) {
+        return false;
+    }
+
+    outcome = it->second.outcome;
+    return true;
+}
+
+void ConnectionParameterController::applyProfile(Profile profile) {
+    for (const LinkState& link : adapter.getConnectionTracker().snapshot()) {
+        requestUpdate(link, profile);
+    }
+}
+
+// Sends LE Connection Update: [Handle(2)][Interval_Min(2)][Interval_Max(2)][Max_Latency(2)][Timeout(2)][Min_CE(2)][Max_CE(2)]
+void ConnectionParameterController::requestUpdate(const LinkState& state, Profile profile) {
+    ProfileParameters parameters = ProfileParameters::forProfile(profile);
+    uint16_t handle = state.handle;
+
+    {
+        std::lock_guard<std::mutex> lock(requestsMutex);
+        Request& request = requests[handle];
+        request.outcome.profile = profile;
+        request.outcome.requested = parameters;
+        request.outcome.outcome = LinkRequestOutcome::Pending;
+        request.outcome.status = 0;
+        request.requestedAt = Clock::now();
+    }
+
+    std::vector<uint8_t> command;
+    command.reserve(14);
+    hciAppendLe16(command, handle);
+    hciAppendLe16(command, parameters.minInterval);
+    hciAppendLe16(command, parameters.maxInterval);
+    hciAppendLe16(command, parameters.latency);
+    hciAppendLe16(command, parameters.supervisionTimeout);
+    hciAppendLe16(command, 0);
+    hciAppendLe16(command, 0);
+
+    adapter.sendCommandAsync(CMD_LE_CONNECTION_UPDATE, std::move(command), [this, handle](const HciCommandResult& result) {
+        // 성공(Command Status)이면 LE Connection Update Complete를 기다림
+        if (result.succeeded()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex);
+            auto it = requests.find(handle);
+            if (it != requests.end()) {
+                it->second.outcome.outcome = LinkRequestOutcome::Rejected;
+                it->second.outcome.status = result.status;
+                it->second.unsupported = isUnsupportedStatus(result.status);
+            }
+        }
+
+        Logger::warn("LE Connection Update failed on connection " + std::to_string(handle) +
+                     " with status " + Utils::hex(result.status));
+    });
+}
+
+void ConnectionParameterController::handleLinkEvent(ConnectionTracker::LinkEvent event, const LinkState& state) {
+    switch (event) {
+        case ConnectionTracker::LinkEvent::Connected:
+            // 수동 모드에서는 선택된 프로파일을 새 연결에도 적용
+            if (!automatic && profileSelected) {
+                requestUpdate(state, activeProfile);
+            }
+            break;
+
+        case ConnectionTracker::LinkEvent::Disconnected:
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex);
+            requests.erase(state.handle);
+            break;
+        }
+
+        case ConnectionTracker::LinkEvent::ParametersUpdated:
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex);
+            auto it = requests.find(state.handle);
+            if (it == requests.end()) {
+                break;
+            }
+
+            Outcome& outcome = it->second.outcome;
+            outcome.interval = state.interval;
+            outcome.latency = state.latency;
+            outcome.supervisionTimeout = state.supervisionTimeout;
+            outcome.updateCount++;
+
+            if (outcome.outcome == LinkRequestOutcome::Pending) {
+                outcome.outcome = LinkRequestOutcome::Accepted;
+                outcome.settleTime = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - it->second.requestedAt);
+
+                Logger::info("Connection " + std::to_string(state.handle) + " " + profileName(outcome.profile) +
+                             ": interval " + std::to_string(state.intervalMicros() / 1000.0) + " ms, latency " +
+                             std::to_string(state.latency) + " after " + std::to_string(outcome.settleTime.count()) + " ms" +
+                             (outcome.withinRequest() ? "" : " (outside requested range)"));
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void ConnectionParameterController::run() {
+    Logger::debug("Started connection parameter controller");
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (isRunning) {
+        wakeCondition.wait_for(lock, kEvaluationInterval);
+        if (!isRunning) {
+            break;
+        }
+
+        lock.unlock();
+        evaluate();
+        lock.lock();
+    }
+
+    Logger::debug("Stopped connection parameter controller");
+}
+
+} // namespace ggk
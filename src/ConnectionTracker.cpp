@@ -0,0 +1,337 @@
+#include "ConnectionTracker.h"
+#include "Logger.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace ggk {
+
+ConnectionTracker::ConnectionTracker()
+    : activeCount(0) {
+    LinkState empty;
+    for (Slot& slot : slots) {
+        writeSlot(slot, empty);
+    }
+    slotHandles.fill(LinkState::kInvalidHandle);
+}
+
+// Registers the HCI event handlers that keep the table up to date
+void ConnectionTracker::attach(HciEventDecoder& decoder) {
+    decoder.onLeConnectionComplete([this](const HciLeConnectionCompleteView& view) {
+        if (view.status() != 0x00) {
+            return;
+        }
+
+        LinkState state;
+        state.handle = view.connectionHandle();
+        state.role = view.role();
+        state.addressType = view.peerAddressType();
+        memcpy(state.address, view.peerAddress(), sizeof(state.address));
+        state.interval = view.connectionInterval();
+        state.latency = view.peripheralLatency();
+        state.supervisionTimeout = view.supervisionTimeout();
+        connectionComplete(state);
+    });
+
+    decoder.onDisconnectionComplete([this](const HciDisconnectionCompleteView& view) {
+        if (view.status() == 0x00) {
+            disconnectionComplete(view.connectionHandle());
+        }
+    });
+
+    decoder.onLeConnectionUpdateComplete([this](const HciLeConnectionUpdateCompleteView& view) {
+        if (view.status() != 0x00) {
+            return;
+        }
+        modify(view.connectionHandle(), LinkEvent::ParametersUpdated, [&](LinkState& state) {
+            state.interval = view.connectionInterval();
+            state.latency = view.peripheralLatency();
+            state.supervisionTimeout = view.supervisionTimeout();
+        });
+    });
+
+    decoder.onLeDataLengthChange([this](const HciLeDataLengthChangeView& view) {
+        modify(view.connectionHandle(), LinkEvent::DataLengthChanged, [&](LinkState& state) {
+            state.maxTxOctets = view.maxTxOctets();
+            state.maxTxTime = view.maxTxTime();
+            state.maxRxOctets = view.maxRxOctets();
+            state.maxRxTime = view.maxRxTime();
+        });
+    });
+
+    decoder.onLePhyUpdateComplete([this](const HciLePhyUpdateCompleteView& view) {
+        modify(view.connectionHandle(), LinkEvent::PhyUpdated, [&](LinkState& state) {
+            // 실패한 경우에도 호스트가 요청한 PHY 변경의 결과로 기록
+            if (view.status() != 0x00) {
+                if (state.phyOutcome == LinkRequestOutcome::Pending) {
+                    state.phyOutcome = LinkRequestOutcome::Rejected;
+                    state.phyStatus = view.status();
+                }
+                return;
+            }
+
+            state.txPhy = view.txPhy();
+            state.rxPhy = view.rxPhy();
+            if (state.phyOutcome == LinkRequestOutcome::Pending) {
+                state.phyOutcome = LinkRequestOutcome::Accepted;
+                state.phyStatus = 0x00;
+            }
+        });
+    });
+}
+
+void ConnectionTracker::addListener(Listener listener) {
+    listeners.push_back(std::move(listener));
+}
+
+bool ConnectionTracker::getByHandle(uint16_t handle, LinkState& state) const {
+    if (handle == LinkState::kInvalidHandle) {
+        return false;
+    }
+
+    for (const Slot& slot : slots) {
+        readSlot(slot, state);
+        if (state.handle == handle) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConnectionTracker::getByAddress(const uint8_t* pAddress, LinkState& state) const {
+    for (const Slot& slot : slots) {
+        readSlot(slot, state);
+        if (state.isValid() && memcmp(state.address, pAddress, sizeof(state.address)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConnectionTracker::getByAddress(const std::string& address, LinkState& state) const {
+    uint8_t bytes[6];
+    return parseAddress(address, bytes) && getByAddress(bytes, state);
+}
+
+std::vector<LinkState> ConnectionTracker::snapshot() const {
+    std::vector<LinkState> states;
+    states.reserve(connectionCount());
+
+    LinkState state;
+    for (const Slot& slot : slots) {
+        readSlot(slot, state);
+        if (state.isValid()) {
+            states.push_back(state);
+        }
+    }
+    return states;
+}
+
+bool ConnectionTracker::updateMtu(uint16_t handle, uint16_t mtu) {
+    return modify(handle, LinkEvent::MtuChanged, [mtu](LinkState& state) {
+        state.mtu = mtu;
+    });
+}
+
+// ReadValue/WriteValue마다 호출되므로 값이 같으면 잠금 없이 끝냄
+bool ConnectionTracker::updateMtu(const uint8_t* pAddress, uint16_t mtu) {
+    LinkState state;
+    if (!getByAddress(pAddress, state)) {
+        return false;
+    }
+    return state.mtu == mtu || updateMtu(state.handle, mtu);
+}
+
+bool ConnectionTracker::updateMtu(const std::string& address, uint16_t mtu) {
+    uint8_t bytes[6];
+    return parseAddress(address, bytes) && updateMtu(bytes, mtu);
+}
+
+void ConnectionTracker::connectionComplete(const LinkState& state) {
+    if (!state.isValid()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+
+        // 같은 핸들이 남아 있으면(Disconnection 이벤트 유실) 덮어씀
+        Slot* pSlot = findSlotLocked(state.handle);
+        if (pSlot == nullptr) {
+            pSlot = findSlotLocked(LinkState::kInvalidHandle);
+            if (pSlot == nullptr) {
+                Logger::error("Connection table full, not tracking handle " + std::to_string(state.handle));
+                return;
+            }
+            activeCount.fetch_add(1, std::memory_order_release);
+        }
+
+        slotHandles[pSlot - slots.data()] = state.handle;
+        writeSlot(*pSlot, state);
+    }
+
+    Logger::info("LE connection " + std::to_string(state.handle) + " established with " + state.addressString());
+    notify(LinkEvent::Connected, state);
+}
+
+void ConnectionTracker::disconnectionComplete(uint16_t handle) {
+    if (handle == LinkState::kInvalidHandle) {
+        return;
+    }
+
+    LinkState state;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+
+        Slot* pSlot = findSlotLocked(handle);
+        if (pSlot == nullptr) {
+            return;
+        }
+
+        readSlot(*pSlot, state);
+        slotHandles[pSlot - slots.data()] = LinkState::kInvalidHandle;
+        writeSlot(*pSlot, LinkState());
+        activeCount.fetch_sub(1, std::memory_order_release);
+    }
+
+    Logger::info("LE connection " + std::to_string(handle) + " with " + state.addressString() + " closed");
+    notify(LinkEvent::Disconnected, state);
+}
+
+bool ConnectionTracker::modify(uint16_t handle, LinkEvent event, const std::function<void(LinkState&)>& update) {
+    LinkState state;
+    if (!apply(handle, update, state)) {
+        return false;
+    }
+
+    notify(event, state);
+    return true;
+}
+
+bool ConnectionTracker::update(uint16_t handle, const std::function<void(LinkState&)>& update) {
+    LinkState state;
+    return apply(handle, update, state);
+}
+
+bool ConnectionTracker::apply(uint16_t handle, const std::function<void(LinkState&)>& update, LinkState& state) {
+    if (handle == LinkState::kInvalidHandle) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    Slot* pSlot = findSlotLocked(handle);
+    if (pSlot == nullptr) {
+        return false;
+    }
+
+    readSlot(*pSlot, state);
+    update(state);
+    state.handle = handle;
+    writeSlot(*pSlot, state);
+    return true;
+}
+
+void ConnectionTracker::clear() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    LinkState empty;
+    for (Slot& slot : slots) {
+        writeSlot(slot, empty);
+    }
+    slotHandles.fill(LinkState::kInvalidHandle);
+    activeCount.store(0, std::memory_order_release);
+}
+
+// Parses "AA:BB:CC:DD:EE:FF" into little endian HCI order
+bool ConnectionTracker::parseAddress(const std::string& address, uint8_t* pAddress) {
+    unsigned int bytes[6];
+    if (sscanf(address.c_str(), "%2x:%2x:%2x:%2x:%2x:%2x",
+               &bytes[0], &bytes[1], &bytes[2], &bytes[3], &bytes[4], &bytes[5]) != 6) {
+        return false;
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        pAddress[i] = static_cast<uint8_t>(bytes[5 - i]);
+    }
+    return true;
+}
+
+bool ConnectionTracker::parseDevicePath(const char* pPath, uint8_t* pAddress) {
+    const char* pDevice = pPath != nullptr ? strstr(pPath, "/dev_") : nullptr;
+    if (pDevice == nullptr) {
+        return false;
+    }
+
+    unsigned int bytes[6];
+    int consumed = 0;
+    if (sscanf(pDevice, "/dev_%2x_%2x_%2x_%2x_%2x_%2x%n",
+               &bytes[0], &bytes[1], &bytes[2], &bytes[3], &bytes[4], &bytes[5], &consumed) != 6 ||
+        pDevice[consumed] != '\0') {
+        return false;
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        pAddress[i] = static_cast<uint8_t>(bytes[5 - i]);
+    }
+    return true;
+}
+
+// Copies a slot, retrying while a writer is active or if one finished during the copy
+void ConnectionTracker::readSlot(const Slot& slot, LinkState& state) const {
+    uint64_t buffer[kWords];
+
+    for (;;) {
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+
+        for (size_t i = 0; i < kWords; ++i) {
+            buffer[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    memcpy(&state, buffer, sizeof(LinkState));
+}
+
+// Publishes a slot (caller holds writeMutex, or is the constructor)
+void ConnectionTracker::writeSlot(Slot& slot, const LinkState& state) {
+    uint64_t buffer[kWords] = {};
+    memcpy(buffer, &state, sizeof(LinkState));
+
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < kWords; ++i) {
+        slot.words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+ConnectionTracker::Slot* ConnectionTracker::findSlotLocked(uint16_t handle) {
+    for (size_t i = 0; i < kMaxConnections; ++i) {
+        if (slotHandles[i] == handle) {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+void ConnectionTracker::notify(LinkEvent event, const LinkState& state) const {
+    for (const Listener& listener : listeners) {
+        try {
+            listener(event, state);
+        } catch (const std::exception& e) {
+            Logger::error("Exception in connection listener: " + std::string(e.what()));
+        }
+    }
+}
+
+} // namespace ggk
@@ -1,5 +1,9 @@
 #include "DBusConnection.h"
+#include "FlightRecorder.h"
+#include <memory>
 #include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
 
 namespace ggk {
 
@@ -14,10 +18,103 @@ DBusConnection::DBusConnection(GBusType busType)
     : busType(busType), connection(nullptr, &g_object_unref) {
 }
 
+DBusConnection::DBusConnection(GDBusConnectionPtr connection)
+    : busType(G_BUS_TYPE_NONE), connection(std::move(connection)) {
+    if (this->connection) {
+        g_dbus_connection_set_exit_on_close(this->connection.get(), FALSE);
+    }
+}
+
 DBusConnection::~DBusConnection() {
     disconnect();
 }
 
+namespace {
+
+GIOStream* socketStream(int fd) {
+    GError* error = nullptr;
+    GSocket* socket = g_socket_new_from_fd(fd, &error);
+    if (!socket) {
+        Logger::error("g_socket_new_from_fd failed: " + std::string(error->message));
+        g_error_free(error);
+        close(fd);
+        return nullptr;
+    }
+    GSocketConnection* socketConnection = g_socket_connection_factory_create_connection(socket);
+    g_object_unref(socket);
+    return G_IO_STREAM(socketConnection);
+}
+
+} // namespace
+
+bool DBusConnection::openPeerPair(GDBusConnectionPtr& server, GDBusConnectionPtr& client) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        Logger::error("socketpair failed for peer D-Bus connection");
+        return false;
+    }
+
+    GIOStream* serverStream = socketStream(fds[0]);
+    GIOStream* clientStream = socketStream(fds[1]);
+    if (!serverStream || !clientStream) {
+        if (serverStream) {
+            g_object_unref(serverStream);
+        }
+        if (clientStream) {
+            g_object_unref(clientStream);
+        }
+        return false;
+    }
+
+    struct Pending {
+        GDBusConnection* connection = nullptr;
+        bool done = false;
+    } pending;
+
+    // 서버 쪽 인증은 비동기로 시작하고 클라이언트 쪽은 동기로 진행
+    gchar* guid = g_dbus_generate_guid();
+    g_dbus_connection_new(
+        serverStream, guid,
+        static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER |
+                                          G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS),
+        nullptr, nullptr,
+        [](GObject*, GAsyncResult* result, gpointer userData) {
+            Pending* pending = static_cast<Pending*>(userData);
+            pending->connection = g_dbus_connection_new_finish(result, nullptr);
+            pending->done = true;
+        },
+        &pending);
+
+    GError* error = nullptr;
+    GDBusConnection* rawClient = g_dbus_connection_new_sync(
+        clientStream, nullptr, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT, nullptr, nullptr, &error);
+    while (!pending.done) {
+        g_main_context_iteration(nullptr, TRUE);
+    }
+
+    g_free(guid);
+    g_object_unref(serverStream);
+    g_object_unref(clientStream);
+
+    if (!rawClient || !pending.connection) {
+        Logger::error("Peer D-Bus connection failed: " + std::string(error ? error->message : "server side"));
+        if (error) {
+            g_error_free(error);
+        }
+        if (rawClient) {
+            g_object_unref(rawClient);
+        }
+        if (pending.connection) {
+            g_object_unref(pending.connection);
+        }
+        return false;
+    }
+
+    server = makeGDBusConnectionPtr(pending.connection);
+    client = makeGDBusConnectionPtr(rawClient);
+    return true;
+}
+
 bool DBusConnection::connect() {
     if (isConnected()) {
         return true;
@@ -47,7 +144,9 @@ bool DBusConnection::connect() {
 bool DBusConnection::disconnect() {
     // 등록된 모든 객체 해제
     for (const auto& obj : registeredObjects) {
-        g_dbus_connection_unregister_object(connection.get(), obj.second);
+        for (guint registrationId : obj.second) {
+            g_dbus_connection_unregister_object(connection.get(), registrationId);
+        }
     }
     registeredObjects.clear();
     
@@ -108,6 +207,53 @@ GVariantPtr DBusConnection::callMethod(
     return GVariantPtr(result, &g_variant_unref);
 }
 
+bool DBusConnection::callMethodAsync(
+    const std::string& destination,
+    const DBusObjectPath& path,
+    const std::string& interface,
+    const std::string& method,
+    GVariantPtr parameters,
+    ReplyHandler handler,
+    int timeoutMs)
+{
+    if (!isConnected()) {
+        Logger::error("Cannot call method: not connected to D-Bus");
+        return false;
+    }
+    
+    // 핸들러는 응답 콜백에서 해제
+    g_dbus_connection_call(
+        connection.get(),
+        destination.c_str(),
+        path.c_str(),
+        interface.c_str(),
+        method.c_str(),
+        parameters.get(),
+        nullptr,
+        G_DBUS_CALL_FLAGS_NONE,
+        timeoutMs,
+        nullptr,
+        &DBusConnection::handleReply,
+        new ReplyHandler(std::move(handler))
+    );
+    return true;
+}
+
+void DBusConnection::handleReply(GObject* source, GAsyncResult* result, gpointer userData) {
+    std::unique_ptr<ReplyHandler> pHandler(static_cast<ReplyHandler*>(userData));
+    
+    GError* error = nullptr;
+    GVariant* reply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (error) {
+        Logger::error("D-Bus method call failed: " + std::string(error->message));
+        g_error_free(error);
+        (*pHandler)(makeNullGVariantPtr());
+        return;
+    }
+    
+    (*pHandler)(GVariantPtr(reply, &g_variant_unref));
+}
+
 bool DBusConnection::emitSignal(
     const DBusObjectPath& path,
     const std::string& interface,
@@ -174,12 +320,6 @@ bool DBusConnection::registerObject(
         return false;
     }
     
-    // 핸들러 데이터 설정
-    HandlerData* data = new HandlerData();
-    data->connection = this;
-    data->methodHandlers = methodHandlers;
-    data->properties = properties;
-    
     // 인터페이스별 처리
     GDBusInterfaceVTable vtable = {
         handleMethodCall,
@@ -188,11 +328,16 @@ bool DBusConnection::registerObject(
         { nullptr }  // 기타 필드 초기화
     };
     
-    guint registrationId = 0;
+    std::vector<guint> registrationIds;
     
-    // 모든 인터페이스 등록
+    // 모든 인터페이스 등록 (등록마다 해제 시 데이터를 지우므로 인터페이스별로 복사본 사용)
     for (GDBusInterfaceInfo** interfaces = nodeInfo->interfaces; interfaces && *interfaces; interfaces++) {
-        registrationId = g_dbus_connection_register_object(
+        HandlerData* data = new HandlerData();
+        data->connection = this;
+        data->methodHandlers = methodHandlers;
+        data->properties = properties;
+        
+        guint registrationId = g_dbus_connection_register_object(
             connection.get(),
             path.c_str(),
             *interfaces,
@@ -211,17 +356,19 @@ bool DBusConnection::registerObject(
             } else {
                 Logger::error("Failed to register interface " + std::string((*interfaces)->name));
             }
+            continue;   // data는 해제하지 않음 (실패 시 해제 함수 호출 여부가 GLib 버전마다 다름)
         }
+        registrationIds.push_back(registrationId);
     }
     
     g_dbus_node_info_unref(nodeInfo);
     
-    if (registrationId == 0) {
+    if (registrationIds.empty()) {
         return false;
     }
     
-    registeredObjects[path.toString()] = registrationId;
-    Logger::info("Registered D-Bus object at path: " + path.toString());
+    registeredObjects[path.toString()] = std::move(registrationIds);
+    GGK_LOG_INFO(DBus, "Registered D-Bus object at path: " << path.toString());
     
     return true;
 }
@@ -237,14 +384,19 @@ bool DBusConnection::unregisterObject(const DBusObjectPath& path) {
         return false;
     }
     
-    if (g_dbus_connection_unregister_object(connection.get(), it->second)) {
-        registeredObjects.erase(it);
-        Logger::info("Unregistered D-Bus object at path: " + path.toString());
-        return true;
+    bool success = true;
+    for (guint registrationId : it->second) {
+        success = g_dbus_connection_unregister_object(connection.get(), registrationId) && success;
+    }
+    registeredObjects.erase(it);
+    
+    if (!success) {
+        Logger::error("Failed to unregister D-Bus object at path: " + path.toString());
+        return false;
     }
     
-    Logger::error("Failed to unregister D-Bus object at path: " + path.toString());
-    return false;
+    GGK_LOG_INFO(DBus, "Unregistered D-Bus object at path: " << path.toString());
+    return true;
 }
 
 bool DBusConnection::emitPropertyChanged(
@@ -257,21 +409,24 @@ bool DBusConnection::emitPropertyChanged(
         return false;
     }
     
-    // 변경된 속성 사전 생성
+    // 부동 참조로 넘어온 값은 소유 참조로 바꿈 (빌더가 따로 참조를 잡으므로 이중 해제 방지)
+    g_variant_take_ref(value.get());
+
+    // 변경된 속성 사전 생성 (빈 배열도 만들 수 있도록 타입을 명시)
     GVariantBuilder builder;
-    g_variant_builder_init(&builder, G_VARIANT_TYPE_ARRAY);
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
     g_variant_builder_add(&builder, "{sv}", propertyName.c_str(), value.get());
     
     // 무효화된 속성 빈 배열
     GVariantBuilder invalidatedBuilder;
-    g_variant_builder_init(&invalidatedBuilder, G_VARIANT_TYPE_ARRAY);
+    g_variant_builder_init(&invalidatedBuilder, G_VARIANT_TYPE("as"));
     
     // 시그널 매개변수 생성
     GVariantPtr params(
-        g_variant_new("(sa{sv}as)",
+        g_variant_ref_sink(g_variant_new("(sa{sv}as)",
             interface.c_str(),
             &builder,
-            &invalidatedBuilder),
+            &invalidatedBuilder)),
         &g_variant_unref
     );
     
@@ -312,7 +467,7 @@ guint DBusConnection::addSignalWatch(
     
     if (subscriptionId > 0) {
         signalHandlers[subscriptionId] = handler;
-        Logger::debug("Added signal watch: " + interface + "." + signalName);
+        GGK_LOG_DEBUG(DBus, "Added signal watch: " << interface << "." << signalName);
     } else {
         Logger::error("Failed to add signal watch: " + interface + "." + signalName);
     }
@@ -350,6 +505,9 @@ void DBusConnection::handleMethodCall(
     gpointer userData)
 {
     HandlerData* data = static_cast<HandlerData*>(userData);
+
+    FlightRecorder::record(FlightRecorder::Category::DBus, 0, 0,
+                           {interfaceName, ".", methodName, " ", objectPath, " ", sender});
     
     // 인터페이스 및 메서드 핸들러 찾기
     auto ifaceIt = data->methodHandlers.find(interfaceName);
@@ -130,6 +130,11 @@ bool DBusMethod::checkArgumentTypes(GVariant* parameters) const {
 }
 
 void DBusMethod::logMethodInvocation(const DBusMethodCall& call) const {
+   // 파라미터 전체를 텍스트로 변환하므로 debug 레벨이 아니면 건너뜀
+   if (!Logger::isEnabled(LogLevel::Debug, LogModule::DBus)) {
+       return;
+   }
+
    std::string paramStr;
    if (call.parameters) {
        gchar* params = g_variant_print(call.parameters, TRUE);
@@ -139,11 +144,11 @@ void DBusMethod::logMethodInvocation(const DBusMethodCall& call) const {
        }
    }
 
-   Logger::debug("D-Bus method invocation:" 
-                "\n  Method: " + name +
-                "\n  Interface: " + call.interface +
-                "\n  Sender: " + call.sender +
-                "\n  Parameters: " + (paramStr.empty() ? "none" : paramStr));
+   GGK_LOG_DEBUG(DBus, "D-Bus method invocation:"
+                 << "\n  Method: " << name
+                 << "\n  Interface: " << call.interface
+                 << "\n  Sender: " << call.sender
+                 << "\n  Parameters: " << (paramStr.empty() ? "none" : paramStr));
 }
 
 std::string DBusMethod::generateIntrospectionXML(const DBusIntrospection& config) const {
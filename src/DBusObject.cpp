@@ -1,6 +1,7 @@
 #include "DBusObject.h"
 #include "DBusXml.h"
 #include "Logger.h"
+#include "StartupProfiler.h"
 
 namespace ggk {
 
@@ -23,11 +24,12 @@ bool DBusObject::addInterface(const std::string& interface, const std::vector<DB
     }
     
     interfaces[interface] = properties;
-    Logger::debug("Added interface: " + interface + " to object: " + path.toString());
+    GGK_LOG_DEBUG(DBus, "Added interface: " << interface << " to object: " << path.toString());
     return true;
 }
 
-bool DBusObject::addMethod(const std::string& interface, const std::string& method, DBusConnection::MethodHandler handler) {
+bool DBusObject::addMethod(const std::string& interface, const std::string& method, DBusConnection::MethodHandler handler,
+                           const std::vector<DBusArgument>& arguments) {
     std::lock_guard<std::mutex> lock(mutex);
     
     if (registered) {
@@ -41,7 +43,8 @@ bool DBusObject::addMethod(const std::string& interface, const std::string& meth
     }
     
     methodHandlers[interface][method] = handler;
-    Logger::debug("Added method: " + interface + "." + method + " to object: " + path.toString());
+    methodArguments[interface][method] = arguments;
+    GGK_LOG_DEBUG(DBus, "Added method: " << interface << "." << method << " to object: " << path.toString());
     return true;
 }
 
@@ -133,7 +136,7 @@ bool DBusObject::registerObject() {
     std::lock_guard<std::mutex> lock(mutex);
     
     if (registered) {
-        Logger::debug("Object already registered: " + path.toString());
+        GGK_LOG_DEBUG(DBus, "Object already registered: " << path.toString());
         return true;
     }
     
@@ -143,19 +146,26 @@ bool DBusObject::registerObject() {
     }
     
     // 인트로스펙션 XML 생성
-    std::string xml = generateIntrospectionXml();
-    Logger::debug("Registering object with XML:\n" + xml);
+    std::string xml;
+    {
+        StartupProfiler::Accumulator profile("dbus", "introspection_xml");
+        xml = generateIntrospectionXml();
+    }
+    GGK_LOG_DEBUG(DBus, "Registering object with XML:\n" << xml);
     
     // 객체 등록
-    registered = connection.registerObject(
-        path,
-        xml,
-        methodHandlers,
-        interfaces
-    );
+    {
+        StartupProfiler::Accumulator profile("dbus", "register_object");
+        registered = connection.registerObject(
+            path,
+            xml,
+            methodHandlers,
+            interfaces
+        );
+    }
     
     if (registered) {
-        Logger::info("Registered D-Bus object: " + path.toString());
+        GGK_LOG_INFO(DBus, "Registered D-Bus object: " << path.toString());
     } else {
         Logger::error("Failed to register D-Bus object: " + path.toString());
     }
@@ -172,7 +182,7 @@ bool DBusObject::unregisterObject() {
     
     registered = !connection.unregisterObject(path);
     if (!registered) {
-        Logger::info("Unregistered D-Bus object: " + path.toString());
+        GGK_LOG_INFO(DBus, "Unregistered D-Bus object: " << path.toString());
     } else {
         Logger::error("Failed to unregister D-Bus object: " + path.toString());
     }
@@ -181,14 +191,6 @@ bool DBusObject::unregisterObject() {
 }
 
 std::string DBusObject::generateIntrospectionXml() const {
-    // 메서드 목록 수집
-    std::vector<std::pair<std::string, std::string>> methods; // 인터페이스와 메서드 이름만 저장
-    for (const auto& ifaceMethods : methodHandlers) {
-        for (const auto& method : ifaceMethods.second) {
-            methods.push_back({ifaceMethods.first, method.first});
-        }
-    }
-    
     // 시그널 목록은 현재 지원하지 않음
     std::vector<DBusSignal> signals;
     
@@ -196,29 +198,14 @@ std::string DBusObject::generateIntrospectionXml() const {
     std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<node>\n";
     
     for (const auto& iface : interfaces) {
-        // 해당 인터페이스의 메서드 필터링
-        std::vector<DBusMethodCall> ifaceMethods;
-        auto it = methodHandlers.find(iface.first);
-        if (it != methodHandlers.end()) {
-            for (const auto& method : it->second) {
-                // 복사 대신 직접 생성자 호출
-                DBusMethodCall call(
-                    "",  // sender
-                    iface.first,  // interface
-                    method.first,  // method
-                    makeNullGVariantPtr(),  // parameters
-                    makeNullGDBusMethodInvocationPtr()  // invocation
-                );
-                // 이동(move) 사용하여 복사 방지
-                ifaceMethods.push_back(std::move(call));
-            }
-        }
+        // 해당 인터페이스의 메서드와 인자
+        auto it = methodArguments.find(iface.first);
         
         // 인터페이스 XML 생성
         xml += DBusXml::createInterface(
             iface.first,
             iface.second,
-            ifaceMethods,
+            it != methodArguments.end() ? it->second : std::map<std::string, std::vector<DBusArgument>>(),
             signals,
             1  // 들여쓰기 레벨
         );
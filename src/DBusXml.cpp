@@ -11,6 +11,20 @@ std::string DBusXml::createInterface(
     const std::vector<DBusMethodCall>& methods,
     const std::vector<DBusSignal>& signals,
     int indentLevel)
+{
+    std::map<std::string, std::vector<DBusArgument>> methodArguments;
+    for (const auto& method : methods) {
+        methodArguments[method.method];
+    }
+    return createInterface(name, properties, methodArguments, signals, indentLevel);
+}
+
+std::string DBusXml::createInterface(
+    const std::string& name,
+    const std::vector<DBusProperty>& properties,
+    const std::map<std::string, std::vector<DBusArgument>>& methods,
+    const std::vector<DBusSignal>& signals,
+    int indentLevel)
 {
     try {
         std::ostringstream xml;
@@ -24,7 +38,12 @@ std::string DBusXml::createInterface(
     
         // Methods
         for (const auto& method : methods) {
-            xml << createMethod(method.method, {}, {}, indentLevel + 2);
+            std::vector<DBusArgument> inArgs;
+            std::vector<DBusArgument> outArgs;
+            for (const auto& arg : method.second) {
+                (arg.direction == "out" ? outArgs : inArgs).push_back(arg);
+            }
+            xml << createMethod(method.first, inArgs, outArgs, indentLevel + 2);
         }
     
         // Signals
@@ -0,0 +1,373 @@
+#include "ExtendedAdvertiser.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace ggk {
+
+namespace {
+
+void appendLe24(std::vector<uint8_t>& buffer, uint32_t value) {
+    buffer.push_back(static_cast<uint8_t>(value & 0xFF));
+    buffer.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
+}
+
+} // namespace
+
+ExtendedAdvertiser::ExtendedAdvertiser(HciAdapter& adapter)
+    : adapter(adapter)
+    , maxDataLength(kMaxDataLength)
+    , supportedSets(1) {
+}
+
+ExtendedAdvertiser::~ExtendedAdvertiser() {
+}
+
+// Reads the controller's limits (number of sets, maximum data length)
+bool ExtendedAdvertiser::initialize() {
+    std::vector<HciCommandResult> results;
+    adapter.sendCommandBatch({
+        {CMD_LE_READ_MAX_ADV_DATA_LENGTH, {}},
+        {CMD_LE_READ_NUM_ADV_SETS, {}}
+    }, &results);
+
+    if (results.size() != 2 || !results[0].succeeded() || results[0].returnParameters.size() < 2 ||
+        !results[1].succeeded() || results[1].returnParameters.empty()) {
+        Logger::error("Controller does not support LE extended advertising");
+        return false;
+    }
+
+    maxDataLength = std::min<size_t>(hciLe16(results[0].returnParameters.data()), kMaxDataLength);
+    supportedSets = results[1].returnParameters[0];
+
+    Logger::info("Extended advertising: " + std::to_string(supportedSets) + " sets, up to " +
+                 std::to_string(maxDataLength) + " bytes of data");
+    return true;
+}
+
+// 빈 핸들 선택부터 세트 추가까지 잠금을 유지해 동시에 생성된 세트가 같은 핸들을 받지 않도록 함
+int ExtendedAdvertiser::createSet(const AdvertisingSetParameters& parameters) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    if (sets.size() >= supportedSets) {
+        Logger::error("No free advertising set (controller supports " + std::to_string(supportedSets) + ")");
+        return -1;
+    }
+
+    uint8_t handle = 0;
+    while (sets.count(handle) != 0 && handle < kMaxHandle) {
+        ++handle;
+    }
+
+    if (!setParametersLocked(handle, parameters)) {
+        return -1;
+    }
+
+    return handle;
+}
+
+// Changes the parameters of a (disabled) set
+//
+// LE Set Extended Advertising Parameters (0x2036):
+// [Handle][Properties(2)][Interval_Min(3)][Interval_Max(3)][Channel_Map][Own_Address_Type][Peer_Address_Type][Peer_Address(6)]
+// [Filter_Policy][TX_Power][Primary_PHY][Secondary_Max_Skip][Secondary_PHY][SID][Scan_Request_Notification_Enable]
+std::vector<uint8_t> ExtendedAdvertiser::encodeParameters(uint8_t handle, const AdvertisingSetParameters& parameters) {
+    std::vector<uint8_t> command;
+    command.reserve(25);
+
+    command.push_back(handle);
+    hciAppendLe16(command, parameters.eventProperties);
+    appendLe24(command, parameters.minInterval);
+    appendLe24(command, parameters.maxInterval);
+    command.push_back(parameters.channelMap);
+    command.push_back(parameters.ownAddressType);
+    command.push_back(0x00);                            // peer address type (방향성 광고 미사용)
+    command.insert(command.end(), 6, 0x00);             // peer address
+    command.push_back(parameters.filterPolicy);
+    command.push_back(static_cast<uint8_t>(parameters.txPower));
+    command.push_back(parameters.primaryPhy);
+    command.push_back(parameters.secondaryMaxSkip);
+    command.push_back(parameters.secondaryPhy);
+    command.push_back(parameters.sid);
+    command.push_back(parameters.scanRequestNotifications ? 0x01 : 0x00);
+
+    return command;
+}
+
+bool ExtendedAdvertiser::setParameters(uint8_t handle, const AdvertisingSetParameters& parameters) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+    return setParametersLocked(handle, parameters);
+}
+
+bool ExtendedAdvertiser::setParametersLocked(uint8_t handle, const AdvertisingSetParameters& parameters) {
+    if (handle > kMaxHandle) {
+        Logger::error("Invalid advertising handle " + std::to_string(handle));
+        return false;
+    }
+
+    if (parameters.primaryPhy == AdvertisingSetParameters::kPhy2M) {
+        Logger::error("The 2M PHY cannot be used as primary advertising PHY");
+        return false;
+    }
+
+    auto it = sets.find(handle);
+    if (it != sets.end() && it->second.enabled) {
+        Logger::error("Cannot change parameters of advertising set " + std::to_string(handle) + " while it is enabled");
+        return false;
+    }
+
+    std::vector<HciCommand> commands = {{CMD_LE_SET_EXT_ADV_PARAMETERS, encodeParameters(handle, parameters)}};
+    if (parameters.hasRandomAddress) {
+        std::vector<uint8_t> address = {handle};
+        address.insert(address.end(), parameters.randomAddress, parameters.randomAddress + 6);
+        commands.push_back({CMD_LE_SET_ADV_SET_RANDOM_ADDRESS, std::move(address)});
+    }
+
+    std::vector<HciCommandResult> results;
+    if (!adapter.sendCommandBatch(commands, &results)) {
+        Logger::error("Failed to configure advertising set " + std::to_string(handle));
+        return false;
+    }
+
+    AdvertisingSet& set = sets[handle];
+    set.parameters = parameters;
+    if (!results[0].returnParameters.empty()) {
+        set.selectedTxPower = static_cast<int8_t>(results[0].returnParameters[0]);
+    }
+
+    return true;
+}
+
+// Builds the LE Set Extended Advertising/Scan Response Data commands for `data`
+//
+// [Handle][Operation][Fragment_Preference][Data_Length][Data...]
+std::vector<HciCommand> ExtendedAdvertiser::fragmentData(uint16_t opcode, uint8_t handle, const uint8_t* pData, size_t size) {
+    std::vector<HciCommand> commands;
+
+    size_t offset = 0;
+    do {
+        size_t length = std::min(size - offset, kMaxFragmentLength);
+        bool first = offset == 0;
+        bool last = offset + length == size;
+
+        uint8_t operation;
+        if (first && last) {
+            operation = kOperationComplete;
+        } else if (first) {
+            operation = kOperationFirst;
+        } else if (last) {
+            operation = kOperationLast;
+        } else {
+            operation = kOperationIntermediate;
+        }
+
+        HciCommand command;
+        command.opcode = opcode;
+        command.parameters.reserve(4 + length);
+        command.parameters.push_back(handle);
+        command.parameters.push_back(operation);
+        command.parameters.push_back(0x01);    // 컨트롤러가 다시 분할하지 않도록 요청
+        command.parameters.push_back(static_cast<uint8_t>(length));
+        command.parameters.insert(command.parameters.end(), pData + offset, pData + offset + length);
+        commands.push_back(std::move(command));
+
+        offset += length;
+    } while (offset < size);
+
+    return commands;
+}
+
+bool ExtendedAdvertiser::setData(uint8_t handle, const std::vector<uint8_t>& data) {
+    return writeData(CMD_LE_SET_EXT_ADV_DATA, handle, data);
+}
+
+bool ExtendedAdvertiser::setScanResponseData(uint8_t handle, const std::vector<uint8_t>& data) {
+    return writeData(CMD_LE_SET_EXT_SCAN_RESPONSE_DATA, handle, data);
+}
+
+bool ExtendedAdvertiser::writeData(uint16_t opcode, uint8_t handle, const std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    auto it = sets.find(handle);
+    if (it == sets.end()) {
+        Logger::error("Unknown advertising set " + std::to_string(handle));
+        return false;
+    }
+
+    size_t limit = it->second.parameters.isLegacy() ? kMaxLegacyDataLength : maxDataLength;
+    if (data.size() > limit) {
+        Logger::error("Advertising data for set " + std::to_string(handle) + " too long (" +
+                      std::to_string(data.size()) + " > " + std::to_string(limit) + " bytes)");
+        return false;
+    }
+
+    // 광고 중에는 단일 조각(complete operation)만 허용됨
+    bool pause = it->second.enabled && data.size() > kMaxFragmentLength;
+    if (pause && !sendEnable(false, {handle}, 0, 0)) {
+        return false;
+    }
+
+    bool success = adapter.sendCommandBatch(fragmentData(opcode, handle, data.data(), data.size()));
+    if (!success) {
+        Logger::error("Failed to write advertising data for set " + std::to_string(handle));
+    }
+
+    if (pause && !sendEnable(true, {handle}, 0, 0)) {
+        it->second.enabled = false;
+        return false;
+    }
+
+    return success;
+}
+
+// LE Set Extended Advertising Enable (0x2039): [Enable][Num_Sets]{[Handle][Duration(2)][Max_Events]}...
+bool ExtendedAdvertiser::sendEnable(bool enable, const std::vector<uint8_t>& handles, uint32_t durationMs, uint8_t maxEvents) {
+    std::vector<uint8_t> command;
+    command.reserve(2 + handles.size() * 4);
+    command.push_back(enable ? 0x01 : 0x00);
+    command.push_back(static_cast<uint8_t>(handles.size()));
+
+    uint16_t duration = static_cast<uint16_t>(std::min<uint32_t>(durationMs / 10, 0xFFFF));
+    for (uint8_t handle : handles) {
+        command.push_back(handle);
+        hciAppendLe16(command, duration);
+        command.push_back(maxEvents);
+    }
+
+    HciCommandResult result = adapter.sendCommandSync(CMD_LE_SET_EXT_ADV_ENABLE, std::move(command));
+    if (!result.succeeded()) {
+        Logger::error(std::string("Failed to ") + (enable ? "enable" : "disable") + " advertising sets (status " +
+                      Utils::hex(result.status) + ")");
+        return false;
+    }
+
+    return true;
+}
+
+bool ExtendedAdvertiser::enable(uint8_t handle, uint32_t durationMs, uint8_t maxEvents) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    auto it = sets.find(handle);
+    if (it == sets.end()) {
+        Logger::error("Unknown advertising set " + std::to_string(handle));
+        return false;
+    }
+
+    if (!sendEnable(true, {handle}, durationMs, maxEvents)) {
+        return false;
+    }
+
+    it->second.enabled = true;
+    return true;
+}
+
+bool ExtendedAdvertiser::enable(const std::vector<uint8_t>& handles) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    for (uint8_t handle : handles) {
+        if (sets.count(handle) == 0) {
+            Logger::error("Unknown advertising set " + std::to_string(handle));
+            return false;
+        }
+    }
+
+    if (handles.empty() || !sendEnable(true, handles, 0, 0)) {
+        return false;
+    }
+
+    for (uint8_t handle : handles) {
+        sets[handle].enabled = true;
+    }
+    return true;
+}
+
+bool ExtendedAdvertiser::disable(uint8_t handle) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    auto it = sets.find(handle);
+    if (it == sets.end()) {
+        return false;
+    }
+
+    if (!sendEnable(false, {handle}, 0, 0)) {
+        return false;
+    }
+
+    it->second.enabled = false;
+    return true;
+}
+
+// Num_Sets = 0 disables every set
+bool ExtendedAdvertiser::disableAll() {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    if (!sendEnable(false, {}, 0, 0)) {
+        return false;
+    }
+
+    for (auto& entry : sets) {
+        entry.second.enabled = false;
+    }
+    return true;
+}
+
+bool ExtendedAdvertiser::removeSet(uint8_t handle) {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    auto it = sets.find(handle);
+    if (it == sets.end()) {
+        return false;
+    }
+
+    if (it->second.enabled && !sendEnable(false, {handle}, 0, 0)) {
+        return false;
+    }
+
+    if (!adapter.sendCommandSync(CMD_LE_REMOVE_ADV_SET, {handle}).succeeded()) {
+        Logger::error("Failed to remove advertising set " + std::to_string(handle));
+        return false;
+    }
+
+    sets.erase(it);
+    return true;
+}
+
+bool ExtendedAdvertiser::clear() {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    // 활성화된 세트가 있으면 Clear Advertising Sets가 거부됨
+    sendEnable(false, {}, 0, 0);
+
+    if (!adapter.sendCommandSync(CMD_LE_CLEAR_ADV_SETS, {}).succeeded()) {
+        Logger::error("Failed to clear advertising sets");
+        return false;
+    }
+
+    sets.clear();
+    return true;
+}
+
+bool ExtendedAdvertiser::isEnabled(uint8_t handle) const {
+    std::lock_guard<std::mutex> lock(setsMutex);
+    auto it = sets.find(handle);
+    return it != sets.end() && it->second.enabled;
+}
+
+std::vector<uint8_t> ExtendedAdvertiser::getSets() const {
+    std::lock_guard<std::mutex> lock(setsMutex);
+
+    std::vector<uint8_t> handles;
+    handles.reserve(sets.size());
+    for (const auto& entry : sets) {
+        handles.push_back(entry.first);
+    }
+    return handles;
+}
+
+int8_t ExtendedAdvertiser::getSelectedTxPower(uint8_t handle) const {
+    std::lock_guard<std::mutex> lock(setsMutex);
+    auto it = sets.find(handle);
+    return it != sets.end() ? it->second.selectedTxPower : AdvertisingSetParameters::kTxPowerNoPreference;
+}
+
+} // namespace ggk
@@ -0,0 +1,451 @@
+#include "FlightRecorder.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ggk {
+
+namespace {
+
+constexpr uint64_t kMask = FlightRecorder::kCapacity - 1;
+static_assert((FlightRecorder::kCapacity & kMask) == 0, "kCapacity must be a power of two");
+
+// One event; `sequence` is 2 * index + 1 while the slot is being written and 2 * index + 2 once it holds event `index`
+struct alignas(64) Slot {
+    std::atomic<uint64_t> sequence;
+    uint64_t timestampUs;
+    uint32_t threadId;
+    uint32_t value;
+    uint16_t code;
+    uint8_t category;
+    uint8_t length;
+    char text[FlightRecorder::kTextLength];
+};
+static_assert(sizeof(Slot) == 128, "Slot should span two cache lines");
+
+// Plain copy of a slot taken by the readers
+struct SlotCopy {
+    uint64_t index;
+    uint64_t timestampUs;
+    uint32_t threadId;
+    uint32_t value;
+    uint16_t code;
+    uint8_t category;
+    uint8_t length;
+    char text[FlightRecorder::kTextLength];
+};
+
+Slot g_slots[FlightRecorder::kCapacity];
+std::atomic<uint64_t> g_next(0);
+
+char g_dumpPath[FlightRecorder::kMaxPathLength] = "/tmp/ble-flight-recorder.txt";
+
+const int kFatalSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+constexpr size_t kFatalSignalCount = sizeof(kFatalSignals) / sizeof(kFatalSignals[0]);
+
+bool g_installed = false;
+struct sigaction g_previousUsr1;
+struct sigaction g_previousFatal[kFatalSignalCount];
+
+const char* const kCategoryNames[] = {"LOG", "GATT", "DBUS", "HCI_CMD", "HCI_EVT", "STATE", "HCI_CNT"};
+const char* const kGattOperationNames[] = {"?", "Read", "Write", "StartNotify", "StopNotify", "Notify"};
+const char* const kStateEventNames[] = {"?", "Connected", "Disconnected", "AdvertisingStarted", "AdvertisingStopped", "Signal"};
+
+constexpr uint16_t kEventCommandComplete = 0x0E;
+constexpr uint16_t kEventCommandStatus = 0x0F;
+
+// clock_gettime은 async-signal-safe
+uint64_t nowMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000u + static_cast<uint64_t>(now.tv_nsec) / 1000u;
+}
+
+// 0으로 초기화되는 thread_local이라 초기화 가드가 없음
+thread_local uint32_t t_threadId = 0;
+
+uint32_t currentThreadId() {
+    if (t_threadId == 0) {
+        t_threadId = static_cast<uint32_t>(syscall(SYS_gettid));
+    }
+    return t_threadId;
+}
+
+Slot& beginSlot(FlightRecorder::Category category, uint16_t code, uint32_t value, uint64_t& index) {
+    index = g_next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = g_slots[index & kMask];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestampUs = nowMicros();
+    slot.threadId = currentThreadId();
+    slot.value = value;
+    slot.code = code;
+    slot.category = static_cast<uint8_t>(category);
+    slot.length = 0;
+    return slot;
+}
+
+void appendText(Slot& slot, const char* pText, size_t length) {
+    size_t count = std::min(length, FlightRecorder::kTextLength - slot.length);
+    memcpy(slot.text + slot.length, pText, count);
+    slot.length = static_cast<uint8_t>(slot.length + count);
+}
+
+void endSlot(Slot& slot, uint64_t index) {
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+// Copies event `index` if the slot still holds it and was not rewritten during the copy
+bool readSlot(uint64_t index, SlotCopy& copy) {
+    const Slot& slot = g_slots[index & kMask];
+    uint64_t expected = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+
+    copy.index = index;
+    copy.timestampUs = slot.timestampUs;
+    copy.threadId = slot.threadId;
+    copy.value = slot.value;
+    copy.code = slot.code;
+    copy.category = slot.category;
+    copy.length = std::min<uint8_t>(slot.length, static_cast<uint8_t>(FlightRecorder::kTextLength));
+    memcpy(copy.text, slot.text, copy.length);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == expected;
+}
+
+// Oldest event index still in the ring
+uint64_t firstIndex(uint64_t next) {
+    return next > FlightRecorder::kCapacity ? next - FlightRecorder::kCapacity : 0;
+}
+
+// Fixed-size line builder without allocation or stdio (usable from signal handlers)
+class LineWriter {
+public:
+    void append(const char* pText, size_t length) {
+        size_t count = std::min(length, sizeof(buffer) - size);
+        memcpy(buffer + size, pText, count);
+        size += count;
+    }
+
+    void append(const char* pText) { append(pText, strlen(pText)); }
+
+    void append(char c) { append(&c, 1); }
+
+    void appendDecimal(uint64_t value, size_t minimumDigits = 1) {
+        char digits[20];
+        size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0 || count < minimumDigits);
+        while (count > 0) {
+            append(digits[--count]);
+        }
+    }
+
+    void appendHex(uint64_t value, size_t digits) {
+        static const char kHex[] = "0123456789ABCDEF";
+        append("0x");
+        for (size_t i = digits; i > 0; --i) {
+            append(kHex[(value >> ((i - 1) * 4)) & 0x0F]);
+        }
+    }
+
+    void padTo(size_t column) {
+        while (size < column) {
+            append(' ');
+        }
+    }
+
+    const char* data() const { return buffer; }
+    size_t length() const { return size; }
+
+private:
+    char buffer[256];
+    size_t size = 0;
+};
+
+const char* nameAt(const char* const* pNames, size_t count, size_t index) {
+    return index < count ? pNames[index] : "?";
+}
+
+// "<seq> <sec>.<usec> [<tid>] <CATEGORY> <내용>"
+void formatLine(const SlotCopy& copy, LineWriter& line) {
+    line.appendDecimal(copy.index + 1);
+    line.append(' ');
+    line.appendDecimal(copy.timestampUs / 1000000u);
+    line.append('.');
+    line.appendDecimal(copy.timestampUs % 1000000u, 6);
+    line.append(" [");
+    line.appendDecimal(copy.threadId);
+    line.append("] ");
+
+    size_t start = line.length();
+    line.append(FlightRecorder::categoryName(static_cast<FlightRecorder::Category>(copy.category)));
+    line.padTo(start + 8);
+
+    switch (static_cast<FlightRecorder::Category>(copy.category)) {
+        case FlightRecorder::Category::Log:
+            line.append(Logger::levelName(static_cast<LogLevel>(copy.code)));
+            break;
+        case FlightRecorder::Category::Gatt:
+            line.append(nameAt(kGattOperationNames, sizeof(kGattOperationNames) / sizeof(kGattOperationNames[0]), copy.code));
+            line.append(" length=");
+            line.appendDecimal(copy.value);
+            break;
+        case FlightRecorder::Category::DBus:
+            break;
+        case FlightRecorder::Category::HciCommand:
+            line.append("opcode=");
+            line.appendHex(copy.code, 4);
+            line.append(" length=");
+            line.appendDecimal(copy.value);
+            break;
+        case FlightRecorder::Category::HciEvent:
+            line.append("event=");
+            line.appendHex(copy.code, copy.code > 0xFF ? 4 : 2);
+            if (copy.code == kEventCommandComplete || copy.code == kEventCommandStatus) {
+                line.append(" opcode=");
+                line.appendHex(copy.value >> 8, 4);
+                line.append(" status=");
+                line.appendHex(copy.value & 0xFF, 2);
+            } else {
+                line.append(" length=");
+                line.appendDecimal(copy.value);
+            }
+            break;
+        case FlightRecorder::Category::HciEventCount:
+            line.append("event=");
+            line.appendHex(copy.code, copy.code > 0xFF ? 4 : 2);
+            line.append(" count=");
+            line.appendDecimal(copy.value);
+            break;
+        case FlightRecorder::Category::State:
+            line.append(nameAt(kStateEventNames, sizeof(kStateEventNames) / sizeof(kStateEventNames[0]), copy.code));
+            line.append(" value=");
+            line.appendDecimal(copy.value);
+            break;
+        default:
+            line.append("code=");
+            line.appendHex(copy.code, 4);
+            break;
+    }
+
+    if (copy.length > 0) {
+        line.append(' ');
+        line.append(copy.text, copy.length);
+    }
+}
+
+bool writeAll(int fd, const char* pData, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, pData, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        pData += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+void logTap(LogLevel level, const char* pText) {
+    FlightRecorder::record(FlightRecorder::Category::Log, static_cast<uint16_t>(level), 0, pText);
+}
+
+void dumpSignalHandler(int) {
+    int savedErrno = errno;
+    FlightRecorder::dump();
+    errno = savedErrno;
+}
+
+// 기록을 남기고 기본 동작(코어 덤프 등)으로 다시 전달 (SA_RESETHAND로 이미 기본 핸들러로 복원됨)
+void fatalSignalHandler(int signal) {
+    FlightRecorder::record(FlightRecorder::Category::State, static_cast<uint16_t>(FlightRecorder::StateEvent::Signal),
+                           static_cast<uint32_t>(signal), "fatal signal");
+    FlightRecorder::dump();
+    raise(signal);
+}
+
+} // namespace
+
+void FlightRecorder::record(Category category, uint16_t code, uint32_t value, const char* pText) {
+    uint64_t index;
+    Slot& slot = beginSlot(category, code, value, index);
+    if (pText != nullptr) {
+        appendText(slot, pText, strnlen(pText, kTextLength));
+    }
+    endSlot(slot, index);
+}
+
+void FlightRecorder::record(Category category, uint16_t code, uint32_t value, const std::string& text) {
+    uint64_t index;
+    Slot& slot = beginSlot(category, code, value, index);
+    appendText(slot, text.data(), text.size());
+    endSlot(slot, index);
+}
+
+void FlightRecorder::record(Category category, uint16_t code, uint32_t value, std::initializer_list<const char*> parts) {
+    uint64_t index;
+    Slot& slot = beginSlot(category, code, value, index);
+    for (const char* pPart : parts) {
+        if (pPart != nullptr) {
+            appendText(slot, pPart, strnlen(pPart, kTextLength));
+        }
+    }
+    endSlot(slot, index);
+}
+
+bool FlightRecorder::install(const std::string& dumpPath, LogLevel logLevel) {
+    if (dumpPath.empty() || dumpPath.size() >= kMaxPathLength) {
+        Logger::error("Invalid flight recorder dump path: " + dumpPath);
+        return false;
+    }
+    if (g_installed) {
+        uninstall();
+    }
+    memcpy(g_dumpPath, dumpPath.c_str(), dumpPath.size() + 1);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = dumpSignalHandler;
+    action.sa_flags = SA_RESTART;
+    if (sigaction(SIGUSR1, &action, &g_previousUsr1) != 0) {
+        Logger::error("Failed to install the SIGUSR1 handler: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    action.sa_handler = fatalSignalHandler;
+    action.sa_flags = SA_RESETHAND | SA_NODEFER;
+    for (size_t i = 0; i < kFatalSignalCount; ++i) {
+        sigaction(kFatalSignals[i], &action, &g_previousFatal[i]);
+    }
+
+    Logger::setTap(&logTap, logLevel);
+    g_installed = true;
+
+    Logger::info("Flight recorder installed (dump with SIGUSR1 to " + dumpPath + ")");
+    return true;
+}
+
+void FlightRecorder::uninstall() {
+    if (!g_installed) {
+        return;
+    }
+    Logger::setTap(nullptr);
+    sigaction(SIGUSR1, &g_previousUsr1, nullptr);
+    for (size_t i = 0; i < kFatalSignalCount; ++i) {
+        sigaction(kFatalSignals[i], &g_previousFatal[i], nullptr);
+    }
+    g_installed = false;
+}
+
+bool FlightRecorder::dump() {
+    return dump(g_dumpPath);
+}
+
+bool FlightRecorder::dump(const char* pPath) {
+    int fd = open(pPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    dumpToFd(fd);
+    return close(fd) == 0;
+}
+
+size_t FlightRecorder::dumpToFd(int fd) {
+    uint64_t next = g_next.load(std::memory_order_acquire);
+
+    LineWriter header;
+    header.append("# flight recorder: pid ");
+    header.appendDecimal(static_cast<uint64_t>(getpid()));
+    header.append(", ");
+    header.appendDecimal(next);
+    header.append(" events recorded\n");
+    writeAll(fd, header.data(), header.length());
+
+    size_t count = 0;
+    SlotCopy copy;
+    for (uint64_t index = firstIndex(next); index < next; ++index) {
+        if (!readSlot(index, copy)) {
+            continue;
+        }
+        LineWriter line;
+        formatLine(copy, line);
+        line.append('\n');
+        if (!writeAll(fd, line.data(), line.length())) {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+std::vector<FlightRecorder::Record> FlightRecorder::snapshot() {
+    uint64_t next = g_next.load(std::memory_order_acquire);
+
+    std::vector<Record> records;
+    records.reserve(static_cast<size_t>(next - firstIndex(next)));
+
+    SlotCopy copy;
+    for (uint64_t index = firstIndex(next); index < next; ++index) {
+        if (!readSlot(index, copy)) {
+            continue;
+        }
+        Record record;
+        record.sequence = copy.index + 1;
+        record.timestampUs = copy.timestampUs;
+        record.threadId = copy.threadId;
+        record.category = static_cast<Category>(copy.category);
+        record.code = copy.code;
+        record.value = copy.value;
+        record.text.assign(copy.text, copy.length);
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+uint64_t FlightRecorder::getRecordedCount() {
+    return g_next.load(std::memory_order_relaxed);
+}
+
+const char* FlightRecorder::getDumpPath() {
+    return g_dumpPath;
+}
+
+const char* FlightRecorder::categoryName(Category category) {
+    return nameAt(kCategoryNames, sizeof(kCategoryNames) / sizeof(kCategoryNames[0]), static_cast<size_t>(category));
+}
+
+std::string FlightRecorder::toText(const Record& record) {
+    SlotCopy copy;
+    copy.index = record.sequence - 1;
+    copy.timestampUs = record.timestampUs;
+    copy.threadId = record.threadId;
+    copy.value = record.value;
+    copy.code = record.code;
+    copy.category = static_cast<uint8_t>(record.category);
+    copy.length = static_cast<uint8_t>(std::min(record.text.size(), kTextLength));
+    memcpy(copy.text, record.text.data(), copy.length);
+
+    LineWriter line;
+    formatLine(copy, line);
+    return std::string(line.data(), line.length());
+}
+
+} // namespace ggk
@@ -1,7 +1,12 @@
 // GattApplication.cpp
 #include "GattApplication.h"
+#include "FlightRecorder.h"
 #include "Logger.h"
+#include "StartupProfiler.h"
 #include "Utils.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 
 namespace ggk {
 
@@ -10,6 +15,7 @@ GattApplication::GattApplication(DBusConnection& connection, const DBusObjectPat
       registered(false) {
     // GattApplication 생성자에서 
     if (connection.isConnected()) {  // DBusObject가 아닌 connection에서 호출
+        StartupProfiler::Scope profile("gatt", "request_bus_name");
         try {
             // 고정된 D-Bus 이름 요청
             const std::string busName = "com.example.gatt";
@@ -18,10 +24,14 @@ GattApplication::GattApplication(DBusConnection& connection, const DBusObjectPat
                 DBusObjectPath("/org/freedesktop/DBus"),
                 "org.freedesktop.DBus",
                 "RequestName",
-                GVariantPtr(g_variant_new("(su)", busName.c_str(), 0), &g_variant_unref)
+                makeGVariantPtr(g_variant_ref_sink(g_variant_new("(su)", busName.c_str(), 0)))
             );
+            if (!result) {
+                profile.fail();
+            }
             Logger::info("Requested bus name: " + busName);
         } catch (const std::exception& e) {
+            profile.fail();
             Logger::error("Failed to request bus name: " + std::string(e.what()));
         }
     }
@@ -39,11 +49,19 @@ bool GattApplication::setupDBusInterfaces() {
                   [this](const DBusMethodCall& call) { 
                       Logger::info("GetManagedObjects called by BlueZ");
                       handleGetManagedObjects(call); 
-                  })) {
+                  },
+                  {{"a{oa{sa{sv}}}", "objects", "out", ""}})) {
         Logger::error("Failed to add GetManagedObjects method");
         return false;
     }
     
+    // 2-1. 플라이트 레코더 덤프 메서드 (예: busctl call <name> <path> com.example.gatt.FlightRecorder1 Dump)
+    if (!addInterface(FlightRecorder::kDBusInterface, {}) ||
+        !addMethod(FlightRecorder::kDBusInterface, "Dump", [](const DBusMethodCall& call) { handleDumpFlightRecorder(call); })) {
+        Logger::error("Failed to add FlightRecorder interface");
+        return false;
+    }
+
     // 3. 마지막으로 객체 등록
     if (!registerObject()) {
         Logger::error("Failed to register application object");
@@ -74,11 +92,26 @@ bool GattApplication::addService(GattServicePtr service) {
     
     // 서비스 추가
     services.push_back(service);
+    if (pConnectionTracker != nullptr) {
+        for (const auto& entry : service->getCharacteristics()) {
+            entry.second->setConnectionTracker(pConnectionTracker);
+        }
+    }
     
     Logger::info("Added service to application: " + uuidStr);
     return true;
 }
 
+void GattApplication::setConnectionTracker(ConnectionTracker* pTracker) {
+    std::lock_guard<std::mutex> lock(servicesMutex);
+    pConnectionTracker = pTracker;
+    for (const auto& service : services) {
+        for (const auto& entry : service->getCharacteristics()) {
+            entry.second->setConnectionTracker(pTracker);
+        }
+    }
+}
+
 bool GattApplication::removeService(const GattUuid& uuid) {
     std::string uuidStr = uuid.toString();
     
@@ -116,19 +149,28 @@ std::vector<GattServicePtr> GattApplication::getServices() const {
 }
 
 bool GattApplication::registerWithBlueZ() {
+    StartupProfiler::Scope profile("gatt", "register_application");
     try {
         if (registered) {
             Logger::info("Application already registered with BlueZ");
             return true;
         }
         
-        if (!setupDBusInterfaces()) {
-            Logger::error("Failed to setup D-Bus interfaces");
-            return false;
+        {
+            StartupProfiler::Scope profileSetup("gatt", "setup_interfaces");
+            if (!setupDBusInterfaces()) {
+                profileSetup.fail();
+                profile.fail();
+                Logger::error("Failed to setup D-Bus interfaces");
+                return false;
+            }
         }
 
         // D-Bus 메시지 큐가 처리될 시간 제공
-        usleep(100000); // 100ms 대기
+        {
+            StartupProfiler::Scope profileSettle("gatt", "settle_delay");
+            usleep(100000); // 100ms 대기
+        }
         
         // 가장 단순한 접근 방식으로 다시 시도
         // g_variant_new 함수로 직접 중첩 구조 생성
@@ -138,19 +180,14 @@ bool GattApplication::registerWithBlueZ() {
             NULL                       // 빈 딕셔너리
         );
         
-        // 스마트 포인터로 래핑
-        GVariantPtr parameters(params, &g_variant_unref);
-        
-        // 메서드 호출
-        GVariantPtr result = getConnection().callMethod(
-            BlueZConstants::BLUEZ_SERVICE,
-            DBusObjectPath(BlueZConstants::ADAPTER_PATH),
-            BlueZConstants::GATT_MANAGER_INTERFACE,
-            BlueZConstants::REGISTER_APPLICATION,
-            std::move(parameters)
-        );
+        // 스마트 포인터로 래핑 (플로팅 참조는 호출이 소비하므로 먼저 싱크)
+        GVariantPtr parameters(g_variant_ref_sink(params), &g_variant_unref);
         
-        if (!result) {
+        // 메서드 호출 (BlueZ는 GetManagedObjects로 트리를 읽은 뒤 응답)
+        StartupProfiler::Scope profileCall("gatt", "register_call");
+        if (!callRegisterApplication(std::move(parameters))) {
+            profileCall.fail();
+            profile.fail();
             Logger::error("Failed to register application with BlueZ");
             return false;
         }
@@ -159,11 +196,65 @@ bool GattApplication::registerWithBlueZ() {
         Logger::info("Successfully registered application with BlueZ");
         return true;
     } catch (const std::exception& e) {
+        profile.fail();
         Logger::error("Exception in registerWithBlueZ: " + std::string(e.what()));
         return false;
     }
 }
 
+// Calls RegisterApplication asynchronously and waits for the reply
+//
+// bluetoothd only replies after it has read the tree with GetManagedObjects, which is dispatched on the main context the objects
+// were registered on. A blocking call from the thread that owns that context would never answer it, so while waiting this
+// thread runs its thread-default context itself; if another thread is already running that context's loop, the walk and the
+// reply are dispatched there and this thread just waits.
+bool GattApplication::callRegisterApplication(GVariantPtr parameters) {
+    struct Reply {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+        bool success = false;
+    };
+    auto pReply = std::make_shared<Reply>();
+
+    GMainContext* pContext = g_main_context_ref_thread_default();
+    bool sent = getConnection().callMethodAsync(
+        BlueZConstants::BLUEZ_SERVICE,
+        DBusObjectPath(BlueZConstants::ADAPTER_PATH),
+        BlueZConstants::GATT_MANAGER_INTERFACE,
+        BlueZConstants::REGISTER_APPLICATION,
+        std::move(parameters),
+        [pReply](GVariantPtr result) {
+            std::lock_guard<std::mutex> lock(pReply->mutex);
+            pReply->done = true;
+            pReply->success = result != nullptr;
+            pReply->condition.notify_all();
+        });
+
+    if (sent) {
+        if (g_main_context_acquire(pContext)) {
+            // 응답 콜백도 이 컨텍스트에서 실행됨
+            while (true) {
+                {
+                    std::lock_guard<std::mutex> lock(pReply->mutex);
+                    if (pReply->done) {
+                        break;
+                    }
+                }
+                g_main_context_iteration(pContext, TRUE);
+            }
+            g_main_context_release(pContext);
+        } else {
+            std::unique_lock<std::mutex> lock(pReply->mutex);
+            pReply->condition.wait(lock, [&pReply]() { return pReply->done; });
+        }
+    }
+    g_main_context_unref(pContext);
+
+    std::lock_guard<std::mutex> lock(pReply->mutex);
+    return sent && pReply->success;
+}
+
 bool GattApplication::unregisterFromBlueZ() {
     try {
         // 등록되어 있지 않으면 성공으로 간주
@@ -173,7 +264,7 @@ bool GattApplication::unregisterFromBlueZ() {
         
         // 더 간단한 방식으로 매개변수 생성
         GVariant* params = g_variant_new("(o)", getPath().c_str());
-        GVariantPtr parameters(params, &g_variant_unref);
+        GVariantPtr parameters(g_variant_ref_sink(params), &g_variant_unref);
         
         GVariantPtr result = getConnection().callMethod(
             BlueZConstants::BLUEZ_SERVICE,
@@ -198,6 +289,22 @@ bool GattApplication::unregisterFromBlueZ() {
     }
 }
 
+// 링을 설정된 경로에 기록 (SIGUSR1과 같은 결과)
+void GattApplication::handleDumpFlightRecorder(const DBusMethodCall& call) {
+    if (!call.invocation) {
+        Logger::error("Invalid method invocation in FlightRecorder.Dump");
+        return;
+    }
+
+    if (FlightRecorder::dump()) {
+        Logger::info(std::string("Flight recorder dumped to ") + FlightRecorder::getDumpPath() + " by " + call.sender);
+        g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
+    } else {
+        g_dbus_method_invocation_return_error(call.invocation.get(), G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
+                                              "Cannot write %s", FlightRecorder::getDumpPath());
+    }
+}
+
 void GattApplication::handleGetManagedObjects(const DBusMethodCall& call) {
     Logger::info("GetManagedObjects called by BlueZ");
     try {
@@ -206,7 +313,7 @@ void GattApplication::handleGetManagedObjects(const DBusMethodCall& call) {
             return;
         }
         
-        Logger::debug("GetManagedObjects called for application: " + getPath().toString());
+        GGK_LOG_DEBUG(Gatt, "GetManagedObjects called for application: " << getPath().toString());
         
         // 관리 객체 딕셔너리 생성
         GVariantPtr result = createManagedObjectsDict();
@@ -222,8 +329,9 @@ void GattApplication::handleGetManagedObjects(const DBusMethodCall& call) {
             return;
         }
         
-        // 메서드 응답 생성 및 전송
-        g_dbus_method_invocation_return_value(call.invocation.get(), result.get());
+        // 메서드 응답 생성 및 전송 (응답은 튜플, 딕셔너리는 튜플이 참조를 하나 더 잡음)
+        GVariant* pResult = result.get();
+        g_dbus_method_invocation_return_value(call.invocation.get(), g_variant_new_tuple(&pResult, 1));
         
     } catch (const std::exception& e) {
         Logger::error("Exception in handleGetManagedObjects: " + std::string(e.what()));
@@ -451,13 +559,15 @@ GVariantPtr GattApplication::createManagedObjectsDict() const {
     GVariant* result = g_variant_builder_end(&objects_builder);
     Logger::info("Successfully created managed objects dictionary");
     
-    // 디버깅 목적으로 출력
-    char* debug_str = g_variant_print(result, TRUE);
-    Logger::debug("Managed objects dictionary: " + std::string(debug_str));
-    g_free(debug_str);
+    // 디버깅 목적으로 출력 (트리 전체를 텍스트로 변환하므로 debug 레벨에서만)
+    if (Logger::isEnabled(LogLevel::Debug, LogModule::Gatt)) {
+        char* debug_str = g_variant_print(result, TRUE);
+        GGK_LOG_DEBUG(Gatt, "Managed objects dictionary: " << debug_str);
+        g_free(debug_str);
+    }
     
-    // 스마트 포인터로 래핑하여 반환
-    return GVariantPtr(result, &g_variant_unref);
+    // 스마트 포인터로 래핑하여 반환 (부동 참조를 소유 참조로)
+    return GVariantPtr(g_variant_ref_sink(result), &g_variant_unref);
 }
 
 } // namespace ggk
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "GattCharacteristic.h"
 #include "GattService.h"
 #include "GattDescriptor.h"
+#include "ConnectionTracker.h"
+#include "FlightRecorder.h"
 #include "Logger.h"
+#include "BinaryLog.h"
 #include "Utils.h"
 #include "DBusMessage.h"
+#include "GVariantCodec.h"
 
 namespace ggk {
 
@@ -55,6 +59,12 @@ void GattCharacteristic::setValue(const std::vector<uint8_t>& newValue) {
                         Logger::error("Exception in notify callback: " + std::string(e.what()));
                     }
                 }
+                if (trafficCallback) {
+                    trafficCallback(value.size());
+                }
+                FlightRecorder::record(FlightRecorder::Category::Gatt,
+                                       static_cast<uint16_t>(FlightRecorder::GattOperation::Notify),
+                                       static_cast<uint32_t>(value.size()), uuid.toString());
             }
             
             // Value 속성 변경 알림 - 속성이 공개되어 있는 경우에만
@@ -65,6 +75,22 @@ void GattCharacteristic::setValue(const std::vector<uint8_t>& newValue) {
     }
 }
 
+bool GattCharacteristic::notifyValue(const std::vector<uint8_t>& newValue, std::chrono::milliseconds timeout) {
+    // 콜백은 대기할 수 있으므로 잠금 없이 호출
+    GattCreditCallback credit;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        credit = creditCallback;
+    }
+
+    if (credit && isNotifying() && !credit(newValue.size(), timeout)) {
+        return false;
+    }
+
+    setValue(newValue);
+    return true;
+}
+
 GattDescriptorPtr GattCharacteristic::createDescriptor(
     const GattUuid& uuid,
     uint8_t permissions
@@ -74,8 +100,7 @@ GattDescriptorPtr GattCharacteristic::createDescriptor(
         return nullptr;
     }
     
-    Logger::debug("Creating descriptor UUID: " + uuid.toString() + 
-                 ", permissions: " + Utils::hex(permissions));
+    GGK_LOG_DEBUG(Gatt, "Creating descriptor UUID: " << uuid.toString() << ", permissions: " << Utils::hex(permissions));
 
     std::string uuidStr = uuid.toString();
     
@@ -110,7 +135,7 @@ GattDescriptorPtr GattCharacteristic::createDescriptor(
             return nullptr;
         }
         
-        Logger::debug("About to setup descriptor DBus interfaces");
+        GGK_LOG_DEBUG(Gatt, "About to setup descriptor DBus interfaces");
         // 설명자 등록
         if (!descriptor->setupDBusInterfaces()) {
             Logger::error("Failed to setup descriptor interfaces for: " + uuidStr);
@@ -120,7 +145,7 @@ GattDescriptorPtr GattCharacteristic::createDescriptor(
         // 맵에 추가
         descriptors[uuidStr] = descriptor;
         
-        Logger::info("Created descriptor: " + uuidStr + " at path: " + descriptorPath.toString());
+        GGK_LOG_INFO(Gatt, "Created descriptor: " << uuidStr << " at path: " << descriptorPath.toString());
         return descriptor;
     } catch (const std::exception& e) {
         Logger::error("Exception during descriptor creation: " + std::string(e.what()));
@@ -272,15 +297,17 @@ bool GattCharacteristic::setupDBusInterfaces() {
         return false;
     }
     
-    // 메서드 핸들러 등록
+    // 메서드 핸들러 등록 (인자는 BlueZ API: ReadValue(a{sv} options) -> ay, WriteValue(ay value, a{sv} options))
     if (!addMethod(BlueZConstants::GATT_CHARACTERISTIC_INTERFACE, "ReadValue", 
-                  [this](const DBusMethodCall& call) { handleReadValue(call); })) {
+                  [this](const DBusMethodCall& call) { handleReadValue(call); },
+                  {{"a{sv}", "options", "in", ""}, {"ay", "value", "out", ""}})) {
         Logger::error("Failed to add ReadValue method");
         return false;
     }
     
     if (!addMethod(BlueZConstants::GATT_CHARACTERISTIC_INTERFACE, "WriteValue", 
-                  [this](const DBusMethodCall& call) { handleWriteValue(call); })) {
+                  [this](const DBusMethodCall& call) { handleWriteValue(call); },
+                  {{"ay", "value", "in", ""}, {"a{sv}", "options", "in", ""}})) {
         Logger::error("Failed to add WriteValue method");
         return false;
     }
@@ -303,7 +330,7 @@ bool GattCharacteristic::setupDBusInterfaces() {
         return false;
     }
     
-    Logger::info("Registered GATT characteristic: " + uuid.toString());
+    GGK_LOG_INFO(Gatt, "Registered GATT characteristic: " << uuid.toString());
     return true;
 }
 
@@ -313,11 +340,16 @@ void GattCharacteristic::handleReadValue(const DBusMethodCall& call) {
         return;
     }
     
-    Logger::debug("ReadValue called for characteristic: " + uuid.toString());
+    GGK_BLOG_DEBUG(Gatt, "ReadValue called for characteristic: {}", uuid.toString());
     
     try {
-        // 옵션 파라미터 처리 (예: offset)
-        // 실제 구현에서는 이 부분을 확장해야 함
+        // 옵션 파라미터 처리: 연결 테이블이 있을 때만 풀어서 MTU를 반영 (offset은 아직 처리하지 않음)
+        if (getConnectionTracker() != nullptr && call.parameters &&
+            g_variant_is_of_type(call.parameters.get(), G_VARIANT_TYPE("(a{sv})"))) {
+            GVariantPtr options = makeGVariantPtr(g_variant_get_child_value(call.parameters.get(), 0));
+            GattRequestOptions parsed = GattRequestOptions::parse(options.get());
+            reportMtu(parsed.pDevice, parsed.mtu);
+        }
         
         std::vector<uint8_t> returnValue;
         
@@ -344,13 +376,14 @@ void GattCharacteristic::handleReadValue(const DBusMethodCall& call) {
             }
         }
         
-        // 결과 반환
-        GVariantPtr resultVariant(
-            Utils::gvariantFromByteArray(returnValue.data(), returnValue.size()),
-            &g_variant_unref
-        );
+        GGK_BLOG_TRACE(Gatt, "ReadValue returned {} bytes for characteristic {}: {}", returnValue.size(), uuid.toString(), returnValue);
+        FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::Read),
+                               static_cast<uint32_t>(returnValue.size()), uuid.toString());
+
+        // 결과 반환 (응답은 튜플 "(ay)"; 부동 참조는 튜플과 응답이 차례로 가져감)
+        GVariant* pResult = Utils::gvariantFromByteArray(returnValue.data(), returnValue.size());
         
-        if (!resultVariant) {
+        if (!pResult) {
             Logger::error("Failed to create GVariant for read response");
             g_dbus_method_invocation_return_error_literal(
                 call.invocation.get(),
@@ -362,7 +395,7 @@ void GattCharacteristic::handleReadValue(const DBusMethodCall& call) {
         }
         
         // 메서드 응답 생성 및 전송
-        g_dbus_method_invocation_return_value(call.invocation.get(), resultVariant.get());
+        g_dbus_method_invocation_return_value(call.invocation.get(), g_variant_new_tuple(&pResult, 1));
         
     } catch (const std::exception& e) {
         Logger::error("Exception in ReadValue: " + std::string(e.what()));
@@ -375,13 +408,25 @@ void GattCharacteristic::handleReadValue(const DBusMethodCall& call) {
     }
 }
 
+void GattCharacteristic::reportMtu(const char* pDevice, uint16_t mtu) {
+    ConnectionTracker* pTracker = getConnectionTracker();
+    uint8_t address[6];
+    if (pTracker == nullptr || mtu == 0 || !ConnectionTracker::parseDevicePath(pDevice, address)) {
+        return;
+    }
+
+    if (!pTracker->updateMtu(address, mtu)) {
+        GGK_LOG_DEBUG(Gatt, "No LE connection for " << pDevice << " (MTU " << mtu << ")");
+    }
+}
+
 void GattCharacteristic::handleWriteValue(const DBusMethodCall& call) {
     if (!call.invocation) {
         Logger::error("Invalid method invocation in WriteValue");
         return;
     }
     
-    Logger::debug("WriteValue called for characteristic: " + uuid.toString());
+    GGK_BLOG_DEBUG(Gatt, "WriteValue called for characteristic: {}", uuid.toString());
     
     // 파라미터 확인
     if (!call.parameters) {
@@ -397,59 +442,102 @@ void GattCharacteristic::handleWriteValue(const DBusMethodCall& call) {
         return;
     }
     
-    // 바이트 배열 파라미터 추출
-    try {
-        std::string byteString = Utils::stringFromGVariantByteArray(call.parameters.get());
-        std::vector<uint8_t> newValue(byteString.begin(), byteString.end());
-        
-        // 콜백이 있으면 호출
-        bool success = true;
-        {
-            std::lock_guard<std::mutex> callbackLock(callbackMutex);
-            if (writeCallback) {
-                try {
-                    success = writeCallback(newValue);
-                } catch (const std::exception& e) {
-                    Logger::error("Exception in write callback: " + std::string(e.what()));
-                    g_dbus_method_invocation_return_error_literal(
-                        call.invocation.get(),
-                        G_DBUS_ERROR,
-                        G_DBUS_ERROR_FAILED,
-                        e.what()
-                    );
-                    return;
+    // 값은 파라미터 GVariant를 직접 가리킴 (복사 없음)
+    GattWriteRequest request;
+    if (!GattWriteRequest::parse(call.parameters.get(), request)) {
+        Logger::error("Invalid WriteValue parameters for characteristic: " + uuid.toString());
+        g_dbus_method_invocation_return_error_literal(
+            call.invocation.get(),
+            G_DBUS_ERROR,
+            G_DBUS_ERROR_INVALID_ARGS,
+            "Invalid parameters"
+        );
+        return;
+    }
+
+    if (getConnectionTracker() != nullptr) {
+        reportMtu(request.device(), request.mtu());
+    }
+
+    // 콜백 호출: 요청 콜백은 뷰를 받고, 기존 쓰기 콜백은 벡터 사본을 받아 항상 저장
+    bool success = true;
+    std::vector<uint8_t> copiedValue;
+    bool copied = false;
+    {
+        std::lock_guard<std::mutex> callbackLock(callbackMutex);
+        try {
+            if (writeRequestCallback) {
+                success = writeRequestCallback(request);
+            } else {
+                copiedValue.assign(request.pData, request.pData + request.size);
+                copied = true;
+                request.store = true;
+                if (writeCallback) {
+                    success = writeCallback(copiedValue);
                 }
             }
-        }
-        
-        if (success) {
-            // 성공적으로 처리됨
-            {
-                std::lock_guard<std::mutex> valueLock(valueMutex);
-                value = newValue;
-            }
-            
-            // 빈 응답 생성 및 전송
-            g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
-        } else {
-            // 콜백에서 실패 반환
+        } catch (const std::exception& e) {
+            Logger::error("Exception in write callback: " + std::string(e.what()));
             g_dbus_method_invocation_return_error_literal(
                 call.invocation.get(),
                 G_DBUS_ERROR,
                 G_DBUS_ERROR_FAILED,
-                "Write operation failed"
+                e.what()
             );
+            return;
         }
-    } catch (const std::exception& e) {
-        Logger::error("Failed to parse WriteValue parameters: " + std::string(e.what()));
-        
+    }
+
+    GGK_BLOG_TRACE(Gatt, "WriteValue of {} bytes at offset {} to characteristic {} {}: {}", request.size, request.offset(),
+                   uuid.toString(), success ? "accepted" : "rejected", GVariantBytes(request.pData, request.size));
+    FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::Write),
+                           static_cast<uint32_t>(request.size),
+                           {uuid.toString().c_str(), success ? " accepted" : " rejected"});
+
+    if (!success) {
+        // 콜백에서 실패 반환
         g_dbus_method_invocation_return_error_literal(
             call.invocation.get(),
             G_DBUS_ERROR,
-            G_DBUS_ERROR_INVALID_ARGS,
-            "Invalid parameters"
+            G_DBUS_ERROR_FAILED,
+            "Write operation failed"
         );
+        return;
+    }
+
+    if (request.store) {
+        bool stored;
+        if (copied && request.offset() == 0) {
+            std::lock_guard<std::mutex> valueLock(valueMutex);
+            value = std::move(copiedValue);
+            stored = true;
+        } else {
+            stored = storeWrittenValue(request.pData, request.size, request.offset());
+        }
+
+        if (!stored) {
+            g_dbus_method_invocation_return_error_literal(
+                call.invocation.get(),
+                G_DBUS_ERROR,
+                G_DBUS_ERROR_INVALID_ARGS,
+                "Invalid offset"
+            );
+            return;
+        }
+    }
+
+    // 빈 응답 생성 및 전송
+    g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
+}
+
+bool GattCharacteristic::storeWrittenValue(const uint8_t* pData, size_t size, uint16_t offset) {
+    std::lock_guard<std::mutex> valueLock(valueMutex);
+    if (offset > value.size()) {
+        return false;
     }
+    value.resize(offset);
+    value.insert(value.end(), pData, pData + size);
+    return true;
 }
 
 void GattCharacteristic::handleStartNotify(const DBusMethodCall& call) {
@@ -458,7 +546,9 @@ void GattCharacteristic::handleStartNotify(const DBusMethodCall& call) {
         return;
     }
     
-    Logger::debug("StartNotify called for characteristic: " + uuid.toString());
+    GGK_BLOG_DEBUG(Gatt, "StartNotify called for characteristic: {}", uuid.toString());
+    FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::StartNotify), 0,
+                           uuid.toString());
     
     if (startNotify()) {
         // 성공 응답
@@ -480,7 +570,9 @@ void GattCharacteristic::handleStopNotify(const DBusMethodCall& call) {
         return;
     }
     
-    Logger::debug("StopNotify called for characteristic: " + uuid.toString());
+    GGK_BLOG_DEBUG(Gatt, "StopNotify called for characteristic: {}", uuid.toString());
+    FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::StopNotify), 0,
+                           uuid.toString());
     
     if (stopNotify()) {
         // 성공 응답
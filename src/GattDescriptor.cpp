@@ -1,6 +1,9 @@
 #include "GattDescriptor.h"
 #include "GattCharacteristic.h"
+#include "GattWriteRequest.h"
+#include "FlightRecorder.h"
 #include "Logger.h"
+#include "BinaryLog.h"
 #include "Utils.h"
 
 namespace ggk {
@@ -99,15 +102,17 @@ bool GattDescriptor::setupDBusInterfaces() {
         return false;
     }
     
-    // 메서드 핸들러 등록
+    // 메서드 핸들러 등록 (인자는 BlueZ API: ReadValue(a{sv} options) -> ay, WriteValue(ay value, a{sv} options))
     if (!addMethod(BlueZConstants::GATT_DESCRIPTOR_INTERFACE, "ReadValue", 
-                  [this](const DBusMethodCall& call) { handleReadValue(call); })) {
+                  [this](const DBusMethodCall& call) { handleReadValue(call); },
+                  {{"a{sv}", "options", "in", ""}, {"ay", "value", "out", ""}})) {
         Logger::error("Failed to add ReadValue method");
         return false;
     }
     
     if (!addMethod(BlueZConstants::GATT_DESCRIPTOR_INTERFACE, "WriteValue", 
-                  [this](const DBusMethodCall& call) { handleWriteValue(call); })) {
+                  [this](const DBusMethodCall& call) { handleWriteValue(call); },
+                  {{"ay", "value", "in", ""}, {"a{sv}", "options", "in", ""}})) {
         Logger::error("Failed to add WriteValue method");
         return false;
     }
@@ -118,7 +123,7 @@ bool GattDescriptor::setupDBusInterfaces() {
         return false;
     }
     
-    Logger::info("Registered GATT descriptor: " + uuid.toString());
+    GGK_LOG_INFO(Gatt, "Registered GATT descriptor: " << uuid.toString());
     return true;
 }
 
@@ -128,7 +133,7 @@ void GattDescriptor::handleReadValue(const DBusMethodCall& call) {
         return;
     }
     
-    Logger::debug("ReadValue called for descriptor: " + uuid.toString());
+    GGK_BLOG_DEBUG(Gatt, "ReadValue called for descriptor: {}", uuid.toString());
     
     try {
         // 옵션 파라미터 처리 (예: offset)
@@ -159,13 +164,14 @@ void GattDescriptor::handleReadValue(const DBusMethodCall& call) {
             }
         }
         
-        // 결과 반환
-        GVariantPtr resultVariant(
-            Utils::gvariantFromByteArray(returnValue.data(), returnValue.size()),
-            &g_variant_unref
-        );
+        GGK_BLOG_TRACE(Gatt, "ReadValue returned {} bytes for descriptor {}: {}", returnValue.size(), uuid.toString(), returnValue);
+        FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::Read),
+                               static_cast<uint32_t>(returnValue.size()), uuid.toString());
+
+        // 결과 반환 (응답은 튜플 "(ay)"; 부동 참조는 튜플과 응답이 차례로 가져감)
+        GVariant* pResult = Utils::gvariantFromByteArray(returnValue.data(), returnValue.size());
         
-        if (!resultVariant) {
+        if (!pResult) {
             Logger::error("Failed to create GVariant for descriptor read response");
             g_dbus_method_invocation_return_error_literal(
                 call.invocation.get(),
@@ -177,7 +183,7 @@ void GattDescriptor::handleReadValue(const DBusMethodCall& call) {
         }
         
         // 메서드 응답 생성 및 전송
-        g_dbus_method_invocation_return_value(call.invocation.get(), resultVariant.get());
+        g_dbus_method_invocation_return_value(call.invocation.get(), g_variant_new_tuple(&pResult, 1));
         
     } catch (const std::exception& e) {
         Logger::error("Exception in descriptor ReadValue: " + std::string(e.what()));
@@ -196,7 +202,7 @@ void GattDescriptor::handleWriteValue(const DBusMethodCall& call) {
         return;
     }
     
-    Logger::debug("WriteValue called for descriptor: " + uuid.toString());
+    GGK_BLOG_DEBUG(Gatt, "WriteValue called for descriptor: {}", uuid.toString());
     
     // 파라미터 확인
     if (!call.parameters) {
@@ -212,10 +218,13 @@ void GattDescriptor::handleWriteValue(const DBusMethodCall& call) {
         return;
     }
     
-    // 바이트 배열 파라미터 추출
+    // 바이트 배열 파라미터 추출 (설명자 값은 짧고 setValue가 사본을 보관하므로 벡터로 한 번만 복사)
     try {
-        std::string byteString = Utils::stringFromGVariantByteArray(call.parameters.get());
-        std::vector<uint8_t> newValue(byteString.begin(), byteString.end());
+        GattWriteRequest request;
+        if (!GattWriteRequest::parse(call.parameters.get(), request)) {
+            throw std::invalid_argument("expected (aya{sv})");
+        }
+        std::vector<uint8_t> newValue(request.pData, request.pData + request.size);
         
         // 콜백이 있으면 호출
         bool success = true;
@@ -237,6 +246,12 @@ void GattDescriptor::handleWriteValue(const DBusMethodCall& call) {
             }
         }
         
+        GGK_BLOG_TRACE(Gatt, "WriteValue of {} bytes to descriptor {} {}: {}", newValue.size(), uuid.toString(),
+                       success ? "accepted" : "rejected", newValue);
+        FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::Write),
+                               static_cast<uint32_t>(newValue.size()),
+                               {uuid.toString().c_str(), success ? " accepted" : " rejected"});
+
         if (success) {
             // 성공적으로 처리됨
             setValue(newValue); // setValue를 통해 특성의 알림 상태 업데이트
@@ -286,7 +301,7 @@ GVariant* GattDescriptor::getPermissionsProperty() {
     try {
         std::vector<std::string> flags;
 
-        Logger::debug("Descriptor permissions flags count: " + std::to_string(flags.size()));
+        GGK_LOG_DEBUG(Gatt, "Descriptor permissions flags count: " << flags.size());
         
         if (permissions & GattPermission::PERM_READ) {
             flags.push_back("read");
@@ -68,7 +68,7 @@ GattCharacteristicPtr GattService::createCharacteristic(
         // 맵에 추가
         characteristics[uuidStr] = characteristic;
         
-        Logger::info("Created characteristic: " + uuidStr + " at path: " + charPath.toString());
+        GGK_LOG_INFO(Gatt, "Created characteristic: " << uuidStr << " at path: " << charPath.toString());
         return characteristic;
     } catch (const std::exception& e) {
         Logger::error("Exception during characteristic creation: " + std::string(e.what()));
@@ -135,7 +135,7 @@ bool GattService::setupDBusInterfaces() {
         return false;
     }
     
-    Logger::info("Registered GATT service: " + uuid.toString());
+    GGK_LOG_INFO(Gatt, "Registered GATT service: " << uuid.toString());
     return true;
 }
 
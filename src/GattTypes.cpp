@@ -33,7 +33,7 @@ GattUuid GattUuid::fromShortUuid(uint16_t shortUuid) {
     return GattUuid(buffer);
 }
 
-std::string GattUuid::toString() const {
+const std::string& GattUuid::toString() const {
     return uuid;
 }
 
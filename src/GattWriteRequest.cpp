@@ -0,0 +1,101 @@
+#include "GattWriteRequest.h"
+
+#include <cstring>
+
+#include "GVariantCodec.h"
+
+namespace ggk {
+
+namespace {
+
+constexpr const char* kParametersType = "(aya{sv})";
+
+} // namespace
+
+const char* GattWriteRequest::device() const {
+    return options().pDevice;
+}
+
+const char* GattWriteRequest::type() const {
+    return options().pType;
+}
+
+uint16_t GattWriteRequest::offset() const {
+    return options().offset;
+}
+
+uint16_t GattWriteRequest::mtu() const {
+    return options().mtu;
+}
+
+bool GattWriteRequest::isPreparedWrite() const {
+    return options().preparedWrite;
+}
+
+bool GattWriteRequest::isCommand() const {
+    return strcmp(type(), "command") == 0;
+}
+
+GVariantPtr GattWriteRequest::hold() const {
+    return makeGVariantPtr(pParameters != nullptr ? g_variant_ref(pParameters) : nullptr);
+}
+
+bool GattWriteRequest::parse(GVariant* pParameters, GattWriteRequest& request) {
+    // 타입 문자열 비교가 g_variant_is_of_type보다 빠름 (정확한 타입만 허용)
+    if (pParameters == nullptr || strcmp(g_variant_get_type_string(pParameters), kParametersType) != 0) {
+        return false;
+    }
+
+    request = GattWriteRequest();
+    request.pParameters = pParameters;
+
+    GVariantPtr value = makeGVariantPtr(g_variant_get_child_value(pParameters, 0));
+    GVariantBytes bytes;
+    fromGVariant(value.get(), bytes);
+    request.pData = bytes.data;
+    request.size = bytes.size;
+    return true;
+}
+
+const GattRequestOptions& GattWriteRequest::options() const {
+    if (optionsParsed || pParameters == nullptr) {
+        return parsedOptions;
+    }
+    optionsParsed = true;
+
+    // 컨테이너의 자식은 부모의 데이터를 공유하므로 부모가 살아 있는 동안 문자열 포인터가 유효
+    GVariantPtr dictionary = makeGVariantPtr(g_variant_get_child_value(pParameters, 1));
+    parsedOptions = GattRequestOptions::parse(dictionary.get());
+    return parsedOptions;
+}
+
+GattRequestOptions GattRequestOptions::parse(GVariant* pDictionary) {
+    GattRequestOptions options;
+    if (pDictionary == nullptr || !g_variant_is_of_type(pDictionary, G_VARIANT_TYPE("a{sv}"))) {
+        return options;
+    }
+
+    size_t count = g_variant_n_children(pDictionary);
+    for (size_t i = 0; i < count; ++i) {
+        GVariantPtr entry = makeGVariantPtr(g_variant_get_child_value(pDictionary, i));
+        GVariantPtr key = makeGVariantPtr(g_variant_get_child_value(entry.get(), 0));
+        GVariantPtr boxed = makeGVariantPtr(g_variant_get_child_value(entry.get(), 1));
+        GVariantPtr option = makeGVariantPtr(g_variant_get_variant(boxed.get()));
+        const char* pKey = g_variant_get_string(key.get(), nullptr);
+
+        if (strcmp(pKey, "device") == 0 && g_variant_is_of_type(option.get(), G_VARIANT_TYPE("o"))) {
+            options.pDevice = g_variant_get_string(option.get(), nullptr);
+        } else if (strcmp(pKey, "type") == 0 && g_variant_is_of_type(option.get(), G_VARIANT_TYPE("s"))) {
+            options.pType = g_variant_get_string(option.get(), nullptr);
+        } else if (strcmp(pKey, "offset") == 0) {
+            fromGVariant(option.get(), options.offset);
+        } else if (strcmp(pKey, "mtu") == 0) {
+            fromGVariant(option.get(), options.mtu);
+        } else if (strcmp(pKey, "prepare-authorize") == 0) {
+            fromGVariant(option.get(), options.preparedWrite);
+        }
+    }
+    return options;
+}
+
+} // namespace ggk
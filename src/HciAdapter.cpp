@@ -1,10 +1,33 @@
 #include "HciAdapter.h"
+#include "FlightRecorder.h"
+#include "StartupProfiler.h"
+#include <algorithm>
 #include <string.h>
 
 namespace ggk {
 
-HciAdapter::HciAdapter() 
-    : isRunning(false) {
+HciAdapter::HciAdapter(uint16_t deviceIndex)
+    : deviceIndex(deviceIndex)
+    , commandQueue(hciSocket)
+    , isRunning(false)
+    , maxSupportedTxOctets(251)
+    , maxSupportedTxTime(17040) {
+    linkPolicies[kDefaultDeviceClass] = LinkPolicy::throughput();
+
+    connectionTracker.attach(eventDecoder);
+    aclFlowControl.attach(eventDecoder, connectionTracker);
+    connectionTracker.addListener([this](ConnectionTracker::LinkEvent event, const LinkState& state) {
+        if (event == ConnectionTracker::LinkEvent::Connected) {
+            FlightRecorder::record(FlightRecorder::Category::State,
+                                   static_cast<uint16_t>(FlightRecorder::StateEvent::Connected), state.handle,
+                                   state.addressString());
+            applyLinkPolicy(state);
+        } else if (event == ConnectionTracker::LinkEvent::Disconnected) {
+            FlightRecorder::record(FlightRecorder::Category::State,
+                                   static_cast<uint16_t>(FlightRecorder::StateEvent::Disconnected), state.handle,
+                                   state.addressString());
+        }
+    });
 }
 
 HciAdapter::~HciAdapter() {
@@ -12,15 +35,30 @@ HciAdapter::~HciAdapter() {
 }
 
 bool HciAdapter::initialize() {
-    if (!hciSocket.connect()) {
-        Logger::error("Failed to connect HCI socket");
-        return false;
+    StartupProfiler::Scope profile("hci", "initialize");
+    {
+        StartupProfiler::Scope profileOpen("hci", "open_socket");
+        if (!hciSocket.connect(deviceIndex)) {
+            profileOpen.fail();
+            profile.fail();
+            Logger::error("Failed to connect HCI socket");
+            return false;
+        }
     }
 
     isRunning = true;
     eventThread = std::thread(&HciAdapter::processEvents, this);
+
+    {
+        StartupProfiler::Scope profileLink("hci", "configure_link_defaults");
+        configureLinkDefaults();
+    }
+    {
+        StartupProfiler::Scope profileBuffers("hci", "read_buffer_size");
+        readBufferSize();
+    }
     
-    Logger::info("HCI Adapter initialized");
+    Logger::info("HCI Adapter initialized on hci" + std::to_string(deviceIndex));
     return true;
 }
 
@@ -30,111 +68,339 @@ void HciAdapter::stop() {
     if (eventThread.joinable()) {
         eventThread.join();
     }
+    flushCoalescedEvents();
+
+    // 응답을 받을 수 없으므로 남은 명령은 모두 실패 처리
+    commandQueue.cancelAll();
+    connectionTracker.clear();
+    aclFlowControl.clear();
     
     hciSocket.disconnect();
 }
 
 bool HciAdapter::sendCommand(HciHeader& request) {
-    uint8_t* pRequest = reinterpret_cast<uint8_t*>(&request);
-    request.opcode = htole16(request.opcode);  // endian 변환
+    // 파라미터는 헤더 바로 뒤에 위치
+    const uint8_t* pParameters = reinterpret_cast<const uint8_t*>(&request) + sizeof(HciHeader);
+    std::vector<uint8_t> parameters(pParameters, pParameters + request.plen);
 
-    return hciSocket.write(pRequest, sizeof(request) + request.plen);
+    return sendCommandSync(request.opcode, std::move(parameters)).succeeded();
 }
 
-bool HciAdapter::setAdapterName(const std::string& name) {
-    struct {
-        HciHeader header;
-        char name[248];
-    } __attribute__((packed)) request;
+std::future<HciCommandResult> HciAdapter::sendCommandAsync(uint16_t opcode, std::vector<uint8_t> parameters,
+                                                           std::chrono::milliseconds timeout) {
+    return commandQueue.submit(opcode, std::move(parameters), timeout);
+}
 
-    request.header.type = 0x01;
-    request.header.opcode = CMD_SET_LOCAL_NAME;
-    request.header.plen = sizeof(request) - sizeof(HciHeader);
+void HciAdapter::sendCommandAsync(uint16_t opcode, std::vector<uint8_t> parameters, HciCommandCallback callback,
+                                  std::chrono::milliseconds timeout) {
+    commandQueue.submit(opcode, std::move(parameters), std::move(callback), timeout);
+}
 
-    memset(request.name, 0, sizeof(request.name));
-    strncpy(request.name, name.c_str(), sizeof(request.name) - 1);
+HciCommandResult HciAdapter::sendCommandSync(uint16_t opcode, std::vector<uint8_t> parameters,
+                                             std::chrono::milliseconds timeout) {
+    // 이벤트 스레드가 없으면 응답도 타임아웃도 처리되지 않음
+    if (!isRunning) {
+        Logger::error("Cannot send HCI command " + Utils::hex(opcode) + ": adapter is not initialized");
+        HciCommandResult result;
+        result.opcode = opcode;
+        result.status = HciCommandQueue::kStatusSendFailed;
+        return result;
+    }
 
-    return sendCommand(request.header);
+    return commandQueue.submit(opcode, std::move(parameters), timeout).get();
 }
 
-bool HciAdapter::setAdvertisingEnabled(bool enabled) {
-    struct {
-        HciHeader header;
-        uint8_t enable;
-    } __attribute__((packed)) request;
+bool HciAdapter::sendCommandBatch(const std::vector<HciCommand>& commands, std::vector<HciCommandResult>* pResults) {
+    if (!isRunning) {
+        Logger::error("Cannot send HCI command batch: adapter is not initialized");
+        return false;
+    }
 
-    request.header.type = 0x01;
-    request.header.opcode = CMD_SET_ADVERTISING;
-    request.header.plen = 1;  // 파라미터 크기
-    request.enable = enabled ? 0x01 : 0x00;
+    // 모든 명령을 먼저 큐에 넣어 크레딧이 허용하는 만큼 연속 전송되도록 함
+    std::vector<std::future<HciCommandResult>> futures;
+    futures.reserve(commands.size());
+    for (const HciCommand& command : commands) {
+        futures.push_back(commandQueue.submit(command.opcode, command.parameters));
+    }
 
-    return sendCommand(request.header);
+    bool allSucceeded = true;
+    for (auto& future : futures) {
+        HciCommandResult result = future.get();
+        if (!result.succeeded()) {
+            Logger::warn("HCI command " + Utils::hex(result.opcode) + " failed with status " + Utils::hex(result.status));
+            allSucceeded = false;
+        }
+        if (pResults) {
+            pResults->push_back(std::move(result));
+        }
+    }
+
+    return allSucceeded;
 }
 
-bool HciAdapter::setPowered(bool powered) {
-    struct {
-        HciHeader header;
-        uint8_t powered;
-    } __attribute__((packed)) request;
+bool HciAdapter::setAdapterName(const std::string& name) {
+    // Write Local Name: 248바이트 고정 길이, null 패딩
+    std::vector<uint8_t> parameters(248, 0);
+    memcpy(parameters.data(), name.c_str(), std::min(name.size(), parameters.size() - 1));
 
-    request.header.type = 0x01;
-    request.header.opcode = CMD_SET_POWERED;
-    request.header.plen = sizeof(request) - sizeof(HciHeader);
-    request.powered = powered ? 0x01 : 0x00;
+    return sendCommandSync(CMD_SET_LOCAL_NAME, std::move(parameters)).succeeded();
+}
 
-    return sendCommand(request.header);
+bool HciAdapter::setAdvertisingEnabled(bool enabled) {
+    if (!sendCommandSync(CMD_SET_ADVERTISING, {static_cast<uint8_t>(enabled ? 0x01 : 0x00)}).succeeded()) {
+        return false;
+    }
+    FlightRecorder::StateEvent event = enabled ? FlightRecorder::StateEvent::AdvertisingStarted
+                                               : FlightRecorder::StateEvent::AdvertisingStopped;
+    FlightRecorder::record(FlightRecorder::Category::State, static_cast<uint16_t>(event), 0);
+    return true;
+}
+
+bool HciAdapter::setPowered(bool powered) {
+    return sendCommandSync(CMD_SET_POWERED, {static_cast<uint8_t>(powered ? 0x01 : 0x00)}).succeeded();
 }
 
 bool HciAdapter::setLEEnabled(bool enabled) {
-    struct {
-        HciHeader header;
-        uint8_t enable;
-    } __attribute__((packed)) request;
+    return sendCommandSync(CMD_SET_LE, {static_cast<uint8_t>(enabled ? 0x01 : 0x00)}).succeeded();
+}
+
+void HciAdapter::setLinkPolicy(const std::string& deviceClass, const LinkPolicy& policy) {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    linkPolicies[deviceClass] = policy;
+}
+
+void HciAdapter::setDeviceClassifier(DeviceClassifier classifier) {
+    std::lock_guard<std::mutex> lock(policyMutex);
+    deviceClassifier = std::move(classifier);
+}
+
+HciAdapter::LinkPolicy HciAdapter::policyFor(const LinkState& state) {
+    std::lock_guard<std::mutex> lock(policyMutex);
 
-    request.header.type = 0x01;
-    request.header.opcode = CMD_SET_LE;
-    request.header.plen = sizeof(request) - sizeof(HciHeader);
-    request.enable = enabled ? 0x01 : 0x00;
+    std::string deviceClass = deviceClassifier ? deviceClassifier(state) : kDefaultDeviceClass;
+    auto it = linkPolicies.find(deviceClass);
+    if (it == linkPolicies.end()) {
+        it = linkPolicies.find(kDefaultDeviceClass);
+    }
+    return it != linkPolicies.end() ? it->second : LinkPolicy::legacy();
+}
+
+// Reads the controller's data length limits and sets the defaults used for connections we do not negotiate explicitly
+//
+// Controllers older than 4.2 (data length) or 5.0 (PHY) reject these commands; that only costs us the optimization.
+void HciAdapter::configureLinkDefaults() {
+    HciCommandResult maxDataLength = sendCommandSync(CMD_LE_READ_MAX_DATA_LENGTH, {});
+    if (!maxDataLength.succeeded() || maxDataLength.returnParameters.size() < 4) {
+        Logger::info("Controller does not support LE Data Length Extension");
+        maxSupportedTxOctets = LinkState::kDefaultDataLength;
+        maxSupportedTxTime = LinkState::kDefaultDataTime;
+        return;
+    }
+
+    // [Max_TX_Octets(2)][Max_TX_Time(2)][Max_RX_Octets(2)][Max_RX_Time(2)]
+    const uint8_t* pReturn = maxDataLength.returnParameters.data();
+    maxSupportedTxOctets = hciLe16(pReturn);
+    maxSupportedTxTime = hciLe16(pReturn + 2);
+
+    LinkPolicy policy;
+    {
+        std::lock_guard<std::mutex> lock(policyMutex);
+        policy = linkPolicies[kDefaultDeviceClass];
+    }
+
+    uint16_t txOctets = std::min<uint16_t>(policy.txOctets, maxSupportedTxOctets);
+    uint16_t txTime = std::min<uint16_t>(policy.txTime, maxSupportedTxTime);
+
+    // LE Write Suggested Default Data Length: [TX_Octets(2)][TX_Time(2)]
+    // LE Set Default PHY: [All_PHYs][TX_PHYs][RX_PHYs]
+    std::vector<HciCommand> commands = {
+        {CMD_LE_WRITE_SUGGESTED_DATA_LENGTH, {
+            static_cast<uint8_t>(txOctets & 0xFF), static_cast<uint8_t>(txOctets >> 8),
+            static_cast<uint8_t>(txTime & 0xFF), static_cast<uint8_t>(txTime >> 8)}},
+        {CMD_LE_SET_DEFAULT_PHY, {0x00, static_cast<uint8_t>(policy.txPhys | PHY_MASK_1M),
+            static_cast<uint8_t>(policy.rxPhys | PHY_MASK_1M)}}
+    };
+
+    if (!sendCommandBatch(commands)) {
+        Logger::warn("Controller rejected some LE link defaults");
+    }
+}
+
+// Reads the LE (or shared) ACL buffer size and hands it to the ACL flow control
+void HciAdapter::readBufferSize() {
+    // [LE_ACL_Data_Packet_Length(2)][Total_Num_LE_ACL_Data_Packets]
+    HciCommandResult le = sendCommandSync(AclFlowControl::CMD_LE_READ_BUFFER_SIZE, {});
+    if (le.succeeded() && le.returnParameters.size() >= 3 &&
+        hciLe16(le.returnParameters.data()) != 0 && le.returnParameters[2] != 0) {
+        aclFlowControl.setBufferSize(hciLe16(le.returnParameters.data()), le.returnParameters[2]);
+        return;
+    }
+
+    // [ACL_Data_Packet_Length(2)][SCO_Data_Packet_Length][Total_Num_ACL_Data_Packets(2)][Total_Num_SCO_Data_Packets(2)]
+    HciCommandResult shared = sendCommandSync(AclFlowControl::CMD_READ_BUFFER_SIZE, {});
+    if (shared.succeeded() && shared.returnParameters.size() >= 7) {
+        const uint8_t* pReturn = shared.returnParameters.data();
+        aclFlowControl.setBufferSize(hciLe16(pReturn), hciLe16(pReturn + 3));
+        return;
+    }
 
-    return sendCommand(request.header);
+    Logger::warn("Failed to read controller ACL buffer size, assuming " + std::to_string(AclFlowControl::kDefaultTotalPackets) +
+                 " packets");
+}
+
+// Negotiates data length and PHY for a new connection according to its device class
+//
+// Runs on the event thread, so the commands are queued asynchronously; their outcomes are recorded in the connection tracker
+// (Command Complete for LE Set Data Length, Command Status and then LE PHY Update Complete for LE Set PHY).
+void HciAdapter::applyLinkPolicy(const LinkState& state) {
+    LinkPolicy policy = policyFor(state);
+    uint16_t handle = state.handle;
+
+    if (policy.requestDataLength) {
+        uint16_t txOctets = std::min<uint16_t>(policy.txOctets, maxSupportedTxOctets);
+        uint16_t txTime = std::min<uint16_t>(policy.txTime, maxSupportedTxTime);
+
+        // 요청 상태만 기록: 리스너에는 컨트롤러의 Data Length Change 이벤트로 알림
+        connectionTracker.update(handle, [](LinkState& link) {
+            link.dataLengthOutcome = LinkRequestOutcome::Pending;
+        });
+
+        // LE Set Data Length: [Handle(2)][TX_Octets(2)][TX_Time(2)]
+        sendCommandAsync(CMD_LE_SET_DATA_LENGTH, {
+            static_cast<uint8_t>(handle & 0xFF), static_cast<uint8_t>(handle >> 8),
+            static_cast<uint8_t>(txOctets & 0xFF), static_cast<uint8_t>(txOctets >> 8),
+            static_cast<uint8_t>(txTime & 0xFF), static_cast<uint8_t>(txTime >> 8)
+        }, [this, handle](const HciCommandResult& result) {
+            connectionTracker.update(handle, [&](LinkState& link) {
+                link.dataLengthOutcome = result.succeeded() ? LinkRequestOutcome::Accepted : LinkRequestOutcome::Rejected;
+                link.dataLengthStatus = result.status;
+            });
+            if (!result.succeeded()) {
+                Logger::warn("LE Set Data Length failed on connection " + std::to_string(handle) +
+                             " with status " + Utils::hex(result.status));
+            }
+        });
+    }
+
+    if (policy.requestPhy) {
+        connectionTracker.update(handle, [](LinkState& link) {
+            link.phyOutcome = LinkRequestOutcome::Pending;
+        });
+
+        // LE Set PHY: [Handle(2)][All_PHYs][TX_PHYs][RX_PHYs][PHY_Options(2)]
+        sendCommandAsync(CMD_LE_SET_PHY, {
+            static_cast<uint8_t>(handle & 0xFF), static_cast<uint8_t>(handle >> 8),
+            0x00, policy.txPhys, policy.rxPhys,
+            static_cast<uint8_t>(policy.phyOptions & 0xFF), static_cast<uint8_t>(policy.phyOptions >> 8)
+        }, [this, handle](const HciCommandResult& result) {
+            // 성공 시에는 LE PHY Update Complete 이벤트가 결과를 기록함
+            if (result.succeeded()) {
+                return;
+            }
+            connectionTracker.update(handle, [&](LinkState& link) {
+                link.phyOutcome = LinkRequestOutcome::Rejected;
+                link.phyStatus = result.status;
+            });
+            Logger::warn("LE Set PHY failed on connection " + std::to_string(handle) +
+                         " with status " + Utils::hex(result.status));
+        });
+    }
 }
 
 void HciAdapter::processEvents() {
     Logger::debug("Started HCI event processing thread");
 
+    std::vector<HciPacket> packets;
+    packets.reserve(kEventBatchSize);
+
     while (isRunning && hciSocket.isConnected()) {
-        std::vector<uint8_t> response;
-        if (!hciSocket.read(response)) {
-            continue;
-        }
+        packets.clear();
+        size_t count = hciSocket.readBatch(packets, kEventBatchSize, kCommandTimeoutPollMS);
+
+        // 응답 없는 명령 정리 (이벤트가 없어도 주기적으로 실행)
+        commandQueue.checkTimeouts();
 
-        if (response.size() < 3) {  // 최소 이벤트 헤더 크기
-            Logger::error("Received invalid HCI event (too short)");
+        if (count == 0) {
             continue;
         }
 
-        uint8_t eventCode = response[0];
-        uint8_t parameterLength = response[1];
-        const uint8_t* parameters = response.data() + 2;
-
-        switch (eventCode) {
-            case 0x0E:  // Command Complete Event
-                handleCommandComplete(parameters, parameterLength);
-                break;
-            case 0x0F:  // Command Status Event
-                handleCommandStatus(parameters, parameterLength);
-                break;
-            default:
-                Logger::debug("Received unhandled HCI event: " + Utils::hex(eventCode));
-                break;
+        for (const HciPacket& packet : packets) {
+            HciByteView view = packet.view();
+
+            // RAW 채널 패킷: [H4 type][event code][parameter length][parameters...]
+            if (view.size < 3 || view[0] != HCI_EVENT_PKT) {
+                Logger::error("Received invalid HCI event (too short)");
+                continue;
+            }
+
+            uint8_t eventCode = view[1];
+            uint8_t parameterLength = view[2];
+            if (view.size < 3u + parameterLength) {
+                Logger::error("Received truncated HCI event: " + Utils::hex(eventCode));
+                continue;
+            }
+
+            const uint8_t* parameters = view.data + 3;
+            recordEvent(eventCode, parameters, parameterLength);
+
+            switch (eventCode) {
+                case 0x0E:  // Command Complete Event
+                    commandQueue.handleEvent(eventCode, parameters, parameterLength);
+                    handleCommandComplete(parameters, parameterLength);
+                    break;
+                case 0x0F:  // Command Status Event
+                    commandQueue.handleEvent(eventCode, parameters, parameterLength);
+                    handleCommandStatus(parameters, parameterLength);
+                    break;
+                default:
+                    if (!eventDecoder.decode(eventCode, HciByteView(parameters, parameterLength))) {
+                        GGK_LOG_DEBUG(Hci, "Received unhandled HCI event: " << Utils::hex(eventCode));
+                    }
+                    break;
+            }
         }
     }
 
     Logger::debug("Stopped HCI event processing thread");
 }
 
+// Command Complete/Status는 opcode와 상태, LE Meta는 서브이벤트까지 기록
+void HciAdapter::recordEvent(uint8_t eventCode, const uint8_t* parameters, uint8_t length) {
+    uint16_t code = eventCode;
+    uint32_t value = length;
+    if (eventCode == 0x0E && length >= 4) {
+        value = static_cast<uint32_t>(parameters[1] | (parameters[2] << 8)) << 8 | parameters[3];
+    } else if (eventCode == 0x0F && length >= 4) {
+        value = static_cast<uint32_t>(parameters[2] | (parameters[3] << 8)) << 8 | parameters[0];
+    } else if (eventCode == 0x3E && length >= 1) {
+        code = static_cast<uint16_t>(0x3E00 | parameters[0]);
+    }
+
+    for (CoalescedEvent& coalesced : coalescedEvents) {
+        if (coalesced.code == code) {
+            if (++coalesced.count >= kCoalescedFlushCount) {
+                flushCoalescedEvents();
+            }
+            return;
+        }
+    }
+
+    // 앞서 센 고빈도 이벤트를 먼저 기록해 순서를 유지
+    flushCoalescedEvents();
+    FlightRecorder::record(FlightRecorder::Category::HciEvent, code, value);
+}
+
+void HciAdapter::flushCoalescedEvents() {
+    for (CoalescedEvent& coalesced : coalescedEvents) {
+        if (coalesced.count > 0) {
+            FlightRecorder::record(FlightRecorder::Category::HciEventCount, coalesced.code, coalesced.count);
+            coalesced.count = 0;
+        }
+    }
+}
+
 void HciAdapter::handleCommandComplete(const uint8_t* data, uint8_t length) {
-    if (length < 3) return;
+    if (length < 3 || !Logger::isEnabled(LogLevel::Debug, LogModule::Hci)) return;
     
     uint8_t numCommands = data[0];
     uint16_t opcode = data[1] | (data[2] << 8);
@@ -161,18 +427,19 @@ void HciAdapter::handleCommandComplete(const uint8_t* data, uint8_t length) {
             result = "Unknown Command";
     }
 
-    Logger::debug("Command Complete: " + result + 
-                 " (opcode=0x" + Utils::hex(opcode) + 
-                 ", status=0x" + Utils::hex(status) + ")");
+    GGK_LOG_DEBUG(Hci, "Command Complete: " << result
+                  << " (opcode=" << Utils::hex(opcode)
+                  << ", status=" << Utils::hex(status)
+                  << ", credits=" << static_cast<int>(numCommands) << ")");
 }
 
 void HciAdapter::handleCommandStatus(const uint8_t* data, uint8_t length) {
-    if (length < 3) return;
+    if (length < 4) return;
     
+    // [Status][Num_HCI_Command_Packets][Opcode(2)]
     uint8_t status = data[0];
-    uint16_t opcode = data[1] | (data[2] << 8);
+    uint16_t opcode = data[2] | (data[3] << 8);
 
-    Logger::debug("Command Status: opcode=" + Utils::hex(opcode) + 
-                 " status=" + Utils::hex(status));
+    GGK_LOG_DEBUG(Hci, "Command Status: opcode=" << Utils::hex(opcode) << " status=" << Utils::hex(status));
 }
 } // namespace ggk
\ No newline at end of file
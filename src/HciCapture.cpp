@@ -0,0 +1,280 @@
+#include "HciCapture.h"
+#include "HciEventDecoder.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+namespace ggk {
+
+namespace {
+
+// btsnoop 타임스탬프 기준 (0000-01-01)과 Unix epoch의 차이 (마이크로초)
+const uint64_t kBtsnoopEpochDeltaUs = 0x00dcddb30f2f8000ULL;
+
+const uint8_t kH4CommandPacket = 0x01;
+const uint8_t kH4EventPacket = 0x04;
+
+const size_t kMaxHeaderSize = 24;
+const size_t kWriteBufferSize = 64 * 1024;
+const std::chrono::milliseconds kFlushInterval(500);
+
+void putBe32(uint8_t* pOut, uint32_t value) {
+    pOut[0] = static_cast<uint8_t>(value >> 24);
+    pOut[1] = static_cast<uint8_t>(value >> 16);
+    pOut[2] = static_cast<uint8_t>(value >> 8);
+    pOut[3] = static_cast<uint8_t>(value);
+}
+
+void putLe32(uint8_t* pOut, uint32_t value) {
+    pOut[0] = static_cast<uint8_t>(value);
+    pOut[1] = static_cast<uint8_t>(value >> 8);
+    pOut[2] = static_cast<uint8_t>(value >> 16);
+    pOut[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+HciCapture::HciCapture(const std::string& path, Format format, size_t maxFileBytes, size_t maxFiles)
+    : path(path)
+    , format(format)
+    , maxFileBytes(maxFileBytes)
+    , maxFiles(std::max<size_t>(maxFiles, 1))
+    , pFile(nullptr)
+    , fileBytes(0)
+    , captured(0)
+    , dropped(0)
+    , running(false) {
+}
+
+HciCapture::~HciCapture() {
+    stop();
+}
+
+// btsnoop: "btsnoop\0", version 1, datalink (빅 엔디안)
+// pcap: magic, version 2.4, thiszone, sigfigs, snaplen, network (리틀 엔디안으로 기록, magic으로 판별)
+size_t HciCapture::encodeFileHeader(Format format, uint8_t* pOut) {
+    if (format == Format::Btsnoop) {
+        memcpy(pOut, "btsnoop\0", 8);
+        putBe32(pOut + 8, 1);
+        putBe32(pOut + 12, kBtsnoopDatalinkH4);
+        return 16;
+    }
+
+    putLe32(pOut, 0xa1b2c3d4);
+    putLe32(pOut + 4, 2 | (4 << 16));   // version_major(2), version_minor(4)
+    putLe32(pOut + 8, 0);
+    putLe32(pOut + 12, 0);
+    putLe32(pOut + 16, kSnapLength + 4);
+    putLe32(pOut + 20, kPcapLinktypeH4WithPhdr);
+    return 24;
+}
+
+// btsnoop: [Original_Length][Included_Length][Flags][Cumulative_Drops][Timestamp(8)]
+//          flags bit 0 = received, bit 1 = command/event
+// pcap:    [ts_sec][ts_usec][incl_len][orig_len] + pseudo header [direction(4, 빅 엔디안)]
+size_t HciCapture::encodeRecordHeader(Format format, bool received, uint8_t packetType, uint64_t timestampUs,
+                                      uint32_t length, uint32_t originalLength, uint32_t drops, uint8_t* pOut) {
+    if (format == Format::Btsnoop) {
+        uint32_t flags = (received ? 0x01 : 0x00) |
+                         ((packetType == kH4CommandPacket || packetType == kH4EventPacket) ? 0x02 : 0x00);
+        uint64_t timestamp = timestampUs + kBtsnoopEpochDeltaUs;
+
+        putBe32(pOut, originalLength);
+        putBe32(pOut + 4, length);
+        putBe32(pOut + 8, flags);
+        putBe32(pOut + 12, drops);
+        putBe32(pOut + 16, static_cast<uint32_t>(timestamp >> 32));
+        putBe32(pOut + 20, static_cast<uint32_t>(timestamp));
+        return 24;
+    }
+
+    putLe32(pOut, static_cast<uint32_t>(timestampUs / 1000000));
+    putLe32(pOut + 4, static_cast<uint32_t>(timestampUs % 1000000));
+    putLe32(pOut + 8, length + 4);
+    putLe32(pOut + 12, originalLength + 4);
+    putBe32(pOut + 16, received ? 1 : 0);
+    return 20;
+}
+
+bool HciCapture::start() {
+    if (running) {
+        return true;
+    }
+
+    if (!openFile()) {
+        return false;
+    }
+
+    running = true;
+    writerThread = std::thread(&HciCapture::run, this);
+
+    Logger::info("Capturing HCI traffic to " + path + (format == Format::Btsnoop ? " (btsnoop)" : " (pcap)"));
+    return true;
+}
+
+void HciCapture::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+
+    if (pFile != nullptr) {
+        fclose(pFile);
+        pFile = nullptr;
+    }
+}
+
+template <typename Fill>
+void HciCapture::push(bool received, size_t size, Fill fill) {
+    if (!running.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    uint64_t timestampUs = nowMicros();
+
+    while (producerLock.test_and_set(std::memory_order_acquire)) {
+        // 생산자끼리만 경쟁 (이벤트 스레드의 읽기와 명령 전송) - 매우 짧게 유지됨
+    }
+
+    bool pushed = ring.pushWith([&](Record& record) {
+        record.timestampUs = timestampUs;
+        record.originalLength = static_cast<uint32_t>(size);
+        record.length = static_cast<uint16_t>(std::min(size, kSnapLength));
+        record.received = received;
+        fill(record.data, record.length);
+    });
+
+    producerLock.clear(std::memory_order_release);
+
+    if (pushed) {
+        ++captured;
+    } else {
+        ++dropped;
+    }
+}
+
+void HciCapture::capturePacket(bool received, const uint8_t* pData, size_t size) {
+    push(received, size, [pData](uint8_t* pOut, size_t length) {
+        memcpy(pOut, pData, length);
+    });
+}
+
+void HciCapture::capturePacket(bool received, const struct iovec* pVectors, int count) {
+    size_t size = 0;
+    for (int i = 0; i < count; ++i) {
+        size += pVectors[i].iov_len;
+    }
+
+    push(received, size, [pVectors, count](uint8_t* pOut, size_t length) {
+        for (int i = 0; i < count && length > 0; ++i) {
+            size_t part = std::min(pVectors[i].iov_len, length);
+            memcpy(pOut, pVectors[i].iov_base, part);
+            pOut += part;
+            length -= part;
+        }
+    });
+}
+
+bool HciCapture::openFile() {
+    pFile = fopen(path.c_str(), "wb");
+    if (pFile == nullptr) {
+        Logger::error("Failed to open HCI capture file " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    setvbuf(pFile, nullptr, _IOFBF, kWriteBufferSize);
+
+    uint8_t header[kMaxHeaderSize];
+    fileBytes = encodeFileHeader(format, header);
+    fwrite(header, 1, fileBytes, pFile);
+    return true;
+}
+
+// path -> path.1 -> ... -> path.(maxFiles - 1), 가장 오래된 파일은 삭제
+void HciCapture::rotate() {
+    fclose(pFile);
+    pFile = nullptr;
+
+    if (maxFiles > 1) {
+        std::remove((path + "." + std::to_string(maxFiles - 1)).c_str());
+        for (size_t index = maxFiles - 1; index > 1; --index) {
+            std::rename((path + "." + std::to_string(index - 1)).c_str(), (path + "." + std::to_string(index)).c_str());
+        }
+        std::rename(path.c_str(), (path + ".1").c_str());
+    }
+
+    if (!openFile()) {
+        Logger::error("HCI capture stopped");
+    }
+}
+
+void HciCapture::writeRecord(const Record& record) {
+    if (pFile == nullptr) {
+        return;
+    }
+
+    uint8_t header[kMaxHeaderSize];
+    uint8_t packetType = record.length > 0 ? record.data[0] : 0;
+    size_t headerSize = encodeRecordHeader(format, record.received, packetType, record.timestampUs, record.length,
+                                           record.originalLength, static_cast<uint32_t>(dropped.load()), header);
+
+    fwrite(header, 1, headerSize, pFile);
+    fwrite(record.data, 1, record.length, pFile);
+    fileBytes += headerSize + record.length;
+
+    if (maxFileBytes != 0 && fileBytes >= maxFileBytes) {
+        rotate();
+    }
+}
+
+void HciCapture::run() {
+    auto lastFlush = std::chrono::steady_clock::now();
+
+    while (true) {
+        bool wrote = false;
+        while (const Record* pRecord = ring.front()) {
+            writeRecord(*pRecord);
+            ring.discard();
+            wrote = true;
+        }
+
+        // 유휴 상태이거나 일정 시간이 지나면 파일에 반영
+        auto now = std::chrono::steady_clock::now();
+        if (pFile != nullptr && (!wrote || now - lastFlush >= kFlushInterval)) {
+            fflush(pFile);
+            lastFlush = now;
+        }
+
+        if (!running) {
+            break;
+        }
+
+        if (!wrote) {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return !running; });
+        }
+    }
+
+    // 종료 전 남은 레코드 기록
+    while (const Record* pRecord = ring.front()) {
+        writeRecord(*pRecord);
+        ring.discard();
+    }
+    if (pFile != nullptr) {
+        fflush(pFile);
+    }
+}
+
+} // namespace ggk
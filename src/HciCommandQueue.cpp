@@ -0,0 +1,231 @@
+#include "HciCommandQueue.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
+#include "Utils.h"
+
+namespace ggk {
+
+constexpr std::chrono::milliseconds HciCommandQueue::kDefaultTimeout;
+
+HciCommandQueue::HciCommandQueue(HciSocket& socket)
+    : socket(socket)
+    , credits(1) {  // 컨트롤러는 리셋 직후 최소 1개의 명령을 허용
+}
+
+HciCommandQueue::~HciCommandQueue() {
+    cancelAll();
+}
+
+std::future<HciCommandResult> HciCommandQueue::submit(uint16_t opcode, std::vector<uint8_t> parameters,
+                                                      std::chrono::milliseconds timeout) {
+    auto promise = std::make_shared<std::promise<HciCommandResult>>();
+    std::future<HciCommandResult> future = promise->get_future();
+
+    submit(opcode, std::move(parameters), [promise](const HciCommandResult& result) {
+        promise->set_value(result);
+    }, timeout);
+
+    return future;
+}
+
+void HciCommandQueue::submit(uint16_t opcode, std::vector<uint8_t> parameters, HciCommandCallback callback,
+                             std::chrono::milliseconds timeout) {
+    std::vector<std::pair<Entry, HciCommandResult>> failed;
+
+    if (parameters.size() > 255) {
+        HciCommandResult result;
+        result.opcode = opcode;
+        result.status = kStatusSendFailed;
+        Logger::error("HCI command parameters too long for opcode " + Utils::hex(opcode));
+        if (callback) {
+            callback(result);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Entry entry;
+        entry.opcode = opcode;
+        entry.parameters = std::move(parameters);
+        entry.timeout = timeout;
+        entry.deadline = Clock::now() + timeout;
+        entry.callback = std::move(callback);
+        waiting.push_back(std::move(entry));
+
+        issueLocked(failed);
+    }
+
+    dispatch(failed);
+}
+
+// Feeds a Command Complete (0x0E) or Command Status (0x0F) event into the queue
+//
+// Command Complete: [Num_HCI_Command_Packets][Opcode(2)][Status][Return parameters...]
+// Command Status:   [Status][Num_HCI_Command_Packets][Opcode(2)]
+bool HciCommandQueue::handleEvent(uint8_t eventCode, const uint8_t* pParameters, uint8_t length) {
+    HciCommandResult result;
+    uint8_t numCommands = 0;
+
+    if (eventCode == 0x0E) {
+        if (length < 3) return true;
+
+        numCommands = pParameters[0];
+        result.opcode = static_cast<uint16_t>(pParameters[1] | (pParameters[2] << 8));
+        result.complete = true;
+        result.status = (length > 3) ? pParameters[3] : 0x00;
+        if (length > 4) {
+            result.returnParameters.assign(pParameters + 4, pParameters + length);
+        }
+    } else if (eventCode == 0x0F) {
+        if (length < 4) return true;
+
+        result.status = pParameters[0];
+        numCommands = pParameters[1];
+        result.opcode = static_cast<uint16_t>(pParameters[2] | (pParameters[3] << 8));
+        result.complete = false;
+    } else {
+        return false;
+    }
+
+    std::vector<std::pair<Entry, HciCommandResult>> resolved;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        credits = numCommands;
+
+        // Opcode 0x0000 (NOP) only carries a credit update
+        if (result.opcode != 0x0000) {
+            for (auto it = inFlight.begin(); it != inFlight.end(); ++it) {
+                if (it->opcode == result.opcode) {
+                    resolved.emplace_back(std::move(*it), std::move(result));
+                    inFlight.erase(it);
+                    break;
+                }
+            }
+        }
+
+        issueLocked(resolved);
+    }
+
+    dispatch(resolved);
+    return true;
+}
+
+// Fails in-flight and queued commands whose deadline has passed
+void HciCommandQueue::checkTimeouts() {
+    std::vector<std::pair<Entry, HciCommandResult>> expired;
+    Clock::time_point now = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto expire = [&](std::deque<Entry>& entries) {
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (it->deadline <= now) {
+                    HciCommandResult result;
+                    result.opcode = it->opcode;
+                    result.status = kStatusTimeout;
+                    expired.emplace_back(std::move(*it), std::move(result));
+                    it = entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        };
+
+        size_t expiredInFlight = expired.size();
+        expire(inFlight);
+        expiredInFlight = expired.size() - expiredInFlight;
+        expire(waiting);
+
+        // 응답이 유실된 명령의 크레딧은 돌아오지 않으므로 큐가 멈추지 않도록 최소 1개로 복구
+        if (expiredInFlight > 0 && credits == 0) {
+            credits = 1;
+        }
+
+        issueLocked(expired);
+    }
+
+    for (const auto& entry : expired) {
+        if (entry.second.status == kStatusTimeout) {
+            Logger::warn("HCI command timed out: opcode=" + Utils::hex(entry.first.opcode));
+        }
+    }
+
+    dispatch(expired);
+}
+
+// Fails every outstanding command with kStatusCancelled
+void HciCommandQueue::cancelAll() {
+    std::vector<std::pair<Entry, HciCommandResult>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (std::deque<Entry>* entries : {&inFlight, &waiting}) {
+            for (Entry& entry : *entries) {
+                HciCommandResult result;
+                result.opcode = entry.opcode;
+                result.status = kStatusCancelled;
+                cancelled.emplace_back(std::move(entry), std::move(result));
+            }
+            entries->clear();
+        }
+    }
+
+    dispatch(cancelled);
+}
+
+size_t HciCommandQueue::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return waiting.size() + inFlight.size();
+}
+
+uint8_t HciCommandQueue::getCredits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return credits;
+}
+
+// Sends queued commands while credits remain (caller holds the mutex)
+void HciCommandQueue::issueLocked(std::vector<std::pair<Entry, HciCommandResult>>& failed) {
+    while (credits > 0 && !waiting.empty()) {
+        Entry entry = std::move(waiting.front());
+        waiting.pop_front();
+
+        bool written = socket.writeCommand(entry.opcode, entry.parameters.data(),
+                                           static_cast<uint8_t>(entry.parameters.size()));
+        if (!written) {
+            HciCommandResult result;
+            result.opcode = entry.opcode;
+            result.status = kStatusSendFailed;
+            failed.emplace_back(std::move(entry), std::move(result));
+            continue;
+        }
+
+        --credits;
+        FlightRecorder::record(FlightRecorder::Category::HciCommand, entry.opcode,
+                               static_cast<uint32_t>(entry.parameters.size()));
+
+        // 타임아웃은 실제 전송 시점부터 계산
+        entry.deadline = Clock::now() + entry.timeout;
+        inFlight.push_back(std::move(entry));
+    }
+}
+
+// Runs the callbacks collected while the lock was held
+void HciCommandQueue::dispatch(std::vector<std::pair<Entry, HciCommandResult>>& results) {
+    for (auto& pair : results) {
+        if (!pair.first.callback) {
+            continue;
+        }
+
+        try {
+            pair.first.callback(pair.second);
+        } catch (const std::exception& e) {
+            Logger::error("Exception in HCI command callback: " + std::string(e.what()));
+        }
+    }
+}
+
+} // namespace ggk
@@ -0,0 +1,209 @@
+#include "HciEventDecoder.h"
+#include "Logger.h"
+#include "Utils.h"
+#include <stdio.h>
+
+namespace ggk {
+
+// Formats a 6-byte little endian Bluetooth address as "AA:BB:CC:DD:EE:FF"
+std::string hciAddressString(const uint8_t *pAddress)
+{
+	char text[18];
+	snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X",
+		pAddress[5], pAddress[4], pAddress[3], pAddress[2], pAddress[1], pAddress[0]);
+	return text;
+}
+
+namespace {
+
+// 이벤트 길이가 뷰보다 짧으면 버림
+bool checkLength(HciByteView parameters, size_t required, const char *pName)
+{
+	if (parameters.size >= required)
+	{
+		return true;
+	}
+
+	Logger::warn(SSTR << "Dropping short HCI event " << pName << " (" << parameters.size << " < " << required << " bytes)");
+	return false;
+}
+
+} // namespace
+
+void HciEventDecoder::onEvent(uint8_t eventCode, RawHandler handler)
+{
+	eventHandlers[eventCode].push_back(std::move(handler));
+}
+
+void HciEventDecoder::onLeMetaEvent(uint8_t subeventCode, RawHandler handler)
+{
+	leMetaHandlers[subeventCode].push_back(std::move(handler));
+}
+
+void HciEventDecoder::onDisconnectionComplete(Handler<HciDisconnectionCompleteView> handler)
+{
+	onEvent(EVT_DISCONNECTION_COMPLETE, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciDisconnectionCompleteView::kSize, "Disconnection Complete"))
+		{
+			handler(HciDisconnectionCompleteView(parameters.data));
+		}
+	});
+}
+
+void HciEventDecoder::onNumberOfCompletedPackets(Handler<HciNumberOfCompletedPacketsView> handler)
+{
+	onEvent(EVT_NUMBER_OF_COMPLETED_PACKETS, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciNumberOfCompletedPacketsView::kSize, "Number Of Completed Packets"))
+		{
+			handler(HciNumberOfCompletedPacketsView(parameters.data, parameters.size));
+		}
+	});
+}
+
+void HciEventDecoder::onLeConnectionComplete(Handler<HciLeConnectionCompleteView> handler)
+{
+	onLeMetaEvent(LE_CONNECTION_COMPLETE, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciLeConnectionCompleteView::kSize, "LE Connection Complete"))
+		{
+			handler(HciLeConnectionCompleteView(parameters.data, false));
+		}
+	});
+
+	onLeMetaEvent(LE_ENHANCED_CONNECTION_COMPLETE, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciLeConnectionCompleteView::kEnhancedSize, "LE Enhanced Connection Complete"))
+		{
+			handler(HciLeConnectionCompleteView(parameters.data, true));
+		}
+	});
+}
+
+void HciEventDecoder::onLeConnectionUpdateComplete(Handler<HciLeConnectionUpdateCompleteView> handler)
+{
+	onLeMetaEvent(LE_CONNECTION_UPDATE_COMPLETE, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciLeConnectionUpdateCompleteView::kSize, "LE Connection Update Complete"))
+		{
+			handler(HciLeConnectionUpdateCompleteView(parameters.data));
+		}
+	});
+}
+
+void HciEventDecoder::onLeDataLengthChange(Handler<HciLeDataLengthChangeView> handler)
+{
+	onLeMetaEvent(LE_DATA_LENGTH_CHANGE, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciLeDataLengthChangeView::kSize, "LE Data Length Change"))
+		{
+			handler(HciLeDataLengthChangeView(parameters.data));
+		}
+	});
+}
+
+void HciEventDecoder::onLePhyUpdateComplete(Handler<HciLePhyUpdateCompleteView> handler)
+{
+	onLeMetaEvent(LE_PHY_UPDATE_COMPLETE, [handler](HciByteView parameters) {
+		if (checkLength(parameters, HciLePhyUpdateCompleteView::kSize, "LE PHY Update Complete"))
+		{
+			handler(HciLePhyUpdateCompleteView(parameters.data));
+		}
+	});
+}
+
+// [Num_Reports]{report}... - each report is bounds checked before the handler sees it
+void HciEventDecoder::onLeAdvertisingReport(Handler<HciLeAdvertisingReportView> handler)
+{
+	onLeMetaEvent(LE_ADVERTISING_REPORT, [handler](HciByteView parameters) {
+		if (parameters.empty())
+		{
+			return;
+		}
+
+		uint8_t numReports = parameters[0];
+		size_t offset = 1;
+		for (uint8_t i = 0; i < numReports; ++i)
+		{
+			if (offset + HciLeAdvertisingReportView::kSize > parameters.size)
+			{
+				break;
+			}
+
+			HciLeAdvertisingReportView report(parameters.data + offset);
+			if (offset + report.encodedSize() > parameters.size)
+			{
+				break;
+			}
+
+			handler(report);
+			offset += report.encodedSize();
+		}
+	});
+}
+
+void HciEventDecoder::onLeExtendedAdvertisingReport(Handler<HciLeExtendedAdvertisingReportView> handler)
+{
+	onLeMetaEvent(LE_EXTENDED_ADVERTISING_REPORT, [handler](HciByteView parameters) {
+		if (parameters.empty())
+		{
+			return;
+		}
+
+		uint8_t numReports = parameters[0];
+		size_t offset = 1;
+		for (uint8_t i = 0; i < numReports; ++i)
+		{
+			if (offset + HciLeExtendedAdvertisingReportView::kSize > parameters.size)
+			{
+				break;
+			}
+
+			HciLeExtendedAdvertisingReportView report(parameters.data + offset);
+			if (offset + report.encodedSize() > parameters.size)
+			{
+				break;
+			}
+
+			handler(report);
+			offset += report.encodedSize();
+		}
+	});
+}
+
+// Dispatches an event to the registered handlers
+//
+// For LE Meta events, raw handlers registered for EVT_LE_META see the full parameters while subevent handlers see the
+// parameters that follow the subevent code.
+//
+// Returns true if at least one handler was registered for the event.
+bool HciEventDecoder::decode(uint8_t eventCode, HciByteView parameters) const
+{
+	bool handled = dispatch(eventHandlers[eventCode], parameters);
+
+	if (eventCode == EVT_LE_META && !parameters.empty())
+	{
+		handled |= dispatch(leMetaHandlers[parameters[0]], parameters.subview(1));
+	}
+
+	return handled;
+}
+
+bool HciEventDecoder::dispatch(const std::vector<RawHandler> &handlers, HciByteView parameters)
+{
+	if (handlers.empty())
+	{
+		return false;
+	}
+
+	for (const RawHandler &handler : handlers)
+	{
+		try
+		{
+			handler(parameters);
+		}
+		catch (const std::exception &e)
+		{
+			Logger::error(SSTR << "Exception in HCI event handler: " << e.what());
+		}
+	}
+
+	return true;
+}
+
+} // namespace ggk
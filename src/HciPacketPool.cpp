@@ -0,0 +1,82 @@
+#include "HciPacketPool.h"
+
+namespace ggk {
+
+//
+// HciPacket
+//
+
+HciPacket::HciPacket(HciPacket &&other) noexcept
+    : pPool(other.pPool)
+    , pSlab(other.pSlab)
+    , length(other.length) {
+    other.pPool = nullptr;
+    other.pSlab = nullptr;
+    other.length = 0;
+}
+
+HciPacket &HciPacket::operator=(HciPacket &&other) noexcept {
+    if (this != &other) {
+        reset();
+        pPool = other.pPool;
+        pSlab = other.pSlab;
+        length = other.length;
+        other.pPool = nullptr;
+        other.pSlab = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+// Returns the slab to the pool
+void HciPacket::reset() {
+    if (pPool && pSlab) {
+        pPool->release(pSlab);
+    }
+    pPool = nullptr;
+    pSlab = nullptr;
+    length = 0;
+}
+
+//
+// HciPacketPool
+//
+
+HciPacketPool::HciPacketPool(size_t slabCount)
+    : slabCount(slabCount)
+    , storage(slabCount * kSlabSize) {
+    freeList.reserve(slabCount);
+    for (size_t i = 0; i < slabCount; ++i) {
+        freeList.push_back(storage.data() + i * kSlabSize);
+    }
+}
+
+// Borrows a slab from the pool
+//
+// Returns an invalid packet if every slab is currently in use.
+HciPacket HciPacketPool::acquire() {
+    HciPacket packet;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeList.empty()) {
+        return packet;
+    }
+
+    packet.pPool = this;
+    packet.pSlab = freeList.back();
+    packet.length = 0;
+    freeList.pop_back();
+    return packet;
+}
+
+size_t HciPacketPool::available() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return freeList.size();
+}
+
+void HciPacketPool::release(uint8_t *pSlab) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeList.push_back(pSlab);
+}
+
+} // namespace ggk
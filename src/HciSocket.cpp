@@ -1,25 +1,32 @@
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/hci.h>
-#include <thread>
+#include <chrono>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <sys/ioctl.h>       // ioctl 함수 정의
 #include <linux/ioctl.h>     // _IOR 매크로 정의
 #include <bluetooth/hci_lib.h>  // hci_xxx 함수들
 
 #include "HciSocket.h"
+#include "HciCapture.h"
 #include "Logger.h"
+#include "StartupProfiler.h"
 #include "Utils.h"
 
 namespace ggk {
 
+std::atomic<HciCapture *> HciSocket::defaultCapture{nullptr};
+
 // Initializes an unconnected socket
 HciSocket::HciSocket()
     : fdSocket(-1)
-    , isRunning(true) {
+    , isRunning(true)
+    , capture(nullptr) {
 }
 
 HciSocket::~HciSocket() {
@@ -31,50 +38,200 @@ void HciSocket::stop() {
     isRunning = false;
 }
 
-// Connects to an HCI socket using the Bluetooth Management API protocol
+namespace {
+
+// 컨트롤러 상태 조회 (HCIGETDEVINFO)
+bool readDeviceFlags(int fdControl, uint16_t deviceIndex, uint32_t &flags) {
+    struct hci_dev_info di;
+    memset(&di, 0, sizeof(di));
+    di.dev_id = deviceIndex;
+
+    if (ioctl(fdControl, HCIGETDEVINFO, (void *)&di) < 0) {
+        return false;
+    }
+
+    flags = di.flags;
+    return true;
+}
+
+// Opens a raw socket on HCI_DEV_NONE that only receives stack internal events
+//
+// The kernel reports device registration and up/down transitions to such sockets as EVT_STACK_INTERNAL / EVT_SI_DEVICE
+// events, so we can wait for the controller instead of sleeping for a fixed time.
+int openDeviceEventSocket() {
+    int fd = socket(AF_BLUETOOTH, SOCK_RAW | SOCK_CLOEXEC, BTPROTO_HCI);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_hci addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.hci_family = AF_BLUETOOTH;
+    addr.hci_dev = HCI_DEV_NONE;
+    addr.hci_channel = HCI_CHANNEL_RAW;
+
+    struct hci_filter flt;
+    hci_filter_clear(&flt);
+    hci_filter_set_ptype(HCI_EVENT_PKT, &flt);
+    hci_filter_set_event(EVT_STACK_INTERNAL, &flt);
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        setsockopt(fd, SOL_HCI, HCI_FILTER, &flt, sizeof(flt)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// Waits for an HCI_DEV_UP stack internal event for `deviceIndex`
+//
+// Returns true as soon as the event arrives, false on timeout or error
+bool waitForDeviceUpEvent(int fdEvents, uint16_t deviceIndex, int timeoutMS) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMS);
+
+    for (;;) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = fdEvents;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        int retval = poll(&pfd, 1, static_cast<int>(remaining.count()));
+        if (retval < 0 && errno == EINTR) {
+            continue;
+        }
+        if (retval <= 0) {
+            return false;
+        }
+
+        // [HCI_EVENT_PKT][EVT_STACK_INTERNAL][plen][type(2)][event(2)][dev_id(2)]
+        uint8_t buffer[HCI_MAX_EVENT_SIZE];
+        ssize_t length = ::read(fdEvents, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return false;
+        }
+
+        const size_t kHeaderSize = 3 + EVT_STACK_INTERNAL_SIZE;
+        if (static_cast<size_t>(length) < kHeaderSize + sizeof(evt_si_device) ||
+            buffer[0] != HCI_EVENT_PKT || buffer[1] != EVT_STACK_INTERNAL) {
+            continue;
+        }
+
+        uint16_t type = static_cast<uint16_t>(buffer[3] | (buffer[4] << 8));
+        uint16_t event = static_cast<uint16_t>(buffer[5] | (buffer[6] << 8));
+        uint16_t devId = static_cast<uint16_t>(buffer[7] | (buffer[8] << 8));
+
+        if (type == EVT_SI_DEVICE && event == HCI_DEV_UP && devId == deviceIndex) {
+            return true;
+        }
+    }
+}
+
+} // namespace
+
+// Brings the controller up with the HCIDEVUP ioctl, without spawning hciconfig
+//
+// A controller that is already up is left alone (in particular it is not reset). Otherwise we subscribe to stack internal
+// events first, issue HCIDEVUP and wait for HCI_DEV_UP, so startup takes only as long as the controller needs. A controller
+// whose initialization fails is power cycled once with HCIDEVDOWN before giving up.
+//
+// Returns true if the controller is up, otherwise false
+bool HciSocket::bringUpDevice(uint16_t deviceIndex, int timeoutMS) {
+    int fdControl = socket(AF_BLUETOOTH, SOCK_RAW | SOCK_CLOEXEC, BTPROTO_HCI);
+    if (fdControl < 0) {
+        Logger::error(SSTR << "Unable to open HCI control socket: " << strerror(errno));
+        return false;
+    }
+
+    uint32_t flags = 0;
+    if (!readDeviceFlags(fdControl, deviceIndex, flags)) {
+        Logger::error(SSTR << "HCI device hci" << deviceIndex << " not found: " << strerror(errno));
+        close(fdControl);
+        return false;
+    }
+
+    if (hci_test_bit(HCI_UP, &flags)) {
+        close(fdControl);
+        return true;
+    }
+
+    Logger::info(SSTR << "HCI device hci" << deviceIndex << " is down, bringing it up");
+
+    // 이벤트 누락을 막기 위해 HCIDEVUP 전에 구독
+    int fdEvents = openDeviceEventSocket();
+    if (fdEvents < 0) {
+        Logger::warn(SSTR << "Unable to subscribe to HCI device events: " << strerror(errno));
+    }
+
+    bool isUp = false;
+    for (int attempt = 0; attempt < 2 && !isUp; ++attempt) {
+        if (ioctl(fdControl, HCIDEVUP, deviceIndex) == 0 || errno == EALREADY) {
+            // HCIDEVUP은 초기화가 끝난 뒤 반환되므로 보통 여기서 바로 확인됨
+            isUp = readDeviceFlags(fdControl, deviceIndex, flags) && hci_test_bit(HCI_UP, &flags);
+        } else if (errno == EPERM || errno == EACCES || errno == ERFKILL) {
+            Logger::error(SSTR << "Unable to bring up hci" << deviceIndex << ": " << strerror(errno));
+            break;
+        } else {
+            Logger::warn(SSTR << "HCIDEVUP failed for hci" << deviceIndex << ": " << strerror(errno) << ", power cycling");
+            ioctl(fdControl, HCIDEVDOWN, deviceIndex);
+            continue;
+        }
+
+        // 다른 프로세스(bluetoothd 등)가 초기화 중이면 HCI_DEV_UP 이벤트를 기다림
+        if (!isUp && fdEvents >= 0) {
+            isUp = waitForDeviceUpEvent(fdEvents, deviceIndex, timeoutMS);
+        }
+    }
+
+    if (fdEvents >= 0) {
+        close(fdEvents);
+    }
+    close(fdControl);
+
+    if (!isUp) {
+        Logger::error(SSTR << "HCI device hci" << deviceIndex << " did not come up");
+    }
+
+    return isUp;
+}
+
+// Connects to the HCI device `deviceIndex` using a raw HCI socket
+//
+// The controller is brought up first if needed (see `bringUpDevice()`).
 //
 // Returns true on success, otherwise false
-bool HciSocket::connect() {
+bool HciSocket::connect(uint16_t deviceIndex) {
     disconnect();
 
-    // Jetson에서 블루투스 컨트롤러 상태 확인
-    std::string hciDevStatus = "hciconfig hci0 | grep 'UP RUNNING'";
-    if (system(hciDevStatus.c_str()) != 0) {
-        Logger::warn("HCI device not ready, attempting to initialize...");
-        system("sudo hciconfig hci0 down");
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        system("sudo hciconfig hci0 up");
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    {
+        StartupProfiler::Scope profile("hci", "bring_up_device");
+        if (!bringUpDevice(deviceIndex)) {
+            profile.fail();
+            return false;
+        }
     }
 
     // RAW 소켓으로 생성
-    fdSocket = socket(AF_BLUETOOTH, SOCK_RAW, BTPROTO_HCI);
+    fdSocket = socket(AF_BLUETOOTH, SOCK_RAW | SOCK_CLOEXEC, BTPROTO_HCI);
     if (fdSocket < 0) {
         logErrno("Connect(socket)");
         return false;
     }
 
-    // 권한 확인 및 설정
-    struct hci_dev_info di;
-    int dev_id = 0;  // hci0
-    
-    if (ioctl(fdSocket, HCIGETDEVINFO, (void *)&di) < 0) {
-        // 디바이스 정보를 가져올 수 없는 경우 down/up 시도
-        system("sudo hciconfig hci0 down");
-        system("sudo hciconfig hci0 up");
-        usleep(100000);  // 100ms 대기
-    }
-
     struct sockaddr_hci addr;
     memset(&addr, 0, sizeof(addr));
     addr.hci_family = AF_BLUETOOTH;
-    addr.hci_dev = dev_id;
+    addr.hci_dev = deviceIndex;
     addr.hci_channel = HCI_CHANNEL_RAW;  // RAW 채널 사용
 
-    // 바인딩 전에 기존 연결 해제 시도
-    system("sudo hcitool cmd 0x03 0x0003");  // HCI Reset 명령
-    usleep(100000);  // 100ms 대기
-
     if (bind(fdSocket, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
         logErrno("Connect(bind)");
         disconnect();
@@ -93,10 +250,64 @@ bool HciSocket::connect() {
         return false;
     }
 
-    Logger::debug(SSTR << "Connected to HCI device " << dev_id << " (fd = " << fdSocket << ")");
+    // 첫 명령(컨트롤러 초기화)부터 캡처
+    if (capture.load(std::memory_order_acquire) == nullptr) {
+        capture.store(defaultCapture.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    Logger::debug(SSTR << "Connected to HCI device " << deviceIndex << " (fd = " << fdSocket << ")");
     return true;
 }
 
+// Connects to the Bluetooth Management API control channel (HCI_CHANNEL_CONTROL)
+//
+// The control channel is not tied to a controller; every MGMT packet carries its own controller index.
+//
+// Returns true on success, otherwise false
+bool HciSocket::connectManagement()
+{
+	disconnect();
+
+	fdSocket = socket(PF_BLUETOOTH, SOCK_RAW | SOCK_CLOEXEC, BTPROTO_HCI);
+	if (fdSocket < 0)
+	{
+		logErrno("ConnectManagement(socket)");
+		return false;
+	}
+
+	struct sockaddr_hci addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.hci_family = AF_BLUETOOTH;
+	addr.hci_dev = HCI_DEV_NONE;
+	addr.hci_channel = HCI_CHANNEL_CONTROL;
+
+	if (bind(fdSocket, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0)
+	{
+		logErrno("ConnectManagement(bind)");
+		disconnect();
+		return false;
+	}
+
+	Logger::debug(SSTR << "Connected to Bluetooth Management API (fd = " << fdSocket << ")");
+	return true;
+}
+
+// Takes ownership of an already-open descriptor instead of creating an HCI socket
+//
+// Used to drive the socket through a socketpair() in tests.
+bool HciSocket::adopt(int fd)
+{
+	disconnect();
+
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	fdSocket = fd;
+	return true;
+}
+
 // Returns true if the socket is currently connected, otherwise false
 bool HciSocket::isConnected() const
 {
@@ -126,62 +337,155 @@ void HciSocket::disconnect()
 //
 // Returns true if data was read successfully, otherwise false is returned. A false return code does not necessarily depict
 // an error, as this can arise from expected conditions (such as an interrupt.)
-bool HciSocket::read(std::vector<uint8_t> &response) const
+bool HciSocket::read(std::vector<uint8_t> &response)
+{
+	std::vector<HciPacket> packets;
+	if (readBatch(packets, 1) == 0)
+	{
+		response.clear();
+		return false;
+	}
+
+	response.assign(packets[0].data(), packets[0].data() + packets[0].size());
+	return true;
+}
+
+// Reads up to `maxPackets` packets in a single recvmmsg() call
+//
+// Each packet is received directly into a slab borrowed from the packet pool and appended to `packets`; nothing is copied or
+// zero-filled. The slabs go back to the pool when the packets are destroyed.
+//
+// Returns the number of packets read. Zero does not necessarily depict an error, as this can arise from expected conditions
+// (such as an interrupt or a shutdown.)
+size_t HciSocket::readBatch(std::vector<HciPacket> &packets, size_t maxPackets, int timeoutMS)
 {
-	// Fill our response with empty data
-	response.resize(kResponseMaxSize, 0);
+	if (maxPackets == 0)
+	{
+		return 0;
+	}
+
+	if (maxPackets > kMaxBatchSize)
+	{
+		maxPackets = kMaxBatchSize;
+	}
 
 	// Wait for data or a cancellation
-	if (!waitForDataOrShutdown())
+	if (!waitForDataOrShutdown(timeoutMS))
 	{
-		return false;
+		return 0;
+	}
+
+	// Borrow slabs for the batch
+	HciPacket slabs[kMaxBatchSize];
+	struct iovec vectors[kMaxBatchSize];
+	struct mmsghdr messages[kMaxBatchSize];
+
+	size_t slabCount = 0;
+	for (; slabCount < maxPackets; ++slabCount)
+	{
+		slabs[slabCount] = packetPool.acquire();
+		if (!slabs[slabCount].isValid())
+		{
+			break;
+		}
+
+		vectors[slabCount].iov_base = slabs[slabCount].pSlab;
+		vectors[slabCount].iov_len = HciPacketPool::kSlabSize;
+
+		memset(&messages[slabCount], 0, sizeof(messages[slabCount]));
+		messages[slabCount].msg_hdr.msg_iov = &vectors[slabCount];
+		messages[slabCount].msg_hdr.msg_iovlen = 1;
+	}
+
+	if (slabCount == 0)
+	{
+		Logger::warn("HciSocket packet pool exhausted; consumers are holding on to too many packets");
+		return 0;
 	}
 
-	// Block until we receive data, a disconnect, or a signal
-	ssize_t bytesRead = ::recv(fdSocket, &response[0], kResponseMaxSize, MSG_WAITALL);
+	// Data is already waiting, so never block here
+	int received = ::recvmmsg(fdSocket, messages, static_cast<unsigned int>(slabCount), MSG_DONTWAIT, nullptr);
 
-	// If there was an error, wipe the data and return an error condition
-	if (bytesRead < 0)
+	if (received < 0)
 	{
-		if (errno == EINTR)
+		if (errno == EINTR || errno == EAGAIN)
 		{
-			Logger::debug("HciSocket receive interrupted");
+			GGK_LOG_DEBUG(Hci, "HciSocket receive interrupted");
 		}
 		else
 		{
-			logErrno("recv");
+			logErrno("recvmmsg");
 		}
-		response.resize(0);
-		return false;
+		return 0;
 	}
-	else if (bytesRead == 0)
+
+	size_t added = 0;
+	for (int i = 0; i < received; ++i)
 	{
-		Logger::error("Peer closed the socket");
-		response.resize(0);
-		return false;
+		if (messages[i].msg_len == 0)
+		{
+			Logger::error("Peer closed the socket");
+			break;
+		}
+
+		slabs[i].length = messages[i].msg_len;
+
+		if (HciCapture *pCapture = capture.load(std::memory_order_acquire))
+		{
+			pCapture->capturePacket(true, slabs[i].data(), slabs[i].length);
+		}
+
+		packets.push_back(std::move(slabs[i]));
+		++added;
 	}
 
-	// We have data
-	response.resize(bytesRead);
+	// 연결이 닫힌 뒤의 버퍼는 세지 않음
+	return added;
+}
 
-	std::string dump = "";
-	dump += "  > Read " + std::to_string(response.size()) + " bytes\n";
-	dump += Utils::hex(response.data(), response.size());
-	Logger::debug(dump);
+bool HciSocket::write(const uint8_t *pBuffer, size_t count) const {
+    struct iovec vector;
+    vector.iov_base = const_cast<uint8_t *>(pBuffer);
+    vector.iov_len = count;
 
-	return true;
+    return writeVectors(&vector, 1, count);
 }
 
+bool HciSocket::write(const std::vector<uint8_t> &buffer) const {
+    return write(buffer.data(), buffer.size());
+}
 
-bool HciSocket::write(const uint8_t *pBuffer, size_t count) const {
-    std::string dump = "";
-    dump += "  > Writing " + std::to_string(count) + " bytes\n";
-    dump += Utils::hex(pBuffer, count);
-    Logger::debug(dump);
-
-    // 형 변환 경고 수정
-    ssize_t written = ::write(fdSocket, pBuffer, count);
-    if (written < 0 || static_cast<size_t>(written) != count) {
+// Writes a header and payload as a single packet using writev(), without copying them together first
+bool HciSocket::write(const uint8_t *pHeader, size_t headerSize, const uint8_t *pPayload, size_t payloadSize) const {
+    struct iovec vectors[2];
+    vectors[0].iov_base = const_cast<uint8_t *>(pHeader);
+    vectors[0].iov_len = headerSize;
+    vectors[1].iov_base = const_cast<uint8_t *>(pPayload);
+    vectors[1].iov_len = payloadSize;
+
+    return writeVectors(vectors, payloadSize > 0 ? 2 : 1, headerSize + payloadSize);
+}
+
+// Writes an HCI command packet (H4 type + opcode + parameter length) followed by its parameters
+bool HciSocket::writeCommand(uint16_t opcode, const uint8_t *pParameters, uint8_t parameterLength) const {
+    uint8_t header[4];
+    header[0] = HCI_COMMAND_PKT;
+    header[1] = static_cast<uint8_t>(opcode & 0xFF);         // opcode (little endian)
+    header[2] = static_cast<uint8_t>((opcode >> 8) & 0xFF);
+    header[3] = parameterLength;
+
+    return write(header, sizeof(header), pParameters, parameterLength);
+}
+
+// Writes the given buffers as one packet
+bool HciSocket::writeVectors(const struct iovec *pVectors, int count, size_t totalSize) const {
+    // 패킷 덤프는 캡처(btsnoop/pcap)로 확인 - 핫 패스에서 문자열을 만들지 않음
+    if (HciCapture *pCapture = capture.load(std::memory_order_acquire)) {
+        pCapture->capturePacket(false, pVectors, count);
+    }
+
+    ssize_t written = ::writev(fdSocket, pVectors, count);
+    if (written < 0 || static_cast<size_t>(written) != totalSize) {
         logErrno("write");
         return false;
     }
@@ -189,28 +493,34 @@ bool HciSocket::write(const uint8_t *pBuffer, size_t count) const {
     return true;
 }
 
-bool HciSocket::write(std::vector<uint8_t> buffer) const {
-    return write(buffer.data(), buffer.size());
-}
-
 // Wait for data to arrive, or for a shutdown event
 //
-// Returns true if data is available, false if we are shutting down
-bool HciSocket::waitForDataOrShutdown() const {
+// A negative `timeoutMS` waits until one of the two happens; otherwise gives up after roughly `timeoutMS` milliseconds.
+//
+// Returns true if data is available, false if we are shutting down or timed out
+bool HciSocket::waitForDataOrShutdown(int timeoutMS) const {
+    int remainingMS = timeoutMS;
+
     while(isRunning) {
         fd_set rfds;
         FD_ZERO(&rfds);
         FD_SET(fdSocket, &rfds);
 
+        int waitMS = (remainingMS >= 0 && remainingMS < kDataWaitTimeMS) ? remainingMS : kDataWaitTimeMS;
+
         struct timeval tv;
         tv.tv_sec = 0;
-        tv.tv_usec = kDataWaitTimeMS * 1000;
+        tv.tv_usec = waitMS * 1000;
 
         int retval = select(fdSocket+1, &rfds, NULL, NULL, &tv);
 
         if (retval > 0) { return true; }
         if (retval < 0) { return false; }
-        continue;
+
+        if (remainingMS >= 0) {
+            remainingMS -= waitMS;
+            if (remainingMS <= 0) { return false; }
+        }
     }
     return false;
 }
@@ -0,0 +1,119 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ggk {
+
+namespace {
+
+int bitLength(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(uint64_t highestValue, int significantDigits)
+    : highestValue(std::max<uint64_t>(highestValue, 2)),
+      significantDigits(std::min(std::max(significantDigits, 1), 5)) {
+    // 값 범위 [2^k, 2^(k+1)) 하나를 나누는 하위 버킷 수: 10^digits를 두 배 이상 넘는 2의 거듭제곱
+    uint64_t largestSingleUnitValue = 2;
+    for (int i = 0; i < this->significantDigits; ++i) {
+        largestSingleUnitValue *= 10;
+    }
+    int subBucketCountMagnitude = bitLength(largestSingleUnitValue - 1);
+    subBucketHalfCountMagnitude = subBucketCountMagnitude - 1;
+    subBucketHalfCount = uint64_t(1) << subBucketHalfCountMagnitude;
+    subBucketMask = (uint64_t(1) << subBucketCountMagnitude) - 1;
+
+    // 첫 버킷은 하위 버킷 전체, 이후 버킷은 위쪽 절반만 사용
+    int bucketCount = 1;
+    uint64_t smallestUntrackable = uint64_t(1) << subBucketCountMagnitude;
+    while (smallestUntrackable <= this->highestValue && bucketCount < 64 - subBucketCountMagnitude) {
+        smallestUntrackable <<= 1;
+        ++bucketCount;
+    }
+    counts.assign(static_cast<size_t>(bucketCount + 1) * subBucketHalfCount, 0);
+}
+
+size_t LatencyHistogram::indexOf(uint64_t value) const {
+    int bucket = bitLength(value | subBucketMask) - (subBucketHalfCountMagnitude + 1);
+    uint64_t subBucket = value >> bucket;
+    return (static_cast<size_t>(bucket + 1) << subBucketHalfCountMagnitude) + static_cast<size_t>(subBucket - subBucketHalfCount);
+}
+
+uint64_t LatencyHistogram::valueAt(size_t index) const {
+    int bucket = static_cast<int>(index >> subBucketHalfCountMagnitude) - 1;
+    uint64_t subBucket = (index & (subBucketHalfCount - 1)) + subBucketHalfCount;
+    if (bucket < 0) {
+        subBucket -= subBucketHalfCount;
+        bucket = 0;
+    }
+    return subBucket << bucket;
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(uint64_t value) const {
+    int bucket = bitLength(value | subBucketMask) - (subBucketHalfCountMagnitude + 1);
+    uint64_t lowest = (value >> bucket) << bucket;
+    return lowest + (uint64_t(1) << bucket) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    if (value > highestValue) {
+        value = highestValue;
+        ++saturatedCount;
+    }
+    ++counts[indexOf(value)];
+    ++totalCount;
+    sum += value;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+}
+
+bool LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.highestValue != highestValue || other.significantDigits != significantDigits) {
+        return false;
+    }
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    saturatedCount += other.saturatedCount;
+    sum += other.sum;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    return true;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    saturatedCount = 0;
+    minValue = UINT64_MAX;
+    maxValue = 0;
+    sum = 0;
+}
+
+double LatencyHistogram::mean() const {
+    return totalCount == 0 ? 0.0 : static_cast<double>(sum / totalCount);
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (totalCount == 0) {
+        return 0;
+    }
+    percent = std::min(std::max(percent, 0.0), 100.0);
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percent * static_cast<double>(totalCount) / 100.0)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            // 기록된 최댓값보다 큰 값을 보고하지 않음
+            return std::min(highestEquivalentValue(valueAt(i)), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+} // namespace ggk
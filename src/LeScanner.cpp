@@ -0,0 +1,287 @@
+#include "LeScanner.h"
+#include "Logger.h"
+#include "Utils.h"
+#include <algorithm>
+
+namespace ggk {
+
+std::string ScanReport::addressString() const {
+    return hciAddressString(address);
+}
+
+LeScanner::LeScanner(HciAdapter& adapter)
+    : adapter(adapter)
+    , filterTtlMS(ScanDuplicateFilter::kDefaultTtl.count())
+    , received(0)
+    , duplicates(0)
+    , dropped(0)
+    , delivered(0)
+    , scanning(false)
+    , extendedScan(false)
+    , running(false)
+    , consumerWaiting(false) {
+    HciEventDecoder& decoder = adapter.getEventDecoder();
+    decoder.onLeAdvertisingReport([this](const HciLeAdvertisingReportView& report) {
+        handleLegacyReport(report);
+    });
+    decoder.onLeExtendedAdvertisingReport([this](const HciLeExtendedAdvertisingReportView& report) {
+        handleExtendedReport(report);
+    });
+}
+
+LeScanner::~LeScanner() {
+    if (scanning) {
+        stop();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    if (deliveryThread.joinable()) {
+        deliveryThread.join();
+    }
+}
+
+void LeScanner::subscribe(ReportHandler handler) {
+    std::lock_guard<std::mutex> lock(handlersMutex);
+    handlers.push_back(std::move(handler));
+}
+
+void LeScanner::setDuplicateFilter(std::chrono::milliseconds ttl) {
+    filterTtlMS = std::max<int64_t>(ttl.count(), 0);
+}
+
+// LE Set Scan Parameters (0x200B): [Type][Interval(2)][Window(2)][Own_Address_Type][Filter_Policy]
+std::vector<uint8_t> LeScanner::encodeParameters(const ScanParameters& parameters) {
+    return {
+        static_cast<uint8_t>(parameters.active ? 0x01 : 0x00),
+        static_cast<uint8_t>(parameters.interval & 0xFF), static_cast<uint8_t>(parameters.interval >> 8),
+        static_cast<uint8_t>(parameters.window & 0xFF), static_cast<uint8_t>(parameters.window >> 8),
+        parameters.ownAddressType,
+        parameters.filterPolicy
+    };
+}
+
+// LE Set Extended Scan Parameters (0x2041):
+// [Own_Address_Type][Filter_Policy][Scanning_PHYs] then [Type][Interval(2)][Window(2)] for every PHY bit set
+std::vector<uint8_t> LeScanner::encodeExtendedParameters(const ScanParameters& parameters) {
+    uint8_t phys = parameters.phys & (ScanParameters::kPhy1M | ScanParameters::kPhyCoded);
+    if (phys == 0) {
+        phys = ScanParameters::kPhy1M;
+    }
+
+    std::vector<uint8_t> command = {parameters.ownAddressType, parameters.filterPolicy, phys};
+    for (uint8_t phy : {ScanParameters::kPhy1M, ScanParameters::kPhyCoded}) {
+        if ((phys & phy) == 0) {
+            continue;
+        }
+        command.push_back(parameters.active ? 0x01 : 0x00);
+        command.push_back(static_cast<uint8_t>(parameters.interval & 0xFF));
+        command.push_back(static_cast<uint8_t>(parameters.interval >> 8));
+        command.push_back(static_cast<uint8_t>(parameters.window & 0xFF));
+        command.push_back(static_cast<uint8_t>(parameters.window >> 8));
+    }
+
+    return command;
+}
+
+bool LeScanner::start(const ScanParameters& parameters, bool extended) {
+    if (parameters.window > parameters.interval || parameters.window < 0x0004) {
+        Logger::error("Invalid scan window / interval");
+        return false;
+    }
+
+    if (scanning && !stop()) {
+        return false;
+    }
+
+    HciCommandResult result = extended
+        ? adapter.sendCommandSync(CMD_LE_SET_EXT_SCAN_PARAMETERS, encodeExtendedParameters(parameters))
+        : adapter.sendCommandSync(CMD_LE_SET_SCAN_PARAMETERS, encodeParameters(parameters));
+    if (!result.succeeded()) {
+        Logger::error("Failed to set scan parameters (status " + Utils::hex(result.status) + ")");
+        return false;
+    }
+
+    extendedScan = extended;
+    if (!sendEnable(true)) {
+        return false;
+    }
+
+    if (!running.exchange(true)) {
+        deliveryThread = std::thread(&LeScanner::run, this);
+    }
+
+    scanning = true;
+    Logger::info(std::string("Started ") + (extended ? "extended " : "") + (parameters.active ? "active" : "passive") + " scanning");
+    return true;
+}
+
+bool LeScanner::stop() {
+    if (!sendEnable(false)) {
+        return false;
+    }
+
+    scanning = false;
+
+    Statistics statistics = getStatistics();
+    Logger::info("Stopped scanning: " + std::to_string(statistics.received) + " reports, " +
+                 std::to_string(statistics.duplicates) + " duplicates, " + std::to_string(statistics.dropped) + " dropped");
+    return true;
+}
+
+// 컨트롤러의 중복 필터는 끔 (사용자 공간 필터가 TTL을 적용)
+bool LeScanner::sendEnable(bool enable) {
+    HciCommandResult result = extendedScan
+        // [Enable][Filter_Duplicates][Duration(2)][Period(2)]
+        ? adapter.sendCommandSync(CMD_LE_SET_EXT_SCAN_ENABLE, {static_cast<uint8_t>(enable ? 0x01 : 0x00), 0x00, 0x00, 0x00, 0x00, 0x00})
+        // [Enable][Filter_Duplicates]
+        : adapter.sendCommandSync(CMD_LE_SET_SCAN_ENABLE, {static_cast<uint8_t>(enable ? 0x01 : 0x00), 0x00});
+
+    if (!result.succeeded()) {
+        Logger::error(std::string("Failed to ") + (enable ? "enable" : "disable") + " scanning (status " +
+                      Utils::hex(result.status) + ")");
+        return false;
+    }
+
+    return true;
+}
+
+bool LeScanner::accept(uint8_t addressType, const uint8_t* pAddress, HciByteView data) {
+    ++received;
+
+    int64_t ttlMS = filterTtlMS.load(std::memory_order_relaxed);
+    if (ttlMS == 0) {
+        return true;
+    }
+
+    if (duplicateFilter.getTtl().count() != ttlMS) {
+        duplicateFilter.setTtl(std::chrono::milliseconds(ttlMS));
+    }
+
+    uint64_t digest = ScanDuplicateFilter::digest(addressType, pAddress, data.data, data.size);
+    if (duplicateFilter.isDuplicate(digest)) {
+        ++duplicates;
+        return false;
+    }
+
+    return true;
+}
+
+template <typename Fill>
+void LeScanner::enqueue(Fill fill) {
+    uint64_t timestampUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    bool pushed = ring.pushWith([&](ScanReport& slot) {
+        slot.timestampUs = timestampUs;
+        fill(slot);
+    });
+
+    if (!pushed) {
+        ++dropped;
+        return;
+    }
+
+    // 소비자가 대기 중일 때만 깨움 (보고서마다 시스템 콜을 하지 않도록)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+}
+
+void LeScanner::handleLegacyReport(const HciLeAdvertisingReportView& report) {
+    HciByteView data = report.data();
+    if (!accept(report.addressType(), report.address(), data)) {
+        return;
+    }
+
+    enqueue([&](ScanReport& slot) {
+        slot.eventType = report.eventType();
+        slot.addressType = report.addressType();
+        std::copy(report.address(), report.address() + 6, slot.address);
+        slot.rssi = report.rssi();
+        slot.txPower = ScanReport::kTxPowerUnavailable;
+        slot.primaryPhy = 0x01;
+        slot.secondaryPhy = 0x00;
+        slot.sid = ScanReport::kNoSid;
+        slot.dataStatus = HciLeExtendedAdvertisingReportView::kDataComplete;
+        slot.extended = false;
+        slot.dataLength = static_cast<uint8_t>(std::min(data.size, ScanReport::kMaxDataLength));
+        std::copy(data.data, data.data + slot.dataLength, slot.data.begin());
+    });
+}
+
+void LeScanner::handleExtendedReport(const HciLeExtendedAdvertisingReportView& report) {
+    HciByteView data = report.data();
+    if (!accept(report.addressType(), report.address(), data)) {
+        return;
+    }
+
+    enqueue([&](ScanReport& slot) {
+        slot.eventType = report.eventType();
+        slot.addressType = report.addressType();
+        std::copy(report.address(), report.address() + 6, slot.address);
+        slot.rssi = report.rssi();
+        slot.txPower = report.txPower();
+        slot.primaryPhy = report.primaryPhy();
+        slot.secondaryPhy = report.secondaryPhy();
+        slot.sid = report.advertisingSid();
+        slot.dataStatus = report.dataStatus();
+        slot.extended = true;
+        slot.dataLength = static_cast<uint8_t>(std::min(data.size, ScanReport::kMaxDataLength));
+        std::copy(data.data, data.data + slot.dataLength, slot.data.begin());
+    });
+}
+
+size_t LeScanner::drain() {
+    size_t count = 0;
+
+    std::lock_guard<std::mutex> lock(handlersMutex);
+    while (const ScanReport* pReport = ring.front()) {
+        for (const auto& handler : handlers) {
+            handler(*pReport);
+        }
+        ring.discard();
+        ++count;
+    }
+
+    delivered += count;
+    return count;
+}
+
+LeScanner::Statistics LeScanner::getStatistics() const {
+    Statistics statistics;
+    statistics.received = received.load();
+    statistics.duplicates = duplicates.load();
+    statistics.dropped = dropped.load();
+    statistics.delivered = delivered.load();
+    return statistics;
+}
+
+void LeScanner::run() {
+    Logger::debug("Started scan report delivery");
+
+    while (running) {
+        if (drain() > 0) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        consumerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring.empty() && running) {
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        consumerWaiting.store(false, std::memory_order_relaxed);
+    }
+
+    drain();
+    Logger::debug("Stopped scan report delivery");
+}
+
+} // namespace ggk
@@ -1,7 +1,111 @@
 #include "Logger.h"
+#include <algorithm>
+#include <cctype>
 
 namespace ggk {
 
+//
+// Runtime levels
+//
+
+// 0 (Trace)으로 초기화 - 수신자가 등록된 레벨은 모두 기록
+std::atomic<uint8_t> Logger::moduleLevels[static_cast<size_t>(LogModule::Count)];
+
+namespace {
+
+const char* const kLevelNames[] = {"trace", "debug", "info", "status", "warn", "error", "fatal", "always", "off"};
+const char* const kModuleNames[] = {"general", "hci", "dbus", "gatt", "server"};
+
+bool parseLevel(const std::string& name, LogLevel& level) {
+    for (size_t i = 0; i < sizeof(kLevelNames) / sizeof(kLevelNames[0]); ++i) {
+        if (name == kLevelNames[i]) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseModule(const std::string& name, LogModule& module) {
+    for (size_t i = 0; i < sizeof(kModuleNames) / sizeof(kModuleNames[0]); ++i) {
+        if (name == kModuleNames[i]) {
+            module = static_cast<LogModule>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void Logger::setLevel(LogLevel level) {
+    for (auto& moduleLevel : moduleLevels) {
+        moduleLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+}
+
+void Logger::setLevel(LogModule module, LogLevel level) {
+    if (module < LogModule::Count) {
+        moduleLevels[static_cast<size_t>(module)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+}
+
+LogLevel Logger::getLevel(LogModule module) {
+    if (module >= LogModule::Count) {
+        return LogLevel::Off;
+    }
+    return static_cast<LogLevel>(moduleLevels[static_cast<size_t>(module)].load(std::memory_order_relaxed));
+}
+
+// "info,hci=debug" -> 모든 모듈 info, hci만 debug (앞에서부터 순서대로 적용)
+bool Logger::setLevels(const std::string& spec) {
+    bool valid = true;
+    size_t start = 0;
+
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) {
+            end = spec.size();
+        }
+
+        std::string entry = spec.substr(start, end - start);
+        entry.erase(std::remove_if(entry.begin(), entry.end(), [](unsigned char c) { return std::isspace(c); }), entry.end());
+        std::transform(entry.begin(), entry.end(), entry.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        if (!entry.empty()) {
+            size_t separator = entry.find('=');
+            LogLevel level;
+            LogModule module;
+
+            if (separator == std::string::npos) {
+                if (parseLevel(entry, level)) {
+                    setLevel(level);
+                } else {
+                    valid = false;
+                }
+            } else if (parseModule(entry.substr(0, separator), module) && parseLevel(entry.substr(separator + 1), level)) {
+                setLevel(module, level);
+            } else {
+                valid = false;
+            }
+        }
+
+        start = end + 1;
+    }
+
+    return valid;
+}
+
+const char* Logger::levelName(LogLevel level) {
+    size_t index = static_cast<size_t>(level);
+    return index < sizeof(kLevelNames) / sizeof(kLevelNames[0]) ? kLevelNames[index] : "unknown";
+}
+
+const char* Logger::moduleName(LogModule module) {
+    size_t index = static_cast<size_t>(module);
+    return index < sizeof(kModuleNames) / sizeof(kModuleNames[0]) ? kModuleNames[index] : "unknown";
+}
+
 //
 // Log receiver delegates
 //
@@ -29,80 +133,173 @@ void Logger::registerFatalReceiver(LogReceiver receiver) { logReceiverFatal = re
 void Logger::registerAlwaysReceiver(LogReceiver receiver) { logReceiverAlways = receiver; }
 void Logger::registerTraceReceiver(LogReceiver receiver) { logReceiverTrace = receiver; }
 
+Logger::LogReceiver Logger::getReceiver(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return logReceiverTrace;
+        case LogLevel::Debug: return logReceiverDebug;
+        case LogLevel::Info: return logReceiverInfo;
+        case LogLevel::Status: return logReceiverStatus;
+        case LogLevel::Warn: return logReceiverWarn;
+        case LogLevel::Error: return logReceiverError;
+        case LogLevel::Fatal: return logReceiverFatal;
+        case LogLevel::Always: return logReceiverAlways;
+        default: return LogReceiver();
+    }
+}
+
+// 탭은 함수 포인터이므로 잠금 없이 교체 가능 (Off = 비활성)
+std::atomic<Logger::LogTap> Logger::logTap{nullptr};
+std::atomic<uint8_t> Logger::tapLevel{static_cast<uint8_t>(LogLevel::Off)};
+
+void Logger::setTap(LogTap tap, LogLevel minimum) {
+    tapLevel.store(static_cast<uint8_t>(tap != nullptr ? minimum : LogLevel::Off), std::memory_order_relaxed);
+    logTap.store(tap, std::memory_order_release);
+}
+
+void Logger::notifyTap(LogLevel level, const char *pText) {
+    if (isTapped(level)) {
+        LogTap tap = logTap.load(std::memory_order_acquire);
+        if (tap != nullptr) {
+            tap(level, pText);
+        }
+    }
+}
+
 //
 // Logging actions
 //
 
+// Passes a message that has already been gated to the tap and the receiver for its level
+void Logger::write(LogLevel level, const char *pText) {
+    notifyTap(level, pText);
+    switch (level) {
+        case LogLevel::Trace: if (logReceiverTrace) { logReceiverTrace(pText); } break;
+        case LogLevel::Debug: if (logReceiverDebug) { logReceiverDebug(pText); } break;
+        case LogLevel::Info: if (logReceiverInfo) { logReceiverInfo(pText); } break;
+        case LogLevel::Status: if (logReceiverStatus) { logReceiverStatus(pText); } break;
+        case LogLevel::Warn: if (logReceiverWarn) { logReceiverWarn(pText); } break;
+        case LogLevel::Error: if (logReceiverError) { logReceiverError(pText); } break;
+        case LogLevel::Fatal: if (logReceiverFatal) { logReceiverFatal(pText); } break;
+        case LogLevel::Always: if (logReceiverAlways) { logReceiverAlways(pText); } break;
+        default: break;
+    }
+}
+
+// 이름 있는 진입점은 General 모듈의 런타임 레벨을 따름 (BLE_LOG=warn이면 debug/info 생략)
+
 // Log a DEBUG entry with a C string
-void Logger::debug(const char *pText) { if (logReceiverDebug) { logReceiverDebug(pText); } }
+void Logger::debug(const char *pText) { if (isLevelEnabled(LogLevel::Debug, LogModule::General)) { write(LogLevel::Debug, pText); } }
 
 // Log a DEBUG entry with a string
-void Logger::debug(const std::string &text) { if (logReceiverDebug) { debug(text.c_str()); } }
+void Logger::debug(const std::string &text) { if (isEnabled(LogLevel::Debug)) { write(LogLevel::Debug, text.c_str()); } }
 
 // Log a DEBUG entry using a stream
-void Logger::debug(const std::ostream &text) { if (logReceiverDebug) { debug(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::debug(const std::ostream &text) { if (isEnabled(LogLevel::Debug)) { write(LogLevel::Debug, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a INFO entry with a C string
-void Logger::info(const char *pText) { if (logReceiverInfo) { logReceiverInfo(pText); } }
+void Logger::info(const char *pText) { if (isLevelEnabled(LogLevel::Info, LogModule::General)) { write(LogLevel::Info, pText); } }
 
 // Log a INFO entry with a string
-void Logger::info(const std::string &text) { if (logReceiverInfo) { info(text.c_str()); } }
+void Logger::info(const std::string &text) { if (isEnabled(LogLevel::Info)) { write(LogLevel::Info, text.c_str()); } }
 
 // Log a INFO entry using a stream
-void Logger::info(const std::ostream &text) { if (logReceiverInfo) { info(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::info(const std::ostream &text) { if (isEnabled(LogLevel::Info)) { write(LogLevel::Info, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a STATUS entry with a C string
-void Logger::status(const char *pText) { if (logReceiverStatus) { Logger::logReceiverStatus(pText); } }
+void Logger::status(const char *pText) { if (isLevelEnabled(LogLevel::Status, LogModule::General)) { write(LogLevel::Status, pText); } }
 
 // Log a STATUS entry with a string
-void Logger::status(const std::string &text) { if (logReceiverStatus) { status(text.c_str()); } }
+void Logger::status(const std::string &text) { if (isEnabled(LogLevel::Status)) { write(LogLevel::Status, text.c_str()); } }
 
 // Log a STATUS entry using a stream
-void Logger::status(const std::ostream &text) { if (logReceiverStatus) { status(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::status(const std::ostream &text) { if (isEnabled(LogLevel::Status)) { write(LogLevel::Status, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a WARN entry with a C string
-void Logger::warn(const char *pText) { if (logReceiverWarn) { logReceiverWarn(pText); } }
+void Logger::warn(const char *pText) { if (isLevelEnabled(LogLevel::Warn, LogModule::General)) { write(LogLevel::Warn, pText); } }
 
 // Log a WARN entry with a string
-void Logger::warn(const std::string &text) { if (logReceiverWarn) { warn(text.c_str()); } }
+void Logger::warn(const std::string &text) { if (isEnabled(LogLevel::Warn)) { write(LogLevel::Warn, text.c_str()); } }
 
 // Log a WARN entry using a stream
-void Logger::warn(const std::ostream &text) { if (logReceiverWarn) { warn(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::warn(const std::ostream &text) { if (isEnabled(LogLevel::Warn)) { write(LogLevel::Warn, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a ERROR entry with a C string
-void Logger::error(const char *pText) { if (logReceiverError) { logReceiverError(pText); } }
+void Logger::error(const char *pText) { if (isLevelEnabled(LogLevel::Error, LogModule::General)) { write(LogLevel::Error, pText); } }
 
 // Log a ERROR entry with a string
-void Logger::error(const std::string &text) { if (logReceiverError) { error(text.c_str()); } }
+void Logger::error(const std::string &text) { if (isEnabled(LogLevel::Error)) { write(LogLevel::Error, text.c_str()); } }
 
 // Log a ERROR entry using a stream
-void Logger::error(const std::ostream &text) { if (logReceiverError) { error(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::error(const std::ostream &text) { if (isEnabled(LogLevel::Error)) { write(LogLevel::Error, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a FATAL entry with a C string
-void Logger::fatal(const char *pText) { if (logReceiverFatal) { logReceiverFatal(pText); } }
+void Logger::fatal(const char *pText) { if (isLevelEnabled(LogLevel::Fatal, LogModule::General)) { write(LogLevel::Fatal, pText); } }
 
 // Log a FATAL entry with a string
-void Logger::fatal(const std::string &text) { if (logReceiverFatal) { fatal(text.c_str()); } }
+void Logger::fatal(const std::string &text) { if (isEnabled(LogLevel::Fatal)) { write(LogLevel::Fatal, text.c_str()); } }
 
 // Log a FATAL entry using a stream
-void Logger::fatal(const std::ostream &text) { if (logReceiverFatal) { fatal(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::fatal(const std::ostream &text) { if (isEnabled(LogLevel::Fatal)) { write(LogLevel::Fatal, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a ALWAYS entry with a C string
-void Logger::always(const char *pText) { if (logReceiverAlways) { logReceiverAlways(pText); } }
+void Logger::always(const char *pText) { if (isLevelEnabled(LogLevel::Always, LogModule::General)) { write(LogLevel::Always, pText); } }
 
 // Log a ALWAYS entry with a string
-void Logger::always(const std::string &text) { if (logReceiverAlways) { always(text.c_str()); } }
+void Logger::always(const std::string &text) { if (isEnabled(LogLevel::Always)) { write(LogLevel::Always, text.c_str()); } }
 
 // Log a ALWAYS entry using a stream
-void Logger::always(const std::ostream &text) { if (logReceiverAlways) { always(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::always(const std::ostream &text) { if (isEnabled(LogLevel::Always)) { write(LogLevel::Always, static_cast<const std::ostringstream &>(text).str().c_str()); } }
 
 // Log a TRACE entry with a C string
-void Logger::trace(const char *pText) { if (logReceiverTrace) { logReceiverTrace(pText); } }
+void Logger::trace(const char *pText) { if (isLevelEnabled(LogLevel::Trace, LogModule::General)) { write(LogLevel::Trace, pText); } }
 
 // Log a TRACE entry with a string
-void Logger::trace(const std::string &text) { if (logReceiverTrace) { trace(text.c_str()); } }
+void Logger::trace(const std::string &text) { if (isEnabled(LogLevel::Trace)) { write(LogLevel::Trace, text.c_str()); } }
 
 // Log a TRACE entry using a stream
-void Logger::trace(const std::ostream &text) { if (logReceiverTrace) { trace(static_cast<const std::ostringstream &>(text).str().c_str()); } }
+void Logger::trace(const std::ostream &text) { if (isEnabled(LogLevel::Trace)) { write(LogLevel::Trace, static_cast<const std::ostringstream &>(text).str().c_str()); } }
+
+//
+// Formatting stream
+//
+
+namespace {
+
+// std::ostringstream 생성(로케일 초기화)이 포맷팅 비용의 대부분이므로 스레드별로 재사용
+thread_local std::ostringstream t_logStream;
+thread_local bool t_logStreamBusy = false;
+
+// 재사용할 때 이전 메시지의 std::hex, setw, setfill, setprecision 등을 되돌리는 기본 포맷
+thread_local const std::ostringstream t_defaultFormat;
+
+} // namespace
+
+Logger::ScopedStream::ScopedStream() {
+    owned = !t_logStreamBusy;
+    if (owned) {
+        t_logStreamBusy = true;
+        t_logStream.str(std::string());
+        t_logStream.clear();
+        t_logStream.copyfmt(t_defaultFormat);
+        pStream = &t_logStream;
+    } else {
+        pStream = new std::ostringstream();
+    }
+}
+
+Logger::ScopedStream::~ScopedStream() {
+    if (owned) {
+        t_logStreamBusy = false;
+    } else {
+        delete pStream;
+    }
+}
+
+// Log an entry at a level chosen at runtime; the caller (the GGK_LOG macros) has already checked the module's level
+void Logger::log(LogLevel level, const char *pText) { write(level, pText); }
+
+void Logger::log(LogLevel level, const std::string &text) { log(level, text.c_str()); }
+
+void Logger::log(LogLevel level, const std::ostream &text) { log(level, static_cast<const std::ostringstream &>(text).str().c_str()); }
 
 }; // namespace ggk
\ No newline at end of file
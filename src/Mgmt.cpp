@@ -1,105 +1,377 @@
 #include "Mgmt.h"
+#include "HciEventDecoder.h"
 #include "Logger.h"
 #include <string.h>
 
 namespace ggk {
 
-Mgmt::Mgmt(HciAdapter& adapter, uint16_t controllerIndex)
-    : hciAdapter(adapter)
-    , controllerIndex(controllerIndex) {
+constexpr std::chrono::milliseconds Mgmt::kDefaultTimeout;
+
+namespace {
+
+// 리틀 엔디안 필드 읽기
+uint32_t readLe32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+
+// MGMT 주소는 리틀 엔디안(역순)으로 전달됨
+std::string addressString(const uint8_t* pAddress) {
+    uint8_t reversed[6];
+    for (int i = 0; i < 6; ++i) {
+        reversed[i] = pAddress[5 - i];
+    }
+    return Utils::bluetoothAddressString(reversed);
 }
 
-bool Mgmt::setName(std::string name, std::string shortName) {
-    name = truncateName(name);
-    shortName = truncateShortName(shortName);
+} // namespace
+
+Mgmt::Mgmt(uint16_t controllerIndex)
+    : controllerIndex(controllerIndex)
+    , isRunning(false)
+    , currentSettings(0) {
+}
+
+Mgmt::~Mgmt() {
+    stop();
+}
 
-    struct {
-        HciAdapter::HciHeader header;
-        char name[249];
-        char shortName[11];
-    } __attribute__((packed)) request;
+bool Mgmt::initialize() {
+    std::lock_guard<std::mutex> lock(initMutex);
 
-    request.header.type = 0x01;
-    request.header.opcode = HciAdapter::CMD_SET_LOCAL_NAME;
-    request.header.plen = sizeof(request) - sizeof(HciAdapter::HciHeader);
+    if (isRunning) {
+        return true;
+    }
+
+    if (!mgmtSocket.connectManagement()) {
+        Logger::error("Failed to connect to the Bluetooth Management API");
+        return false;
+    }
 
-    memset(request.name, 0, sizeof(request.name));
-    strncpy(request.name, name.c_str(), sizeof(request.name) - 1);
-    
-    memset(request.shortName, 0, sizeof(request.shortName));
-    strncpy(request.shortName, shortName.c_str(), sizeof(request.shortName) - 1);
+    isRunning = true;
+    eventThread = std::thread(&Mgmt::processEvents, this);
 
-    return hciAdapter.sendCommand(request.header);
+    Logger::info("Mgmt initialized for controller " + std::to_string(controllerIndex));
+    return true;
 }
 
-bool Mgmt::setDiscoverable(uint8_t disc, uint16_t timeout) {
-    struct {
-        HciAdapter::HciHeader header;
-        uint8_t disc;
-        uint16_t timeout;
-    } __attribute__((packed)) request;
+void Mgmt::stop() {
+    {
+        std::lock_guard<std::mutex> lock(initMutex);
+        isRunning = false;
+
+        if (eventThread.joinable()) {
+            eventThread.join();
+        }
 
-    request.header.type = 0x01;
-    request.header.opcode = HciAdapter::CMD_SET_DISCOVERABLE;
-    request.header.plen = sizeof(request) - sizeof(HciAdapter::HciHeader);
-    request.disc = disc;
-    request.timeout = timeout;
+        mgmtSocket.disconnect();
+    }
 
-    return hciAdapter.sendCommand(request.header);
+    // 응답을 받을 수 없으므로 대기 중인 명령은 모두 취소
+    std::list<PendingCommand> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        cancelled.swap(pendingCommands);
+    }
+
+    for (auto& pending : cancelled) {
+        CommandResult result;
+        result.command = pending.command;
+        result.status = kStatusCancelled;
+        pending.promise->set_value(result);
+    }
 }
 
-bool Mgmt::setState(uint16_t commandCode, uint16_t controllerId, uint8_t newState) {
-    struct {
-        HciAdapter::HciHeader header;
-        uint8_t state;
-    } __attribute__((packed)) request;
+bool Mgmt::setName(std::string name, std::string shortName) {
+    name = truncateName(name);
+    shortName = truncateShortName(shortName);
 
-    request.header.type = 0x01;
-    request.header.opcode = commandCode;
-    request.header.plen = sizeof(request) - sizeof(HciAdapter::HciHeader);
-    request.state = newState;
+    // MGMT_OP_SET_LOCAL_NAME: name[249] + short_name[11], null 패딩
+    std::vector<uint8_t> parameters(249 + 11, 0);
+    memcpy(parameters.data(), name.data(), name.size());
+    memcpy(parameters.data() + 249, shortName.data(), shortName.size());
 
-    return hciAdapter.sendCommand(request.header);
+    return sendCommand(CMD_SET_LOCAL_NAME, parameters).succeeded();
 }
 
-bool Mgmt::setPowered(bool newState) {
-    struct {
-        uint8_t type;    // HCI Command packet type = 0x01
-        uint16_t opcode; // OGF = 0x03 (Controller & Baseband), OCF = 0x0003 (Reset)
-        uint8_t plen;    // Parameter length
-        uint8_t state;   // Power state
-    } __attribute__((packed)) cmd;
+bool Mgmt::setDiscoverable(uint8_t disc, uint16_t timeout) {
+    // MGMT_OP_SET_DISCOVERABLE: [val][timeout(2)]
+    std::vector<uint8_t> parameters = {
+        disc,
+        static_cast<uint8_t>(timeout & 0xFF),
+        static_cast<uint8_t>(timeout >> 8)
+    };
 
-    cmd.type = 0x01;  // HCI Command
-    cmd.opcode = htole16(0x0C03);  // OGF = 0x03, OCF = 0x0003
-    cmd.plen = 1;
-    cmd.state = newState ? 1 : 0;
+    return sendCommand(CMD_SET_DISCOVERABLE, parameters).succeeded();
+}
 
-    return hciAdapter.getSocket().write(reinterpret_cast<uint8_t*>(&cmd), sizeof(cmd));
+bool Mgmt::setState(uint16_t commandCode, uint8_t newState) {
+    return sendCommand(commandCode, {newState}).succeeded();
+}
+
+bool Mgmt::setPowered(bool newState) {
+    return setState(CMD_SET_POWERED, newState ? 1 : 0);
 }
 
 bool Mgmt::setBredr(bool newState) {
-    return setState(HciAdapter::CMD_SET_BREDR, controllerIndex, newState ? 1 : 0);
+    return setState(CMD_SET_BREDR, newState ? 1 : 0);
 }
 
 bool Mgmt::setSecureConnections(uint8_t newState) {
-    return setState(HciAdapter::CMD_SET_SECURE_CONN, controllerIndex, newState);
+    return setState(CMD_SET_SECURE_CONNECTIONS, newState);
 }
 
 bool Mgmt::setBondable(bool newState) {
-    return setState(HciAdapter::CMD_SET_BONDABLE, controllerIndex, newState ? 1 : 0);
+    return setState(CMD_SET_BONDABLE, newState ? 1 : 0);
 }
 
 bool Mgmt::setConnectable(bool newState) {
-    return setState(HciAdapter::CMD_SET_CONNECTABLE, controllerIndex, newState ? 1 : 0);
+    return setState(CMD_SET_CONNECTABLE, newState ? 1 : 0);
 }
 
 bool Mgmt::setLE(bool newState) {
-    return setState(HciAdapter::CMD_SET_LE, controllerIndex, newState ? 1 : 0);
+    return setState(CMD_SET_LE, newState ? 1 : 0);
 }
 
 bool Mgmt::setAdvertising(uint8_t newState) {
-    return setState(HciAdapter::CMD_SET_ADVERTISING, controllerIndex, newState);
+    return setState(CMD_SET_ADVERTISING, newState);
+}
+
+Mgmt::CommandResult Mgmt::sendCommand(uint16_t command, const std::vector<uint8_t>& parameters,
+                                      std::chrono::milliseconds timeout) {
+    std::future<CommandResult> future = sendCommandAsync(command, parameters);
+
+    if (future.wait_for(timeout) == std::future_status::ready) {
+        return future.get();
+    }
+
+    // 타임아웃 - 나중에 도착한 응답이 다음 명령과 섞이지 않도록 가장 오래된 대기 항목 제거
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        for (auto it = pendingCommands.begin(); it != pendingCommands.end(); ++it) {
+            if (it->command == command) {
+                pendingCommands.erase(it);
+                break;
+            }
+        }
+    }
+
+    Logger::warn("MGMT command timed out: " + Utils::hex(command));
+
+    CommandResult result;
+    result.command = command;
+    result.status = kStatusTimeout;
+    return result;
+}
+
+std::future<Mgmt::CommandResult> Mgmt::sendCommandAsync(uint16_t command, const std::vector<uint8_t>& parameters) {
+    auto promise = std::make_shared<std::promise<CommandResult>>();
+    std::future<CommandResult> future = promise->get_future();
+
+    auto fail = [&](const std::string& reason) {
+        Logger::error("Failed to send MGMT command " + Utils::hex(command) + ": " + reason);
+        CommandResult result;
+        result.command = command;
+        result.status = kStatusSendFailed;
+        promise->set_value(result);
+        return std::move(future);
+    };
+
+    if (!isRunning && !initialize()) {
+        return fail("management socket unavailable");
+    }
+
+    if (parameters.size() > 0xFFFF) {
+        return fail("parameters too long");
+    }
+
+    MgmtHeader header;
+    header.code = Utils::endianToHci(command);
+    header.controllerId = Utils::endianToHci(controllerIndex);
+    header.dataSize = Utils::endianToHci(static_cast<uint16_t>(parameters.size()));
+
+    // 응답이 쓰기 직후 도착할 수 있으므로 먼저 대기 목록에 등록
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pendingCommands.push_back({command, promise});
+    }
+
+    bool written;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        written = mgmtSocket.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header),
+                                   parameters.data(), parameters.size());
+    }
+
+    if (!written) {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        for (auto it = pendingCommands.begin(); it != pendingCommands.end(); ++it) {
+            if (it->promise == promise) {
+                pendingCommands.erase(it);
+                break;
+            }
+        }
+        return fail("write failed");
+    }
+
+    return future;
+}
+
+void Mgmt::subscribe(uint16_t eventCode, EventHandler handler) {
+    std::lock_guard<std::mutex> lock(handlersMutex);
+    eventHandlers[eventCode].push_back(std::move(handler));
+}
+
+void Mgmt::onNewSettings(SettingsHandler handler) {
+    subscribe(EVT_NEW_SETTINGS, [handler](uint16_t, HciByteView data) {
+        if (data.size >= 4) {
+            handler(readLe32(data.data));
+        }
+    });
+}
+
+void Mgmt::onDeviceConnected(DeviceConnectedHandler handler) {
+    // [address(6)][address type][flags(4)][eir length(2)][eir...]
+    subscribe(EVT_DEVICE_CONNECTED, [handler](uint16_t, HciByteView data) {
+        if (data.size >= 7) {
+            handler(addressString(data.data), data[6]);
+        }
+    });
+}
+
+void Mgmt::onDeviceDisconnected(DeviceDisconnectedHandler handler) {
+    // [address(6)][address type][reason]
+    subscribe(EVT_DEVICE_DISCONNECTED, [handler](uint16_t, HciByteView data) {
+        if (data.size >= 8) {
+            handler(addressString(data.data), data[6], data[7]);
+        }
+    });
+}
+
+void Mgmt::onConnectionParameters(ConnectionParametersHandler handler) {
+    // [address(6)][address type][store hint][min interval(2)][max interval(2)][latency(2)][timeout(2)]
+    subscribe(EVT_NEW_CONN_PARAM, [handler](uint16_t, HciByteView data) {
+        if (data.size >= 16) {
+            ConnectionParameters parameters;
+            parameters.address = addressString(data.data);
+            parameters.addressType = data[6];
+            parameters.minInterval = hciLe16(data.data + 8);
+            parameters.maxInterval = hciLe16(data.data + 10);
+            parameters.latency = hciLe16(data.data + 12);
+            parameters.timeout = hciLe16(data.data + 14);
+            handler(parameters);
+        }
+    });
+}
+
+void Mgmt::completeCommand(uint16_t command, uint16_t controllerId, CommandResult result) {
+    std::shared_ptr<std::promise<CommandResult>> promise;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        for (auto it = pendingCommands.begin(); it != pendingCommands.end(); ++it) {
+            if (it->command == command) {
+                promise = it->promise;
+                pendingCommands.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (!promise) {
+        GGK_LOG_DEBUG(Hci, "Unmatched MGMT reply for command " << Utils::hex(command) << " on controller " << controllerId);
+        return;
+    }
+
+    promise->set_value(std::move(result));
+}
+
+void Mgmt::processEvents() {
+    Logger::debug("Started MGMT event processing thread");
+
+    std::vector<HciPacket> packets;
+    packets.reserve(kEventBatchSize);
+
+    while (isRunning && mgmtSocket.isConnected()) {
+        packets.clear();
+        if (mgmtSocket.readBatch(packets, kEventBatchSize, kEventWaitMS) == 0) {
+            continue;
+        }
+
+        for (const HciPacket& packet : packets) {
+            HciByteView view = packet.view();
+            if (view.size < sizeof(MgmtHeader)) {
+                Logger::error("Received invalid MGMT event (too short)");
+                continue;
+            }
+
+            uint16_t eventCode = hciLe16(view.data);
+            uint16_t controllerId = hciLe16(view.data + 2);
+            uint16_t dataSize = hciLe16(view.data + 4);
+
+            HciByteView data = view.subview(sizeof(MgmtHeader));
+            if (data.size < dataSize) {
+                Logger::error("Received truncated MGMT event: " + Utils::hex(eventCode));
+                continue;
+            }
+            data.size = dataSize;
+
+            switch (eventCode) {
+                case EVT_CMD_COMPLETE:  // [opcode(2)][status][return parameters...]
+                case EVT_CMD_STATUS:    // [opcode(2)][status]
+                {
+                    if (data.size < 3) {
+                        break;
+                    }
+
+                    CommandResult result;
+                    result.command = hciLe16(data.data);
+                    result.status = data[2];
+                    if (eventCode == EVT_CMD_COMPLETE && data.size > 3) {
+                        result.data.assign(data.data + 3, data.data + data.size);
+                    }
+
+                    // 설정 변경 명령의 Command Complete에는 현재 설정값이 포함됨
+                    if (eventCode == EVT_CMD_COMPLETE && result.succeeded() && result.data.size() == 4 &&
+                        controllerId == controllerIndex) {
+                        currentSettings = readLe32(result.data.data());
+                    }
+
+                    completeCommand(result.command, controllerId, std::move(result));
+                    break;
+                }
+                default:
+                    if (eventCode == EVT_NEW_SETTINGS && data.size >= 4 && controllerId == controllerIndex) {
+                        currentSettings = readLe32(data.data);
+                    }
+                    dispatchEvent(eventCode, controllerId, data);
+                    break;
+            }
+        }
+    }
+
+    Logger::debug("Stopped MGMT event processing thread");
+}
+
+void Mgmt::dispatchEvent(uint16_t eventCode, uint16_t controllerId, HciByteView data) {
+    // 다른 컨트롤러의 이벤트는 무시
+    if (controllerId != controllerIndex && controllerId != kNonControllerIndex) {
+        return;
+    }
+
+    std::vector<EventHandler> handlers;
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        auto it = eventHandlers.find(eventCode);
+        if (it == eventHandlers.end()) {
+            return;
+        }
+        handlers = it->second;
+    }
+
+    for (const auto& handler : handlers) {
+        try {
+            handler(controllerId, data);
+        } catch (const std::exception& e) {
+            Logger::error("Exception in MGMT event handler: " + std::string(e.what()));
+        }
+    }
 }
 
 std::string Mgmt::truncateName(const std::string& name) {
@@ -116,4 +388,4 @@ std::string Mgmt::truncateShortName(const std::string& name) {
     return name.substr(0, kMaxAdvertisingShortNameLength);
 }
 
-} // namespace ggk
\ No newline at end of file
+} // namespace ggk
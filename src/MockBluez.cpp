@@ -0,0 +1,880 @@
+#include "MockBluez.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Logger.h"
+
+namespace ggk {
+
+namespace {
+
+constexpr const char* kErrorFailed = "org.bluez.Error.Failed";
+constexpr const char* kErrorInvalidArguments = "org.bluez.Error.InvalidArguments";
+constexpr const char* kErrorAlreadyExists = "org.bluez.Error.AlreadyExists";
+constexpr const char* kErrorDoesNotExist = "org.bluez.Error.DoesNotExist";
+constexpr const char* kErrorNotPermitted = "org.bluez.Error.NotPermitted";
+
+constexpr uint32_t kNameFlagDoNotQueue = 4;              // DBUS_NAME_FLAG_DO_NOT_QUEUE
+constexpr uint32_t kNameReplyPrimaryOwner = 1;           // DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER
+constexpr uint8_t kSupportedAdvertisements = 5;          // bluetoothd가 흔히 보고하는 값
+constexpr guint kTickIntervalMs = 1;
+
+bool hasFlag(GVariant* pFlags, const char* pFlag) {
+    size_t count = g_variant_n_children(pFlags);
+    for (size_t i = 0; i < count; ++i) {
+        const char* pValue = nullptr;
+        g_variant_get_child(pFlags, i, "&s", &pValue);
+        if (strcmp(pValue, pFlag) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hasInterface(GVariant* pInterfaces, const std::string& name) {
+    GVariantPtr properties = makeGVariantPtr(g_variant_lookup_value(pInterfaces, name.c_str(), nullptr));
+    return properties != nullptr;
+}
+
+// bluetoothd가 ReadValue/WriteValue에 넘기는 옵션
+GVariant* requestOptions(const std::string& devicePath, uint16_t mtu, const char* pType) {
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+    g_variant_builder_add(&builder, "{sv}", "device", g_variant_new_object_path(devicePath.c_str()));
+    g_variant_builder_add(&builder, "{sv}", "link", g_variant_new_string("LE"));
+    g_variant_builder_add(&builder, "{sv}", "mtu", g_variant_new_uint16(mtu));
+    g_variant_builder_add(&builder, "{sv}", "offset", g_variant_new_uint16(0));
+    if (pType != nullptr) {
+        g_variant_builder_add(&builder, "{sv}", "type", g_variant_new_string(pType));
+    }
+    return g_variant_builder_end(&builder);
+}
+
+void returnError(GDBusMethodInvocation* pInvocation, const char* pName, const std::string& message) {
+    g_dbus_method_invocation_return_dbus_error(pInvocation, pName, message.c_str());
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    char* pEnd = nullptr;
+    value = strtod(text.c_str(), &pEnd);
+    return !text.empty() && *pEnd == '\0';
+}
+
+uint64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// "count", "mean_us", "p50_us", "p99_us", "p999_us", "max_us"
+void appendLatency(std::string& out, const LatencyHistogram& histogram) {
+    char text[256];
+    snprintf(text, sizeof(text),
+             "\"count\": %llu, \"mean_us\": %.1f, \"p50_us\": %.1f, \"p99_us\": %.1f, \"p999_us\": %.1f, \"max_us\": %.1f",
+             static_cast<unsigned long long>(histogram.count()), histogram.mean() / 1000.0,
+             histogram.percentile(50) / 1000.0, histogram.percentile(99) / 1000.0, histogram.percentile(99.9) / 1000.0,
+             histogram.max() / 1000.0);
+    out += text;
+}
+
+} // namespace
+
+void MockBluez::OperationStats::add(uint64_t latencyNs, bool ok) {
+    completed += ok ? 1 : 0;
+    failed += ok ? 0 : 1;
+    latency.record(latencyNs);
+}
+
+double MockBluez::Report::requestsPerSecond() const {
+    return elapsedSeconds > 0 ? static_cast<double>(reads.completed + writes.completed + commands) / elapsedSeconds : 0.0;
+}
+
+MockBluez::MockBluez(DBusConnection& connection, Config config)
+    : connection(connection),
+      config(std::move(config)),
+      adapter(std::make_unique<DBusObject>(connection, DBusObjectPath(this->config.adapterPath))),
+      random(1) {
+}
+
+MockBluez::~MockBluez() {
+    stop();
+    if (adapter->isRegistered()) {
+        adapter->unregisterObject();
+    }
+    if (pCancellable != nullptr) {
+        g_object_unref(pCancellable);
+    }
+    if (pContext != nullptr) {
+        g_main_context_unref(pContext);
+    }
+}
+
+bool MockBluez::start() {
+    GDBusConnection* pConnection = connection.getRawConnection();
+    if (pConnection == nullptr) {
+        Logger::error("MockBluez: not connected to D-Bus");
+        return false;
+    }
+
+    pContext = g_main_context_ref_thread_default();
+    pCancellable = g_cancellable_new();
+
+    // 메시지 버스에서는 org.bluez 이름을 가져옴 (피어 간 연결에는 이름이 없음)
+    if (g_dbus_connection_get_unique_name(pConnection) != nullptr) {
+        GVariantPtr result = connection.callMethod(
+            "org.freedesktop.DBus",
+            DBusObjectPath("/org/freedesktop/DBus"),
+            "org.freedesktop.DBus",
+            "RequestName",
+            makeGVariantPtr(g_variant_ref_sink(g_variant_new("(su)", BlueZConstants::BLUEZ_SERVICE.c_str(), kNameFlagDoNotQueue))),
+            "(u)");
+        guint32 reply = 0;
+        if (result) {
+            g_variant_get(result.get(), "(u)", &reply);
+        }
+        if (reply != kNameReplyPrimaryOwner) {
+            Logger::error("MockBluez: cannot own " + BlueZConstants::BLUEZ_SERVICE + " (is bluetoothd running on this bus?)");
+            return false;
+        }
+    }
+
+    bool ok = adapter->addInterface(BlueZConstants::GATT_MANAGER_INTERFACE);
+    ok = ok && adapter->addMethod(BlueZConstants::GATT_MANAGER_INTERFACE, BlueZConstants::REGISTER_APPLICATION,
+                                  [this](const DBusMethodCall& call) { handleRegisterApplication(call); },
+                                  {{"o", "application", "in", ""}, {"a{sv}", "options", "in", ""}});
+    ok = ok && adapter->addMethod(BlueZConstants::GATT_MANAGER_INTERFACE, BlueZConstants::UNREGISTER_APPLICATION,
+                                  [this](const DBusMethodCall& call) { handleUnregisterApplication(call); },
+                                  {{"o", "application", "in", ""}});
+
+    std::vector<DBusProperty> advertisingProperties = {
+        {"ActiveInstances", "y", true, false, false,
+         [this]() { return g_variant_new_byte(static_cast<uint8_t>(advertisementCount.load())); }, nullptr},
+        {"SupportedInstances", "y", true, false, false,
+         [this]() { return g_variant_new_byte(static_cast<uint8_t>(kSupportedAdvertisements - advertisementCount.load())); },
+         nullptr},
+        {"SupportedIncludes", "as", true, false, false,
+         []() {
+             const char* includes[] = {"tx-power", "appearance", "local-name"};
+             return g_variant_new_strv(includes, 3);
+         },
+         nullptr},
+    };
+    ok = ok && adapter->addInterface(BlueZConstants::LE_ADVERTISING_MANAGER_INTERFACE, advertisingProperties);
+    ok = ok && adapter->addMethod(BlueZConstants::LE_ADVERTISING_MANAGER_INTERFACE, BlueZConstants::REGISTER_ADVERTISEMENT,
+                                  [this](const DBusMethodCall& call) { handleRegisterAdvertisement(call); },
+                                  {{"o", "advertisement", "in", ""}, {"a{sv}", "options", "in", ""}});
+    ok = ok && adapter->addMethod(BlueZConstants::LE_ADVERTISING_MANAGER_INTERFACE, BlueZConstants::UNREGISTER_ADVERTISEMENT,
+                                  [this](const DBusMethodCall& call) { handleUnregisterAdvertisement(call); },
+                                  {{"o", "advertisement", "in", ""}});
+
+    if (!ok || !adapter->registerObject()) {
+        Logger::error("MockBluez: failed to export " + config.adapterPath);
+        return false;
+    }
+
+    Logger::info("MockBluez: waiting for RegisterApplication on " + config.adapterPath);
+    return true;
+}
+
+void MockBluez::stop() {
+    stopRequested = true;
+    phaseActive = false;
+    stopLoad();
+
+    if (pCancellable != nullptr) {
+        g_cancellable_cancel(pCancellable);
+        while (inFlight > 0) {
+            g_main_context_iteration(pContext, TRUE);
+        }
+    }
+
+    if (signalSubscription != 0) {
+        g_dbus_connection_signal_unsubscribe(connection.getRawConnection(), signalSubscription);
+        signalSubscription = 0;
+    }
+    if (pPendingRegistration != nullptr) {
+        returnError(pPendingRegistration, kErrorFailed, "Stopped");
+        pPendingRegistration = nullptr;
+    }
+}
+
+std::vector<MockBluez::Characteristic> MockBluez::getCharacteristics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return characteristics;
+}
+
+std::vector<MockBluez::Report> MockBluez::getReports() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reports;
+}
+
+//
+// GattManager1 / LEAdvertisingManager1
+//
+
+void MockBluez::handleRegisterApplication(const DBusMethodCall& call) {
+    const char* pPath = nullptr;
+    g_variant_get_child(call.parameters.get(), 0, "&o", &pPath);
+
+    if (!applicationPath.empty()) {
+        returnError(call.invocation.get(), kErrorAlreadyExists, "Application already registered: " + applicationPath);
+        return;
+    }
+
+    applicationOwner = call.sender;
+    applicationPath = pPath;
+    Logger::info("MockBluez: RegisterApplication " + applicationPath + " from " + applicationOwner);
+
+    if (config.replyAfterWalk) {
+        // 응답하지 않은 호출의 참조는 응답할 때 반환됨
+        pPendingRegistration = call.invocation.get();
+    } else {
+        g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
+    }
+    walkApplication();
+}
+
+void MockBluez::handleUnregisterApplication(const DBusMethodCall& call) {
+    const char* pPath = nullptr;
+    g_variant_get_child(call.parameters.get(), 0, "&o", &pPath);
+
+    if (applicationPath.empty() || applicationPath != pPath) {
+        returnError(call.invocation.get(), kErrorDoesNotExist, std::string("Not registered: ") + pPath);
+        return;
+    }
+
+    Logger::info("MockBluez: UnregisterApplication " + applicationPath);
+    stopRequested = true;
+    stopLoad();
+    if (signalSubscription != 0) {
+        g_dbus_connection_signal_unsubscribe(connection.getRawConnection(), signalSubscription);
+        signalSubscription = 0;
+    }
+    applicationRegistered = false;
+    applicationPath.clear();
+    g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
+
+    if (!phaseActive && !finished) {
+        finish();
+    }
+}
+
+void MockBluez::handleRegisterAdvertisement(const DBusMethodCall& call) {
+    const char* pPath = nullptr;
+    g_variant_get_child(call.parameters.get(), 0, "&o", &pPath);
+
+    for (const auto& advertisement : advertisements) {
+        if (advertisement.first == call.sender && advertisement.second == pPath) {
+            returnError(call.invocation.get(), kErrorAlreadyExists, std::string("Already registered: ") + pPath);
+            return;
+        }
+    }
+    if (advertisements.size() >= kSupportedAdvertisements) {
+        returnError(call.invocation.get(), kErrorNotPermitted, "Maximum advertisements reached");
+        return;
+    }
+
+    advertisements.emplace_back(call.sender, pPath);
+    advertisementCount = advertisements.size();
+    g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
+
+    // bluetoothd처럼 광고 속성을 읽어 확인 (응답은 먼저 보냄: 등록 호출이 동기식)
+    struct Pending {
+        MockBluez* pOwner;
+        std::string path;
+    };
+    ++inFlight;
+    g_dbus_connection_call(
+        connection.getRawConnection(), call.sender.empty() ? nullptr : call.sender.c_str(), pPath,
+        BlueZConstants::PROPERTIES_INTERFACE.c_str(), "GetAll",
+        g_variant_new("(s)", BlueZConstants::LE_ADVERTISEMENT_INTERFACE.c_str()), G_VARIANT_TYPE("(a{sv})"),
+        G_DBUS_CALL_FLAGS_NONE, -1, pCancellable,
+        [](GObject* pSource, GAsyncResult* pResult, gpointer pUserData) {
+            std::unique_ptr<Pending> pending(static_cast<Pending*>(pUserData));
+            GError* pError = nullptr;
+            GVariant* pProperties = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, &pError);
+            --pending->pOwner->inFlight;
+
+            if (pProperties == nullptr) {
+                if (!g_error_matches(pError, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+                    Logger::warn("MockBluez: cannot read advertisement " + pending->path + ": " + pError->message);
+                }
+                g_error_free(pError);
+                return;
+            }
+
+            GVariantPtr properties = makeGVariantPtr(g_variant_get_child_value(pProperties, 0));
+            g_variant_unref(pProperties);
+            const char* pType = "?";
+            g_variant_lookup(properties.get(), "Type", "&s", &pType);
+            Logger::info("MockBluez: RegisterAdvertisement " + pending->path + " (" + pType + ", " +
+                         std::to_string(g_variant_n_children(properties.get())) + " properties)");
+        },
+        new Pending{this, pPath});
+}
+
+void MockBluez::handleUnregisterAdvertisement(const DBusMethodCall& call) {
+    const char* pPath = nullptr;
+    g_variant_get_child(call.parameters.get(), 0, "&o", &pPath);
+
+    for (auto it = advertisements.begin(); it != advertisements.end(); ++it) {
+        if (it->first == call.sender && it->second == pPath) {
+            advertisements.erase(it);
+            advertisementCount = advertisements.size();
+            Logger::info(std::string("MockBluez: UnregisterAdvertisement ") + pPath);
+            g_dbus_method_invocation_return_value(call.invocation.get(), nullptr);
+            return;
+        }
+    }
+    returnError(call.invocation.get(), kErrorDoesNotExist, std::string("Not registered: ") + pPath);
+}
+
+//
+// GetManagedObjects walk
+//
+
+void MockBluez::walkApplication() {
+    ++inFlight;
+    g_dbus_connection_call(
+        connection.getRawConnection(), peerName(), applicationPath.c_str(),
+        BlueZConstants::OBJECT_MANAGER_INTERFACE.c_str(), BlueZConstants::GET_MANAGED_OBJECTS.c_str(), nullptr,
+        G_VARIANT_TYPE("(a{oa{sa{sv}}})"), G_DBUS_CALL_FLAGS_NONE, -1, pCancellable,
+        [](GObject* pSource, GAsyncResult* pResult, gpointer pUserData) {
+            MockBluez* pSelf = static_cast<MockBluez*>(pUserData);
+            GError* pError = nullptr;
+            GVariant* pObjects = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, &pError);
+            --pSelf->inFlight;
+
+            if (pError != nullptr && g_error_matches(pError, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+                g_error_free(pError);
+                return;
+            }
+            pSelf->onManagedObjects(pObjects, pError);
+            if (pObjects != nullptr) {
+                g_variant_unref(pObjects);
+            }
+            if (pError != nullptr) {
+                g_error_free(pError);
+            }
+        },
+        this);
+}
+
+void MockBluez::onManagedObjects(GVariant* pObjects, const GError* pError) {
+    if (pObjects == nullptr) {
+        finishRegistration(false, std::string("GetManagedObjects failed: ") + (pError != nullptr ? pError->message : "?"));
+        return;
+    }
+
+    std::vector<Characteristic> found;
+    size_t services = 0;
+    size_t descriptors = 0;
+
+    GVariantPtr objects = makeGVariantPtr(g_variant_get_child_value(pObjects, 0));
+    GVariantIter iter;
+    g_variant_iter_init(&iter, objects.get());
+    const char* pPath = nullptr;
+    GVariant* pInterfaces = nullptr;
+    while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &pPath, &pInterfaces)) {
+        GVariantPtr interfaces = makeGVariantPtr(pInterfaces);
+        GVariantPtr properties = makeGVariantPtr(g_variant_lookup_value(
+            interfaces.get(), BlueZConstants::GATT_CHARACTERISTIC_INTERFACE.c_str(), G_VARIANT_TYPE("a{sv}")));
+
+        if (!properties) {
+            services += hasInterface(interfaces.get(), BlueZConstants::GATT_SERVICE_INTERFACE) ? 1 : 0;
+            descriptors += hasInterface(interfaces.get(), BlueZConstants::GATT_DESCRIPTOR_INTERFACE) ? 1 : 0;
+            continue;
+        }
+
+        Characteristic characteristic;
+        characteristic.path = pPath;
+        const char* pUuid = "";
+        g_variant_lookup(properties.get(), BlueZConstants::PROPERTY_UUID.c_str(), "&s", &pUuid);
+        characteristic.uuid = pUuid;
+
+        GVariantPtr flags = makeGVariantPtr(
+            g_variant_lookup_value(properties.get(), BlueZConstants::PROPERTY_FLAGS.c_str(), G_VARIANT_TYPE("as")));
+        if (flags) {
+            characteristic.readable = hasFlag(flags.get(), "read");
+            characteristic.writable = hasFlag(flags.get(), "write");
+            characteristic.writableWithoutResponse = hasFlag(flags.get(), "write-without-response");
+            characteristic.notifiable = hasFlag(flags.get(), "notify") || hasFlag(flags.get(), "indicate");
+        }
+        found.push_back(std::move(characteristic));
+    }
+
+    readTargets.clear();
+    writeTargets.clear();
+    commandTargets.clear();
+    for (size_t i = 0; i < found.size(); ++i) {
+        if (found[i].readable) {
+            readTargets.push_back(i);
+        }
+        if (found[i].writable) {
+            writeTargets.push_back(i);
+        }
+        if (found[i].writableWithoutResponse) {
+            commandTargets.push_back(i);
+        }
+    }
+
+    Logger::info("MockBluez: " + applicationPath + ": " + std::to_string(services) + " services, " +
+                 std::to_string(found.size()) + " characteristics, " + std::to_string(descriptors) + " descriptors");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        characteristics = std::move(found);
+    }
+    finishRegistration(true, "");
+}
+
+void MockBluez::finishRegistration(bool success, const std::string& message) {
+    if (pPendingRegistration != nullptr) {
+        if (success) {
+            g_dbus_method_invocation_return_value(pPendingRegistration, nullptr);
+        } else {
+            returnError(pPendingRegistration, kErrorInvalidArguments, message);
+        }
+        pPendingRegistration = nullptr;
+    }
+
+    if (!success) {
+        Logger::error("MockBluez: " + message);
+        applicationPath.clear();
+        finish();
+        return;
+    }
+
+    applicationRegistered = true;
+    if (config.subscribe) {
+        subscribeNotifications();
+    }
+    startPhase(0);
+}
+
+void MockBluez::subscribeNotifications() {
+    signalSubscription = g_dbus_connection_signal_subscribe(
+        connection.getRawConnection(), peerName(), BlueZConstants::PROPERTIES_INTERFACE.c_str(), "PropertiesChanged", nullptr,
+        BlueZConstants::GATT_CHARACTERISTIC_INTERFACE.c_str(), G_DBUS_SIGNAL_FLAGS_NONE,
+        [](GDBusConnection*, const gchar*, const gchar*, const gchar*, const gchar*, GVariant* pParameters, gpointer pUserData) {
+            static_cast<MockBluez*>(pUserData)->onPropertiesChanged(pParameters);
+        },
+        this, nullptr);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Characteristic& characteristic : characteristics) {
+        if (!characteristic.notifiable) {
+            continue;
+        }
+        ++inFlight;
+        g_dbus_connection_call(
+            connection.getRawConnection(), peerName(), characteristic.path.c_str(),
+            BlueZConstants::GATT_CHARACTERISTIC_INTERFACE.c_str(), BlueZConstants::START_NOTIFY.c_str(), nullptr, nullptr,
+            G_DBUS_CALL_FLAGS_NONE, -1, pCancellable,
+            [](GObject* pSource, GAsyncResult* pResult, gpointer pUserData) {
+                MockBluez* pSelf = static_cast<MockBluez*>(pUserData);
+                GError* pError = nullptr;
+                GVariant* pReply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, &pError);
+                --pSelf->inFlight;
+                if (pReply != nullptr) {
+                    g_variant_unref(pReply);
+                } else {
+                    if (!g_error_matches(pError, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+                        Logger::warn(std::string("MockBluez: StartNotify failed: ") + pError->message);
+                    }
+                    g_error_free(pError);
+                }
+            },
+            this);
+    }
+}
+
+void MockBluez::onPropertiesChanged(GVariant* pParameters) {
+    GVariantPtr changed = makeGVariantPtr(g_variant_get_child_value(pParameters, 1));
+    GVariantPtr value = makeGVariantPtr(
+        g_variant_lookup_value(changed.get(), BlueZConstants::PROPERTY_VALUE.c_str(), G_VARIANT_TYPE("ay")));
+    if (!value) {
+        return;
+    }
+    ++notifications;
+    if (!phaseActive) {
+        return;
+    }
+    ++current.notifications;
+
+    // 값 앞 8바이트: 보낸 쪽의 steady_clock 시각 (ns, 리틀 엔디언)
+    gsize size = 0;
+    const uint8_t* pBytes = static_cast<const uint8_t*>(g_variant_get_fixed_array(value.get(), &size, sizeof(uint8_t)));
+    if (config.timestampedValues && size >= sizeof(uint64_t)) {
+        uint64_t stamp = 0;
+        for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+            stamp |= static_cast<uint64_t>(pBytes[i]) << (8 * i);
+        }
+        uint64_t now = steadyNanoseconds();
+        current.notificationLag.record(now > stamp ? now - stamp : 0);
+    }
+}
+
+//
+// Load phases
+//
+
+void MockBluez::startPhase(size_t index) {
+    phaseIndex = index;
+    if (stopRequested || index >= config.phases.size()) {
+        finish();
+        return;
+    }
+    if (readTargets.empty() && writeTargets.empty() && commandTargets.empty()) {
+        Logger::warn("MockBluez: no readable or writable characteristics, nothing to load");
+        finish();
+        return;
+    }
+
+    const Phase& phase = config.phases[index];
+    current = Report();
+    current.phase = phase.name.empty() ? "phase" + std::to_string(index + 1) : phase.name;
+    current.clients = phase.clients;
+    current.targetRate = phase.ratePerClient * static_cast<double>(phase.clients);
+
+    // 클라이언트마다 가상 장치 하나; 파라미터는 미리 만들어 재사용 (측정 대상은 서버 쪽 비용)
+    std::vector<uint8_t> value(phase.writeSize);
+    phaseStart = Clock::now();
+    phaseEnd = phaseStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(phase.durationSeconds));
+    auto period = phase.ratePerClient > 0
+                      ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / phase.ratePerClient))
+                      : Clock::duration::zero();
+
+    clients.clear();
+    clients.resize(phase.clients);
+    for (size_t i = 0; i < clients.size(); ++i) {
+        Client& client = clients[i];
+        char devicePath[128];
+        snprintf(devicePath, sizeof(devicePath), "%s/dev_00_00_00_00_%02X_%02X", config.adapterPath.c_str(),
+                 static_cast<unsigned>((i >> 8) & 0xFF), static_cast<unsigned>(i & 0xFF));
+
+        for (size_t b = 0; b < value.size(); ++b) {
+            value[b] = static_cast<uint8_t>(i + b);
+        }
+        GVariant* pBytes = g_variant_new_fixed_array(G_VARIANT_TYPE("y"), value.data(), value.size(), sizeof(uint8_t));
+
+        client.pOwner = this;
+        client.devicePath = devicePath;
+        client.sequence = i;
+        client.readParameters = makeGVariantPtr(
+            g_variant_ref_sink(g_variant_new("(@a{sv})", requestOptions(client.devicePath, phase.mtu, nullptr))));
+        client.writeParameters = makeGVariantPtr(
+            g_variant_ref_sink(g_variant_new("(@ay@a{sv})", pBytes, requestOptions(client.devicePath, phase.mtu, "request"))));
+        client.commandParameters = makeGVariantPtr(g_variant_ref_sink(
+            g_variant_new("(@ay@a{sv})", g_variant_new_fixed_array(G_VARIANT_TYPE("y"), value.data(), value.size(), sizeof(uint8_t)),
+                          requestOptions(client.devicePath, phase.mtu, "command"))));
+        client.nextSend = phaseStart + period * i / clients.size();       // 동시에 몰리지 않도록 분산
+    }
+
+    Logger::info("MockBluez: " + current.phase + ": " + std::to_string(phase.clients) + " clients, " +
+                 (phase.ratePerClient > 0 ? std::to_string(phase.ratePerClient) + " req/s each" : std::string("closed loop")) +
+                 ", " + std::to_string(phase.durationSeconds) + " s");
+
+    phaseActive = true;
+    phaseRunning = true;
+    if (phase.ratePerClient <= 0) {
+        for (Client& client : clients) {
+            sendRequest(client);
+        }
+    }
+
+    pTickSource = g_timeout_source_new(kTickIntervalMs);
+    g_source_set_callback(
+        pTickSource,
+        [](gpointer pUserData) -> gboolean {
+            return static_cast<MockBluez*>(pUserData)->onTick() ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+        },
+        this, nullptr);
+    g_source_attach(pTickSource, pContext);
+}
+
+void MockBluez::stopLoad() {
+    phaseRunning = false;
+    if (pTickSource != nullptr) {
+        g_source_destroy(pTickSource);
+        g_source_unref(pTickSource);
+        pTickSource = nullptr;
+    }
+    if (phaseActive && outstanding == 0) {
+        endPhase();
+    }
+}
+
+bool MockBluez::onTick() {
+    Clock::time_point now = Clock::now();
+    if (now >= phaseEnd) {
+        // 소스는 콜백이 G_SOURCE_REMOVE를 반환하면 제거됨
+        g_source_unref(pTickSource);
+        pTickSource = nullptr;
+        stopLoad();
+        return false;
+    }
+
+    // 일정이 있는 클라이언트와, 폐루프에서 응답 없는 쓰기를 보낸 클라이언트
+    for (Client& client : clients) {
+        if (!client.busy && client.nextSend <= now) {
+            sendRequest(client);
+        }
+    }
+    return true;
+}
+
+void MockBluez::sendRequest(Client& client) {
+    const Phase& phase = config.phases[phaseIndex];
+
+    // 비율대로 고르되 해당 특성이 없으면 있는 종류로 대체
+    unsigned pick = static_cast<unsigned>(random() % 100);
+    bool command = false;
+    if (pick < phase.readPercent && !readTargets.empty()) {
+        client.reading = true;
+    } else if (pick < phase.readPercent + phase.commandPercent && !commandTargets.empty()) {
+        command = true;
+    } else if (!writeTargets.empty()) {
+        client.reading = false;
+    } else if (!readTargets.empty()) {
+        client.reading = true;
+    } else {
+        command = true;
+    }
+
+    const std::vector<size_t>& targets = command ? commandTargets : client.reading ? readTargets : writeTargets;
+    const std::string& path = characteristics[targets[client.sequence++ % targets.size()]].path;
+    if (command) {
+        sendCommand(client, path);
+        return;
+    }
+
+    client.busy = true;
+    client.sent = phase.ratePerClient > 0 ? client.nextSend : Clock::now();
+    ++outstanding;
+    ++inFlight;
+    g_dbus_connection_call(
+        connection.getRawConnection(), peerName(), path.c_str(), BlueZConstants::GATT_CHARACTERISTIC_INTERFACE.c_str(),
+        client.reading ? BlueZConstants::READ_VALUE.c_str() : BlueZConstants::WRITE_VALUE.c_str(),
+        client.reading ? client.readParameters.get() : client.writeParameters.get(),
+        client.reading ? G_VARIANT_TYPE("(ay)") : nullptr, G_DBUS_CALL_FLAGS_NONE, -1, pCancellable,
+        [](GObject* pSource, GAsyncResult* pResult, gpointer pUserData) {
+            Client* pClient = static_cast<Client*>(pUserData);
+            GVariant* pReply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, nullptr);
+            if (pReply != nullptr) {
+                g_variant_unref(pReply);
+            }
+            pClient->pOwner->onReply(*pClient, pReply != nullptr);
+        },
+        &client);
+}
+
+void MockBluez::sendCommand(Client& client, const std::string& path) {
+    GDBusMessage* pMessage = g_dbus_message_new_method_call(peerName(), path.c_str(),
+                                                            BlueZConstants::GATT_CHARACTERISTIC_INTERFACE.c_str(),
+                                                            BlueZConstants::WRITE_VALUE.c_str());
+    g_dbus_message_set_body(pMessage, client.commandParameters.get());
+    g_dbus_message_set_flags(pMessage, G_DBUS_MESSAGE_FLAGS_NO_REPLY_EXPECTED);
+
+    GError* pError = nullptr;
+    if (g_dbus_connection_send_message(connection.getRawConnection(), pMessage, G_DBUS_SEND_MESSAGE_FLAGS_NONE, nullptr,
+                                       &pError)) {
+        ++current.commands;
+    } else {
+        Logger::warn(std::string("MockBluez: write command failed: ") + pError->message);
+        g_error_free(pError);
+    }
+    g_object_unref(pMessage);
+
+    // 응답이 없으므로 다음 요청은 틱에서 (폐루프에서도 재귀 없이 최대 틱당 하나)
+    const Phase& phase = config.phases[phaseIndex];
+    if (phase.ratePerClient > 0) {
+        client.nextSend += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / phase.ratePerClient));
+    } else {
+        client.nextSend = Clock::now();
+    }
+}
+
+void MockBluez::onReply(Client& client, bool ok) {
+    --inFlight;
+    --outstanding;
+    client.busy = false;
+    if (!phaseActive) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    uint64_t latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - client.sent).count();
+    (client.reading ? current.reads : current.writes).add(latencyNs, ok);
+
+    if (!phaseRunning) {
+        if (outstanding == 0) {
+            endPhase();                 // clients가 비워지므로 이후 client를 쓰지 않음
+        }
+        return;
+    }
+
+    const Phase& phase = config.phases[phaseIndex];
+    if (phase.ratePerClient <= 0) {
+        sendRequest(client);
+        return;
+    }
+
+    client.nextSend += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / phase.ratePerClient));
+    if (client.nextSend <= now) {
+        // 응답이 다음 예정 시각보다 늦음: 바로 보냄 (일정은 유지, 지연은 예정 시각부터 잼)
+        ++current.lateRequests;
+        sendRequest(client);
+    }
+}
+
+void MockBluez::endPhase() {
+    phaseActive = false;
+    current.elapsedSeconds = std::chrono::duration<double>(Clock::now() - phaseStart).count();
+    Logger::info("MockBluez: " + formatReport(current));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back(current);
+    }
+    clients.clear();
+    startPhase(phaseIndex + 1);
+}
+
+void MockBluez::finish() {
+    if (finished.exchange(true)) {
+        return;
+    }
+    if (finishedCallback) {
+        finishedCallback();
+    }
+}
+
+//
+// Phase scripts and reports
+//
+
+bool MockBluez::parsePhase(const std::string& text, Phase& phase) {
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string item = text.substr(start, end - start);
+        start = end + 1;
+
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            Logger::error("Invalid phase item (expected key=value): " + item);
+            return false;
+        }
+        std::string key = item.substr(0, equals);
+        std::string valueText = item.substr(equals + 1);
+
+        if (key == "name") {
+            phase.name = valueText;
+            continue;
+        }
+
+        double value = 0;
+        bool ok = parseNumber(valueText, value) && value >= 0;
+        if (ok && key == "clients") {
+            ok = value >= 1 && value <= 65535;
+            phase.clients = static_cast<size_t>(value);
+        } else if (ok && key == "rate") {
+            phase.ratePerClient = value;
+        } else if (ok && key == "duration") {
+            ok = value > 0;
+            phase.durationSeconds = value;
+        } else if (ok && key == "read") {
+            ok = value <= 100;
+            phase.readPercent = static_cast<unsigned>(value);
+        } else if (ok && key == "command") {
+            ok = value <= 100;
+            phase.commandPercent = static_cast<unsigned>(value);
+        } else if (ok && key == "size") {
+            ok = value <= 512;          // ATT 속성 값 최대 길이
+            phase.writeSize = static_cast<size_t>(value);
+        } else if (ok && key == "mtu") {
+            ok = value >= 23 && value <= 517;
+            phase.mtu = static_cast<uint16_t>(value);
+        } else if (ok) {
+            Logger::error("Unknown phase key: " + key);
+            return false;
+        }
+
+        if (!ok) {
+            Logger::error("Invalid phase value: " + item);
+            return false;
+        }
+    }
+
+    if (phase.readPercent + phase.commandPercent > 100) {
+        Logger::error("Invalid phase mix: read + command > 100: " + text);
+        return false;
+    }
+    return true;
+}
+
+std::string MockBluez::formatReport(const Report& report) {
+    char line[512];
+    int length = snprintf(line, sizeof(line),
+                          "%-12s clients=%-4zu %6.1f s  %9.1f req/s  read %zu (%zu failed, p50 %.0f us, p99 %.0f us)  "
+                          "write %zu (%zu failed, p50 %.0f us, p99 %.0f us)  command %zu  notify %zu  late %zu",
+                          report.phase.c_str(), report.clients, report.elapsedSeconds, report.requestsPerSecond(),
+                          report.reads.completed, report.reads.failed, report.reads.percentileUs(50),
+                          report.reads.percentileUs(99), report.writes.completed, report.writes.failed,
+                          report.writes.percentileUs(50), report.writes.percentileUs(99), report.commands,
+                          report.notifications, report.lateRequests);
+    if (report.notificationLag.count() > 0 && length > 0 && static_cast<size_t>(length) < sizeof(line)) {
+        snprintf(line + length, sizeof(line) - length, "  lag p50 %.0f us, p99 %.0f us",
+                 report.notificationLag.percentile(50) / 1000.0, report.notificationLag.percentile(99) / 1000.0);
+    }
+    return line;
+}
+
+std::string MockBluez::toJson(const Report& report) {
+    std::string out = "{\"phase\": ";
+    appendJsonString(out, report.phase);
+
+    char text[256];
+    snprintf(text, sizeof(text),
+             ", \"clients\": %zu, \"target_rps\": %.1f, \"elapsed_s\": %.3f, \"throughput_rps\": %.1f, \"late\": %zu",
+             report.clients, report.targetRate, report.elapsedSeconds, report.requestsPerSecond(), report.lateRequests);
+    out += text;
+
+    const std::pair<const char*, const OperationStats*> operations[] = {{"read", &report.reads}, {"write", &report.writes}};
+    for (const auto& operation : operations) {
+        snprintf(text, sizeof(text), ", \"%s\": {\"completed\": %zu, \"failed\": %zu, ", operation.first,
+                 operation.second->completed, operation.second->failed);
+        out += text;
+        appendLatency(out, operation.second->latency);
+        out += "}";
+    }
+
+    snprintf(text, sizeof(text), ", \"command\": {\"sent\": %zu}, \"notification\": {\"received\": %zu, \"lag\": {",
+             report.commands, report.notifications);
+    out += text;
+    appendLatency(out, report.notificationLag);
+    out += "}}}";
+    return out;
+}
+
+} // namespace ggk
@@ -0,0 +1,318 @@
+#include "PeriodicAdvertiser.h"
+#include "Logger.h"
+#include "Utils.h"
+#include <algorithm>
+
+namespace ggk {
+
+PeriodicAdvertiser::PeriodicAdvertiser(ExtendedAdvertiser& advertiser)
+    : advertiser(advertiser)
+    , adapter(advertiser.getAdapter())
+    , running(true) {
+    updateThread = std::thread(&PeriodicAdvertiser::run, this);
+}
+
+PeriodicAdvertiser::~PeriodicAdvertiser() {
+    {
+        std::lock_guard<std::mutex> lock(trainsMutex);
+        running = false;
+    }
+    updateCondition.notify_all();
+
+    if (updateThread.joinable()) {
+        updateThread.join();
+    }
+}
+
+// LE Set Periodic Advertising Parameters (0x203E): [Handle][Interval_Min(2)][Interval_Max(2)][Properties(2)]
+std::vector<uint8_t> PeriodicAdvertiser::encodeParameters(uint8_t handle, const Parameters& parameters) {
+    uint16_t properties = parameters.includeTxPower ? kPropIncludeTxPower : 0x0000;
+    return {
+        handle,
+        static_cast<uint8_t>(parameters.minInterval & 0xFF), static_cast<uint8_t>(parameters.minInterval >> 8),
+        static_cast<uint8_t>(parameters.maxInterval & 0xFF), static_cast<uint8_t>(parameters.maxInterval >> 8),
+        static_cast<uint8_t>(properties & 0xFF), static_cast<uint8_t>(properties >> 8)
+    };
+}
+
+// LE Set Periodic Advertising Data (0x203F): [Handle][Operation][Data_Length][Data...]
+std::vector<HciCommand> PeriodicAdvertiser::fragmentData(uint8_t handle, const uint8_t* pData, size_t size) {
+    std::vector<HciCommand> commands;
+
+    size_t offset = 0;
+    do {
+        size_t length = std::min(size - offset, kMaxFragmentLength);
+        bool first = offset == 0;
+        bool last = offset + length == size;
+
+        uint8_t operation;
+        if (first && last) {
+            operation = ExtendedAdvertiser::kOperationComplete;
+        } else if (first) {
+            operation = ExtendedAdvertiser::kOperationFirst;
+        } else if (last) {
+            operation = ExtendedAdvertiser::kOperationLast;
+        } else {
+            operation = ExtendedAdvertiser::kOperationIntermediate;
+        }
+
+        HciCommand command;
+        command.opcode = CMD_LE_SET_PERIODIC_ADV_DATA;
+        command.parameters.reserve(3 + length);
+        command.parameters.push_back(handle);
+        command.parameters.push_back(operation);
+        command.parameters.push_back(static_cast<uint8_t>(length));
+        command.parameters.insert(command.parameters.end(), pData + offset, pData + offset + length);
+        commands.push_back(std::move(command));
+
+        offset += length;
+    } while (offset < size);
+
+    return commands;
+}
+
+int PeriodicAdvertiser::createTrain(const Parameters& parameters, AdvertisingSetParameters setParameters) {
+    if (parameters.minInterval < 0x0006 || parameters.minInterval > parameters.maxInterval) {
+        Logger::error("Invalid periodic advertising interval");
+        return -1;
+    }
+
+    // 주기적 광고는 비연결/비스캔/비익명 확장 광고 세트에서만 가능
+    setParameters.eventProperties &= AdvertisingSetParameters::kPropIncludeTxPower;
+
+    int handle = advertiser.createSet(setParameters);
+    if (handle < 0) {
+        return -1;
+    }
+
+    uint8_t setHandle = static_cast<uint8_t>(handle);
+    HciCommandResult result = adapter.sendCommandSync(CMD_LE_SET_PERIODIC_ADV_PARAMETERS, encodeParameters(setHandle, parameters));
+    if (!result.succeeded()) {
+        Logger::error("Failed to set periodic advertising parameters (status " + Utils::hex(result.status) + ")");
+        advertiser.removeSet(setHandle);
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    Train& train = trains[setHandle];
+    train.parameters = parameters;
+    train.source = std::make_shared<DataSource>(*this, setHandle);
+    return handle;
+}
+
+// LE Set Periodic Advertising Enable (0x2040): [Enable][Handle]
+bool PeriodicAdvertiser::sendEnable(bool enable, uint8_t handle) {
+    HciCommandResult result = adapter.sendCommandSync(CMD_LE_SET_PERIODIC_ADV_ENABLE, {static_cast<uint8_t>(enable ? 0x01 : 0x00), handle});
+    if (!result.succeeded()) {
+        Logger::error(std::string("Failed to ") + (enable ? "enable" : "disable") + " periodic advertising on set " +
+                      std::to_string(handle) + " (status " + Utils::hex(result.status) + ")");
+        return false;
+    }
+
+    return true;
+}
+
+bool PeriodicAdvertiser::enable(uint8_t handle) {
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    {
+        std::lock_guard<std::mutex> lock(trainsMutex);
+        if (trains.count(handle) == 0) {
+            Logger::error("Unknown periodic advertising train " + std::to_string(handle));
+            return false;
+        }
+    }
+
+    // 주기적 광고를 먼저 켜야 확장 광고 시작 시 SyncInfo가 포함됨
+    if (!sendEnable(true, handle)) {
+        return false;
+    }
+
+    if (!advertiser.isEnabled(handle) && !advertiser.enable(handle)) {
+        sendEnable(false, handle);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    trains[handle].enabled = true;
+    return true;
+}
+
+bool PeriodicAdvertiser::disable(uint8_t handle) {
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    if (!sendEnable(false, handle)) {
+        return false;
+    }
+
+    advertiser.disable(handle);
+
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    auto it = trains.find(handle);
+    if (it != trains.end()) {
+        it->second.enabled = false;
+    }
+    return true;
+}
+
+bool PeriodicAdvertiser::removeTrain(uint8_t handle) {
+    if (isEnabled(handle) && !disable(handle)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    if (!advertiser.removeSet(handle)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    trains.erase(handle);
+    return true;
+}
+
+bool PeriodicAdvertiser::setData(uint8_t handle, const std::vector<uint8_t>& data) {
+    {
+        std::lock_guard<std::mutex> lock(trainsMutex);
+        auto it = trains.find(handle);
+        if (it == trains.end()) {
+            Logger::error("Unknown periodic advertising train " + std::to_string(handle));
+            return false;
+        }
+
+        it->second.value = data;
+        it->second.dirty = false;
+        it->second.lastSent = Clock::now();
+    }
+
+    return writeData(handle, data);
+}
+
+bool PeriodicAdvertiser::writeData(uint8_t handle, const std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+
+    if (data.size() > advertiser.getMaxDataLength()) {
+        Logger::error("Periodic advertising data for set " + std::to_string(handle) + " too long (" +
+                      std::to_string(data.size()) + " bytes)");
+        return false;
+    }
+
+    // 주기적 광고 중에는 단일 조각(complete operation)만 허용됨
+    bool pause = isEnabled(handle) && data.size() > kMaxFragmentLength;
+    if (pause && !sendEnable(false, handle)) {
+        return false;
+    }
+
+    bool success = adapter.sendCommandBatch(fragmentData(handle, data.data(), data.size()));
+
+    bool resumed = !pause || sendEnable(true, handle);
+
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    auto it = trains.find(handle);
+    if (it != trains.end()) {
+        if (!resumed) {
+            it->second.enabled = false;
+            success = false;
+        }
+        if (success) {
+            ++it->second.statistics.updatesSent;
+        } else {
+            ++it->second.statistics.failures;
+        }
+    }
+
+    if (!success) {
+        Logger::error("Failed to write periodic advertising data for set " + std::to_string(handle));
+    }
+    return success;
+}
+
+std::shared_ptr<PeriodicAdvertiser::DataSource> PeriodicAdvertiser::getDataSource(uint8_t handle) {
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    auto it = trains.find(handle);
+    return it != trains.end() ? it->second.source : nullptr;
+}
+
+void PeriodicAdvertiser::valueChanged(uint8_t handle, const std::vector<uint8_t>& value) {
+    {
+        std::lock_guard<std::mutex> lock(trainsMutex);
+        auto it = trains.find(handle);
+        if (it == trains.end()) {
+            return;
+        }
+
+        if (it->second.dirty) {
+            ++it->second.statistics.updatesCoalesced;
+        }
+        it->second.value = value;
+        it->second.dirty = true;
+    }
+
+    updateCondition.notify_all();
+}
+
+std::vector<uint8_t> PeriodicAdvertiser::getValue(uint8_t handle) const {
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    auto it = trains.find(handle);
+    return it != trains.end() ? it->second.value : std::vector<uint8_t>();
+}
+
+bool PeriodicAdvertiser::isEnabled(uint8_t handle) const {
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    auto it = trains.find(handle);
+    return it != trains.end() && it->second.enabled;
+}
+
+bool PeriodicAdvertiser::getStatistics(uint8_t handle, Statistics& statistics) const {
+    std::lock_guard<std::mutex> lock(trainsMutex);
+    auto it = trains.find(handle);
+    if (it == trains.end()) {
+        return false;
+    }
+
+    statistics = it->second.statistics;
+    return true;
+}
+
+void PeriodicAdvertiser::run() {
+    std::unique_lock<std::mutex> lock(trainsMutex);
+
+    while (running) {
+        // 갱신할 값이 있는 트레인 중 전송 가능 시각이 가장 이른 것을 찾음
+        Clock::time_point now = Clock::now();
+        Clock::time_point next = Clock::time_point::max();
+        uint8_t dueHandle = 0;
+        bool due = false;
+
+        for (const auto& entry : trains) {
+            if (!entry.second.dirty) {
+                continue;
+            }
+
+            Clock::time_point sendAt = entry.second.lastSent + entry.second.parameters.minUpdateInterval;
+            if (sendAt <= now) {
+                dueHandle = entry.first;
+                due = true;
+                break;
+            }
+            next = std::min(next, sendAt);
+        }
+
+        if (!due) {
+            if (next == Clock::time_point::max()) {
+                updateCondition.wait(lock);
+            } else {
+                updateCondition.wait_until(lock, next);
+            }
+            continue;
+        }
+
+        Train& train = trains[dueHandle];
+        std::vector<uint8_t> value = train.value;
+        train.dirty = false;
+        train.lastSent = now;
+
+        lock.unlock();
+        writeData(dueHandle, value);
+        lock.lock();
+    }
+}
+
+} // namespace ggk
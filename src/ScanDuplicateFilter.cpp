@@ -0,0 +1,81 @@
+#include "ScanDuplicateFilter.h"
+
+namespace ggk {
+
+namespace {
+
+const uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+const uint64_t kFnvPrime = 0x100000001b3ULL;
+
+inline uint64_t fnv1a(uint64_t hash, const uint8_t* pData, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= pData[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// 2의 거듭제곱으로 올림 (마스크로 인덱싱)
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 16;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+ScanDuplicateFilter::ScanDuplicateFilter(size_t capacity, std::chrono::milliseconds ttl)
+    : entries(roundUpToPowerOfTwo(capacity))
+    , mask(entries.size() - 1)
+    , ttl(ttl) {
+}
+
+uint64_t ScanDuplicateFilter::digest(uint8_t addressType, const uint8_t* pAddress, const uint8_t* pData, size_t size) {
+    uint64_t hash = fnv1a(kFnvOffsetBasis, &addressType, 1);
+    hash = fnv1a(hash, pAddress, 6);
+    hash = fnv1a(hash, pData, size);
+    return hash != 0 ? hash : 1;
+}
+
+bool ScanDuplicateFilter::isDuplicate(uint64_t digest, std::chrono::steady_clock::time_point now) {
+    // 상위 비트를 섞어 인덱스 분포를 고르게 함
+    size_t index = static_cast<size_t>(digest ^ (digest >> 32)) & mask;
+    Entry* pVictim = nullptr;
+    bool victimReusable = false;
+
+    for (size_t probe = 0; probe < kProbeLength; ++probe) {
+        Entry& entry = entries[(index + probe) & mask];
+
+        if (entry.digest == digest) {
+            if (now - entry.seen < ttl) {
+                return true;
+            }
+            entry.seen = now;
+            return false;
+        }
+
+        // 빈 슬롯이나 만료된 슬롯을 우선 재사용, 없으면 가장 오래된 항목을 교체
+        if (entry.digest == 0 || now - entry.seen >= ttl) {
+            if (!victimReusable) {
+                pVictim = &entry;
+                victimReusable = true;
+            }
+        } else if (!victimReusable && (pVictim == nullptr || entry.seen < pVictim->seen)) {
+            pVictim = &entry;
+        }
+    }
+
+    pVictim->digest = digest;
+    pVictim->seen = now;
+    return false;
+}
+
+void ScanDuplicateFilter::clear() {
+    for (auto& entry : entries) {
+        entry = Entry();
+    }
+}
+
+} // namespace ggk
@@ -0,0 +1,219 @@
+#include "StartupProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include "Logger.h"
+
+namespace ggk {
+
+namespace {
+
+std::mutex phasesMutex;
+std::vector<StartupProfiler::Phase> phases;
+std::atomic<uint64_t> originNs{0};
+std::atomic<bool> recording{true};
+thread_local unsigned threadDepth = 0;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// begin() 전에 처음 기록되는 단계가 시작 시각이 됨
+uint64_t origin() {
+    uint64_t value = originNs.load();
+    if (value == 0) {
+        uint64_t now = nowNs();
+        if (originNs.compare_exchange_strong(value, now)) {
+            return now;
+        }
+    }
+    return value;
+}
+
+double toMs(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+StartupProfiler::Scope::Scope(const char* pComponent, const char* pName)
+    : pComponent(pComponent), pName(pName), active(recording.load()) {
+    if (active) {
+        origin();
+        startNs = nowNs();
+        depth = threadDepth++;
+    }
+}
+
+StartupProfiler::Scope::~Scope() {
+    if (!active) {
+        return;
+    }
+    --threadDepth;
+    uint64_t endNs = nowNs();
+
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    if (!recording.load()) {
+        return;
+    }
+    Phase phase;
+    phase.component = pComponent;
+    phase.name = pName;
+    phase.startNs = startNs - std::min(startNs, originNs.load());
+    phase.durationNs = endNs - startNs;
+    phase.depth = depth;
+    phase.ok = ok;
+    phases.push_back(std::move(phase));
+}
+
+StartupProfiler::Accumulator::Accumulator(const char* pComponent, const char* pName)
+    : pComponent(pComponent), pName(pName), active(recording.load()) {
+    if (active) {
+        origin();
+        startNs = nowNs();
+        depth = threadDepth++;
+    }
+}
+
+StartupProfiler::Accumulator::~Accumulator() {
+    if (!active) {
+        return;
+    }
+    --threadDepth;
+    uint64_t durationNs = nowNs() - startNs;
+
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    if (!recording.load()) {
+        return;
+    }
+    for (Phase& phase : phases) {
+        if (phase.name == pName && phase.component == pComponent) {
+            phase.durationNs += durationNs;
+            ++phase.count;
+            return;
+        }
+    }
+    Phase phase;
+    phase.component = pComponent;
+    phase.name = pName;
+    phase.startNs = startNs - std::min(startNs, originNs.load());
+    phase.durationNs = durationNs;
+    phase.depth = depth;
+    phases.push_back(std::move(phase));
+}
+
+void StartupProfiler::begin() {
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    phases.clear();
+    originNs = nowNs();
+    recording = true;
+}
+
+void StartupProfiler::mark(const char* pComponent, const char* pName) {
+    if (!recording.load()) {
+        return;
+    }
+    uint64_t start = origin();
+    uint64_t now = nowNs();
+
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    Phase phase;
+    phase.component = pComponent;
+    phase.name = pName;
+    phase.startNs = now - std::min(now, start);
+    phase.durationNs = 0;
+    phase.depth = threadDepth;
+    phases.push_back(std::move(phase));
+}
+
+void StartupProfiler::finish() {
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    recording = false;
+}
+
+bool StartupProfiler::isRecording() {
+    return recording.load();
+}
+
+std::vector<StartupProfiler::Phase> StartupProfiler::getPhases() {
+    std::vector<Phase> result;
+    {
+        std::lock_guard<std::mutex> lock(phasesMutex);
+        result = phases;
+    }
+    // 바깥 단계가 먼저 시작하고, 같은 시각이면 얕은 단계가 먼저
+    std::stable_sort(result.begin(), result.end(), [](const Phase& a, const Phase& b) {
+        return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+    });
+    return result;
+}
+
+uint64_t StartupProfiler::getElapsedNs() {
+    std::lock_guard<std::mutex> lock(phasesMutex);
+    uint64_t elapsed = 0;
+    for (const Phase& phase : phases) {
+        elapsed = std::max(elapsed, phase.startNs + phase.durationNs);
+    }
+    return elapsed;
+}
+
+std::string StartupProfiler::formatReport() {
+    std::vector<Phase> sorted = getPhases();
+
+    char line[256];
+    snprintf(line, sizeof(line), "Startup report: %.3f ms\n%10s %12s %7s  %s\n", toMs(getElapsedNs()), "start ms", "time ms",
+             "calls", "phase");
+    std::string report = line;
+    for (const Phase& phase : sorted) {
+        char calls[21] = "";     // size_t 최대 20자리
+        if (phase.count > 1) {
+            snprintf(calls, sizeof(calls), "%zu", phase.count);
+        }
+        snprintf(line, sizeof(line), "%10.3f %12.3f %7s  %*s%s/%s%s\n", toMs(phase.startNs), toMs(phase.durationNs), calls,
+                 static_cast<int>(phase.depth * 2), "", phase.component.c_str(), phase.name.c_str(),
+                 phase.ok ? "" : " (failed)");
+        report += line;
+    }
+    return report;
+}
+
+std::string StartupProfiler::toJson() {
+    std::vector<Phase> sorted = getPhases();
+
+    char text[512];
+    snprintf(text, sizeof(text), "{\"total_ms\": %.3f, \"finished\": %s, \"phases\": [", toMs(getElapsedNs()),
+             isRecording() ? "false" : "true");
+    std::string json = text;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const Phase& phase = sorted[i];
+        // 이름은 코드의 문자열 상수이므로 이스케이프하지 않음
+        snprintf(text, sizeof(text),
+                 "%s{\"component\": \"%s\", \"name\": \"%s\", \"start_ms\": %.3f, \"duration_ms\": %.3f, \"count\": %zu, "
+                 "\"depth\": %u, \"ok\": %s}",
+                 i == 0 ? "" : ", ", phase.component.c_str(), phase.name.c_str(), toMs(phase.startNs),
+                 toMs(phase.durationNs), phase.count, phase.depth, phase.ok ? "true" : "false");
+        json += text;
+    }
+    json += "]}";
+    return json;
+}
+
+bool StartupProfiler::writeJson(const std::string& path) {
+    FILE* pFile = fopen(path.c_str(), "w");
+    if (pFile == nullptr) {
+        Logger::error("Cannot write startup report to " + path + ": " + strerror(errno));
+        return false;
+    }
+    std::string json = toJson();
+    bool ok = fwrite(json.data(), 1, json.size(), pFile) == json.size() && fputc('\n', pFile) != EOF;
+    return fclose(pFile) == 0 && ok;
+}
+
+} // namespace ggk
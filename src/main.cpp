@@ -5,7 +5,14 @@
 #include "GattCharacteristic.h"
 #include "GattTypes.h"
 #include "Logger.h"
+#include "AsyncLogSink.h"
+#include "BinaryLog.h"
+#include "FlightRecorder.h"
+#include "HciCapture.h"
+#include "StartupProfiler.h"
+#include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <signal.h>
 #include <unistd.h>
 
@@ -19,9 +26,40 @@ void signalHandler(int sig) {
     g_running = false;
 }
 
-// 콘솔 로그 핸들러
-void consoleLogger(const char* text) {
-    std::cout << text << std::endl;
+// 로그 출력 선택 (BLE_LOG_OUTPUT: 없음=stdout, "journal", 그 외=파일 경로)
+bool openLogOutput(AsyncLogSink& sink) {
+    const char* pOutput = getenv("BLE_LOG_OUTPUT");
+    if (pOutput == nullptr || pOutput[0] == '\0') {
+        return sink.openStdout();
+    }
+    if (std::string(pOutput) == "journal") {
+        return sink.openJournal("ble-server");
+    }
+    return sink.openFile(pOutput);
+}
+
+// HCI 캡처 (BLE_HCI_CAPTURE: "[btsnoop:|pcap:]경로", 형식을 생략하면 btsnoop)
+std::unique_ptr<HciCapture> openHciCapture() {
+    const char* pCapture = getenv("BLE_HCI_CAPTURE");
+    if (pCapture == nullptr || pCapture[0] == '\0') {
+        return nullptr;
+    }
+
+    std::string path = pCapture;
+    HciCapture::Format format = HciCapture::Format::Btsnoop;
+    if (path.compare(0, 5, "pcap:") == 0) {
+        format = HciCapture::Format::Pcap;
+        path.erase(0, 5);
+    } else if (path.compare(0, 8, "btsnoop:") == 0) {
+        path.erase(0, 8);
+    }
+
+    auto capture = std::make_unique<HciCapture>(path, format);
+    if (!capture->start()) {
+        Logger::warn("HCI capture disabled: cannot write " + path);
+        return nullptr;
+    }
+    return capture;
 }
 
 // Battery Service 상수
@@ -37,11 +75,33 @@ std::vector<uint8_t> getBatteryLevel() {
 }
 
 int main() {
-    // 로그 핸들러 등록
-    Logger::registerInfoReceiver(&consoleLogger);
-    Logger::registerDebugReceiver(&consoleLogger);
-    Logger::registerErrorReceiver(&consoleLogger);
-    Logger::registerWarnReceiver(&consoleLogger);
+    // 시작 단계별 시간 측정 (광고 시작까지; BLE_STARTUP_REPORT가 있으면 JSON으로도 저장)
+    StartupProfiler::begin();
+
+    // 로그 핸들러 등록 (기록은 백그라운드 스레드에서)
+    AsyncLogSink logSink;
+    if (!openLogOutput(logSink) || !logSink.start()) {
+        std::cerr << "Failed to open log output" << std::endl;
+        return 1;
+    }
+    logSink.install();
+
+    // 모듈별 로그 레벨 (예: BLE_LOG="info,hci=debug")
+    if (const char* pLevels = getenv("BLE_LOG")) {
+        if (!Logger::setLevels(pLevels)) {
+            Logger::warn(std::string("Ignoring invalid entries in BLE_LOG: ") + pLevels);
+        }
+    }
+
+    // 바이너리 로그 (GGK_BLOG_* 호출을 파일에 기록, ble-logdecode로 확인)
+    if (const char* pBinaryLog = getenv("BLE_LOG_BINARY")) {
+        BinaryLog::open(pBinaryLog);
+    }
+    
+    // 플라이트 레코더 (SIGUSR1, 치명적 시그널, D-Bus Dump 메서드로 최근 이벤트를 파일에 기록)
+    const char* pFlightRecorder = getenv("BLE_FLIGHT_RECORDER");
+    FlightRecorder::install(pFlightRecorder != nullptr && pFlightRecorder[0] != '\0' ? pFlightRecorder
+                                                                                     : FlightRecorder::kDefaultDumpPath);
     
     // 시그널 핸들러 등록
     signal(SIGINT, signalHandler);
@@ -50,18 +110,25 @@ int main() {
     try {
         // D-Bus 연결 생성
         DBusConnection connection;
-        if (!connection.connect(DBusConnection::BUS_SYSTEM)) {
-            Logger::error("Failed to connect to D-Bus system bus");
-            return 1;
+        {
+            StartupProfiler::Scope profile("server", "connect_dbus");
+            if (!connection.connect(DBusConnection::BUS_SYSTEM)) {
+                Logger::error("Failed to connect to D-Bus system bus");
+                return 1;
+            }
         }
         
-        // 1. BLE 서버 생성 및 초기화
+        // 1. BLE 서버 생성 및 초기화 (캡처는 서버보다 오래 살아야 함; 초기화 중 여는 HCI 소켓에 바로 연결되어 초기화 명령도 기록)
+        std::unique_ptr<HciCapture> hciCapture = openHciCapture();
+        HciSocket::setDefaultCapture(hciCapture.get());
         BleServer server(connection);
-        if (!server.initialize()) {
-            Logger::error("Failed to initialize BLE server");
-            return 1;
+        {
+            StartupProfiler::Scope profile("server", "initialize");
+            if (!server.initialize()) {
+                Logger::error("Failed to initialize BLE server");
+                return 1;
+            }
         }
-        
         // 2. GATT 애플리케이션 생성
         GattApplication app(connection, DBusObjectPath("/com/example/bleserver"));
         if (!app.setupDBusInterfaces()) {
@@ -107,9 +174,20 @@ int main() {
         advData.localName = "Jetson BLE Device";
         advData.serviceUuids.push_back(batteryServiceUuid);
         
-        if (!server.startAdvertising(advData)) {
-            Logger::error("Failed to start advertising");
-            return 1;
+        {
+            StartupProfiler::Scope profile("server", "start_advertising");
+            if (!server.startAdvertising(advData)) {
+                Logger::error("Failed to start advertising");
+                return 1;
+            }
+        }
+        
+        // 시작 보고서: 광고 시작까지
+        StartupProfiler::mark("server", "advertising");
+        StartupProfiler::finish();
+        Logger::info(StartupProfiler::formatReport());
+        if (const char* pStartupReport = getenv("BLE_STARTUP_REPORT")) {
+            StartupProfiler::writeJson(pStartupReport);
         }
         
         Logger::info("BLE server running. Press Ctrl+C to exit.");
@@ -125,6 +203,13 @@ int main() {
         server.stopAdvertising();
         app.unregisterFromBluez(DBusObjectPath("/org/bluez/hci0"));
         server.shutdown();
+        if (hciCapture) {
+            HciSocket::setDefaultCapture(nullptr);
+            if (server.getAdapter() != nullptr) {
+                server.getAdapter()->getSocket().setCapture(nullptr);
+            }
+            hciCapture->stop();
+        }
         
     } catch (const std::exception& e) {
         Logger::error(std::string("Exception: ") + e.what());
@@ -132,5 +217,6 @@ int main() {
     }
     
     Logger::info("BLE server stopped.");
+    BinaryLog::close();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../include/HciAdapter.h"
+
+using namespace ggk;
+
+// 어댑터는 초기화하지 않음 - 연결과 완료 이벤트는 디코더/트래커에 직접 주입
+class AclFlowControlTest : public ::testing::Test {
+protected:
+    HciAdapter adapter;
+
+    AclFlowControl& flow() { return adapter.getAclFlowControl(); }
+
+    void connect(uint16_t handle) {
+        LinkState state;
+        state.handle = handle;
+        adapter.getConnectionTracker().connectionComplete(state);
+    }
+
+    void completed(uint16_t handle, uint16_t count) {
+        const uint8_t params[] = {
+            0x01,
+            static_cast<uint8_t>(handle & 0xFF), static_cast<uint8_t>(handle >> 8),
+            static_cast<uint8_t>(count & 0xFF), static_cast<uint8_t>(count >> 8)
+        };
+        adapter.getEventDecoder().decode(HciEventDecoder::EVT_NUMBER_OF_COMPLETED_PACKETS, HciByteView(params, sizeof(params)));
+    }
+};
+
+// ✅ 1. 연결 수에 따라 버퍼를 균등 분배
+TEST_F(AclFlowControlTest, BudgetIsSharedBetweenConnections) {
+    flow().setBufferSize(251, 8);
+    connect(0x0040);
+
+    AclFlowControl::ConnectionCredits credits;
+    ASSERT_TRUE(flow().getCredits(0x0040, credits));
+    EXPECT_EQ(credits.budget, 8u);
+
+    connect(0x0041);
+    ASSERT_TRUE(flow().getCredits(0x0040, credits));
+    EXPECT_EQ(credits.budget, 4u);
+
+    flow().setConnectionBudget(2);
+    ASSERT_TRUE(flow().getCredits(0x0041, credits));
+    EXPECT_EQ(credits.budget, 2u);
+}
+
+// ✅ 2. Number of Completed Packets로 크레딧 회복, 추적하지 않은 완료는 따로 집계
+TEST_F(AclFlowControlTest, CompletedPacketsReleaseCredit) {
+    flow().setBufferSize(27, 4);
+    connect(0x0040);
+
+    flow().packetsQueued(0x0040, 4);
+    EXPECT_FALSE(flow().hasCredit(0x0040));
+    EXPECT_FALSE(flow().waitForCredit(0x0040, std::chrono::milliseconds(10)));
+
+    completed(0x0040, 3);
+    EXPECT_TRUE(flow().hasCredit(0x0040));
+
+    completed(0x0040, 5);
+    AclFlowControl::ConnectionCredits credits;
+    ASSERT_TRUE(flow().getCredits(0x0040, credits));
+    EXPECT_EQ(credits.outstanding, 0u);
+    EXPECT_EQ(credits.completed, 4u);
+    EXPECT_EQ(flow().getUntrackedCompletions(), 4u);
+}
+
+// ✅ 3. 알림 크기별 ACL 패킷 수 (L2CAP/ATT 헤더 포함)
+TEST_F(AclFlowControlTest, PacketsForNotification) {
+    flow().setBufferSize(27, 4);
+    EXPECT_EQ(flow().packetsForNotification(20), 1u);
+    EXPECT_EQ(flow().packetsForNotification(21), 2u);
+
+    flow().setBufferSize(251, 4);
+    EXPECT_EQ(flow().packetsForNotification(244), 1u);
+    EXPECT_EQ(flow().packetsForNotification(500), 3u);
+}
+
+// ✅ 4. 크레딧 콜백은 완료 이벤트가 올 때까지 대기 후 예약
+TEST_F(AclFlowControlTest, CreditCallbackWaitsForCompletion) {
+    flow().setBufferSize(27, 2);
+    connect(0x0040);
+
+    GattCreditCallback credit = flow().creditCallback();
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+    EXPECT_FALSE(credit(20, std::chrono::milliseconds(0)));
+
+    std::thread completer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        completed(0x0040, 1);
+    });
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(1000)));
+    completer.join();
+
+    // 연결이 끊기면 미완료 패킷도 사라짐
+    adapter.getConnectionTracker().disconnectionComplete(0x0040);
+    EXPECT_FALSE(flow().hasCredit(0x0040));
+    EXPECT_TRUE(flow().waitForAllCredit(std::chrono::milliseconds(0)));
+}
+
+// ✅ 5. 알림을 받지 않는 연결(완료 이벤트 없음)의 예약은 만료되어 다른 연결의 알림을 막지 않음
+TEST_F(AclFlowControlTest, UncompletedChargesExpire) {
+    flow().setBufferSize(27, 4);
+    flow().setChargeExpiry(std::chrono::milliseconds(50));
+    connect(0x0040);
+    connect(0x0041);
+
+    GattCreditCallback credit = flow().creditCallback();
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+    EXPECT_FALSE(credit(20, std::chrono::milliseconds(0)));
+
+    // 0x0040만 완료를 보고; 0x0041의 예약은 만료될 때까지 대기
+    completed(0x0040, 2);
+    EXPECT_FALSE(credit(20, std::chrono::milliseconds(0)));
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(1000)));
+
+    AclFlowControl::ConnectionCredits credits;
+    ASSERT_TRUE(flow().getCredits(0x0041, credits));
+    EXPECT_FALSE(credits.receiving);
+    EXPECT_EQ(credits.outstanding, 0u);
+    EXPECT_EQ(credits.expired, 2u);
+
+    // 만료된 연결에는 더 예약하지 않으므로 이후 알림은 0x0040의 크레딧만 기다림
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+    EXPECT_FALSE(credit(20, std::chrono::milliseconds(0)));
+    ASSERT_TRUE(flow().getCredits(0x0041, credits));
+    EXPECT_EQ(credits.queued, 2u);
+    completed(0x0040, 2);
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+
+    // 완료 이벤트가 다시 오면 알림을 받는 연결로 복귀
+    completed(0x0041, 1);
+    ASSERT_TRUE(flow().getCredits(0x0041, credits));
+    EXPECT_TRUE(credits.receiving);
+    EXPECT_TRUE(credit(20, std::chrono::milliseconds(0)));
+    ASSERT_TRUE(flow().getCredits(0x0041, credits));
+    EXPECT_EQ(credits.outstanding, 1u);
+}
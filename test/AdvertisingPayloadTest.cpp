@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../include/AdvertisingPayload.h"
+
+using namespace ggk;
+
+// ✅ 1. 기본 UUID 기반 UUID는 16/32비트로 축약
+TEST(AdvertisingPayloadTest, UuidCollapsing) {
+    uint8_t encoded[16];
+
+    ASSERT_EQ(AdvertisingPayloadBuilder::encodeUuid(GattUuid::fromShortUuid(0x180F), encoded), 2u);
+    EXPECT_EQ(encoded[0], 0x0F);
+    EXPECT_EQ(encoded[1], 0x18);
+
+    ASSERT_EQ(AdvertisingPayloadBuilder::encodeUuid(GattUuid("12345678-0000-1000-8000-00805f9b34fb"), encoded), 4u);
+    EXPECT_EQ(encoded[0], 0x78);
+    EXPECT_EQ(encoded[3], 0x12);
+
+    ASSERT_EQ(AdvertisingPayloadBuilder::encodeUuid(GattUuid("0193d852-eba5-7d28-9abe-e30a67d39d72"), encoded), 16u);
+    EXPECT_EQ(encoded[0], 0x72);
+    EXPECT_EQ(encoded[15], 0x01);
+}
+
+// ✅ 2. 필드 인코딩 (Flags, 16비트 UUID 목록, 제조사 데이터, 이름)
+TEST(AdvertisingPayloadTest, EncodesAdStructures) {
+    AdvertisingPayload payload;
+    ASSERT_TRUE(AdvertisingPayloadBuilder()
+        .setLocalName("Sensor")
+        .addServiceUuid(GattUuid::fromShortUuid(0x180F))
+        .addServiceUuid(GattUuid::fromShortUuid(0x181A))
+        .addManufacturerData(0xFFFF, {0x01, 0x02})
+        .build(payload));
+
+    const std::vector<uint8_t> expected = {
+        0x02, 0x01, 0x06,
+        0x05, 0xFF, 0xFF, 0xFF, 0x01, 0x02,
+        0x05, 0x03, 0x0F, 0x18, 0x1A, 0x18,
+        0x07, 0x09, 'S', 'e', 'n', 's', 'o', 'r'
+    };
+    EXPECT_EQ(payload.toVector(), expected);
+}
+
+// ✅ 3. 공간이 부족하면 UUID 목록은 incomplete, 이름은 shortened
+TEST(AdvertisingPayloadTest, ShortensToFit) {
+    AdvertisingPayload payload;
+    ASSERT_TRUE(AdvertisingPayloadBuilder()
+        .setLocalName("Environmental Sensor 01")
+        .addServiceUuid(GattUuid("0193d852-eba5-7d28-9abe-e30a67d39d72"))
+        .addServiceUuid(GattUuid("0193d852-eba5-7d28-9abe-e30a67d39d73"))
+        .addServiceData(0x181A, {0x10, 0x20, 0x30})
+        .build(payload));
+
+    EXPECT_EQ(payload.size, AdvertisingPayloadBuilder::kLegacyLimit);
+    EXPECT_EQ(payload.data[3 + 7 + 1], AdvertisingPayloadBuilder::AD_INCOMPLETE_UUID128);
+
+    // 이름은 남은 공간만큼 축약됨: 31 - (3 + 7 + 18) - 2 = 1
+    EXPECT_EQ(payload.data[28], 2);
+    EXPECT_EQ(payload.data[29], AdvertisingPayloadBuilder::AD_SHORTENED_NAME);
+    EXPECT_EQ(payload.data[30], 'E');
+}
+
+// ✅ 4. 필수 데이터가 한도를 넘으면 실패, 확장 광고 한도에서는 성공
+TEST(AdvertisingPayloadTest, RequiredDataMustFit) {
+    AdvertisingPayloadBuilder builder;
+    builder.addManufacturerData(0x0059, std::vector<uint8_t>(40, 0xAA));
+
+    AdvertisingPayload payload;
+    EXPECT_FALSE(builder.build(payload));
+    ASSERT_TRUE(builder.build(payload, AdvertisingPayload::kCapacity));
+    EXPECT_EQ(payload.size, 3u + 2u + 2u + 40u);
+}
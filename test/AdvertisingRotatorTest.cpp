@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../include/AdvertisingRotator.h"
+
+using namespace ggk;
+
+namespace {
+
+AdvertisingPayload makePayload(uint8_t reading) {
+    AdvertisingPayload payload;
+    AdvertisingPayloadBuilder().addServiceData(0x181A, {reading}).build(payload);
+    return payload;
+}
+
+} // namespace
+
+// ✅ 1. 레거시 명령은 길이 + 31바이트(0 패딩)
+TEST(AdvertisingRotatorTest, EncodeLegacyCommand) {
+    AdvertisingPayload payload = makePayload(0x42);
+    auto command = AdvertisingRotator::encodeCommand(payload, false, 0);
+
+    ASSERT_EQ(command.size(), 32u);
+    EXPECT_EQ(command[0], payload.size);
+    EXPECT_EQ(command[1 + payload.size - 1], 0x42);
+    EXPECT_EQ(command[31], 0x00);
+}
+
+// ✅ 2. 확장 명령은 단일 complete 조각
+TEST(AdvertisingRotatorTest, EncodeExtendedCommand) {
+    AdvertisingPayload payload = makePayload(0x42);
+    auto command = AdvertisingRotator::encodeCommand(payload, true, 3);
+
+    ASSERT_EQ(command.size(), 4u + payload.size);
+    EXPECT_EQ(command[0], 3);
+    EXPECT_EQ(command[1], 0x03);
+    EXPECT_EQ(command[3], payload.size);
+}
+
+// ✅ 3. 슬롯을 순서대로 회전 (어댑터 미초기화 - 전송 실패로 집계)
+TEST(AdvertisingRotatorTest, RotatesThroughSlots) {
+    HciAdapter adapter;
+    AdvertisingRotator rotator(adapter);
+
+    EXPECT_FALSE(rotator.rotate());
+    ASSERT_EQ(rotator.addPayload(makePayload(1)), 0);
+    ASSERT_EQ(rotator.addPayload(makePayload(2)), 1);
+
+    AdvertisingPayload large;
+    large.size = 40;
+    EXPECT_EQ(rotator.addPayload(large), -1);
+
+    EXPECT_TRUE(rotator.rotate());
+    EXPECT_EQ(rotator.getCurrentIndex(), 0);
+    EXPECT_TRUE(rotator.rotate());
+    EXPECT_EQ(rotator.getCurrentIndex(), 1);
+    EXPECT_TRUE(rotator.rotate());
+    EXPECT_EQ(rotator.getCurrentIndex(), 0);
+
+    EXPECT_EQ(rotator.getRotationCount(), 3u);
+    EXPECT_EQ(rotator.getFailureCount(), 3u);
+    EXPECT_TRUE(rotator.updatePayload(1, makePayload(3)));
+    EXPECT_FALSE(rotator.updatePayload(2, makePayload(3)));
+}
+
+// ✅ 4. 타이머 스레드가 주기적으로 회전
+TEST(AdvertisingRotatorTest, TimerRotates) {
+    HciAdapter adapter;
+    AdvertisingRotator rotator(adapter);
+    rotator.addPayload(makePayload(1));
+    rotator.addPayload(makePayload(2));
+
+    EXPECT_FALSE(rotator.start(std::chrono::milliseconds(5)));
+    ASSERT_TRUE(rotator.start(std::chrono::milliseconds(20)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(110));
+    rotator.stop();
+
+    EXPECT_GE(rotator.getRotationCount(), 3u);
+    EXPECT_FALSE(rotator.isRunning());
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/AsyncLogSink.h"
+
+using namespace ggk;
+
+namespace {
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::string tempLogPath(const char* pName) {
+    std::string path = testing::TempDir() + pName;
+    std::remove(path.c_str());
+    return path;
+}
+
+} // namespace
+
+// ✅ 1. 줄 형식: 시각, 레벨, 스레드 id, 메시지
+TEST(AsyncLogSinkTest, FormatLine) {
+    std::string line = AsyncLogSink::formatLine(1700000000123456ULL, LogLevel::Warn, 42, "hello world", 5);
+
+    EXPECT_NE(line.find(".123456 WARN   [42] hello\n"), std::string::npos) << line;
+    EXPECT_EQ(line.size(), strlen("YYYY-MM-DD HH:MM:SS.uuuuuu WARN   [42] hello\n"));
+}
+
+// ✅ 2. 여러 스레드의 메시지가 모두 파일에 시간순으로 기록됨
+TEST(AsyncLogSinkTest, WritesMessagesFromThreads) {
+    const std::string path = tempLogPath("async_log_threads.log");
+    const int threads = 4;
+    const int perThread = 200;
+
+    {
+        AsyncLogSink sink;
+        ASSERT_TRUE(sink.openFile(path));
+        sink.setOverflowPolicy(AsyncLogSink::OverflowPolicy::Block);
+        ASSERT_TRUE(sink.start());
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&sink, t] {
+                for (int i = 0; i < perThread; ++i) {
+                    sink.submit(LogLevel::Info, ("thread " + std::to_string(t) + " message " + std::to_string(i)).c_str());
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        EXPECT_TRUE(sink.flush());
+        AsyncLogSink::Statistics statistics = sink.getStatistics();
+        EXPECT_EQ(statistics.written, static_cast<uint64_t>(threads * perThread));
+        EXPECT_EQ(statistics.dropped, 0u);
+    }
+
+    std::vector<std::string> lines = readLines(path);
+    ASSERT_EQ(lines.size(), static_cast<size_t>(threads * perThread));
+
+    // 스레드별 순서 유지
+    std::vector<int> next(threads, 0);
+    for (const std::string& line : lines) {
+        int t = 0;
+        int i = 0;
+        ASSERT_EQ(sscanf(line.c_str() + line.find("thread "), "thread %d message %d", &t, &i), 2) << line;
+        EXPECT_EQ(i, next[t]++);
+    }
+}
+
+// ✅ 3. 링이 가득 차면 버리고 개수를 보고, 긴 메시지는 잘림
+TEST(AsyncLogSinkTest, DropsWhenFullAndTruncates) {
+    const std::string path = tempLogPath("async_log_drop.log");
+
+    AsyncLogSink sink;
+    ASSERT_TRUE(sink.openFile(path));
+
+    // 기록 스레드가 시작되기 전이므로 용량을 넘는 메시지는 버려짐
+    const size_t extra = 10;
+    for (size_t i = 0; i < AsyncLogSink::kRingCapacity + extra; ++i) {
+        sink.submit(LogLevel::Debug, "queued");
+    }
+    std::string longMessage(AsyncLogSink::kMaxMessageLength + 50, 'x');
+    sink.submit(LogLevel::Debug, longMessage.c_str());
+
+    AsyncLogSink::Statistics statistics = sink.getStatistics();
+    EXPECT_EQ(statistics.dropped, extra + 1);
+    EXPECT_EQ(statistics.truncated, 1u);
+
+    ASSERT_TRUE(sink.start());
+    EXPECT_TRUE(sink.flush());
+    sink.stop();
+
+    std::vector<std::string> lines = readLines(path);
+    ASSERT_EQ(lines.size(), AsyncLogSink::kRingCapacity + 1);
+    EXPECT_NE(lines.back().find("11 log messages dropped"), std::string::npos) << lines.back();
+}
+
+// ✅ 4. install() 후 Logger 호출이 싱크로 전달됨
+TEST(AsyncLogSinkTest, InstallRoutesLogger) {
+    const std::string path = tempLogPath("async_log_install.log");
+
+    {
+        AsyncLogSink sink;
+        ASSERT_TRUE(sink.openFile(path));
+        ASSERT_TRUE(sink.start());
+        sink.install();
+
+        Logger::info("info message");
+        GGK_LOG_ERROR(Gatt, "error " << 7);
+        EXPECT_TRUE(sink.flush());
+    }
+
+    // 싱크가 사라진 뒤에는 수신자가 해제되어 있어야 함
+    Logger::info("not delivered");
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Info));
+
+    std::vector<std::string> lines = readLines(path);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[0].find("INFO   ["), std::string::npos);
+    EXPECT_NE(lines[0].find("info message"), std::string::npos);
+    EXPECT_NE(lines[1].find("ERROR  ["), std::string::npos);
+    EXPECT_NE(lines[1].find("error 7"), std::string::npos);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../include/BinaryLog.h"
+#include "../include/BinaryLogReader.h"
+
+using namespace ggk;
+
+namespace {
+
+std::vector<std::string> g_messages;
+
+void captureReceiver(const char* pText) {
+    g_messages.push_back(pText);
+}
+
+enum class TestState : uint8_t { Idle = 1, Connected = 7 };
+
+void logGattRead(const std::string& uuid, uint16_t offset, const std::vector<uint8_t>& value) {
+    GGK_BLOG_DEBUG(Gatt, "ReadValue {} offset {} value [{}]", uuid, offset, value);
+}
+
+void logMixed(int32_t delta, bool accepted, double ratio, TestState state, const char* pName) {
+    GGK_BLOG_INFO(Hci, "delta={} accepted={} ratio={} state={} handle={x} name={} {{literal}}", delta, accepted, ratio, state,
+                  static_cast<uint16_t>(0x40), pName);
+}
+
+void logCounter(uint32_t counter) {
+    GGK_BLOG_DEBUG(General, "counter {}", counter);
+}
+
+} // namespace
+
+class BinaryLogTest : public ::testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override {
+        path = testing::TempDir() + "binary_log_test.blog";
+        g_messages.clear();
+        Logger::setLevel(LogLevel::Trace);
+        Logger::registerDebugReceiver(&captureReceiver);
+        Logger::registerInfoReceiver(&captureReceiver);
+    }
+
+    void TearDown() override {
+        BinaryLog::close();
+        Logger::registerDebugReceiver(nullptr);
+        Logger::registerInfoReceiver(nullptr);
+        Logger::setLevel(LogLevel::Trace);
+        std::remove(path.c_str());
+    }
+
+    std::vector<std::string> decode(bool json) {
+        BinaryLogReader reader;
+        std::vector<std::string> lines;
+        if (reader.open(path)) {
+            reader.forEach([&](const BinaryLogReader::Entry& entry) {
+                lines.push_back(json ? BinaryLogReader::toJson(entry) : BinaryLogReader::toText(entry));
+            });
+        }
+        return lines;
+    }
+};
+
+// ✅ 1. 바이너리 로그가 없으면 같은 호출이 텍스트로 수신자에 전달됨
+TEST_F(BinaryLogTest, FallsBackToTextReceivers) {
+    logGattRead("00002a19-0000-1000-8000-00805f9b34fb", 2, {0x64, 0x0A});
+    logMixed(-5, true, 0.5, TestState::Connected, "peer");
+
+    ASSERT_EQ(g_messages.size(), 2u);
+    EXPECT_EQ(g_messages[0], "ReadValue 00002a19-0000-1000-8000-00805f9b34fb offset 2 value [64 0A]");
+    EXPECT_EQ(g_messages[1], "delta=-5 accepted=true ratio=0.5 state=7 handle=0x0040 name=peer {literal}");
+
+    // 모듈 레벨이 막으면 아무것도 기록하지 않음
+    Logger::setLevel(LogModule::Gatt, LogLevel::Info);
+    logGattRead("x", 0, {});
+    EXPECT_EQ(g_messages.size(), 2u);
+}
+
+// ✅ 2. 바이너리 파일에 기록 후 디코더가 같은 텍스트를 복원함
+TEST_F(BinaryLogTest, RecordsAndDecodes) {
+    ASSERT_TRUE(BinaryLog::open(path, 64 * 1024));
+    g_messages.clear();     // open()의 안내 메시지
+
+    logGattRead("00002a19-0000-1000-8000-00805f9b34fb", 2, {0x64, 0x0A});
+    logMixed(-5, true, 0.5, TestState::Connected, "peer");
+    EXPECT_TRUE(g_messages.empty());        // 텍스트로 포맷하지 않음
+    EXPECT_EQ(BinaryLog::getStatistics().records, 2u);
+    BinaryLog::close();
+
+    std::vector<std::string> lines = decode(false);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[0].find("DEBUG  ["), std::string::npos) << lines[0];
+    EXPECT_NE(lines[0].find("] ReadValue 00002a19-0000-1000-8000-00805f9b34fb offset 2 value [64 0A]"), std::string::npos);
+    EXPECT_NE(lines[1].find("] delta=-5 accepted=true ratio=0.5 state=7 handle=0x0040 name=peer {literal}"), std::string::npos);
+}
+
+// ✅ 3. JSON 출력은 레벨, 모듈, 위치와 타입이 유지된 인자를 포함함
+TEST_F(BinaryLogTest, RendersJson) {
+    ASSERT_TRUE(BinaryLog::open(path, 64 * 1024));
+    logMixed(-5, false, 1.25, TestState::Idle, "a \"quoted\" name");
+    BinaryLog::close();
+
+    std::vector<std::string> lines = decode(true);
+    ASSERT_EQ(lines.size(), 1u);
+    const std::string& json = lines[0];
+    EXPECT_NE(json.find("\"level\":\"info\""), std::string::npos) << json;
+    EXPECT_NE(json.find("\"module\":\"hci\""), std::string::npos) << json;
+    EXPECT_NE(json.find("BinaryLogTest.cpp\",\"line\":"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"args\":[-5,false,1.25,1,64,\"a \\\"quoted\\\" name\"]"), std::string::npos) << json;
+}
+
+// ✅ 4. 파일 크기는 고정되고 가장 최근 레코드만 남음
+TEST_F(BinaryLogTest, WrapsAndKeepsNewestRecords) {
+    ASSERT_TRUE(BinaryLog::open(path, 0));      // 최소 크기 (블록 2개)
+
+    const uint32_t total = 2000;
+    for (uint32_t i = 0; i < total; ++i) {
+        logCounter(i);
+    }
+    BinaryLog::Statistics statistics = BinaryLog::getStatistics();
+    EXPECT_EQ(statistics.records, total);
+    EXPECT_GT(statistics.blocks, BinaryLog::kMinBlocks);
+    BinaryLog::close();
+
+    std::vector<std::string> lines = decode(false);
+    ASSERT_FALSE(lines.empty());
+    ASSERT_LT(lines.size(), static_cast<size_t>(total));
+
+    // 남은 레코드는 연속이고 마지막 레코드로 끝남
+    uint32_t expected = total - static_cast<uint32_t>(lines.size());
+    for (const std::string& line : lines) {
+        EXPECT_NE(line.find("counter " + std::to_string(expected++)), std::string::npos) << line;
+    }
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../include/ConnectionParameterController.h"
+
+using namespace ggk;
+
+// 어댑터는 초기화하지 않음 - 명령은 전송 실패(kStatusSendFailed)로 즉시 완료됨
+class ConnectionParameterControllerTest : public ::testing::Test {
+protected:
+    HciAdapter adapter;
+    std::unique_ptr<ConnectionParameterController> controller;
+
+    void SetUp() override {
+        controller = std::make_unique<ConnectionParameterController>(adapter);
+    }
+
+    void connect(uint16_t handle, uint16_t interval) {
+        LinkState state;
+        state.handle = handle;
+        state.interval = interval;
+        adapter.getConnectionTracker().connectionComplete(state);
+    }
+
+    void connectionUpdated(uint16_t handle, uint16_t interval, uint16_t latency) {
+        const uint8_t params[] = {
+            HciEventDecoder::LE_CONNECTION_UPDATE_COMPLETE, 0x00,
+            static_cast<uint8_t>(handle & 0xFF), static_cast<uint8_t>(handle >> 8),
+            static_cast<uint8_t>(interval & 0xFF), static_cast<uint8_t>(interval >> 8),
+            static_cast<uint8_t>(latency & 0xFF), static_cast<uint8_t>(latency >> 8),
+            0x58, 0x02
+        };
+        adapter.getEventDecoder().decode(HciEventDecoder::EVT_LE_META, HciByteView(params, sizeof(params)));
+    }
+};
+
+// ✅ 1. 프로파일 파라미터 유효성 (supervision timeout > (1 + latency) * interval * 2)
+TEST_F(ConnectionParameterControllerTest, ProfileParametersAreValid) {
+    using Profile = ConnectionParameterController::Profile;
+    for (Profile profile : {Profile::LowLatency, Profile::HighThroughput, Profile::LowPower}) {
+        auto parameters = ConnectionParameterController::ProfileParameters::forProfile(profile);
+        EXPECT_GE(parameters.minInterval, 6);
+        EXPECT_LE(parameters.minInterval, parameters.maxInterval);
+        EXPECT_GT(parameters.supervisionTimeout * 10u, (1u + parameters.latency) * parameters.maxInterval * 1.25 * 2)
+            << ConnectionParameterController::profileName(profile);
+    }
+}
+
+// ✅ 2. 수동 프로파일 선택 시 요청 실패가 기록됨
+TEST_F(ConnectionParameterControllerTest, ManualProfileRecordsFailure) {
+    connect(0x0040, 24);
+    controller->setProfile(ConnectionParameterController::Profile::LowLatency);
+
+    EXPECT_FALSE(controller->isAutomatic());
+
+    ConnectionParameterController::Outcome outcome;
+    ASSERT_TRUE(controller->getOutcome(0x0040, outcome));
+    EXPECT_EQ(outcome.profile, ConnectionParameterController::Profile::LowLatency);
+    EXPECT_EQ(outcome.outcome, LinkRequestOutcome::Rejected);
+    EXPECT_EQ(outcome.status, HciCommandQueue::kStatusSendFailed);
+}
+
+// ✅ 3. 알림 적체 시 high-throughput으로 전환하고 측정 결과를 기록
+TEST_F(ConnectionParameterControllerTest, BacklogSwitchesToHighThroughput) {
+    connect(0x0041, 80);
+
+    // 새 연결 직후의 평가는 busy로 처리됨
+    controller->evaluate();
+    EXPECT_NE(controller->getActiveProfile(), ConnectionParameterController::Profile::HighThroughput);
+
+    GattTrafficCallback traffic = controller->trafficCallback();
+    for (int i = 0; i < 64; ++i) {
+        traffic(20);
+    }
+    controller->evaluate();
+
+    EXPECT_GE(controller->getEstimatedQueueDepth(), ConnectionParameterController::kDefaultHighWatermark);
+    EXPECT_EQ(controller->getActiveProfile(), ConnectionParameterController::Profile::HighThroughput);
+
+    ConnectionParameterController::Outcome outcome;
+    ASSERT_TRUE(controller->getOutcome(0x0041, outcome));
+    EXPECT_EQ(outcome.profile, ConnectionParameterController::Profile::HighThroughput);
+
+    // 컨트롤러가 보고한 결과 반영
+    connectionUpdated(0x0041, 18, 0);
+    ASSERT_TRUE(controller->getOutcome(0x0041, outcome));
+    EXPECT_EQ(outcome.interval, 18);
+    EXPECT_EQ(outcome.updateCount, 1u);
+    EXPECT_TRUE(outcome.withinRequest());
+}
+
+// ✅ 4. 유휴 상태가 지속되면 low-power로 복귀
+TEST_F(ConnectionParameterControllerTest, IdleReturnsToLowPower) {
+    controller->setThresholds(4, std::chrono::milliseconds(0));
+    connect(0x0042, 12);
+
+    controller->reportQueueDepth(10);
+    controller->evaluate();
+    EXPECT_EQ(controller->getActiveProfile(), ConnectionParameterController::Profile::HighThroughput);
+
+    controller->reportQueueDepth(0);
+    controller->evaluate();    // 적체가 남아 있어 설정된 연결 간격으로 배출 중
+    for (int i = 0; i < 10 && controller->getEstimatedQueueDepth() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        controller->evaluate();
+    }
+    controller->evaluate();
+
+    EXPECT_EQ(controller->getEstimatedQueueDepth(), 0u);
+    EXPECT_EQ(controller->getActiveProfile(), ConnectionParameterController::Profile::LowPower);
+}
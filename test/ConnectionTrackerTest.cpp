@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../include/ConnectionTracker.h"
+
+using namespace ggk;
+
+class ConnectionTrackerTest : public ::testing::Test {
+protected:
+    HciEventDecoder decoder;
+    ConnectionTracker tracker;
+
+    void SetUp() override {
+        tracker.attach(decoder);
+    }
+
+    // LE Connection Complete 이벤트 전달 (주소 11:22:33:44:55:66)
+    void connect(uint16_t handle) {
+        const uint8_t params[] = {
+            HciEventDecoder::LE_CONNECTION_COMPLETE, 0x00,
+            static_cast<uint8_t>(handle & 0xFF), static_cast<uint8_t>(handle >> 8),
+            0x01, 0x00, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11,
+            0x18, 0x00, 0x00, 0x00, 0x48, 0x00, 0x01
+        };
+        decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(params, sizeof(params)));
+    }
+};
+
+// ✅ 1. 연결/해제 이벤트로 테이블 갱신
+TEST_F(ConnectionTrackerTest, ConnectAndDisconnect) {
+    EXPECT_FALSE(tracker.isConnected());
+
+    connect(0x0040);
+    ASSERT_EQ(tracker.connectionCount(), 1u);
+
+    LinkState state;
+    ASSERT_TRUE(tracker.getByHandle(0x0040, state));
+    EXPECT_EQ(state.interval, 0x0018);
+    EXPECT_EQ(state.mtu, LinkState::kDefaultMtu);
+    EXPECT_EQ(state.addressString(), "11:22:33:44:55:66");
+
+    ASSERT_TRUE(tracker.getByAddress("11:22:33:44:55:66", state));
+    EXPECT_EQ(state.handle, 0x0040);
+
+    const uint8_t disconnect[] = {0x00, 0x40, 0x00, 0x13};
+    decoder.decode(HciEventDecoder::EVT_DISCONNECTION_COMPLETE, HciByteView(disconnect, sizeof(disconnect)));
+
+    EXPECT_FALSE(tracker.isConnected());
+    EXPECT_FALSE(tracker.getByHandle(0x0040, state));
+}
+
+// ✅ 2. 데이터 길이/PHY/MTU 갱신 및 리스너 호출
+TEST_F(ConnectionTrackerTest, LinkUpdates) {
+    std::vector<ConnectionTracker::LinkEvent> events;
+    tracker.addListener([&](ConnectionTracker::LinkEvent event, const LinkState&) {
+        events.push_back(event);
+    });
+
+    connect(0x0001);
+
+    const uint8_t dataLength[] = {HciEventDecoder::LE_DATA_LENGTH_CHANGE, 0x01, 0x00, 0xFB, 0x00, 0x48, 0x08, 0xFB, 0x00, 0x48, 0x08};
+    decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(dataLength, sizeof(dataLength)));
+
+    const uint8_t phy[] = {HciEventDecoder::LE_PHY_UPDATE_COMPLETE, 0x00, 0x01, 0x00, 0x02, 0x02};
+    decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(phy, sizeof(phy)));
+
+    EXPECT_TRUE(tracker.updateMtu("11:22:33:44:55:66", 247));
+    EXPECT_FALSE(tracker.updateMtu(0x0002, 247)) << "없는 연결의 MTU가 갱신되었습니다.";
+
+    // BlueZ 장치 경로로 찾음; 같은 MTU는 다시 알리지 않음 (ReadValue/WriteValue마다 보고됨)
+    uint8_t address[6];
+    ASSERT_TRUE(ConnectionTracker::parseDevicePath("/org/bluez/hci0/dev_11_22_33_44_55_66", address));
+    EXPECT_TRUE(tracker.updateMtu(address, 247));
+    EXPECT_FALSE(ConnectionTracker::parseDevicePath("/org/bluez/hci0", address));
+    EXPECT_FALSE(ConnectionTracker::parseDevicePath("/org/bluez/hci0/dev_11_22_33_44_55_66/service0001", address));
+
+    LinkState state;
+    ASSERT_TRUE(tracker.getByHandle(0x0001, state));
+    EXPECT_EQ(state.maxTxOctets, 251);
+    EXPECT_EQ(state.txPhy, 0x02);
+    EXPECT_EQ(state.maxNotificationPayload(), 244);
+
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[0], ConnectionTracker::LinkEvent::Connected);
+    EXPECT_EQ(events[3], ConnectionTracker::LinkEvent::MtuChanged);
+}
+
+// ✅ 3. 쓰기 중에도 읽기는 항상 일관된 스냅샷을 반환
+TEST_F(ConnectionTrackerTest, ConsistentSnapshotsUnderConcurrentWrites) {
+    connect(0x0010);
+
+    // 연결 이벤트의 interval(0x18)과 latency(0)는 다르므로 먼저 맞춰 둠
+    tracker.modify(0x0010, ConnectionTracker::LinkEvent::ParametersUpdated, [](LinkState& state) {
+        state.latency = state.interval;
+    });
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint16_t i = 0; i < 20000; ++i) {
+            // interval과 latency를 항상 같은 값으로 갱신
+            tracker.modify(0x0010, ConnectionTracker::LinkEvent::ParametersUpdated, [i](LinkState& state) {
+                state.interval = i;
+                state.latency = i;
+            });
+        }
+        done = true;
+    });
+
+    size_t torn = 0;
+    LinkState state;
+    while (!done) {
+        if (tracker.getByHandle(0x0010, state) && state.interval != state.latency) {
+            ++torn;
+        }
+    }
+    writer.join();
+
+    EXPECT_EQ(torn, 0u);
+}
+
+// ✅ 4. 호스트가 요청한 PHY 변경 결과 기록 (요청 상태 기록은 알리지 않고, 컨트롤러 이벤트만 알림)
+TEST_F(ConnectionTrackerTest, PhyRequestOutcome) {
+    std::vector<ConnectionTracker::LinkEvent> events;
+    tracker.addListener([&](ConnectionTracker::LinkEvent event, const LinkState&) { events.push_back(event); });
+    connect(0x0002);
+
+    ASSERT_TRUE(tracker.update(0x0002, [](LinkState& state) {
+        state.phyOutcome = LinkRequestOutcome::Pending;
+    }));
+    ASSERT_EQ(events.size(), 1u);
+
+    // Unsupported Remote Feature (0x1A)로 실패
+    const uint8_t failed[] = {HciEventDecoder::LE_PHY_UPDATE_COMPLETE, 0x1A, 0x02, 0x00, 0x01, 0x01};
+    decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(failed, sizeof(failed)));
+
+    LinkState state;
+    ASSERT_TRUE(tracker.getByHandle(0x0002, state));
+    EXPECT_EQ(state.phyOutcome, LinkRequestOutcome::Rejected);
+    EXPECT_EQ(state.phyStatus, 0x1A);
+    EXPECT_EQ(state.txPhy, LinkState::kPhy1M);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[1], ConnectionTracker::LinkEvent::PhyUpdated);
+}
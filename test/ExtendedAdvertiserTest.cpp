@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "../include/ExtendedAdvertiser.h"
+
+using namespace ggk;
+
+// ✅ 1. 251바이트 이하 데이터는 단일 complete 조각
+TEST(ExtendedAdvertiserTest, SingleFragment) {
+    std::vector<uint8_t> data(31, 0xAB);
+    auto commands = ExtendedAdvertiser::fragmentData(ExtendedAdvertiser::CMD_LE_SET_EXT_ADV_DATA, 2, data.data(), data.size());
+
+    ASSERT_EQ(commands.size(), 1u);
+    EXPECT_EQ(commands[0].opcode, ExtendedAdvertiser::CMD_LE_SET_EXT_ADV_DATA);
+    EXPECT_EQ(commands[0].parameters[0], 2);
+    EXPECT_EQ(commands[0].parameters[1], ExtendedAdvertiser::kOperationComplete);
+    EXPECT_EQ(commands[0].parameters[3], 31);
+    EXPECT_EQ(commands[0].parameters.size(), 4u + 31u);
+}
+
+// ✅ 2. 최대 1650바이트 데이터를 first/intermediate/last 조각으로 분할
+TEST(ExtendedAdvertiserTest, MaximumDataIsFragmented) {
+    std::vector<uint8_t> data(ExtendedAdvertiser::kMaxDataLength);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    auto commands = ExtendedAdvertiser::fragmentData(ExtendedAdvertiser::CMD_LE_SET_EXT_ADV_DATA, 0, data.data(), data.size());
+    ASSERT_EQ(commands.size(), 7u);    // 6 * 251 + 144
+
+    EXPECT_EQ(commands.front().parameters[1], ExtendedAdvertiser::kOperationFirst);
+    EXPECT_EQ(commands[3].parameters[1], ExtendedAdvertiser::kOperationIntermediate);
+    EXPECT_EQ(commands.back().parameters[1], ExtendedAdvertiser::kOperationLast);
+
+    // 조각을 이어 붙이면 원래 데이터와 같아야 함
+    std::vector<uint8_t> reassembled;
+    for (const auto& command : commands) {
+        EXPECT_LE(command.parameters[3], ExtendedAdvertiser::kMaxFragmentLength);
+        EXPECT_EQ(command.parameters.size(), 4u + command.parameters[3]);
+        reassembled.insert(reassembled.end(), command.parameters.begin() + 4, command.parameters.end());
+    }
+    EXPECT_EQ(reassembled, data);
+}
+
+// ✅ 3. 빈 데이터는 payload 삭제용 complete 조각 하나
+TEST(ExtendedAdvertiserTest, EmptyData) {
+    auto commands = ExtendedAdvertiser::fragmentData(ExtendedAdvertiser::CMD_LE_SET_EXT_SCAN_RESPONSE_DATA, 1, nullptr, 0);
+
+    ASSERT_EQ(commands.size(), 1u);
+    EXPECT_EQ(commands[0].parameters[1], ExtendedAdvertiser::kOperationComplete);
+    EXPECT_EQ(commands[0].parameters[3], 0);
+}
+
+// ✅ 4. 파라미터 인코딩 (24비트 간격, Secondary PHY)
+TEST(ExtendedAdvertiserTest, EncodeParameters) {
+    AdvertisingSetParameters parameters;
+    parameters.setIntervalMs(1000, 1200);
+    parameters.primaryPhy = AdvertisingSetParameters::kPhyCoded;
+    parameters.secondaryPhy = AdvertisingSetParameters::kPhy2M;
+    parameters.sid = 5;
+
+    auto encoded = ExtendedAdvertiser::encodeParameters(3, parameters);
+    ASSERT_EQ(encoded.size(), 25u);
+    EXPECT_EQ(encoded[0], 3);
+    EXPECT_EQ(encoded[3] | (encoded[4] << 8) | (encoded[5] << 16), 1600);     // 1000 ms / 0.625 ms
+    EXPECT_EQ(encoded[6] | (encoded[7] << 8) | (encoded[8] << 16), 1920);
+    EXPECT_EQ(encoded[20], AdvertisingSetParameters::kPhyCoded);
+    EXPECT_EQ(encoded[22], AdvertisingSetParameters::kPhy2M);
+    EXPECT_EQ(encoded[23], 5);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/FlightRecorder.h"
+
+using namespace ggk;
+
+// 탭만으로 기록 여부가 바뀌는지 보려고 테스트 main()이 등록한 debug/warn 수신자는 빼 두었다가 되돌림
+class FlightRecorderTest : public ::testing::Test {
+protected:
+    std::string path;
+    Logger::LogReceiver previousDebug;
+    Logger::LogReceiver previousWarn;
+
+    void SetUp() override {
+        path = testing::TempDir() + "flight_recorder_test.txt";
+        Logger::setLevel(LogLevel::Trace);
+
+        previousDebug = Logger::getReceiver(LogLevel::Debug);
+        previousWarn = Logger::getReceiver(LogLevel::Warn);
+        Logger::registerDebugReceiver(nullptr);
+        Logger::registerWarnReceiver(nullptr);
+    }
+
+    void TearDown() override {
+        FlightRecorder::uninstall();
+        std::remove(path.c_str());
+
+        Logger::registerDebugReceiver(previousDebug);
+        Logger::registerWarnReceiver(previousWarn);
+    }
+
+    std::string readDump() {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+};
+
+// ✅ 1. 링이 가득 차면 가장 오래된 이벤트를 덮어쓰고 순서가 유지됨
+TEST_F(FlightRecorderTest, KeepsNewestEventsInOrder) {
+    const uint32_t total = FlightRecorder::kCapacity + 10;
+    for (uint32_t i = 0; i < total; ++i) {
+        FlightRecorder::record(FlightRecorder::Category::HciCommand, 0x0C03, i, "event " + std::to_string(i));
+    }
+
+    std::vector<FlightRecorder::Record> records = FlightRecorder::snapshot();
+    ASSERT_EQ(records.size(), FlightRecorder::kCapacity);
+    EXPECT_EQ(records.back().sequence, FlightRecorder::getRecordedCount());
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        uint32_t expected = total - FlightRecorder::kCapacity + static_cast<uint32_t>(i);
+        EXPECT_EQ(records[i].value, expected);
+        EXPECT_EQ(records[i].text, "event " + std::to_string(expected));
+        if (i > 0) {
+            EXPECT_EQ(records[i].sequence, records[i - 1].sequence + 1);
+        }
+    }
+
+    // 긴 텍스트는 잘림
+    FlightRecorder::record(FlightRecorder::Category::DBus, 0, 0, std::string(300, 'x'));
+    EXPECT_EQ(FlightRecorder::snapshot().back().text.size(), FlightRecorder::kTextLength);
+}
+
+// ✅ 2. 여러 스레드가 동시에 기록해도 이벤트가 손실되거나 섞이지 않음
+TEST_F(FlightRecorderTest, RecordsFromManyThreads) {
+    const int threadCount = 4;
+    const uint32_t perThread = 1000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([t, perThread]() {
+            std::string name = "thread " + std::to_string(t);
+            for (uint32_t i = 0; i < perThread; ++i) {
+                FlightRecorder::record(FlightRecorder::Category::State, static_cast<uint16_t>(100 + t), i, name);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<uint32_t> counts(threadCount, 0);
+    for (const FlightRecorder::Record& record : FlightRecorder::snapshot()) {
+        if (record.category != FlightRecorder::Category::State || record.code < 100 || record.code >= 100 + threadCount) {
+            continue;
+        }
+        int t = record.code - 100;
+        EXPECT_EQ(record.text, "thread " + std::to_string(t));
+        EXPECT_EQ(record.value, counts[t]++);       // 스레드별 순서 유지
+    }
+    for (int t = 0; t < threadCount; ++t) {
+        EXPECT_EQ(counts[t], perThread);
+    }
+}
+
+// ✅ 3. 덤프 파일은 카테고리별로 해석된 한 줄씩을 포함함
+TEST_F(FlightRecorderTest, DumpsReadableLines) {
+    FlightRecorder::record(FlightRecorder::Category::HciCommand, 0x200A, 1);
+    FlightRecorder::record(FlightRecorder::Category::HciEvent, 0x0E, (0x200A << 8) | 0x0C);
+    FlightRecorder::record(FlightRecorder::Category::HciEvent, 0x3E01, 19);
+    FlightRecorder::record(FlightRecorder::Category::HciEventCount, 0x3E02, 512);
+    FlightRecorder::record(FlightRecorder::Category::Gatt, static_cast<uint16_t>(FlightRecorder::GattOperation::Write), 2,
+                           {"00002a19-0000-1000-8000-00805f9b34fb", " accepted"});
+    FlightRecorder::record(FlightRecorder::Category::State, static_cast<uint16_t>(FlightRecorder::StateEvent::Connected), 64,
+                           "AA:BB:CC:DD:EE:FF");
+
+    ASSERT_TRUE(FlightRecorder::dump(path.c_str()));
+    std::string dump = readDump();
+
+    EXPECT_EQ(dump.find("# flight recorder: pid "), 0u);
+    EXPECT_NE(dump.find("] HCI_CMD opcode=0x200A length=1\n"), std::string::npos) << dump.substr(dump.size() - 600);
+    EXPECT_NE(dump.find("] HCI_EVT event=0x0E opcode=0x200A status=0x0C\n"), std::string::npos);
+    EXPECT_NE(dump.find("] HCI_EVT event=0x3E01 length=19\n"), std::string::npos);
+    EXPECT_NE(dump.find("] HCI_CNT event=0x3E02 count=512\n"), std::string::npos);
+    EXPECT_NE(dump.find("] GATT    Write length=2 00002a19-0000-1000-8000-00805f9b34fb accepted\n"), std::string::npos);
+    EXPECT_NE(dump.find("] STATE   Connected value=64 AA:BB:CC:DD:EE:FF\n"), std::string::npos);
+
+    // snapshot()의 텍스트 표현과 덤프 줄이 같음
+    EXPECT_NE(dump.find(FlightRecorder::toText(FlightRecorder::snapshot().back()) + "\n"), std::string::npos);
+}
+
+// ✅ 4. 설치하면 Logger 메시지를 수신자 없이도 기록하고 SIGUSR1로 덤프함
+TEST_F(FlightRecorderTest, TapsLoggerAndDumpsOnSignal) {
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Warn));
+
+    ASSERT_TRUE(FlightRecorder::install(path, LogLevel::Warn));
+    EXPECT_TRUE(Logger::isEnabled(LogLevel::Warn));
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Debug));
+
+    Logger::debug("not recorded");
+    Logger::warn(std::string("battery low"));
+    FlightRecorder::Record last = FlightRecorder::snapshot().back();
+    EXPECT_EQ(last.category, FlightRecorder::Category::Log);
+    EXPECT_EQ(last.code, static_cast<uint16_t>(LogLevel::Warn));
+    EXPECT_EQ(last.text, "battery low");
+
+    raise(SIGUSR1);
+    EXPECT_NE(readDump().find("] LOG     warn battery low\n"), std::string::npos);
+
+    FlightRecorder::uninstall();
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Warn));
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "../include/GVariantCodec.h"
+
+using namespace ggk;
+
+namespace {
+
+constexpr bool sameSignature(const char* pLhs, const char* pRhs) {
+    while (*pLhs != '\0' && *pLhs == *pRhs) {
+        ++pLhs;
+        ++pRhs;
+    }
+    return *pLhs == *pRhs;
+}
+
+struct Peer {
+    std::string address;
+    uint16_t mtu = 0;
+    std::vector<uint8_t> value;
+
+    auto gvariantFields() { return std::tie(address, mtu, value); }
+    auto gvariantFields() const { return std::tie(address, mtu, value); }
+};
+
+// 부동 참조를 소유하는 GVariantPtr로 변환
+template <typename T>
+GVariantPtr sink(const T& value) {
+    return makeGVariantPtr(g_variant_ref_sink(toGVariant(value)));
+}
+
+} // namespace
+
+// 시그니처는 컴파일 시간에 결정됨
+static_assert(sameSignature(gvariantSignature<uint16_t>(), "q"), "");
+static_assert(sameSignature(gvariantSignature<std::vector<std::string>>(), "as"), "");
+static_assert(sameSignature(gvariantSignature<std::map<std::string, GVariantPtr>>(), "a{sv}"), "");
+static_assert(sameSignature(gvariantSignature<std::tuple<DBusObjectPath, std::vector<uint8_t>>>(), "(oay)"), "");
+static_assert(sameSignature(gvariantSignature<std::vector<Peer>>(), "a(sqay)"), "");
+static_assert(sameSignature(gvariantSignature<GVariantBytes>(), "ay"), "");
+
+// ✅ 1. 스칼라와 문자열 왕복 변환, 타입이 다르면 실패
+TEST(GVariantCodecTest, ScalarsRoundTrip) {
+    GVariantPtr level = sink(static_cast<uint8_t>(100));
+    EXPECT_STREQ(g_variant_get_type_string(level.get()), "y");
+    uint8_t byte = 0;
+    EXPECT_TRUE(fromGVariant(level.get(), byte));
+    EXPECT_EQ(byte, 100);
+
+    GVariantPtr offset = sink(static_cast<int64_t>(-5));
+    int64_t signedValue = 0;
+    EXPECT_TRUE(fromGVariant(offset.get(), signedValue));
+    EXPECT_EQ(signedValue, -5);
+
+    GVariantPtr name = sink(std::string("Jetson BLE Device"));
+    std::string text;
+    EXPECT_TRUE(fromGVariant(name.get(), text));
+    EXPECT_EQ(text, "Jetson BLE Device");
+
+    GVariantPtr path = sink(DBusObjectPath("/com/example/bleserver"));
+    EXPECT_STREQ(g_variant_get_type_string(path.get()), "o");
+    DBusObjectPath objectPath;
+    EXPECT_TRUE(fromGVariant(path.get(), objectPath));
+    EXPECT_EQ(objectPath.toString(), "/com/example/bleserver");
+
+    // 타입 불일치와 null
+    uint16_t mismatched = 0;
+    EXPECT_FALSE(fromGVariant(level.get(), mismatched));
+    EXPECT_FALSE(fromGVariant(nullptr, text));
+}
+
+// ✅ 2. 고정 폭 배열은 한 번에 변환되고 GVariantSpan은 복사 없이 읽음
+TEST(GVariantCodecTest, FixedArrays) {
+    std::vector<uint8_t> bytes = {0x01, 0x02, 0x03, 0xFF};
+    GVariantPtr variant = sink(bytes);
+    EXPECT_STREQ(g_variant_get_type_string(variant.get()), "ay");
+
+    GVariantBytes view;
+    ASSERT_TRUE(fromGVariant(variant.get(), view));
+    ASSERT_EQ(view.size, bytes.size());
+    EXPECT_EQ(view.data, g_variant_get_data(variant.get()));      // GVariant 내부를 가리킴
+    EXPECT_EQ(memcmp(view.data, bytes.data(), bytes.size()), 0);
+
+    std::vector<uint8_t> copy;
+    ASSERT_TRUE(fromGVariant(variant.get(), copy));
+    EXPECT_EQ(copy, bytes);
+
+    std::vector<uint16_t> handles = {0x0040, 0x0041, 0xFFFF};
+    GVariantPtr handleArray = sink(GVariantSpan<uint16_t>(handles));
+    EXPECT_STREQ(g_variant_get_type_string(handleArray.get()), "aq");
+    std::vector<uint16_t> decoded;
+    ASSERT_TRUE(fromGVariant(handleArray.get(), decoded));
+    EXPECT_EQ(decoded, handles);
+
+    // 빈 배열
+    GVariantPtr empty = sink(std::vector<uint8_t>());
+    ASSERT_TRUE(fromGVariant(empty.get(), copy));
+    EXPECT_TRUE(copy.empty());
+}
+
+// ✅ 3. 문자열 배열과 a{sv} 딕셔너리
+TEST(GVariantCodecTest, ArraysAndDictionaries) {
+    std::vector<std::string> flags = {"read", "write-without-response", "notify"};
+    GVariantPtr flagArray = sink(flags);
+    EXPECT_STREQ(g_variant_get_type_string(flagArray.get()), "as");
+    std::vector<std::string> decodedFlags;
+    ASSERT_TRUE(fromGVariant(flagArray.get(), decodedFlags));
+    EXPECT_EQ(decodedFlags, flags);
+
+    std::map<std::string, GVariantPtr> properties;
+    properties.emplace("MTU", sink(static_cast<uint16_t>(247)));
+    properties.emplace("Name", sink(std::string("peer")));
+    GVariantPtr dictionary = sink(properties);
+    EXPECT_STREQ(g_variant_get_type_string(dictionary.get()), "a{sv}");
+
+    std::map<std::string, GVariantPtr> decoded;
+    ASSERT_TRUE(fromGVariant(dictionary.get(), decoded));
+    ASSERT_EQ(decoded.size(), 2u);
+    uint16_t mtu = 0;
+    EXPECT_TRUE(fromGVariant(decoded.at("MTU").get(), mtu));
+    EXPECT_EQ(mtu, 247);
+
+    std::unordered_map<uint16_t, std::string> names = {{1, "one"}, {2, "two"}};
+    GVariantPtr nameMap = sink(names);
+    EXPECT_STREQ(g_variant_get_type_string(nameMap.get()), "a{qs}");
+    std::unordered_map<uint16_t, std::string> decodedNames;
+    ASSERT_TRUE(fromGVariant(nameMap.get(), decodedNames));
+    EXPECT_EQ(decodedNames, names);
+}
+
+// ✅ 4. 튜플과 사용자 구조체
+TEST(GVariantCodecTest, TuplesAndStructs) {
+    std::tuple<DBusObjectPath, uint32_t> reply(DBusObjectPath("/org/bluez/hci0"), 7u);
+    GVariantPtr tuple = sink(reply);
+    EXPECT_STREQ(g_variant_get_type_string(tuple.get()), "(ou)");
+    std::tuple<DBusObjectPath, uint32_t> decodedReply;
+    ASSERT_TRUE(fromGVariant(tuple.get(), decodedReply));
+    EXPECT_EQ(std::get<0>(decodedReply).toString(), "/org/bluez/hci0");
+    EXPECT_EQ(std::get<1>(decodedReply), 7u);
+
+    std::vector<Peer> peers = {{"AA:BB:CC:DD:EE:FF", 247, {0x01}}, {"11:22:33:44:55:66", 23, {}}};
+    GVariantPtr peerArray = sink(peers);
+    EXPECT_STREQ(g_variant_get_type_string(peerArray.get()), "a(sqay)");
+
+    std::vector<Peer> decodedPeers;
+    ASSERT_TRUE(fromGVariant(peerArray.get(), decodedPeers));
+    ASSERT_EQ(decodedPeers.size(), 2u);
+    EXPECT_EQ(decodedPeers[0].address, "AA:BB:CC:DD:EE:FF");
+    EXPECT_EQ(decodedPeers[0].mtu, 247);
+    EXPECT_EQ(decodedPeers[0].value, std::vector<uint8_t>({0x01}));
+    EXPECT_EQ(decodedPeers[1].mtu, 23);
+    EXPECT_TRUE(decodedPeers[1].value.empty());
+}
@@ -6,6 +6,7 @@
 #include "GattTypes.h"
 #include "Logger.h"
 #include "DBusConnection.h"
+#include "ConnectionTracker.h"
 
 using namespace ggk;
 
@@ -165,3 +166,24 @@ TEST_F(GattCharacteristicGvariantTest, SetupDBusInterfaces) {
     EXPECT_TRUE(result);
     EXPECT_TRUE(characteristic->isRegistered());
 }
+
+// reportMtu 테스트: 연결 테이블이 설정되면 요청 옵션의 MTU를 그 장치의 연결에 반영
+TEST_F(GattCharacteristicGvariantTest, ReportsMtuToConnectionTracker) {
+    ConnectionTracker tracker;
+    LinkState link;
+    link.handle = 0x0040;
+    ASSERT_TRUE(ConnectionTracker::parseAddress("11:22:33:44:55:66", link.address));
+    tracker.connectionComplete(link);
+
+    // 연결 테이블이 없으면 무시
+    characteristic->reportMtu("/org/bluez/hci0/dev_11_22_33_44_55_66", 185);
+    ASSERT_TRUE(tracker.getByHandle(0x0040, link));
+    EXPECT_EQ(link.mtu, LinkState::kDefaultMtu);
+
+    characteristic->setConnectionTracker(&tracker);
+    EXPECT_EQ(characteristic->getConnectionTracker(), &tracker);
+    characteristic->reportMtu("/org/bluez/hci0/dev_11_22_33_44_55_66", 185);
+    characteristic->reportMtu("", 247);
+    ASSERT_TRUE(tracker.getByHandle(0x0040, link));
+    EXPECT_EQ(link.mtu, 185);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "../include/GattWriteRequest.h"
+
+using namespace ggk;
+
+namespace {
+
+// BlueZ가 보내는 WriteValue 파라미터 "(aya{sv})" 생성
+GVariantPtr makeParameters(const std::vector<uint8_t>& value, GVariant* pOptions = nullptr) {
+    GVariant* pBytes = g_variant_new_fixed_array(G_VARIANT_TYPE("y"), value.data(), value.size(), sizeof(uint8_t));
+    if (pOptions == nullptr) {
+        pOptions = g_variant_new_array(G_VARIANT_TYPE("{sv}"), nullptr, 0);
+    }
+    return makeGVariantPtr(g_variant_ref_sink(g_variant_new("(@ay@a{sv})", pBytes, pOptions)));
+}
+
+} // namespace
+
+// ✅ 1. 값은 파라미터 데이터를 직접 가리키고 NUL 바이트에서 잘리지 않음
+TEST(GattWriteRequestTest, ValueIsViewIncludingNulBytes) {
+    std::vector<uint8_t> value = {0x01, 0x00, 0x02, 0x00};
+    GVariantPtr parameters = makeParameters(value);
+
+    GattWriteRequest request;
+    ASSERT_TRUE(GattWriteRequest::parse(parameters.get(), request));
+    ASSERT_EQ(request.size, value.size());
+    EXPECT_EQ(memcmp(request.pData, value.data(), value.size()), 0);
+
+    GVariantPtr bytes = makeGVariantPtr(g_variant_get_child_value(parameters.get(), 0));
+    EXPECT_EQ(request.pData, g_variant_get_data(bytes.get()));
+    EXPECT_FALSE(request.store);
+}
+
+// ✅ 2. 옵션 딕셔너리 (device, type, offset, mtu, prepare-authorize) 파싱
+TEST(GattWriteRequestTest, ParsesOptions) {
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+    g_variant_builder_add(&builder, "{sv}", "device", g_variant_new_object_path("/org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF"));
+    g_variant_builder_add(&builder, "{sv}", "type", g_variant_new_string("command"));
+    g_variant_builder_add(&builder, "{sv}", "offset", g_variant_new_uint16(3));
+    g_variant_builder_add(&builder, "{sv}", "mtu", g_variant_new_uint16(247));
+    g_variant_builder_add(&builder, "{sv}", "prepare-authorize", g_variant_new_boolean(TRUE));
+    g_variant_builder_add(&builder, "{sv}", "unknown", g_variant_new_int32(1));
+    GVariantPtr parameters = makeParameters({0x10}, g_variant_builder_end(&builder));
+
+    GattWriteRequest request;
+    ASSERT_TRUE(GattWriteRequest::parse(parameters.get(), request));
+    EXPECT_STREQ(request.device(), "/org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF");
+    EXPECT_STREQ(request.type(), "command");
+    EXPECT_TRUE(request.isCommand());
+    EXPECT_EQ(request.offset(), 3);
+    EXPECT_EQ(request.mtu(), 247);
+    EXPECT_TRUE(request.isPreparedWrite());
+}
+
+// ✅ 3. 다른 시그니처 거부 (바이트 배열만 보낸 경우 포함)
+TEST(GattWriteRequestTest, RejectsWrongSignature) {
+    GattWriteRequest request;
+    EXPECT_FALSE(GattWriteRequest::parse(nullptr, request));
+
+    std::vector<uint8_t> value = {0x01, 0x02};
+    GVariantPtr bytes = makeGVariantPtr(g_variant_ref_sink(
+        g_variant_new_fixed_array(G_VARIANT_TYPE("y"), value.data(), value.size(), sizeof(uint8_t))));
+    EXPECT_FALSE(GattWriteRequest::parse(bytes.get(), request));
+
+    // 옵션 없음: 기본값
+    GVariantPtr parameters = makeParameters(value);
+    ASSERT_TRUE(GattWriteRequest::parse(parameters.get(), request));
+    EXPECT_STREQ(request.device(), "");
+    EXPECT_FALSE(request.isCommand());
+    EXPECT_EQ(request.offset(), 0);
+    EXPECT_EQ(request.mtu(), 0);
+}
+
+// ✅ 4. hold()로 참조를 유지하면 원래 참조를 해제해도 뷰가 유효
+TEST(GattWriteRequestTest, HoldKeepsValueAlive) {
+    std::vector<uint8_t> value(244);
+    for (size_t i = 0; i < value.size(); ++i) {
+        value[i] = static_cast<uint8_t>(i);
+    }
+    GVariantPtr parameters = makeParameters(value);
+
+    GattWriteRequest request;
+    ASSERT_TRUE(GattWriteRequest::parse(parameters.get(), request));
+    GVariantPtr held = request.hold();
+    ASSERT_EQ(held.get(), parameters.get());
+
+    parameters.reset();
+    ASSERT_EQ(request.size, value.size());
+    EXPECT_EQ(memcmp(request.pData, value.data(), value.size()), 0);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/HciCapture.h"
+#include "../include/HciSocket.h"
+
+using namespace ggk;
+
+namespace {
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+uint32_t be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+} // namespace
+
+// ✅ 1. 파일 헤더 (btsnoop / pcap)
+TEST(HciCaptureTest, FileHeaders) {
+    uint8_t header[24];
+
+    ASSERT_EQ(HciCapture::encodeFileHeader(HciCapture::Format::Btsnoop, header), 16u);
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(header), 7), "btsnoop");
+    EXPECT_EQ(be32(header + 8), 1u);
+    EXPECT_EQ(be32(header + 12), HciCapture::kBtsnoopDatalinkH4);
+
+    ASSERT_EQ(HciCapture::encodeFileHeader(HciCapture::Format::Pcap, header), 24u);
+    EXPECT_EQ(header[0], 0xd4);
+    EXPECT_EQ(header[3], 0xa1);
+    EXPECT_EQ(header[20], HciCapture::kPcapLinktypeH4WithPhdr);
+}
+
+// ✅ 2. 소켓 읽기/쓰기가 btsnoop 레코드로 기록됨 (방향, 명령/이벤트 플래그)
+TEST(HciCaptureTest, CapturesSocketTraffic) {
+    const std::string path = testing::TempDir() + "hci_capture_test.btsnoop";
+    HciCapture capture(path, HciCapture::Format::Btsnoop);
+    ASSERT_TRUE(capture.start());
+
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    HciSocket socket;
+    ASSERT_TRUE(socket.adopt(fds[0]));
+    socket.setCapture(&capture);
+
+    const uint8_t parameters[] = {0x01};
+    ASSERT_TRUE(socket.writeCommand(0x200A, parameters, sizeof(parameters)));
+
+    const uint8_t event[] = {0x04, 0x0E, 0x04, 0x01, 0x0A, 0x20, 0x00};
+    ASSERT_EQ(::write(fds[1], event, sizeof(event)), static_cast<ssize_t>(sizeof(event)));
+    std::vector<HciPacket> packets;
+    ASSERT_EQ(socket.readBatch(packets, 1, 1000), 1u);
+
+    socket.setCapture(nullptr);
+    capture.stop();
+    close(fds[1]);
+
+    EXPECT_EQ(capture.getCapturedCount(), 2u);
+    EXPECT_EQ(capture.getDroppedCount(), 0u);
+
+    std::vector<uint8_t> file = readFile(path);
+    ASSERT_EQ(file.size(), 16u + 24u + 5u + 24u + sizeof(event));
+
+    const uint8_t* pCommand = file.data() + 16;
+    EXPECT_EQ(be32(pCommand), 5u);
+    EXPECT_EQ(be32(pCommand + 8), 0x02u);        // 전송, 명령
+    EXPECT_EQ(pCommand[24], 0x01);
+
+    const uint8_t* pEvent = pCommand + 24 + 5;
+    EXPECT_EQ(be32(pEvent + 4), sizeof(event));
+    EXPECT_EQ(be32(pEvent + 8), 0x03u);          // 수신, 이벤트
+    EXPECT_EQ(pEvent[24], 0x04);
+}
+
+// ✅ 3. 크기 한도에서 파일 회전 (path, path.1, ...)
+TEST(HciCaptureTest, RotatesFiles) {
+    const std::string path = testing::TempDir() + "hci_capture_rotate.pcap";
+    std::remove((path + ".1").c_str());
+    std::remove((path + ".2").c_str());
+
+    HciCapture capture(path, HciCapture::Format::Pcap, 200, 3);
+    ASSERT_TRUE(capture.start());
+
+    std::vector<uint8_t> packet(50, 0x02);
+    for (int i = 0; i < 12; ++i) {
+        capture.capturePacket(i % 2 == 0, packet.data(), packet.size());
+    }
+    capture.stop();
+
+    EXPECT_FALSE(readFile(path).empty());
+    EXPECT_FALSE(readFile(path + ".1").empty());
+    EXPECT_FALSE(readFile(path + ".2").empty());
+    EXPECT_TRUE(readFile(path + ".3").empty());
+}
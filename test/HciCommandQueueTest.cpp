@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/HciCommandQueue.h"
+
+using namespace ggk;
+
+// socketpair()로 컨트롤러 역할을 흉내내는 테스트 픽스처
+class HciCommandQueueTest : public ::testing::Test {
+protected:
+    HciSocket socket;
+    int controllerFd = -1;
+
+    void SetUp() override {
+        int fds[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+        ASSERT_TRUE(socket.adopt(fds[0]));
+        controllerFd = fds[1];
+    }
+
+    void TearDown() override {
+        socket.disconnect();
+        if (controllerFd >= 0) {
+            close(controllerFd);
+        }
+    }
+
+    // 컨트롤러 측에서 명령 하나를 읽고 opcode 반환 (없으면 0)
+    uint16_t readCommand() {
+        uint8_t buffer[260];
+        ssize_t n = recv(controllerFd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n < 4 || buffer[0] != 0x01) {
+            return 0;
+        }
+        return static_cast<uint16_t>(buffer[1] | (buffer[2] << 8));
+    }
+
+    static void commandComplete(HciCommandQueue& queue, uint16_t opcode, uint8_t credits, uint8_t status) {
+        const uint8_t params[] = {credits, static_cast<uint8_t>(opcode & 0xFF), static_cast<uint8_t>(opcode >> 8), status, 0xAB};
+        queue.handleEvent(0x0E, params, sizeof(params));
+    }
+};
+
+// ✅ 1. 크레딧이 1개일 때는 한 번에 하나의 명령만 전송되어야 함
+TEST_F(HciCommandQueueTest, RespectsCredits) {
+    HciCommandQueue queue(socket);
+
+    auto first = queue.submit(0x0C03, {});
+    auto second = queue.submit(0x0C13, {0x41});
+
+    EXPECT_EQ(readCommand(), 0x0C03);
+    EXPECT_EQ(readCommand(), 0) << "크레딧 없이 두 번째 명령이 전송되었습니다.";
+    EXPECT_EQ(queue.pendingCount(), 2u);
+
+    // 완료 이벤트로 크레딧이 돌아오면 다음 명령 전송
+    commandComplete(queue, 0x0C03, 1, 0x00);
+    EXPECT_EQ(readCommand(), 0x0C13);
+
+    HciCommandResult result = first.get();
+    EXPECT_TRUE(result.succeeded());
+    EXPECT_TRUE(result.complete);
+    ASSERT_EQ(result.returnParameters.size(), 1u);
+    EXPECT_EQ(result.returnParameters[0], 0xAB);
+}
+
+// ✅ 2. Command Status 이벤트를 opcode로 매칭
+TEST_F(HciCommandQueueTest, MatchesCommandStatus) {
+    HciCommandQueue queue(socket);
+
+    auto future = queue.submit(0x2013, {});
+    ASSERT_EQ(readCommand(), 0x2013);
+
+    const uint8_t params[] = {0x0C, 0x01, 0x13, 0x20};  // status=0x0C(Command Disallowed)
+    EXPECT_TRUE(queue.handleEvent(0x0F, params, sizeof(params)));
+
+    HciCommandResult result = future.get();
+    EXPECT_FALSE(result.complete);
+    EXPECT_EQ(result.status, 0x0C);
+    EXPECT_EQ(queue.getCredits(), 1);
+}
+
+// ✅ 3. 응답이 없으면 타임아웃으로 실패하고 크레딧 복구
+TEST_F(HciCommandQueueTest, TimesOut) {
+    HciCommandQueue queue(socket);
+
+    auto future = queue.submit(0x0C03, {}, std::chrono::milliseconds(1));
+    ASSERT_EQ(readCommand(), 0x0C03);
+    EXPECT_EQ(queue.getCredits(), 0);
+
+    usleep(5000);
+    queue.checkTimeouts();
+
+    EXPECT_EQ(future.get().status, HciCommandQueue::kStatusTimeout);
+    EXPECT_EQ(queue.getCredits(), 1);
+    EXPECT_EQ(queue.pendingCount(), 0u);
+}
+
+// ✅ 4. 크레딧 업데이트만 있는 NOP 이벤트 처리
+TEST_F(HciCommandQueueTest, NopRefreshesCredits) {
+    HciCommandQueue queue(socket);
+
+    auto first = queue.submit(0x0C03, {});
+    auto second = queue.submit(0x0C14, {});
+    auto third = queue.submit(0x1009, {});
+    ASSERT_EQ(readCommand(), 0x0C03);
+
+    commandComplete(queue, 0x0000, 2, 0x00);
+    EXPECT_EQ(readCommand(), 0x0C14);
+    EXPECT_EQ(readCommand(), 0x1009);
+    EXPECT_EQ(queue.pendingCount(), 3u);
+
+    queue.cancelAll();
+    EXPECT_EQ(first.get().status, HciCommandQueue::kStatusCancelled);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/HciEventDecoder.h"
+
+using namespace ggk;
+
+// ✅ 1. Disconnection Complete 디코딩 (리틀 엔디안 핸들)
+TEST(HciEventDecoderTest, DisconnectionComplete) {
+    HciEventDecoder decoder;
+
+    uint16_t handle = 0;
+    uint8_t reason = 0;
+    decoder.onDisconnectionComplete([&](const HciDisconnectionCompleteView& view) {
+        handle = view.connectionHandle();
+        reason = view.reason();
+    });
+
+    const uint8_t params[] = {0x00, 0x40, 0x20, 0x13};  // handle 0x2040 -> 0x040 (PB/BC 플래그 제거)
+    EXPECT_TRUE(decoder.decode(HciEventDecoder::EVT_DISCONNECTION_COMPLETE, HciByteView(params, sizeof(params))));
+    EXPECT_EQ(handle, 0x0040);
+    EXPECT_EQ(reason, 0x13);
+}
+
+// ✅ 2. 레거시/확장 LE Connection Complete 모두 같은 핸들러로 전달
+TEST(HciEventDecoderTest, LeConnectionCompleteLegacyAndEnhanced) {
+    HciEventDecoder decoder;
+
+    std::vector<std::pair<bool, uint16_t>> intervals;
+    std::string address;
+    decoder.onLeConnectionComplete([&](const HciLeConnectionCompleteView& view) {
+        intervals.emplace_back(view.isEnhanced(), view.connectionInterval());
+        address = hciAddressString(view.peerAddress());
+    });
+
+    const uint8_t legacy[] = {
+        HciEventDecoder::LE_CONNECTION_COMPLETE,
+        0x00, 0x01, 0x00, 0x01, 0x00,
+        0x66, 0x55, 0x44, 0x33, 0x22, 0x11,  // AA 리틀 엔디안
+        0x18, 0x00, 0x00, 0x00, 0x48, 0x00, 0x01
+    };
+    EXPECT_TRUE(decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(legacy, sizeof(legacy))));
+    EXPECT_EQ(address, "11:22:33:44:55:66");
+
+    std::vector<uint8_t> enhanced = {HciEventDecoder::LE_ENHANCED_CONNECTION_COMPLETE, 0x00, 0x02, 0x00, 0x01, 0x00};
+    enhanced.insert(enhanced.end(), 6 + 12, 0xAA);            // peer address + 두 개의 RPA
+    enhanced.insert(enhanced.end(), {0x06, 0x00, 0x00, 0x00, 0x48, 0x00, 0x01});
+    EXPECT_TRUE(decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(enhanced.data(), enhanced.size())));
+
+    ASSERT_EQ(intervals.size(), 2u);
+    EXPECT_EQ(intervals[0], std::make_pair(false, uint16_t(0x0018)));
+    EXPECT_EQ(intervals[1], std::make_pair(true, uint16_t(0x0006)));
+}
+
+// ✅ 3. 여러 개의 광고 리포트를 하나씩 전달하고 잘린 리포트는 버림
+TEST(HciEventDecoderTest, AdvertisingReports) {
+    HciEventDecoder decoder;
+
+    std::vector<size_t> dataSizes;
+    std::vector<int8_t> rssis;
+    decoder.onLeAdvertisingReport([&](const HciLeAdvertisingReportView& report) {
+        dataSizes.push_back(report.data().size);
+        rssis.push_back(report.rssi());
+    });
+
+    const uint8_t params[] = {
+        HciEventDecoder::LE_ADVERTISING_REPORT, 0x03,
+        0x00, 0x00, 1, 2, 3, 4, 5, 6, 0x03, 0x02, 0x01, 0x06, 0xC4,    // 3바이트 데이터, RSSI -60
+        0x04, 0x01, 1, 2, 3, 4, 5, 6, 0x00, 0xB0,                        // 데이터 없음, RSSI -80
+        0x00, 0x00, 1, 2, 3, 4, 5, 6, 0x1F, 0x02                         // 잘린 리포트
+    };
+    decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(params, sizeof(params)));
+
+    ASSERT_EQ(dataSizes.size(), 2u);
+    EXPECT_EQ(dataSizes[0], 3u);
+    EXPECT_EQ(dataSizes[1], 0u);
+    EXPECT_EQ(rssis[0], -60);
+    EXPECT_EQ(rssis[1], -80);
+}
+
+// ✅ 4. Number of Completed Packets 및 짧은 이벤트 처리
+TEST(HciEventDecoderTest, NumberOfCompletedPacketsAndShortEvents) {
+    HciEventDecoder decoder;
+
+    uint32_t total = 0;
+    decoder.onNumberOfCompletedPackets([&](const HciNumberOfCompletedPacketsView& view) {
+        for (size_t i = 0; i < view.count(); ++i) {
+            total += view.completedPackets(i);
+        }
+    });
+
+    bool phyCalled = false;
+    decoder.onLePhyUpdateComplete([&](const HciLePhyUpdateCompleteView&) { phyCalled = true; });
+
+    // 핸들 개수는 3이지만 실제로는 2개만 포함됨
+    const uint8_t completed[] = {0x03, 0x40, 0x00, 0x02, 0x00, 0x41, 0x00, 0x05, 0x00};
+    decoder.decode(HciEventDecoder::EVT_NUMBER_OF_COMPLETED_PACKETS, HciByteView(completed, sizeof(completed)));
+    EXPECT_EQ(total, 7u);
+
+    const uint8_t shortPhy[] = {HciEventDecoder::LE_PHY_UPDATE_COMPLETE, 0x00, 0x40};
+    decoder.decode(HciEventDecoder::EVT_LE_META, HciByteView(shortPhy, sizeof(shortPhy)));
+    EXPECT_FALSE(phyCalled) << "짧은 이벤트가 핸들러로 전달되었습니다.";
+
+    // 등록되지 않은 이벤트는 처리되지 않음
+    EXPECT_FALSE(decoder.decode(0x08, HciByteView(completed, sizeof(completed))));
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "../include/HciPacketPool.h"
+
+using namespace ggk;
+
+// ✅ 1. 슬랩 대여 및 반환 테스트
+TEST(HciPacketPoolTest, AcquireAndRelease) {
+    HciPacketPool pool(4);
+    EXPECT_EQ(pool.available(), 4u);
+
+    {
+        HciPacket packet = pool.acquire();
+        ASSERT_TRUE(packet.isValid());
+        EXPECT_EQ(pool.available(), 3u);
+    }
+
+    // 패킷이 소멸되면 슬랩은 풀로 돌아와야 함
+    EXPECT_EQ(pool.available(), 4u);
+}
+
+// ✅ 2. 풀이 비었을 때 invalid 패킷 반환
+TEST(HciPacketPoolTest, Exhaustion) {
+    HciPacketPool pool(2);
+
+    HciPacket first = pool.acquire();
+    HciPacket second = pool.acquire();
+    HciPacket third = pool.acquire();
+
+    EXPECT_TRUE(first.isValid());
+    EXPECT_TRUE(second.isValid());
+    EXPECT_FALSE(third.isValid()) << "빈 풀에서 슬랩이 반환되었습니다.";
+
+    first.reset();
+    EXPECT_EQ(pool.available(), 1u);
+}
+
+// ✅ 3. 이동 시 슬랩 소유권이 이전되는지 확인
+TEST(HciPacketPoolTest, MoveTransfersOwnership) {
+    HciPacketPool pool(1);
+
+    HciPacket packet = pool.acquire();
+    const uint8_t *pSlab = packet.data();
+
+    HciPacket moved = std::move(packet);
+    EXPECT_FALSE(packet.isValid());
+    EXPECT_EQ(moved.data(), pSlab);
+    EXPECT_EQ(pool.available(), 0u);
+}
+
+// ✅ 4. HciByteView 범위 테스트
+TEST(HciPacketPoolTest, ByteViewSubview) {
+    const uint8_t bytes[] = {0x04, 0x0E, 0x04, 0x01};
+    HciByteView view(bytes, sizeof(bytes));
+
+    EXPECT_EQ(view.subview(1).size, 3u);
+    EXPECT_EQ(view.subview(1)[0], 0x0E);
+    EXPECT_TRUE(view.subview(4).empty());
+    EXPECT_TRUE(view.subview(10).empty());
+}
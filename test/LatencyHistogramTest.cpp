@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../include/LatencyHistogram.h"
+
+using namespace ggk;
+
+// ✅ 1. 2048 미만의 값은 정확히 기록됨
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 1000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+    EXPECT_EQ(histogram.percentile(50), 500u);
+    EXPECT_EQ(histogram.percentile(99), 990u);
+    EXPECT_EQ(histogram.percentile(99.9), 999u);
+    EXPECT_EQ(histogram.percentile(100), 1000u);
+}
+
+// ✅ 2. 큰 값의 상대 오차는 유효 자릿수(3자리) 이내
+TEST(LatencyHistogramTest, LargeValuesKeepSignificantDigits) {
+    for (double value = 3000; value < 2e10; value *= 1.37) {
+        LatencyHistogram histogram;
+        uint64_t recorded = static_cast<uint64_t>(value);
+        histogram.record(recorded);
+        histogram.record(recorded * 2);
+
+        uint64_t p50 = histogram.percentile(50);
+        EXPECT_GE(p50, recorded);
+        EXPECT_LE(static_cast<double>(p50 - recorded), static_cast<double>(recorded) * 1e-3) << recorded;
+        EXPECT_EQ(histogram.percentile(100), recorded * 2);
+    }
+}
+
+// ✅ 3. 병합은 개수를 더하고, 범위가 다르면 거부; reset은 비움
+TEST(LatencyHistogramTest, MergesAndResets) {
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 990; ++i) {
+        fast.record(100000);            // 100 us
+    }
+    for (int i = 0; i < 10; ++i) {
+        slow.record(5000000);           // 5 ms
+    }
+
+    ASSERT_TRUE(fast.merge(slow));
+    EXPECT_EQ(fast.count(), 1000u);
+    EXPECT_NEAR(static_cast<double>(fast.percentile(50)), 100000.0, 100.0);
+    EXPECT_NEAR(static_cast<double>(fast.percentile(99)), 100000.0, 100.0);
+    EXPECT_NEAR(static_cast<double>(fast.percentile(99.9)), 5000000.0, 5000.0);
+    EXPECT_EQ(fast.max(), 5000000u);
+
+    LatencyHistogram other(1000000, 2);
+    EXPECT_FALSE(fast.merge(other));
+
+    fast.reset();
+    EXPECT_EQ(fast.count(), 0u);
+    EXPECT_EQ(fast.percentile(99), 0u);
+    EXPECT_EQ(fast.min(), 0u);
+    EXPECT_EQ(fast.max(), 0u);
+}
+
+// ✅ 4. 범위를 넘는 값은 최댓값으로 기록되고 따로 집계됨
+TEST(LatencyHistogramTest, SaturatesAboveHighestValue) {
+    LatencyHistogram histogram(1000000);
+    histogram.record(0);
+    histogram.record(500);
+    histogram.record(5000000);
+
+    EXPECT_EQ(histogram.count(), 3u);
+    EXPECT_EQ(histogram.saturated(), 1u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 1000000u);
+    EXPECT_EQ(histogram.percentile(0), 0u);
+    EXPECT_EQ(histogram.percentile(100), 1000000u);
+}
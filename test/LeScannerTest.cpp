@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../include/LeScanner.h"
+
+using namespace ggk;
+
+namespace {
+
+// LE Advertising Report 이벤트 파라미터 (보고서 1개)
+std::vector<uint8_t> legacyReport(uint8_t lastAddressByte, const std::vector<uint8_t>& data, int8_t rssi) {
+    std::vector<uint8_t> event = {HciEventDecoder::LE_ADVERTISING_REPORT, 0x01, 0x03, 0x01,
+                                  lastAddressByte, 0x22, 0x33, 0x44, 0x55, 0xC6, static_cast<uint8_t>(data.size())};
+    event.insert(event.end(), data.begin(), data.end());
+    event.push_back(static_cast<uint8_t>(rssi));
+    return event;
+}
+
+} // namespace
+
+// 어댑터는 초기화하지 않음 - 보고서는 디코더에 직접 주입
+class LeScannerTest : public ::testing::Test {
+protected:
+    HciAdapter adapter;
+    std::unique_ptr<LeScanner> scanner;
+    std::vector<ScanReport> reports;
+
+    void SetUp() override {
+        scanner = std::make_unique<LeScanner>(adapter);
+        scanner->subscribe([this](const ScanReport& report) { reports.push_back(report); });
+    }
+
+    void inject(const std::vector<uint8_t>& event) {
+        adapter.getEventDecoder().decode(HciEventDecoder::EVT_LE_META, HciByteView(event.data(), event.size()));
+    }
+};
+
+// ✅ 1. 레거시 보고서 디코딩과 전달
+TEST_F(LeScannerTest, DeliversLegacyReport) {
+    inject(legacyReport(0x11, {0x02, 0x01, 0x06}, -60));
+    EXPECT_EQ(scanner->drain(), 1u);
+
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_FALSE(reports[0].extended);
+    EXPECT_EQ(reports[0].eventType, 0x03);
+    EXPECT_EQ(reports[0].addressType, 0x01);
+    EXPECT_EQ(reports[0].addressString(), "C6:55:44:33:22:11");
+    EXPECT_EQ(reports[0].rssi, -60);
+    ASSERT_EQ(reports[0].dataLength, 3);
+    EXPECT_EQ(reports[0].data[2], 0x06);
+    EXPECT_EQ(reports[0].sid, ScanReport::kNoSid);
+}
+
+// ✅ 2. 같은 (주소, 페이로드)는 TTL 동안 걸러지고 페이로드가 바뀌면 통과
+TEST_F(LeScannerTest, FiltersDuplicates) {
+    for (int i = 0; i < 10; ++i) {
+        inject(legacyReport(0x11, {0x02, 0x01, 0x06}, -60));
+    }
+    inject(legacyReport(0x11, {0x02, 0x01, 0x04}, -60));
+    inject(legacyReport(0x12, {0x02, 0x01, 0x06}, -60));
+    scanner->drain();
+
+    EXPECT_EQ(reports.size(), 3u);
+    LeScanner::Statistics statistics = scanner->getStatistics();
+    EXPECT_EQ(statistics.received, 12u);
+    EXPECT_EQ(statistics.duplicates, 9u);
+    EXPECT_EQ(statistics.delivered, 3u);
+
+    // 필터를 끄면 모두 전달
+    scanner->setDuplicateFilter(std::chrono::milliseconds(0));
+    inject(legacyReport(0x11, {0x02, 0x01, 0x06}, -60));
+    inject(legacyReport(0x11, {0x02, 0x01, 0x06}, -60));
+    EXPECT_EQ(scanner->drain(), 2u);
+}
+
+// ✅ 3. 링이 가득 차면 버리고 집계
+TEST_F(LeScannerTest, CountsDropsWhenRingIsFull) {
+    scanner->setDuplicateFilter(std::chrono::milliseconds(0));
+    for (size_t i = 0; i < LeScanner::kRingCapacity + 10; ++i) {
+        inject(legacyReport(0x11, {0x02, 0x01, 0x06}, -60));
+    }
+
+    EXPECT_EQ(scanner->getStatistics().dropped, 10u);
+    EXPECT_EQ(scanner->drain(), LeScanner::kRingCapacity);
+}
+
+// ✅ 4. 파라미터 인코딩 (확장 스캔은 PHY마다 한 블록)
+TEST_F(LeScannerTest, EncodeParameters) {
+    ScanParameters parameters;
+    parameters.active = true;
+    parameters.setIntervalMs(100, 50);
+    parameters.phys = ScanParameters::kPhy1M | ScanParameters::kPhyCoded;
+
+    auto legacy = LeScanner::encodeParameters(parameters);
+    ASSERT_EQ(legacy.size(), 7u);
+    EXPECT_EQ(legacy[0], 0x01);
+    EXPECT_EQ(legacy[1] | (legacy[2] << 8), 160);
+    EXPECT_EQ(legacy[3] | (legacy[4] << 8), 80);
+
+    auto extended = LeScanner::encodeExtendedParameters(parameters);
+    ASSERT_EQ(extended.size(), 3u + 2u * 5u);
+    EXPECT_EQ(extended[2], ScanParameters::kPhy1M | ScanParameters::kPhyCoded);
+
+    EXPECT_FALSE(scanner->start(parameters));    // 어댑터 미초기화
+    EXPECT_FALSE(scanner->isScanning());
+}
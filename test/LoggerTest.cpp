@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "../include/Logger.h"
+
+using namespace ggk;
+
+namespace {
+
+std::vector<std::string> g_messages;
+
+void captureReceiver(const char* pText) {
+    g_messages.push_back(pText);
+}
+
+} // namespace
+
+// 테스트 main()이 등록한 수신자는 보관했다가 되돌림 (trace 수신자는 없는 상태로 실행)
+class LoggerTest : public ::testing::Test {
+protected:
+    Logger::LogReceiver previousDebug;
+    Logger::LogReceiver previousInfo;
+    Logger::LogReceiver previousTrace;
+
+    void SetUp() override {
+        previousDebug = Logger::getReceiver(LogLevel::Debug);
+        previousInfo = Logger::getReceiver(LogLevel::Info);
+        previousTrace = Logger::getReceiver(LogLevel::Trace);
+
+        g_messages.clear();
+        Logger::setLevel(LogLevel::Trace);
+        Logger::registerDebugReceiver(&captureReceiver);
+        Logger::registerInfoReceiver(&captureReceiver);
+        Logger::registerTraceReceiver(nullptr);
+    }
+
+    void TearDown() override {
+        Logger::registerDebugReceiver(previousDebug);
+        Logger::registerInfoReceiver(previousInfo);
+        Logger::registerTraceReceiver(previousTrace);
+        Logger::setLevel(LogLevel::Trace);
+    }
+};
+
+// ✅ 1. 레벨 지정 문자열 파싱 (전체 + 모듈별)
+TEST_F(LoggerTest, SetLevelsFromSpec) {
+    EXPECT_TRUE(Logger::setLevels("info, HCI=debug,gatt=off"));
+    EXPECT_EQ(Logger::getLevel(LogModule::General), LogLevel::Info);
+    EXPECT_EQ(Logger::getLevel(LogModule::DBus), LogLevel::Info);
+    EXPECT_EQ(Logger::getLevel(LogModule::Hci), LogLevel::Debug);
+    EXPECT_EQ(Logger::getLevel(LogModule::Gatt), LogLevel::Off);
+
+    // 잘못된 항목은 무시하고 나머지는 적용
+    EXPECT_FALSE(Logger::setLevels("dbus=trace,radio=debug,loud"));
+    EXPECT_EQ(Logger::getLevel(LogModule::DBus), LogLevel::Trace);
+    EXPECT_STREQ(Logger::levelName(LogLevel::Warn), "warn");
+    EXPECT_STREQ(Logger::moduleName(LogModule::Server), "server");
+}
+
+// ✅ 2. 모듈별 런타임 레벨과 수신자 유무로 기록 여부 결정
+TEST_F(LoggerTest, ModuleLevelsGateMessages) {
+    Logger::setLevel(LogModule::Hci, LogLevel::Info);
+
+    GGK_LOG_DEBUG(Hci, "hci debug");
+    GGK_LOG_INFO(Hci, "hci info");
+    GGK_LOG_DEBUG(Gatt, "gatt debug " << 42);
+    GGK_LOG_TRACE(Gatt, "no trace receiver");
+
+    ASSERT_EQ(g_messages.size(), 2u);
+    EXPECT_EQ(g_messages[0], "hci info");
+    EXPECT_EQ(g_messages[1], "gatt debug 42");
+
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Debug, LogModule::Hci));
+    EXPECT_TRUE(Logger::isEnabled(LogLevel::Debug, LogModule::Gatt));
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Trace, LogModule::Gatt));
+}
+
+// ✅ 3. 비활성 레벨에서는 인자를 평가하지 않음
+TEST_F(LoggerTest, DisabledLevelSkipsArguments) {
+    int evaluations = 0;
+    auto expensive = [&evaluations] {
+        ++evaluations;
+        return std::string("expensive");
+    };
+
+    Logger::setLevel(LogModule::Gatt, LogLevel::Warn);
+    GGK_LOG_DEBUG(Gatt, "value: " << expensive());
+    EXPECT_EQ(evaluations, 0);
+
+    Logger::registerDebugReceiver(nullptr);
+    Logger::setLevel(LogModule::Gatt, LogLevel::Trace);
+    GGK_LOG_DEBUG(Gatt, "value: " << expensive());
+    EXPECT_EQ(evaluations, 0);
+
+    Logger::registerDebugReceiver(&captureReceiver);
+    GGK_LOG_DEBUG(Gatt, "value: " << expensive());
+    EXPECT_EQ(evaluations, 1);
+    ASSERT_EQ(g_messages.size(), 1u);
+    EXPECT_EQ(g_messages[0], "value: expensive");
+}
+
+// ✅ 4. 포맷팅 중 다시 로그를 남겨도 메시지가 섞이지 않음
+TEST_F(LoggerTest, NestedLogStatements) {
+    auto describe = [] {
+        GGK_LOG_DEBUG(General, "inner");
+        return std::string("outer");
+    };
+
+    GGK_LOG_INFO(General, "message: " << describe() << " done");
+
+    ASSERT_EQ(g_messages.size(), 2u);
+    EXPECT_EQ(g_messages[0], "inner");
+    EXPECT_EQ(g_messages[1], "message: outer done");
+}
+
+// ✅ 5. 재사용하는 스트림의 포맷 상태(hex, 폭, 채움 문자, 정밀도)는 다음 메시지로 이어지지 않음
+TEST_F(LoggerTest, FormatStateDoesNotLeak) {
+    GGK_LOG_INFO(General, std::hex << std::setfill('0') << std::setprecision(2) << std::fixed << 255 << " " << 1.0);
+    GGK_LOG_INFO(General, std::setw(6) << std::left);
+    GGK_LOG_INFO(General, 255 << " " << 1.5 << " " << 7);
+
+    ASSERT_EQ(g_messages.size(), 3u);
+    EXPECT_EQ(g_messages[0], "ff 1.00");
+    EXPECT_EQ(g_messages[2], "255 1.5 7");
+}
+
+// ✅ 6. Logger::debug/info 등 이름 있는 진입점은 General 모듈의 레벨을 따름
+TEST_F(LoggerTest, PlainEntryPointsFollowGeneralLevel) {
+    Logger::setLevels("warn,gatt=debug");
+
+    Logger::debug("general debug");
+    Logger::info(std::string("general info"));
+    Logger::info(SSTR << "general stream " << 1);
+    GGK_LOG_DEBUG(Gatt, "gatt debug");
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::Info));
+
+    Logger::setLevel(LogModule::General, LogLevel::Info);
+    Logger::debug("still filtered");
+    Logger::info("general info");
+
+    ASSERT_EQ(g_messages.size(), 2u);
+    EXPECT_EQ(g_messages[0], "gatt debug");
+    EXPECT_EQ(g_messages[1], "general info");
+}
@@ -5,7 +5,6 @@ using namespace ggk;
 
 class MgmtTest : public ::testing::Test {
 protected:
-    HciAdapter adapter;
     std::unique_ptr<Mgmt> mgmt;
         
     // BLE 초기 상태 저장
@@ -17,8 +16,8 @@ protected:
     bool initialLE;
         
     void SetUp() override {
-        ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-        mgmt = std::make_unique<Mgmt>(adapter);
+        mgmt = std::make_unique<Mgmt>();
+        ASSERT_TRUE(mgmt->initialize()) << "Mgmt 초기화 실패!";
     
         // ✅ BLE 현재 상태 저장 (테스트 후 원래 상태로 복구)
         initialPowered = mgmt->setPowered(true);
@@ -44,10 +43,8 @@ protected:
 
 // ✅ 1. `setName()` 테스트 (BLE 장치 이름 변경)
 TEST(MgmtTest, SetNameTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     std::string testName = "JetsonBLE";
     std::string shortName = "JBLE";
@@ -57,10 +54,8 @@ TEST(MgmtTest, SetNameTest) {
 
 // ✅ 2. `setDiscoverable()` 테스트 (BLE 검색 가능 상태 변경)
 TEST(MgmtTest, SetDiscoverableTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setDiscoverable(1, 60)) << "BLE 검색 가능 상태 활성화 실패!";
     sleep(1);
@@ -69,10 +64,8 @@ TEST(MgmtTest, SetDiscoverableTest) {
 
 // ✅ 3. `setPowered()` 테스트 (BLE 전원 ON/OFF)
 TEST(MgmtTest, SetPoweredTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setPowered(true)) << "BLE 전원 켜기 실패!";
     sleep(1);
@@ -81,10 +74,8 @@ TEST(MgmtTest, SetPoweredTest) {
 
 // ✅ 4. `setBredr()` 테스트 (BR/EDR 모드 ON/OFF)
 TEST(MgmtTest, SetBredrTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setBredr(true)) << "BLE BR/EDR 모드 활성화 실패!";
     sleep(1);
@@ -93,10 +84,8 @@ TEST(MgmtTest, SetBredrTest) {
 
 // ✅ 5. `setSecureConnections()` 테스트 (Secure Connection 모드 ON/OFF)
 TEST(MgmtTest, SetSecureConnectionsTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setSecureConnections(1)) << "Secure Connection 활성화 실패!";
     sleep(1);
@@ -105,10 +94,8 @@ TEST(MgmtTest, SetSecureConnectionsTest) {
 
 // ✅ 6. `setBondable()` 테스트 (BLE 장치가 Bonding을 지원하는지 확인)
 TEST(MgmtTest, SetBondableTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setBondable(true)) << "BLE Bonding 모드 활성화 실패!";
     sleep(1);
@@ -117,10 +104,8 @@ TEST(MgmtTest, SetBondableTest) {
 
 // ✅ 7. `setConnectable()` 테스트 (BLE 장치를 연결 가능 상태로 변경)
 TEST(MgmtTest, SetConnectableTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setConnectable(true)) << "BLE Connectable 모드 활성화 실패!";
     sleep(1);
@@ -129,10 +114,8 @@ TEST(MgmtTest, SetConnectableTest) {
 
 // ✅ 8. `setLE()` 테스트 (BLE Low Energy 모드 ON/OFF)
 TEST(MgmtTest, SetLETest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setLE(true)) << "BLE LE 모드 활성화 실패!";
     sleep(1);
@@ -141,10 +124,8 @@ TEST(MgmtTest, SetLETest) {
 
 // ✅ 9. `setAdvertising()` 테스트 (BLE 광고(Advertising) ON/OFF)
 TEST(MgmtTest, SetAdvertisingTest) {
-    HciAdapter adapter;
-    ASSERT_TRUE(adapter.initialize()) << "HciAdapter 초기화 실패!";
-
-    Mgmt mgmt(adapter);
+    Mgmt mgmt;
+    ASSERT_TRUE(mgmt.initialize()) << "Mgmt 초기화 실패!";
 
     EXPECT_TRUE(mgmt.setAdvertising(1)) << "BLE Advertising 활성화 실패!";
     sleep(1);
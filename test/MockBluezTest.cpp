@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "../include/MockBluez.h"
+#include "../include/GattApplication.h"
+#include "../include/GattService.h"
+#include "../include/GattCharacteristic.h"
+
+using namespace ggk;
+
+// 애플리케이션은 기본 메인 컨텍스트(테스트 스레드), 모의 BlueZ는 자체 컨텍스트를 가진 스레드에서 실행.
+// 모의 BlueZ는 기본적으로 bluetoothd처럼 GetManagedObjects를 마친 뒤 RegisterApplication에 응답하므로,
+// registerWithBlueZ()가 기다리는 동안 테스트 스레드의 컨텍스트를 돌리지 않으면 등록이 끝나지 않음
+class MockBluezTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        GDBusConnectionPtr appRaw = makeGDBusConnectionPtr(nullptr);
+        ASSERT_TRUE(DBusConnection::openPeerPair(appRaw, bluezRaw));
+        appConnection = std::make_unique<DBusConnection>(std::move(appRaw));
+        pMockContext = g_main_context_new();
+    }
+
+    void TearDown() override {
+        if (mockThread.joinable()) {
+            quit = true;
+            g_main_context_wakeup(pMockContext);
+            mockThread.join();
+        }
+        application.reset();
+        appConnection.reset();
+        g_main_context_unref(pMockContext);
+    }
+
+    void startMock(MockBluez::Config config) {
+        std::atomic<bool> started{false};
+        mockThread = std::thread([this, config, &started]() {
+            g_main_context_push_thread_default(pMockContext);
+            {
+                DBusConnection connection(std::move(bluezRaw));
+                MockBluez mock(connection, config);
+                mockStarted = mock.start();
+                pMock = &mock;
+                started = true;
+                while (!quit) {
+                    g_main_context_iteration(pMockContext, TRUE);
+                }
+                pMock = nullptr;
+            }
+            g_main_context_pop_thread_default(pMockContext);
+        });
+        while (!started) {
+            std::this_thread::yield();
+        }
+        ASSERT_TRUE(mockStarted);
+    }
+
+    // 서비스 하나: 읽기+알림, 쓰기, 읽기+쓰기 특성
+    void createApplication() {
+        application = std::make_unique<GattApplication>(*appConnection, DBusObjectPath("/com/example/mock"));
+        auto service = std::make_shared<GattService>(*appConnection, DBusObjectPath("/com/example/mock/service0"),
+                                                     GattUuid::fromShortUuid(0x180F), true);
+        notifyCharacteristic = service->createCharacteristic(GattUuid::fromShortUuid(0x2A19),
+                                                             GattProperty::PROP_READ | GattProperty::PROP_NOTIFY,
+                                                             GattPermission::PERM_READ);
+        writeCharacteristic = service->createCharacteristic(GattUuid::fromShortUuid(0x2A06), GattProperty::PROP_WRITE,
+                                                            GattPermission::PERM_WRITE);
+        service->createCharacteristic(GattUuid::fromShortUuid(0x2A2B), GattProperty::PROP_READ | GattProperty::PROP_WRITE,
+                                      GattPermission::PERM_READ | GattPermission::PERM_WRITE);
+        application->addService(service);
+    }
+
+    // 애플리케이션 쪽 메인 컨텍스트를 조건이 참이 될 때까지 돌림
+    bool runUntil(const std::function<bool()>& condition, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            g_main_context_iteration(nullptr, FALSE);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return true;
+    }
+
+    GDBusConnectionPtr bluezRaw = makeGDBusConnectionPtr(nullptr);
+    std::unique_ptr<DBusConnection> appConnection;
+    std::unique_ptr<GattApplication> application;
+    GattCharacteristicPtr notifyCharacteristic;
+    GattCharacteristicPtr writeCharacteristic;
+
+    GMainContext* pMockContext = nullptr;
+    std::thread mockThread;
+    std::atomic<bool> quit{false};
+    std::atomic<bool> mockStarted{false};
+    std::atomic<MockBluez*> pMock{nullptr};
+};
+
+// ✅ 1. 단계 문자열 파싱과 잘못된 값 거부
+TEST(MockBluezPhaseTest, ParsesPhaseSpec) {
+    MockBluez::Phase phase;
+    ASSERT_TRUE(MockBluez::parsePhase("name=ramp,clients=8,rate=50,duration=2.5,read=70,size=100,mtu=185", phase));
+    EXPECT_EQ(phase.name, "ramp");
+    EXPECT_EQ(phase.clients, 8u);
+    EXPECT_DOUBLE_EQ(phase.ratePerClient, 50.0);
+    EXPECT_DOUBLE_EQ(phase.durationSeconds, 2.5);
+    EXPECT_EQ(phase.readPercent, 70u);
+    EXPECT_EQ(phase.writeSize, 100u);
+    EXPECT_EQ(phase.mtu, 185);
+
+    MockBluez::Phase other;
+    EXPECT_FALSE(MockBluez::parsePhase("clients=0", other));
+    EXPECT_FALSE(MockBluez::parsePhase("read=101", other));
+    EXPECT_FALSE(MockBluez::parsePhase("read=60,command=50", other));
+    EXPECT_FALSE(MockBluez::parsePhase("duration=x", other));
+    EXPECT_FALSE(MockBluez::parsePhase("speed=1", other));
+    EXPECT_FALSE(MockBluez::parsePhase("clients", other));
+}
+
+// ✅ 2. RegisterApplication 후 GetManagedObjects로 특성과 플래그를 찾음
+TEST_F(MockBluezTest, RegistersApplicationAndWalksObjects) {
+    startMock(MockBluez::Config());
+    createApplication();
+
+    ASSERT_TRUE(application->registerWithBlueZ());
+    ASSERT_TRUE(runUntil([this]() { return pMock.load()->isFinished(); }));
+    EXPECT_TRUE(pMock.load()->isApplicationRegistered());
+
+    auto characteristics = pMock.load()->getCharacteristics();
+    ASSERT_EQ(characteristics.size(), 3u);
+    size_t readable = 0, writable = 0, notifiable = 0;
+    for (const auto& characteristic : characteristics) {
+        readable += characteristic.readable;
+        writable += characteristic.writable;
+        notifiable += characteristic.notifiable;
+    }
+    EXPECT_EQ(readable, 2u);
+    EXPECT_EQ(writable, 2u);
+    EXPECT_EQ(notifiable, 1u);
+
+    // 알림 가능한 특성에 StartNotify
+    EXPECT_TRUE(runUntil([this]() { return notifyCharacteristic->isNotifying(); }));
+}
+
+// ✅ 3. 부하 단계: 읽기/쓰기가 실패 없이 완료되고 쓴 값이 저장됨
+TEST_F(MockBluezTest, RunsLoadPhase) {
+    MockBluez::Config config;
+    MockBluez::Phase phase;
+    ASSERT_TRUE(MockBluez::parsePhase("name=closed,clients=4,duration=0.3,read=50,size=20", phase));
+    config.phases.push_back(phase);
+    ASSERT_TRUE(MockBluez::parsePhase("name=paced,clients=2,rate=100,duration=0.3,read=0", phase));
+    config.phases.push_back(phase);
+    startMock(config);
+    createApplication();
+
+    ASSERT_TRUE(application->registerWithBlueZ());
+    ASSERT_TRUE(runUntil([this]() { return pMock.load()->isFinished(); }));
+
+    auto reports = pMock.load()->getReports();
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].phase, "closed");
+    EXPECT_EQ(reports[0].clients, 4u);
+    EXPECT_GT(reports[0].reads.completed, 0u);
+    EXPECT_GT(reports[0].writes.completed, 0u);
+    EXPECT_EQ(reports[0].reads.failed + reports[0].writes.failed, 0u);
+
+    // 클라이언트당 초당 100회 × 2 × 0.3초 ≈ 60회 (스케줄 지연 허용)
+    EXPECT_EQ(reports[1].reads.completed, 0u);
+    EXPECT_GT(reports[1].writes.completed, 20u);
+    EXPECT_LT(reports[1].writes.completed, 80u);
+    EXPECT_EQ(reports[1].writes.failed, 0u);
+
+    EXPECT_EQ(writeCharacteristic->getValue().size(), 20u);
+}
+
+// ✅ 4. 알림(PropertiesChanged) 집계와 광고 등록/해제
+TEST_F(MockBluezTest, CountsNotificationsAndAdvertisements) {
+    startMock(MockBluez::Config());
+    createApplication();
+    ASSERT_TRUE(application->registerWithBlueZ());
+    ASSERT_TRUE(runUntil([this]() { return notifyCharacteristic->isNotifying(); }));
+
+    size_t before = pMock.load()->getNotificationCount();
+    notifyCharacteristic->setValue({42});
+    EXPECT_TRUE(runUntil([&]() { return pMock.load()->getNotificationCount() > before; }));
+
+    DBusObject advertisement(*appConnection, DBusObjectPath("/com/example/mock/advertisement0"));
+    ASSERT_TRUE(advertisement.addInterface(BlueZConstants::LE_ADVERTISEMENT_INTERFACE,
+                                           {{"Type", "s", true, false, false, []() { return g_variant_new_string("peripheral"); },
+                                             nullptr}}));
+    ASSERT_TRUE(advertisement.registerObject());
+
+    auto call = [this](const std::string& method) {
+        return appConnection->callMethod(
+            BlueZConstants::BLUEZ_SERVICE, DBusObjectPath(BlueZConstants::ADAPTER_PATH),
+            BlueZConstants::LE_ADVERTISING_MANAGER_INTERFACE, method,
+            makeGVariantPtr(g_variant_ref_sink(g_variant_new("(o@a{sv})", "/com/example/mock/advertisement0",
+                                                             g_variant_new_array(G_VARIANT_TYPE("{sv}"), nullptr, 0)))));
+    };
+    auto unregister = [this]() {
+        return appConnection->callMethod(
+            BlueZConstants::BLUEZ_SERVICE, DBusObjectPath(BlueZConstants::ADAPTER_PATH),
+            BlueZConstants::LE_ADVERTISING_MANAGER_INTERFACE, BlueZConstants::UNREGISTER_ADVERTISEMENT,
+            makeGVariantPtr(g_variant_ref_sink(g_variant_new("(o)", "/com/example/mock/advertisement0"))));
+    };
+
+    EXPECT_TRUE(call(BlueZConstants::REGISTER_ADVERTISEMENT) != nullptr);
+    EXPECT_EQ(pMock.load()->getAdvertisementCount(), 1u);
+    EXPECT_TRUE(call(BlueZConstants::REGISTER_ADVERTISEMENT) == nullptr);     // 중복 등록
+    EXPECT_TRUE(unregister() != nullptr);
+    EXPECT_EQ(pMock.load()->getAdvertisementCount(), 0u);
+    EXPECT_TRUE(unregister() == nullptr);
+}
+
+// ✅ 5. 응답 없는 쓰기(command)와 시각이 담긴 알림의 전달 지연
+TEST_F(MockBluezTest, SendsWriteCommandsAndMeasuresNotificationLag) {
+    MockBluez::Config config;
+    config.timestampedValues = true;
+    MockBluez::Phase phase;
+    ASSERT_TRUE(MockBluez::parsePhase("name=mixed,clients=2,rate=200,duration=0.3,read=20,command=50", phase));
+    config.phases.push_back(phase);
+    startMock(config);
+    createApplication();
+
+    auto service = std::make_shared<GattService>(*appConnection, DBusObjectPath("/com/example/mock/service1"),
+                                                 GattUuid::fromShortUuid(0x1815), true);
+    GattCharacteristicPtr commandCharacteristic = service->createCharacteristic(
+        GattUuid::fromShortUuid(0x2A56), GattProperty::PROP_WRITE_WITHOUT_RESPONSE, GattPermission::PERM_WRITE);
+    application->addService(service);
+    ASSERT_TRUE(application->registerWithBlueZ());
+
+    // 부하 중 5 ms마다 현재 steady_clock 시각을 알림
+    auto lastNotify = std::chrono::steady_clock::now();
+    ASSERT_TRUE(runUntil([&]() {
+        auto now = std::chrono::steady_clock::now();
+        if (notifyCharacteristic->isNotifying() && now - lastNotify >= std::chrono::milliseconds(5)) {
+            uint64_t stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+            std::vector<uint8_t> value(8);
+            for (size_t i = 0; i < value.size(); ++i) {
+                value[i] = static_cast<uint8_t>(stamp >> (8 * i));
+            }
+            notifyCharacteristic->setValue(value);
+            lastNotify = now;
+        }
+        return pMock.load()->isFinished();
+    }));
+
+    auto reports = pMock.load()->getReports();
+    ASSERT_EQ(reports.size(), 1u);
+    const MockBluez::Report& report = reports[0];
+    EXPECT_DOUBLE_EQ(report.targetRate, 400.0);
+    EXPECT_GT(report.commands, 0u);
+    EXPECT_GT(report.reads.completed, 0u);
+    EXPECT_GT(report.writes.completed, 0u);
+    EXPECT_EQ(report.reads.latency.count(), report.reads.completed + report.reads.failed);
+
+    EXPECT_GT(report.notificationLag.count(), 0u);
+    EXPECT_LE(report.notificationLag.count(), report.notifications);
+    EXPECT_LT(report.notificationLag.percentile(99), 1000000000u);
+
+    std::string json = MockBluez::toJson(report);
+    EXPECT_NE(json.find("\"phase\": \"mixed\""), std::string::npos);
+    EXPECT_NE(json.find("\"command\": {\"sent\": " + std::to_string(report.commands) + "}"), std::string::npos);
+    EXPECT_NE(json.find("\"p999_us\""), std::string::npos);
+
+    // 응답 없는 쓰기도 서버에 도달
+    EXPECT_TRUE(runUntil([&]() { return commandCharacteristic->getValue().size() == 20; }));
+}
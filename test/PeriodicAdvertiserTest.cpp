@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "../include/PeriodicAdvertiser.h"
+
+using namespace ggk;
+
+// ✅ 1. 파라미터 인코딩 (1.25 ms 단위 간격, TX power 포함 속성)
+TEST(PeriodicAdvertiserTest, EncodeParameters) {
+    PeriodicAdvertiser::Parameters parameters;
+    parameters.setIntervalMs(500, 1000);
+    parameters.includeTxPower = true;
+
+    auto encoded = PeriodicAdvertiser::encodeParameters(4, parameters);
+    ASSERT_EQ(encoded.size(), 7u);
+    EXPECT_EQ(encoded[0], 4);
+    EXPECT_EQ(encoded[1] | (encoded[2] << 8), 400);
+    EXPECT_EQ(encoded[3] | (encoded[4] << 8), 800);
+    EXPECT_EQ(encoded[5] | (encoded[6] << 8), PeriodicAdvertiser::kPropIncludeTxPower);
+}
+
+// ✅ 2. 주기적 광고 데이터는 252바이트 조각으로 분할 (Fragment_Preference 없음)
+TEST(PeriodicAdvertiserTest, FragmentData) {
+    std::vector<uint8_t> data(600, 0x5A);
+    auto commands = PeriodicAdvertiser::fragmentData(1, data.data(), data.size());
+
+    ASSERT_EQ(commands.size(), 3u);    // 252 + 252 + 96
+    EXPECT_EQ(commands[0].opcode, PeriodicAdvertiser::CMD_LE_SET_PERIODIC_ADV_DATA);
+    EXPECT_EQ(commands[0].parameters[1], ExtendedAdvertiser::kOperationFirst);
+    EXPECT_EQ(commands[0].parameters[2], 252);
+    EXPECT_EQ(commands[1].parameters[1], ExtendedAdvertiser::kOperationIntermediate);
+    EXPECT_EQ(commands[2].parameters[1], ExtendedAdvertiser::kOperationLast);
+    EXPECT_EQ(commands[2].parameters[2], 96);
+    EXPECT_EQ(commands[2].parameters.size(), 3u + 96u);
+
+    auto single = PeriodicAdvertiser::fragmentData(1, data.data(), 20);
+    ASSERT_EQ(single.size(), 1u);
+    EXPECT_EQ(single[0].parameters[1], ExtendedAdvertiser::kOperationComplete);
+}
+
+// ✅ 3. 컨트롤러 없이는 트레인을 만들 수 없고 알 수 없는 핸들은 거부됨
+TEST(PeriodicAdvertiserTest, RequiresTrain) {
+    HciAdapter adapter;
+    ExtendedAdvertiser advertiser(adapter);
+    PeriodicAdvertiser periodic(advertiser);
+
+    PeriodicAdvertiser::Parameters invalid;
+    invalid.minInterval = 0x0002;
+    EXPECT_EQ(periodic.createTrain(invalid), -1);
+    EXPECT_EQ(periodic.createTrain(PeriodicAdvertiser::Parameters()), -1);
+
+    EXPECT_EQ(periodic.getDataSource(0), nullptr);
+    EXPECT_FALSE(periodic.setData(0, {0x01}));
+    EXPECT_FALSE(periodic.enable(0));
+
+    PeriodicAdvertiser::Statistics statistics;
+    EXPECT_FALSE(periodic.getStatistics(0, statistics));
+}
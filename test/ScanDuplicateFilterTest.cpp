@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "../include/ScanDuplicateFilter.h"
+
+using namespace ggk;
+
+namespace {
+
+const uint8_t kAddress[6] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+
+} // namespace
+
+// ✅ 1. TTL 안에서는 중복, TTL이 지나면 다시 통과
+TEST(ScanDuplicateFilterTest, TtlExpiry) {
+    ScanDuplicateFilter filter(64, std::chrono::milliseconds(100));
+    const uint8_t data[] = {0x02, 0x01, 0x06};
+    uint64_t digest = ScanDuplicateFilter::digest(0, kAddress, data, sizeof(data));
+
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_FALSE(filter.isDuplicate(digest, now));
+    EXPECT_TRUE(filter.isDuplicate(digest, now + std::chrono::milliseconds(50)));
+    EXPECT_FALSE(filter.isDuplicate(digest, now + std::chrono::milliseconds(150)));
+    EXPECT_TRUE(filter.isDuplicate(digest, now + std::chrono::milliseconds(200)));
+
+    filter.clear();
+    EXPECT_FALSE(filter.isDuplicate(digest, now + std::chrono::milliseconds(200)));
+}
+
+// ✅ 2. 페이로드나 주소 종류가 바뀌면 다른 보고서로 취급
+TEST(ScanDuplicateFilterTest, DigestCoversPayloadAndAddressType) {
+    const uint8_t first[] = {0x03, 0xFF, 0x01, 0x00};
+    const uint8_t second[] = {0x03, 0xFF, 0x01, 0x01};
+
+    uint64_t a = ScanDuplicateFilter::digest(0, kAddress, first, sizeof(first));
+    EXPECT_NE(a, ScanDuplicateFilter::digest(0, kAddress, second, sizeof(second)));
+    EXPECT_NE(a, ScanDuplicateFilter::digest(1, kAddress, first, sizeof(first)));
+    EXPECT_NE(ScanDuplicateFilter::digest(0, kAddress, nullptr, 0), 0u);
+}
+
+// ✅ 3. 테이블이 가득 차도 메모리는 고정, 최근 항목은 계속 걸러짐
+TEST(ScanDuplicateFilterTest, BoundedTable) {
+    ScanDuplicateFilter filter(16, std::chrono::seconds(10));
+    auto now = std::chrono::steady_clock::now();
+
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        EXPECT_FALSE(filter.isDuplicate(i * 0x9E3779B97F4A7C15ULL, now + std::chrono::microseconds(i)));
+    }
+    EXPECT_TRUE(filter.isDuplicate(1000 * 0x9E3779B97F4A7C15ULL, now + std::chrono::milliseconds(2)));
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../include/SpscRing.h"
+
+using namespace ggk;
+
+// ✅ 1. FIFO 순서와 가득 찬 링 처리
+TEST(SpscRingTest, OrderAndCapacity) {
+    SpscRing<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_FALSE(ring.push(4));
+    EXPECT_EQ(ring.size(), 4u);
+
+    int value = -1;
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 0);
+    ASSERT_NE(ring.front(), nullptr);
+    EXPECT_EQ(*ring.front(), 1);
+    ring.discard();
+
+    EXPECT_TRUE(ring.pushWith([](int& slot) { slot = 42; }));
+    for (int expected : {2, 3, 42}) {
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(ring.pop(value));
+}
+
+// ✅ 2. 생산자/소비자 스레드 간 전달 시 손실이나 순서 뒤바뀜이 없음
+TEST(SpscRingTest, ProducerConsumer) {
+    static SpscRing<uint32_t, 256> ring;
+    const uint32_t count = 20000;
+
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < count; ) {
+            if (ring.push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t outOfOrder = 0;
+    while (expected < count) {
+        uint32_t value;
+        if (ring.pop(value)) {
+            outOfOrder += value != expected ? 1 : 0;
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_EQ(outOfOrder, 0u);
+    EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "../include/StartupProfiler.h"
+
+using namespace ggk;
+
+namespace {
+
+const StartupProfiler::Phase* findPhase(const std::vector<StartupProfiler::Phase>& phases, const std::string& name) {
+    for (const StartupProfiler::Phase& phase : phases) {
+        if (phase.name == name) {
+            return &phase;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// ✅ 1. 중첩된 단계는 깊이와 시작 순서대로 기록되고, 바깥 단계가 안쪽 단계를 포함함
+TEST(StartupProfilerTest, NestedScopesKeepDepthAndOrder) {
+    StartupProfiler::begin();
+    {
+        StartupProfiler::Scope outer("gatt", "register_application");
+        {
+            StartupProfiler::Scope inner("gatt", "setup_interfaces");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        StartupProfiler::Scope call("gatt", "register_call");
+    }
+    StartupProfiler::finish();
+
+    std::vector<StartupProfiler::Phase> phases = StartupProfiler::getPhases();
+    ASSERT_EQ(phases.size(), 3u);
+    EXPECT_EQ(phases[0].name, "register_application");
+    EXPECT_EQ(phases[0].depth, 0u);
+    EXPECT_EQ(phases[1].name, "setup_interfaces");
+    EXPECT_EQ(phases[1].depth, 1u);
+    EXPECT_EQ(phases[2].name, "register_call");
+    EXPECT_EQ(phases[2].depth, 1u);
+
+    EXPECT_GE(phases[1].durationNs, 2000000u);
+    EXPECT_GE(phases[0].durationNs, phases[1].durationNs + phases[2].durationNs);
+    EXPECT_LE(phases[1].startNs + phases[1].durationNs, phases[2].startNs);
+    EXPECT_EQ(StartupProfiler::getElapsedNs(), phases[0].startNs + phases[0].durationNs);
+}
+
+// ✅ 2. 누적 항목은 (component, name)마다 하나로 합쳐지고 호출 횟수를 셈
+TEST(StartupProfilerTest, AccumulatorMergesCalls) {
+    StartupProfiler::begin();
+    {
+        StartupProfiler::Scope scope("gatt", "build_tree");
+        for (int i = 0; i < 100; ++i) {
+            StartupProfiler::Accumulator xml("dbus", "introspection_xml");
+            StartupProfiler::Accumulator registration("dbus", "register_object");
+        }
+    }
+    StartupProfiler::finish();
+
+    std::vector<StartupProfiler::Phase> phases = StartupProfiler::getPhases();
+    ASSERT_EQ(phases.size(), 3u);
+    const StartupProfiler::Phase* pXml = findPhase(phases, "introspection_xml");
+    const StartupProfiler::Phase* pRegistration = findPhase(phases, "register_object");
+    ASSERT_NE(pXml, nullptr);
+    ASSERT_NE(pRegistration, nullptr);
+    EXPECT_EQ(pXml->count, 100u);
+    EXPECT_EQ(pXml->depth, 1u);
+    EXPECT_EQ(pRegistration->count, 100u);
+    EXPECT_EQ(pRegistration->depth, 2u);
+    EXPECT_LE(pXml->durationNs, findPhase(phases, "build_tree")->durationNs);
+}
+
+// ✅ 3. finish() 이후의 단계는 기록되지 않고, begin()은 새 보고서를 시작함
+TEST(StartupProfilerTest, FinishStopsRecording) {
+    StartupProfiler::begin();
+    EXPECT_TRUE(StartupProfiler::isRecording());
+    {
+        StartupProfiler::Scope scope("server", "initialize");
+    }
+    StartupProfiler::mark("server", "advertising");
+    StartupProfiler::finish();
+    EXPECT_FALSE(StartupProfiler::isRecording());
+
+    {
+        StartupProfiler::Scope late("gatt", "register_application");
+        StartupProfiler::Accumulator lateObject("dbus", "register_object");
+    }
+    StartupProfiler::mark("server", "late");
+
+    std::vector<StartupProfiler::Phase> phases = StartupProfiler::getPhases();
+    ASSERT_EQ(phases.size(), 2u);
+    EXPECT_EQ(phases[0].name, "initialize");
+    EXPECT_EQ(phases[1].name, "advertising");
+    EXPECT_EQ(phases[1].durationNs, 0u);
+    EXPECT_GE(phases[1].startNs, phases[0].startNs + phases[0].durationNs);
+
+    StartupProfiler::begin();
+    EXPECT_TRUE(StartupProfiler::getPhases().empty());
+    StartupProfiler::finish();
+}
+
+// ✅ 4. 보고서와 JSON에 모든 단계와 실패 여부가 들어감
+TEST(StartupProfilerTest, ReportAndJsonListPhases) {
+    StartupProfiler::begin();
+    {
+        StartupProfiler::Scope scope("hci", "initialize");
+        StartupProfiler::Scope open("hci", "open_socket");
+        open.fail();
+    }
+    for (int i = 0; i < 3; ++i) {
+        StartupProfiler::Accumulator registration("dbus", "register_object");
+    }
+    StartupProfiler::finish();
+
+    std::string report = StartupProfiler::formatReport();
+    EXPECT_NE(report.find("Startup report:"), std::string::npos);
+    EXPECT_NE(report.find("hci/initialize"), std::string::npos);
+    EXPECT_NE(report.find("  hci/open_socket (failed)"), std::string::npos);
+    EXPECT_NE(report.find("dbus/register_object"), std::string::npos);
+
+    std::string json = StartupProfiler::toJson();
+    EXPECT_EQ(json.rfind("{\"total_ms\": ", 0), 0u);
+    EXPECT_NE(json.find("\"finished\": true"), std::string::npos);
+    EXPECT_NE(json.find("\"component\": \"hci\", \"name\": \"open_socket\""), std::string::npos);
+    EXPECT_NE(json.find("\"depth\": 1, \"ok\": false"), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"register_object\""), std::string::npos);
+    EXPECT_NE(json.find("\"count\": 3"), std::string::npos);
+    EXPECT_EQ(json.back(), '}');
+}
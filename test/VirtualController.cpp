@@ -0,0 +1,315 @@
+#include "VirtualController.h"
+#include "HciEventDecoder.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace ggk {
+
+namespace {
+
+// vhci 생성 요청의 장치 타입 (HCI_PRIMARY)
+const uint8_t kVhciPrimary = 0x00;
+
+// 알 수 없는 명령의 반환 파라미터는 0으로 채움 - 커널은 명령별 최소 길이를 확인하고 남는 바이트는 무시함
+const size_t kDefaultReturnPadding = 32;
+
+const size_t kMaxPacketSize = 1100;
+const int kPollIntervalMS = 50;
+
+} // namespace
+
+VirtualController::VirtualController()
+    : fd(-1)
+    , deviceIndex(0)
+    , commandCount(0)
+    , aclPacketCount(0)
+    , running(false) {
+    setDefaultResponses();
+}
+
+VirtualController::~VirtualController() {
+    close();
+}
+
+bool VirtualController::isAvailable() {
+    return access(kDevicePath, R_OK | W_OK) == 0;
+}
+
+// 커널 초기화 시퀀스가 LE 전용 5.0 컨트롤러로 인식하도록 하는 응답
+void VirtualController::setDefaultResponses() {
+    // Read Local Version: HCI 5.0, Linux Foundation
+    setResponse(0x1001, 0x00, {0x09, 0x00, 0x00, 0x09, 0xF1, 0x05, 0x00, 0x00});
+    // Read Local Supported Commands: 지원 명령 비트맵 없음 (커널이 선택적 명령을 건너뜀)
+    setResponse(0x1002, 0x00, std::vector<uint8_t>(64, 0x00));
+    // Read Local Supported Features: LE Supported (Controller), BR/EDR Not Supported
+    setResponse(0x1003, 0x00, {0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00});
+    // Read Buffer Size: ACL 1021 x 8, SCO 없음
+    setResponse(0x1005, 0x00, {0xFD, 0x03, 0x00, 0x08, 0x00, 0x00, 0x00});
+    // Read BD_ADDR
+    setResponse(0x1009, 0x00, {0x01, 0x00, 0x00, 0xA0, 0xFE, 0xCA});
+    // Read Local Name
+    setResponse(0x0C14, 0x00, std::vector<uint8_t>(248, 0x00));
+    // LE Read Buffer Size: 251 x 8
+    setResponse(0x2002, 0x00, {0xFB, 0x00, 0x08});
+    // LE Read Local Supported Features: Data Packet Length Extension, 2M PHY, Coded PHY, Extended Advertising
+    setResponse(0x2003, 0x00, {0x20, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    // LE Read Maximum Data Length: 251 / 2120 us
+    setResponse(0x202F, 0x00, {0xFB, 0x00, 0x48, 0x08, 0xFB, 0x00, 0x48, 0x08});
+
+    // 완료 이벤트가 따로 오는 명령 (Disconnect, LE Connection Update, LE Read Remote Features, LE Set PHY)
+    setStatusResponse(0x0406);
+    setStatusResponse(0x2013);
+    setStatusResponse(0x2016);
+    setStatusResponse(0x2032);
+}
+
+void VirtualController::setResponse(uint16_t opcode, uint8_t status, std::vector<uint8_t> returnParameters) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    Response& response = responses[opcode];
+    response.commandStatus = false;
+    response.status = status;
+    response.returnParameters = std::move(returnParameters);
+}
+
+void VirtualController::setStatusResponse(uint16_t opcode, uint8_t status) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    Response& response = responses[opcode];
+    response.commandStatus = true;
+    response.status = status;
+    response.returnParameters.clear();
+}
+
+void VirtualController::setCommandObserver(CommandObserver newObserver) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    observer = std::move(newObserver);
+}
+
+bool VirtualController::open() {
+    close();
+
+    fd = ::open(kDevicePath, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        Logger::error(std::string("Failed to open ") + kDevicePath + ": " + strerror(errno));
+        return false;
+    }
+
+    // 생성 요청 [0xFF][장치 타입] -> 응답 [0xFF][장치 타입][index(2)]
+    const uint8_t request[] = {kH4Vendor, kVhciPrimary};
+    if (::write(fd, request, sizeof(request)) != static_cast<ssize_t>(sizeof(request))) {
+        Logger::error(std::string("Failed to create virtual controller: ") + strerror(errno));
+        close();
+        return false;
+    }
+
+    struct pollfd pfd = {fd, POLLIN, 0};
+    uint8_t response[4];
+    if (poll(&pfd, 1, kCreateTimeoutMS) <= 0 || ::read(fd, response, sizeof(response)) != sizeof(response) ||
+        response[0] != kH4Vendor) {
+        Logger::error("Virtual controller was not registered by the kernel");
+        close();
+        return false;
+    }
+
+    deviceIndex = static_cast<uint16_t>(response[2] | (response[3] << 8));
+
+    running = true;
+    responderThread = std::thread(&VirtualController::run, this);
+
+    Logger::info("Virtual controller registered as hci" + std::to_string(deviceIndex));
+    return true;
+}
+
+// 디스크립터를 닫으면 커널이 hciN을 제거함
+void VirtualController::close() {
+    running = false;
+    if (responderThread.joinable()) {
+        responderThread.join();
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+uint64_t VirtualController::getCommandCount(uint16_t opcode) const {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    auto it = commandsReceived.find(opcode);
+    return it != commandsReceived.end() ? it->second : 0;
+}
+
+bool VirtualController::waitForCommand(uint16_t opcode, uint64_t count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(scriptMutex);
+    return commandCondition.wait_for(lock, timeout, [this, opcode, count] {
+        auto it = commandsReceived.find(opcode);
+        return it != commandsReceived.end() && it->second >= count;
+    });
+}
+
+bool VirtualController::writePacket(const uint8_t* pData, size_t size) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (fd < 0) {
+        return false;
+    }
+    return ::write(fd, pData, size) == static_cast<ssize_t>(size);
+}
+
+// [H4 event][event code][length][parameters]
+bool VirtualController::injectEvent(uint8_t eventCode, const std::vector<uint8_t>& parameters) {
+    if (parameters.size() > 255) {
+        return false;
+    }
+
+    uint8_t packet[3 + 255];
+    packet[0] = kH4Event;
+    packet[1] = eventCode;
+    packet[2] = static_cast<uint8_t>(parameters.size());
+    if (!parameters.empty()) {
+        memcpy(packet + 3, parameters.data(), parameters.size());
+    }
+    return writePacket(packet, 3 + parameters.size());
+}
+
+bool VirtualController::injectLeMetaEvent(uint8_t subeventCode, const std::vector<uint8_t>& parameters) {
+    std::vector<uint8_t> event;
+    event.reserve(parameters.size() + 1);
+    event.push_back(subeventCode);
+    event.insert(event.end(), parameters.begin(), parameters.end());
+    return injectEvent(EVT_LE_META, event);
+}
+
+// [status][handle(2)][role][peer address type][peer address(6)][interval(2)][latency(2)][timeout(2)][clock accuracy]
+bool VirtualController::injectLeConnectionComplete(uint16_t handle, const uint8_t* pAddress, uint16_t interval) {
+    std::vector<uint8_t> parameters;
+    parameters.push_back(0x00);
+    hciAppendLe16(parameters, handle);
+    parameters.push_back(0x01);         // peripheral
+    parameters.push_back(0x00);
+    parameters.insert(parameters.end(), pAddress, pAddress + 6);
+    hciAppendLe16(parameters, interval);
+    hciAppendLe16(parameters, 0);
+    hciAppendLe16(parameters, 400);           // 4 s
+    parameters.push_back(0x00);
+    return injectLeMetaEvent(LE_CONNECTION_COMPLETE, parameters);
+}
+
+bool VirtualController::injectDisconnectionComplete(uint16_t handle, uint8_t reason) {
+    std::vector<uint8_t> parameters;
+    parameters.push_back(0x00);
+    hciAppendLe16(parameters, handle);
+    parameters.push_back(reason);
+    return injectEvent(EVT_DISCONNECTION_COMPLETE, parameters);
+}
+
+bool VirtualController::injectNumberOfCompletedPackets(uint16_t handle, uint16_t count) {
+    std::vector<uint8_t> parameters;
+    parameters.push_back(0x01);
+    hciAppendLe16(parameters, handle);
+    hciAppendLe16(parameters, count);
+    return injectEvent(EVT_NUMBER_OF_COMPLETED_PACKETS, parameters);
+}
+
+// [num reports][event type][address type][address(6)][data length][data][rssi]
+bool VirtualController::injectAdvertisingReport(uint8_t addressType, const uint8_t* pAddress, const uint8_t* pData,
+                                                uint8_t size, int8_t rssi) {
+    std::vector<uint8_t> parameters;
+    parameters.reserve(11 + size);
+    parameters.push_back(0x01);
+    parameters.push_back(0x00);         // ADV_IND
+    parameters.push_back(addressType);
+    parameters.insert(parameters.end(), pAddress, pAddress + 6);
+    parameters.push_back(size);
+    parameters.insert(parameters.end(), pData, pData + size);
+    parameters.push_back(static_cast<uint8_t>(rssi));
+    return injectLeMetaEvent(LE_ADVERTISING_REPORT, parameters);
+}
+
+// [H4 command][opcode(2)][length][parameters]
+void VirtualController::handleCommand(const uint8_t* pPacket, size_t size) {
+    if (size < 4) {
+        return;
+    }
+
+    uint16_t opcode = static_cast<uint16_t>(pPacket[1] | (pPacket[2] << 8));
+    const uint8_t* pParameters = pPacket + 4;
+    size_t parameterSize = std::min<size_t>(pPacket[3], size - 4);
+
+    Response response;
+    CommandObserver currentObserver;
+    {
+        std::lock_guard<std::mutex> lock(scriptMutex);
+        auto it = responses.find(opcode);
+        if (it != responses.end()) {
+            response = it->second;
+        } else {
+            response.returnParameters.assign(kDefaultReturnPadding, 0x00);
+        }
+        currentObserver = observer;
+    }
+
+    std::vector<uint8_t> event;
+    if (response.commandStatus) {
+        // [status][num HCI command packets][opcode(2)]
+        event = {response.status, 0x01};
+        hciAppendLe16(event, opcode);
+        injectEvent(EVT_COMMAND_STATUS, event);
+    } else {
+        // [num HCI command packets][opcode(2)][status][return parameters]
+        event.push_back(0x01);
+        hciAppendLe16(event, opcode);
+        event.push_back(response.status);
+        event.insert(event.end(), response.returnParameters.begin(), response.returnParameters.end());
+        injectEvent(EVT_COMMAND_COMPLETE, event);
+    }
+
+    // 응답 후에 집계해야 waitForCommand() 뒤 바로 결과를 확인할 수 있음
+    ++commandCount;
+    {
+        std::lock_guard<std::mutex> lock(scriptMutex);
+        ++commandsReceived[opcode];
+    }
+    commandCondition.notify_all();
+
+    if (currentObserver) {
+        currentObserver(opcode, pParameters, parameterSize);
+    }
+}
+
+void VirtualController::run() {
+    uint8_t packet[kMaxPacketSize];
+
+    while (running) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        int result = poll(&pfd, 1, kPollIntervalMS);
+        if (result <= 0) {
+            continue;
+        }
+
+        ssize_t length = ::read(fd, packet, sizeof(packet));
+        if (length <= 0) {
+            if (length < 0 && errno != EINTR && errno != EAGAIN) {
+                Logger::error(std::string("Virtual controller read failed: ") + strerror(errno));
+                break;
+            }
+            continue;
+        }
+
+        switch (packet[0]) {
+        case kH4Command:
+            handleCommand(packet, static_cast<size_t>(length));
+            break;
+        case kH4Acl:
+            ++aclPacketCount;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+} // namespace ggk
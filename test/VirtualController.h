@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ggk {
+
+// Scriptable virtual Bluetooth controller backed by /dev/vhci
+//
+// Opening /dev/vhci makes the kernel register a new hciN whose "hardware" is this process: every H4 packet the host sends (the
+// kernel's own init sequence included) is read from the descriptor, and every packet written to it is received as if it came
+// from a controller. A responder thread answers each command with Command Complete (or Command Status for the commands that
+// use it), using the return parameters scripted with `setResponse()`; tests and benchmarks inject connection, completed-packets
+// and advertising events on top of that. This lets HciAdapter, the command queue and the event decoder run end to end without a
+// radio.
+//
+// Requires root (or CAP_NET_ADMIN) and the hci_vhci module; `isAvailable()` tells whether /dev/vhci can be opened.
+class VirtualController {
+public:
+    static constexpr const char* kDevicePath = "/dev/vhci";
+    static constexpr int kCreateTimeoutMS = 2000;
+
+    static constexpr uint8_t kH4Command = 0x01;
+    static constexpr uint8_t kH4Acl = 0x02;
+    static constexpr uint8_t kH4Event = 0x04;
+    static constexpr uint8_t kH4Vendor = 0xFF;
+
+    static constexpr uint8_t EVT_DISCONNECTION_COMPLETE = 0x05;
+    static constexpr uint8_t EVT_COMMAND_COMPLETE = 0x0E;
+    static constexpr uint8_t EVT_COMMAND_STATUS = 0x0F;
+    static constexpr uint8_t EVT_NUMBER_OF_COMPLETED_PACKETS = 0x13;
+    static constexpr uint8_t EVT_LE_META = 0x3E;
+
+    static constexpr uint8_t LE_CONNECTION_COMPLETE = 0x01;
+    static constexpr uint8_t LE_ADVERTISING_REPORT = 0x02;
+
+    // Called on the responder thread after a command has been answered (e.g. to follow LE Set PHY with PHY Update Complete)
+    using CommandObserver = std::function<void(uint16_t opcode, const uint8_t* pParameters, size_t size)>;
+
+    VirtualController();
+    ~VirtualController();
+
+    VirtualController(const VirtualController&) = delete;
+    VirtualController& operator=(const VirtualController&) = delete;
+
+    static bool isAvailable();
+
+    // Registers the controller with the kernel and starts answering commands
+    bool open();
+    void close();
+    bool isOpen() const { return fd >= 0; }
+
+    // Index of the hciN device created by `open()`
+    uint16_t getDeviceIndex() const { return deviceIndex; }
+
+    // Command Complete returned for `opcode` (status + return parameters)
+    void setResponse(uint16_t opcode, uint8_t status, std::vector<uint8_t> returnParameters = {});
+
+    // Answers `opcode` with Command Status instead of Command Complete
+    void setStatusResponse(uint16_t opcode, uint8_t status = 0x00);
+
+    void setCommandObserver(CommandObserver observer);
+
+    // Event injection (controller to host)
+    bool injectEvent(uint8_t eventCode, const std::vector<uint8_t>& parameters);
+    bool injectLeMetaEvent(uint8_t subeventCode, const std::vector<uint8_t>& parameters);
+    bool injectLeConnectionComplete(uint16_t handle, const uint8_t* pAddress, uint16_t interval = 0x0018);
+    bool injectDisconnectionComplete(uint16_t handle, uint8_t reason = 0x13);
+    bool injectNumberOfCompletedPackets(uint16_t handle, uint16_t count);
+    bool injectAdvertisingReport(uint8_t addressType, const uint8_t* pAddress, const uint8_t* pData, uint8_t size,
+                                 int8_t rssi = -60);
+
+    // Commands / ACL packets received from the host
+    uint64_t getCommandCount() const { return commandCount.load(); }
+    uint64_t getCommandCount(uint16_t opcode) const;
+    uint64_t getAclPacketCount() const { return aclPacketCount.load(); }
+
+    // Waits until `opcode` has been received at least `count` times
+    bool waitForCommand(uint16_t opcode, uint64_t count = 1, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+private:
+    struct Response {
+        bool commandStatus = false;
+        uint8_t status = 0x00;
+        std::vector<uint8_t> returnParameters;
+    };
+
+    void setDefaultResponses();
+    bool writePacket(const uint8_t* pData, size_t size);
+    void handleCommand(const uint8_t* pPacket, size_t size);
+    void run();
+
+    int fd;
+    uint16_t deviceIndex;
+
+    std::map<uint16_t, Response> responses;
+    std::map<uint16_t, uint64_t> commandsReceived;
+    CommandObserver observer;
+    mutable std::mutex scriptMutex;
+    std::condition_variable commandCondition;
+
+    std::mutex writeMutex;              // 응답 스레드와 주입 스레드의 쓰기 직렬화
+
+    std::atomic<uint64_t> commandCount;
+    std::atomic<uint64_t> aclPacketCount;
+
+    std::atomic<bool> running;
+    std::thread responderThread;
+};
+
+} // namespace ggk
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "VirtualController.h"
+#include "../include/HciAdapter.h"
+
+using namespace ggk;
+
+// /dev/vhci 가상 컨트롤러로 HciAdapter 전체 경로를 검증 (root 권한과 hci_vhci 모듈 필요, 없으면 건너뜀)
+class VirtualControllerTest : public ::testing::Test {
+protected:
+    VirtualController controller;
+
+    void SetUp() override {
+        if (!VirtualController::isAvailable()) {
+            GTEST_SKIP() << VirtualController::kDevicePath << " is not available";
+        }
+        if (!controller.open()) {
+            GTEST_SKIP() << "Cannot create a virtual controller (root required)";
+        }
+    }
+
+    template <typename Predicate>
+    static bool waitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+// ✅ 1. 초기화 시 스크립트된 LE 버퍼 크기를 읽음
+TEST_F(VirtualControllerTest, InitializeReadsBufferSize) {
+    controller.setResponse(AclFlowControl::CMD_LE_READ_BUFFER_SIZE, 0x00, {0x1B, 0x00, 0x03});
+
+    HciAdapter adapter(controller.getDeviceIndex());
+    ASSERT_TRUE(adapter.initialize());
+
+    EXPECT_EQ(adapter.getAclFlowControl().getPacketLength(), 27);
+    EXPECT_EQ(adapter.getAclFlowControl().getTotalPackets(), 3);
+    adapter.stop();
+}
+
+// ✅ 2. 명령 응답의 반환 파라미터가 명령 큐 결과로 전달됨
+TEST_F(VirtualControllerTest, ScriptedCommandResponse) {
+    const uint16_t vendorOpcode = 0xFC01;
+    controller.setResponse(vendorOpcode, 0x00, {0x01, 0x02, 0x03});
+    controller.setResponse(HciAdapter::CMD_SET_ADVERTISING, 0x0C);
+
+    HciAdapter adapter(controller.getDeviceIndex());
+    ASSERT_TRUE(adapter.initialize());
+
+    HciCommandResult result = adapter.sendCommandSync(vendorOpcode, {0xAA});
+    EXPECT_TRUE(result.succeeded());
+    EXPECT_EQ(result.returnParameters, std::vector<uint8_t>({0x01, 0x02, 0x03}));
+
+    EXPECT_FALSE(adapter.setAdvertisingEnabled(true));     // Command Disallowed
+    EXPECT_TRUE(controller.waitForCommand(HciAdapter::CMD_SET_ADVERTISING));
+    adapter.stop();
+}
+
+// ✅ 3. 연결 이벤트와 Number of Completed Packets로 ACL 크레딧이 반환됨
+TEST_F(VirtualControllerTest, CompletedPacketsReleaseCredits) {
+    controller.setResponse(AclFlowControl::CMD_LE_READ_BUFFER_SIZE, 0x00, {0xFB, 0x00, 0x04});
+
+    HciAdapter adapter(controller.getDeviceIndex());
+    ASSERT_TRUE(adapter.initialize());
+    AclFlowControl& flowControl = adapter.getAclFlowControl();
+
+    const uint8_t address[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+    ASSERT_TRUE(controller.injectLeConnectionComplete(0x0040, address));
+    ASSERT_TRUE(waitUntil([&] { return adapter.getConnectionTracker().connectionCount() == 1; }));
+
+    flowControl.packetsQueued(0x0040, 4);
+    EXPECT_FALSE(flowControl.hasCredit(0x0040));
+
+    ASSERT_TRUE(controller.injectNumberOfCompletedPackets(0x0040, 3));
+    EXPECT_TRUE(flowControl.waitForCredit(0x0040, std::chrono::milliseconds(1000)));
+
+    AclFlowControl::ConnectionCredits credits;
+    ASSERT_TRUE(flowControl.getCredits(0x0040, credits));
+    EXPECT_EQ(credits.outstanding, 1u);
+
+    ASSERT_TRUE(controller.injectDisconnectionComplete(0x0040));
+    EXPECT_TRUE(waitUntil([&] { return adapter.getConnectionTracker().connectionCount() == 0; }));
+    adapter.stop();
+}
+
+// ✅ 4. 주입한 광고 보고서가 모두 디코더 핸들러에 도달함
+TEST_F(VirtualControllerTest, AdvertisingReportsReachDecoder) {
+    HciAdapter adapter(controller.getDeviceIndex());
+    std::atomic<int> reports(0);
+    adapter.getEventDecoder().onLeAdvertisingReport([&](const HciLeAdvertisingReportView& report) {
+        if (report.data().size == 3) {
+            ++reports;
+        }
+    });
+    ASSERT_TRUE(adapter.initialize());
+
+    const uint8_t address[6] = {0x01, 0x02, 0x03, 0x04, 0x05, 0xC6};
+    const uint8_t data[] = {0x02, 0x01, 0x06};
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(controller.injectAdvertisingReport(0x01, address, data, sizeof(data)));
+    }
+
+    EXPECT_TRUE(waitUntil([&] { return reports.load() == 100; }));
+    adapter.stop();
+}
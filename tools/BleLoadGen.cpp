@@ -0,0 +1,378 @@
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DBusConnection.h"
+#include "GattApplication.h"
+#include "GattCharacteristic.h"
+#include "GattService.h"
+#include "Logger.h"
+#include "MockBluez.h"
+
+using namespace ggk;
+
+// ble_loadgen: end-to-end GATT load generator
+//
+//   ble_loadgen [--address ADDRESS] [--services N] [--characteristics N] [--value-size BYTES] [--notify-rate HZ]
+//               [--json FILE] [--phase SPEC]...
+//
+// Builds a GattApplication in this process and drives it through MockBluez the way bluetoothd would for many connected
+// devices: reads, write requests and write commands at the rates and mix of each phase, while the server side notifies on
+// every subscribed characteristic at --notify-rate. Notified values start with a steady_clock timestamp, so the report has
+// the notification delivery lag next to the request latencies. Every characteristic can be read, written (with and without
+// response) and notify, so the phase mix alone decides the load.
+//
+// Without --address both ends share a peer-to-peer connection: no daemon, only the cost of GDBus and the GATT objects. With
+// the address of a private dbus-daemon each end gets its own connection and the numbers include the daemon hop, as with
+// BlueZ:
+//
+//   dbus-daemon --session --fork --print-address
+//   ble_loadgen --address unix:abstract=/tmp/dbus-XXXX --phase clients=1,duration=5 --phase clients=64,rate=20,duration=10
+//
+// --json writes one object per phase with throughput and p50/p99/p999 latencies ("-" for stdout).
+
+namespace {
+
+struct Options {
+    const char* pAddress = nullptr;
+    size_t services = 4;
+    size_t characteristicsPerService = 4;
+    size_t valueSize = 20;
+    double notifyRate = 10;             // 특성당 초당 알림
+    std::string jsonPath;
+    std::vector<MockBluez::Phase> phases;
+};
+
+std::atomic<bool> interrupted{false};
+
+void onSignal(int) {
+    interrupted = true;
+}
+
+void usage(const char* pProgram) {
+    fprintf(stderr,
+            "usage: %s [--address ADDRESS] [--services N] [--characteristics N] [--value-size BYTES] [--notify-rate HZ]\n"
+            "          [--json FILE] [--phase SPEC]...\n"
+            "  SPEC: name=N,clients=N,rate=REQ_PER_S,duration=S,read=PERCENT,command=PERCENT,size=BYTES,mtu=N\n",
+            pProgram);
+}
+
+bool parseCount(const char* pText, size_t minimum, size_t maximum, size_t& value) {
+    char* pEnd = nullptr;
+    unsigned long parsed = strtoul(pText, &pEnd, 10);
+    if (*pText == '\0' || *pEnd != '\0' || parsed < minimum || parsed > maximum) {
+        fprintf(stderr, "Invalid number: %s (%zu-%zu)\n", pText, minimum, maximum);
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        bool ok = true;
+        if (strcmp(argv[i], "--address") == 0 && i + 1 < argc) {
+            options.pAddress = argv[++i];
+        } else if (strcmp(argv[i], "--services") == 0 && i + 1 < argc) {
+            ok = parseCount(argv[++i], 1, 1000, options.services);
+        } else if (strcmp(argv[i], "--characteristics") == 0 && i + 1 < argc) {
+            ok = parseCount(argv[++i], 1, 1000, options.characteristicsPerService);
+        } else if (strcmp(argv[i], "--value-size") == 0 && i + 1 < argc) {
+            ok = parseCount(argv[++i], sizeof(uint64_t), 512, options.valueSize);     // 앞 8바이트는 시각
+        } else if (strcmp(argv[i], "--notify-rate") == 0 && i + 1 < argc) {
+            char* pEnd = nullptr;
+            options.notifyRate = strtod(argv[++i], &pEnd);
+            ok = *pEnd == '\0' && options.notifyRate >= 0;
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--phase") == 0 && i + 1 < argc) {
+            MockBluez::Phase phase;
+            ok = MockBluez::parsePhase(argv[++i], phase);
+            options.phases.push_back(phase);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return false;
+        }
+    }
+
+    if (options.phases.empty()) {
+        MockBluez::Phase phase;
+        phase.name = "default";
+        phase.clients = 8;
+        phase.durationSeconds = 10;
+        options.phases.push_back(phase);
+    }
+    return true;
+}
+
+void infoLogger(const char* pText) {
+    std::cerr << pText << std::endl;
+}
+
+bool connectToBus(const char* pAddress, GDBusConnectionPtr& connection) {
+    GError* pError = nullptr;
+    GDBusConnection* pConnection = g_dbus_connection_new_for_address_sync(
+        pAddress,
+        static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                          G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+        nullptr, nullptr, &pError);
+    if (pConnection == nullptr) {
+        fprintf(stderr, "Cannot connect to %s: %s\n", pAddress, pError->message);
+        g_error_free(pError);
+        return false;
+    }
+    connection = makeGDBusConnectionPtr(pConnection);
+    return true;
+}
+
+// 서비스 N개 × 특성 M개, 모든 특성이 읽기/쓰기/응답 없는 쓰기/알림 지원
+std::vector<GattCharacteristicPtr> buildTree(GattApplication& application, DBusConnection& connection, const Options& options) {
+    std::vector<GattCharacteristicPtr> characteristics;
+    std::vector<uint8_t> value(options.valueSize);
+    for (size_t s = 0; s < options.services; ++s) {
+        auto service = std::make_shared<GattService>(
+            connection, application.getPath() + ("service" + std::to_string(s)),
+            GattUuid::fromShortUuid(static_cast<uint16_t>(0xA000 + s)), true);
+        for (size_t c = 0; c < options.characteristicsPerService; ++c) {
+            GattCharacteristicPtr characteristic = service->createCharacteristic(
+                GattUuid::fromShortUuid(static_cast<uint16_t>(0xB000 + s * options.characteristicsPerService + c)),
+                GattProperty::PROP_READ | GattProperty::PROP_WRITE | GattProperty::PROP_WRITE_WITHOUT_RESPONSE |
+                    GattProperty::PROP_NOTIFY,
+                GattPermission::PERM_READ | GattPermission::PERM_WRITE);
+            characteristic->setValue(value);
+            characteristics.push_back(characteristic);
+        }
+        application.addService(service);
+    }
+    return characteristics;
+}
+
+// 서버 쪽 알림: 1 ms 틱마다 밀린 만큼 구독된 특성 전부에 현재 시각을 담아 setValue
+class Notifier {
+public:
+    Notifier(std::vector<GattCharacteristicPtr> characteristics, double rate, size_t valueSize)
+        : characteristics(std::move(characteristics)), rate(rate), value(valueSize) {}
+
+    void attach() {
+        if (rate <= 0) {
+            return;
+        }
+        start = std::chrono::steady_clock::now();
+        pSource = g_timeout_source_new(1);
+        g_source_set_callback(
+            pSource,
+            [](gpointer pUserData) -> gboolean {
+                static_cast<Notifier*>(pUserData)->onTick();
+                return G_SOURCE_CONTINUE;
+            },
+            this, nullptr);
+        g_source_attach(pSource, nullptr);
+    }
+
+    void detach() {
+        if (pSource != nullptr) {
+            g_source_destroy(pSource);
+            g_source_unref(pSource);
+            pSource = nullptr;
+        }
+    }
+
+private:
+    void onTick() {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t due = static_cast<uint64_t>(std::chrono::duration<double>(now - start).count() * rate);
+        if (due > rounds + kMaxCatchUp) {
+            rounds = due - kMaxCatchUp;         // 너무 밀리면 따라잡지 않고 건너뜀
+        }
+        for (; rounds < due; ++rounds) {
+            uint64_t stamp =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            for (size_t i = 0; i < sizeof(stamp); ++i) {
+                value[i] = static_cast<uint8_t>(stamp >> (8 * i));
+            }
+            for (const GattCharacteristicPtr& characteristic : characteristics) {
+                if (characteristic->isNotifying()) {
+                    characteristic->setValue(value);
+                }
+            }
+        }
+    }
+
+    static constexpr uint64_t kMaxCatchUp = 100;
+
+    std::vector<GattCharacteristicPtr> characteristics;
+    double rate;
+    std::vector<uint8_t> value;
+    std::chrono::steady_clock::time_point start;
+    uint64_t rounds = 0;
+    GSource* pSource = nullptr;
+};
+
+void writeJsonString(FILE* pFile, const std::string& text) {
+    fputc('"', pFile);
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', pFile);
+        }
+        fputc(c, pFile);
+    }
+    fputc('"', pFile);
+}
+
+// {"context": {...}, "phases": [MockBluez::toJson(report), ...]}
+bool writeJson(const Options& options, size_t characteristics, const std::vector<MockBluez::Report>& reports) {
+    bool toStdout = options.jsonPath == "-";
+    FILE* pFile = toStdout ? stdout : fopen(options.jsonPath.c_str(), "w");
+    if (pFile == nullptr) {
+        perror(options.jsonPath.c_str());
+        return false;
+    }
+
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+    char date[32] = "";
+    time_t now = time(nullptr);
+    struct tm utc;
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime_r(&now, &utc));
+
+    fprintf(pFile, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"host_name\": ", date);
+    writeJsonString(pFile, host);
+    fprintf(pFile, ",\n    \"transport\": ");
+    writeJsonString(pFile, options.pAddress != nullptr ? "bus" : "peer");
+    fprintf(pFile,
+            ",\n    \"services\": %zu,\n    \"characteristics\": %zu,\n    \"value_size\": %zu,\n"
+            "    \"notify_rate\": %.1f,\n    \"num_cpus\": %ld\n  },\n  \"phases\": [",
+            options.services, characteristics, options.valueSize, options.notifyRate, sysconf(_SC_NPROCESSORS_ONLN));
+    for (size_t i = 0; i < reports.size(); ++i) {
+        fprintf(pFile, "%s\n    %s", i == 0 ? "" : ",", MockBluez::toJson(reports[i]).c_str());
+    }
+    fprintf(pFile, "\n  ]\n}\n");
+
+    bool ok = ferror(pFile) == 0;
+    return toStdout ? fflush(pFile) == 0 && ok : fclose(pFile) == 0 && ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    Logger::registerInfoReceiver(&infoLogger);
+    Logger::registerWarnReceiver(&infoLogger);
+    Logger::registerErrorReceiver(&infoLogger);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    // 연결: 주소가 있으면 버스에 하나씩, 없으면 피어 간 연결의 양 끝
+    GDBusConnectionPtr serverRaw = makeGDBusConnectionPtr(nullptr);
+    GDBusConnectionPtr bluezRaw = makeGDBusConnectionPtr(nullptr);
+    bool connected = options.pAddress != nullptr
+                         ? connectToBus(options.pAddress, serverRaw) && connectToBus(options.pAddress, bluezRaw)
+                         : DBusConnection::openPeerPair(serverRaw, bluezRaw);
+    if (!connected) {
+        return 1;
+    }
+
+    MockBluez::Config config;
+    config.timestampedValues = true;
+    config.phases = options.phases;
+
+    // 모의 BlueZ는 자체 컨텍스트의 스레드에서 (애플리케이션은 서버 스레드의 기본 컨텍스트).
+    // 부하가 끝나도 애플리케이션이 정리될 때까지 연결을 유지함
+    std::atomic<bool> mockReady{false};
+    std::atomic<bool> mockFailed{false};
+    std::atomic<bool> mockDone{false};
+    std::atomic<bool> stopMock{false};
+    std::atomic<bool> quitMock{false};
+    std::vector<MockBluez::Report> reports;
+    GMainContext* pMockContext = g_main_context_new();
+    std::thread mockThread([&]() {
+        g_main_context_push_thread_default(pMockContext);
+        {
+            DBusConnection connection(std::move(bluezRaw));
+            MockBluez mock(connection, config);
+            mockFailed = !mock.start();
+            mockReady = true;
+            while (!mockFailed && !stopMock && !mock.isFinished()) {
+                g_main_context_iteration(pMockContext, TRUE);
+            }
+            mock.stop();
+            reports = mock.getReports();
+            mockDone = true;
+            while (!quitMock) {
+                g_main_context_iteration(pMockContext, TRUE);
+            }
+        }
+        g_main_context_pop_thread_default(pMockContext);
+    });
+    while (!mockReady) {
+        std::this_thread::yield();
+    }
+
+    int status = mockFailed ? 1 : 0;
+    size_t characteristicCount = 0;
+    if (!mockFailed) {
+        DBusConnection connection(std::move(serverRaw));
+        GattApplication application(connection, DBusObjectPath("/com/example/loadgen"));
+        std::vector<GattCharacteristicPtr> characteristics = buildTree(application, connection, options);
+        characteristicCount = characteristics.size();
+
+        // 애플리케이션 객체는 기본 컨텍스트에 등록됨: 서버 스레드가 그 루프를 돌림
+        GMainLoop* pServerLoop = g_main_loop_new(nullptr, FALSE);
+        std::thread serverThread([pServerLoop]() { g_main_loop_run(pServerLoop); });
+        Notifier notifier(characteristics, options.notifyRate, options.valueSize);
+
+        if (application.registerWithBlueZ()) {
+            notifier.attach();
+            while (!mockDone) {
+                if (interrupted) {
+                    stopMock = true;
+                    g_main_context_wakeup(pMockContext);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            notifier.detach();
+        } else {
+            status = 1;
+        }
+
+        g_main_loop_quit(pServerLoop);
+        serverThread.join();
+        g_main_loop_unref(pServerLoop);
+    }
+
+    stopMock = true;
+    quitMock = true;
+    g_main_context_wakeup(pMockContext);
+    mockThread.join();
+
+    if (status == 0) {
+        FILE* pConsole = options.jsonPath == "-" ? stderr : stdout;
+        for (const MockBluez::Report& report : reports) {
+            fprintf(pConsole, "%s\n", MockBluez::formatReport(report).c_str());
+        }
+        if (!options.jsonPath.empty() && !writeJson(options, characteristicCount, reports)) {
+            status = 1;
+        }
+        if (reports.empty()) {
+            status = 1;
+        }
+    }
+    g_main_context_unref(pMockContext);
+    return status;
+}
@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "BinaryLogReader.h"
+#include "Logger.h"
+
+using namespace ggk;
+
+// ble-logdecode: renders a BinaryLog file (BLE_LOG_BINARY) as text or JSON lines
+//
+//   ble-logdecode [--json] [--formats] <file>
+//
+// `--formats` lists the call sites recorded in the file instead of the records.
+
+namespace {
+
+void usage(const char* pProgram) {
+    fprintf(stderr, "usage: %s [--json] [--formats] <file>\n", pProgram);
+}
+
+void errorLogger(const char* pText) {
+    std::cerr << pText << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool json = false;
+    bool listFormats = false;
+    const char* pPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--formats") == 0) {
+            listFormats = true;
+        } else if (argv[i][0] != '-' && pPath == nullptr) {
+            pPath = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (pPath == nullptr) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Logger::registerErrorReceiver(&errorLogger);
+
+    BinaryLogReader reader;
+    if (!reader.open(pPath)) {
+        return 1;
+    }
+
+    if (listFormats) {
+        const auto& formats = reader.getFormats();
+        for (size_t i = 0; i < formats.size(); ++i) {
+            const BinaryLogReader::FormatInfo& format = formats[i];
+            printf("%4zu %-6s %-7s %s:%u \"%s\" (%s)\n", i + 1, Logger::levelName(format.level), Logger::moduleName(format.module),
+                   format.file.c_str(), format.line, format.format.c_str(), format.types.c_str());
+        }
+        return 0;
+    }
+
+    reader.forEach([json](const BinaryLogReader::Entry& entry) {
+        std::string line = json ? BinaryLogReader::toJson(entry) : BinaryLogReader::toText(entry);
+        line.push_back('\n');
+        fwrite(line.data(), 1, line.size(), stdout);
+    });
+    return 0;
+}
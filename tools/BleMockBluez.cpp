@@ -0,0 +1,138 @@
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <glib-unix.h>
+
+#include "DBusConnection.h"
+#include "Logger.h"
+#include "MockBluez.h"
+
+using namespace ggk;
+
+// ble-mockbluez: stands in for bluetoothd so a GATT server can be loaded without a radio
+//
+//   ble-mockbluez [--address ADDRESS] [--lenient] [--no-notify] [--keep-running] [--phase SPEC]...
+//
+// Without --address the mock connects to the system bus. Pointing DBUS_SYSTEM_BUS_ADDRESS at a private dbus-daemon moves both
+// the mock and the server under test onto that bus:
+//
+//   dbus-daemon --session --fork --print-address > /tmp/ble-bus
+//   export DBUS_SYSTEM_BUS_ADDRESS=$(cat /tmp/ble-bus)
+//   ble-mockbluez --phase clients=1,duration=5 --phase clients=16,rate=50,duration=10 &
+//   ./ble_peripheral
+//
+// Phases run in order once the application has registered (see MockBluez::parsePhase for the keys). The mock exits after the
+// last phase unless --keep-running is given. Like bluetoothd, RegisterApplication is answered only after the walk; --lenient
+// answers first, for servers that cannot serve GetManagedObjects while they wait for that reply.
+
+namespace {
+
+void usage(const char* pProgram) {
+    fprintf(stderr,
+            "usage: %s [--address ADDRESS] [--lenient] [--no-notify] [--keep-running] [--phase SPEC]...\n"
+            "  SPEC: name=N,clients=N,rate=REQ_PER_S,duration=S,read=PERCENT,command=PERCENT,size=BYTES,mtu=N\n",
+            pProgram);
+}
+
+void infoLogger(const char* pText) {
+    std::cerr << pText << std::endl;
+}
+
+gboolean quitLoop(gpointer pUserData) {
+    g_main_loop_quit(static_cast<GMainLoop*>(pUserData));
+    return G_SOURCE_CONTINUE;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MockBluez::Config config;
+    const char* pAddress = nullptr;
+    bool keepRunning = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--address") == 0 && i + 1 < argc) {
+            pAddress = argv[++i];
+        } else if (strcmp(argv[i], "--lenient") == 0) {
+            config.replyAfterWalk = false;
+        } else if (strcmp(argv[i], "--no-notify") == 0) {
+            config.subscribe = false;
+        } else if (strcmp(argv[i], "--keep-running") == 0) {
+            keepRunning = true;
+        } else if (strcmp(argv[i], "--phase") == 0 && i + 1 < argc) {
+            MockBluez::Phase phase;
+            if (!MockBluez::parsePhase(argv[++i], phase)) {
+                return 2;
+            }
+            config.phases.push_back(phase);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    Logger::registerInfoReceiver(&infoLogger);
+    Logger::registerWarnReceiver(&infoLogger);
+    Logger::registerErrorReceiver(&infoLogger);
+
+    if (config.phases.empty()) {
+        MockBluez::Phase phase;
+        phase.name = "default";
+        phase.durationSeconds = 10;
+        config.phases.push_back(phase);
+    }
+
+    // 연결: 주소가 있으면 그 버스, 없으면 시스템 버스 (DBUS_SYSTEM_BUS_ADDRESS를 따름)
+    std::unique_ptr<DBusConnection> connection;
+    if (pAddress != nullptr) {
+        GError* pError = nullptr;
+        GDBusConnection* pConnection = g_dbus_connection_new_for_address_sync(
+            pAddress,
+            static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                              G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+            nullptr, nullptr, &pError);
+        if (pConnection == nullptr) {
+            fprintf(stderr, "Cannot connect to %s: %s\n", pAddress, pError->message);
+            g_error_free(pError);
+            return 1;
+        }
+        connection = std::make_unique<DBusConnection>(makeGDBusConnectionPtr(pConnection));
+    } else {
+        connection = std::make_unique<DBusConnection>(G_BUS_TYPE_SYSTEM);
+        if (!connection->connect()) {
+            return 1;
+        }
+    }
+
+    GMainLoop* pLoop = g_main_loop_new(nullptr, FALSE);
+    g_unix_signal_add(SIGINT, quitLoop, pLoop);
+    g_unix_signal_add(SIGTERM, quitLoop, pLoop);
+
+    int status = 0;
+    {
+        MockBluez mock(*connection, config);
+        mock.setFinishedCallback([pLoop, keepRunning]() {
+            if (!keepRunning) {
+                g_main_loop_quit(pLoop);
+            }
+        });
+        if (!mock.start()) {
+            g_main_loop_unref(pLoop);
+            return 1;
+        }
+
+        g_main_loop_run(pLoop);
+        mock.stop();
+
+        for (const MockBluez::Report& report : mock.getReports()) {
+            printf("%s\n", MockBluez::formatReport(report).c_str());
+        }
+        status = mock.getCharacteristics().empty() ? 1 : 0;
+    }
+
+    g_main_loop_unref(pLoop);
+    return status;
+}